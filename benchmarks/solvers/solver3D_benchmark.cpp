@@ -0,0 +1,288 @@
+// ---------------------------------------------------------------------------------------------------------------------
+// Micro-benchmark of the 3D Maxwell solvers
+//
+// Compares the cache-blocked kernels of Solver3DKernels.h to the former implementation
+// (one pass per component through the Field3D::operator()(i,j,k) triple-pointer accessor)
+// and reports the effective memory bandwidth of each version.
+//
+// Build and run from the root of the repository:
+//     make solver3D_benchmark
+//     ./solver3D_benchmark [n_space_x n_space_y n_space_z] [n_iterations]
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include "Solver3DKernels.h"
+
+using namespace std;
+
+// Minimal 3D field with the same memory layout and accessor as Field3D
+class BenchField3D
+{
+public:
+    BenchField3D( unsigned int nx, unsigned int ny, unsigned int nz ) : nx_( nx ), ny_( ny ), nz_( nz )
+    {
+        data_ = new double[nx*ny*nz];
+        data_3D = new double **[nx];
+        for( unsigned int i=0; i<nx; i++ ) {
+            data_3D[i] = new double*[ny];
+            for( unsigned int j=0; j<ny; j++ ) {
+                data_3D[i][j] = data_ + i*ny*nz + j*nz;
+            }
+        }
+        for( unsigned int i=0; i<nx*ny*nz; i++ ) {
+            data_[i] = ( double )rand() / RAND_MAX - 0.5;
+        }
+    }
+    ~BenchField3D()
+    {
+        for( unsigned int i=0; i<nx_; i++ ) {
+            delete [] data_3D[i];
+        }
+        delete [] data_3D;
+        delete [] data_;
+    }
+    inline double &operator()( unsigned int i, unsigned int j, unsigned int k )
+    {
+        return data_3D[i][j][k];
+    }
+    unsigned int size()
+    {
+        return nx_*ny_*nz_;
+    }
+    void copy( BenchField3D &f )
+    {
+        std::copy( f.data_, f.data_+size(), data_ );
+    }
+    double maxdiff( BenchField3D &f )
+    {
+        double d = 0.;
+        for( unsigned int i=0; i<size(); i++ ) {
+            d = max( d, abs( data_[i]-f.data_[i] ) );
+        }
+        return d;
+    }
+    unsigned int nx_, ny_, nz_;
+    double *data_;
+    double ***data_3D;
+};
+
+struct BenchFields {
+    BenchFields( unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d ) :
+        Ex( nx_d, ny_p, nz_p ), Ey( nx_p, ny_d, nz_p ), Ez( nx_p, ny_p, nz_d ),
+        Bx( nx_p, ny_d, nz_d ), By( nx_d, ny_p, nz_d ), Bz( nx_d, ny_d, nz_p ),
+        Jx( nx_d, ny_p, nz_p ), Jy( nx_p, ny_d, nz_p ), Jz( nx_p, ny_p, nz_d ) {}
+    BenchField3D Ex, Ey, Ez, Bx, By, Bz, Jx, Jy, Jz;
+};
+
+// Former MF_Solver3D_Yee::operator()
+void faradayReference( BenchFields &f, unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d,
+                       double dt_ov_dx, double dt_ov_dy, double dt_ov_dz )
+{
+    for( unsigned int i=0 ; i<nx_p;  i++ ) {
+        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                f.Bx( i, j, k ) += -dt_ov_dy * ( f.Ez( i, j, k ) - f.Ez( i, j-1, k ) ) + dt_ov_dz * ( f.Ey( i, j, k ) - f.Ey( i, j, k-1 ) );
+            }
+        }
+    }
+    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
+        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                f.By( i, j, k ) += -dt_ov_dz * ( f.Ex( i, j, k ) - f.Ex( i, j, k-1 ) ) + dt_ov_dx * ( f.Ez( i, j, k ) - f.Ez( i-1, j, k ) );
+            }
+        }
+    }
+    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
+        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                f.Bz( i, j, k ) += -dt_ov_dx * ( f.Ey( i, j, k ) - f.Ey( i-1, j, k ) ) + dt_ov_dy * ( f.Ex( i, j, k ) - f.Ex( i, j-1, k ) );
+            }
+        }
+    }
+}
+
+// Former bulk of MF_Solver3D_Lehe::operator()
+void faradayLeheReference( BenchFields &f, unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d,
+                           double dt_ov_dx, double dt_ov_dy, double dt_ov_dz,
+                           double alpha_x, double alpha_y, double beta_xy, double beta_xz, double beta_yx, double delta_x )
+{
+    for( unsigned int i=1 ; i<nx_p-1;  i++ ) {
+        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                f.Bx( i, j, k ) += -dt_ov_dy * ( alpha_y * ( f.Ez( i,  j, k )  - f.Ez( i,  j-1, k ) )
+                                                 + beta_yx * ( f.Ez( i+1, j, k )  - f.Ez( i+1, j-1, k ) + f.Ez( i-1, j, k )-f.Ez( i-1, j-1, k ) )
+                                               )
+                                   +dt_ov_dz * ( alpha_y * ( f.Ey( i, j, k )-f.Ey( i, j, k-1 ) )
+                                                 + beta_yx * ( f.Ey( i+1, j, k )-f.Ey( i+1, j, k-1 ) + f.Ey( i-1, j, k )-f.Ey( i-1, j, k-1 ) )
+                                               );
+            }
+        }
+    }
+    for( unsigned int i=2 ; i<nx_d-2 ; i++ ) {
+        for( unsigned int j=1 ; j<ny_p-1 ; j++ ) {
+            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                f.By( i, j, k ) += dt_ov_dx * ( alpha_x * ( f.Ez( i,  j, k ) - f.Ez( i-1, j, k ) )
+                                                + beta_xy * ( f.Ez( i,  j+1, k ) - f.Ez( i-1, j+1, k ) + f.Ez( i, j-1, k )-f.Ez( i-1, j-1, k ) )
+                                                + beta_xz * ( f.Ez( i, j, k+1 ) - f.Ez( i-1, j, k+1 ) + f.Ez( i, j, k-1 )-f.Ez( i-1, j, k-1 ) )
+                                                + delta_x * ( f.Ez( i+1, j, k ) - f.Ez( i-2, j, k ) ) )
+                                   -dt_ov_dz * ( alpha_y * ( f.Ex( i, j, k )-f.Ex( i, j, k-1 ) )
+                                                 + beta_yx * ( f.Ex( i+1, j, k )-f.Ex( i+1, j, k-1 ) + f.Ex( i-1, j, k )-f.Ex( i-1, j, k-1 ) )
+                                               );
+            }
+        }
+    }
+    for( unsigned int i=2 ; i<nx_d-2 ; i++ ) {
+        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            for( unsigned int k=1 ; k<nz_p-1 ; k++ ) {
+                f.Bz( i, j, k ) += dt_ov_dy * ( alpha_y * ( f.Ex( i, j, k )-f.Ex( i, j-1, k ) )
+                                                + beta_yx * ( f.Ex( i+1, j, k )-f.Ex( i+1, j-1, k )   + f.Ex( i-1, j, k )-f.Ex( i-1, j-1, k ) ) )
+                                   - dt_ov_dx * ( alpha_x * ( f.Ey( i, j, k )-f.Ey( i-1, j, k ) )
+                                                  + beta_xy * ( f.Ey( i, j+1, k )-f.Ey( i-1, j+1, k )   + f.Ey( i, j-1, k )-f.Ey( i-1, j-1, k ) )
+                                                  + beta_xz * ( f.Ey( i, j, k+1 )-f.Ey( i-1, j, k+1 ) + f.Ey( i, j, k-1 )-f.Ey( i-1, j, k-1 ) )
+                                                  + delta_x * ( f.Ey( i+1, j, k )-f.Ey( i-2, j, k ) ) );
+            }
+        }
+    }
+}
+
+// Former MA_Solver3D_norm::operator()
+void ampereReference( BenchFields &f, unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d,
+                      double dt, double dt_ov_dx, double dt_ov_dy, double dt_ov_dz )
+{
+    for( unsigned int i=0 ; i<nx_d ; i++ ) {
+        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                f.Ex( i, j, k ) += -dt*f.Jx( i, j, k )
+                                   +                 dt_ov_dy * ( f.Bz( i, j+1, k ) - f.Bz( i, j, k ) )
+                                   -                 dt_ov_dz * ( f.By( i, j, k+1 ) - f.By( i, j, k ) );
+            }
+        }
+    }
+    for( unsigned int i=0 ; i<nx_p ; i++ ) {
+        for( unsigned int j=0 ; j<ny_d ; j++ ) {
+            for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                f.Ey( i, j, k ) += -dt*f.Jy( i, j, k )
+                                   -                  dt_ov_dx * ( f.Bz( i+1, j, k ) - f.Bz( i, j, k ) )
+                                   +                  dt_ov_dz * ( f.Bx( i, j, k+1 ) - f.Bx( i, j, k ) );
+            }
+        }
+    }
+    for( unsigned int i=0 ;  i<nx_p ; i++ ) {
+        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            for( unsigned int k=0 ; k<nz_d ; k++ ) {
+                f.Ez( i, j, k ) += -dt*f.Jz( i, j, k )
+                                   +                  dt_ov_dx * ( f.By( i+1, j, k ) - f.By( i, j, k ) )
+                                   -                  dt_ov_dy * ( f.Bx( i, j+1, k ) - f.Bx( i, j, k ) );
+            }
+        }
+    }
+}
+
+template<typename F>
+double bestTime( F f, unsigned int niter )
+{
+    double best = 1e30;
+    for( unsigned int it=0; it<niter; it++ ) {
+        auto t0 = chrono::high_resolution_clock::now();
+        f();
+        auto t1 = chrono::high_resolution_clock::now();
+        best = min( best, chrono::duration<double>( t1-t0 ).count() );
+    }
+    return best;
+}
+
+void report( string name, double bytes, double t_ref, double t_new, double diff )
+{
+    cout << setw( 18 ) << name
+         << setw( 14 ) << setprecision( 2 ) << fixed << bytes/t_ref*1e-9
+         << setw( 14 ) << bytes/t_new*1e-9
+         << setw( 10 ) << t_ref/t_new
+         << setw( 16 ) << scientific << diff << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+    unsigned int n_space[3] = {64, 64, 64};
+    unsigned int niter = 20;
+    if( argc >= 4 ) {
+        for( unsigned int i=0; i<3; i++ ) {
+            n_space[i] = atoi( argv[i+1] );
+        }
+    }
+    if( argc >= 5 ) {
+        niter = atoi( argv[4] );
+    }
+
+    // Same dimensions as Solver3D, with an oversize of 2
+    unsigned int oversize = 2;
+    unsigned int nx_p = n_space[0]+1+2*oversize, nx_d = nx_p+1;
+    unsigned int ny_p = n_space[1]+1+2*oversize, ny_d = ny_p+1;
+    unsigned int nz_p = n_space[2]+1+2*oversize, nz_d = nz_p+1;
+    double dt = 0.95/sqrt( 3. ), dt_ov_dx = dt, dt_ov_dy = dt, dt_ov_dz = dt;
+
+    BenchFields ref( nx_p, nx_d, ny_p, ny_d, nz_p, nz_d );
+    BenchFields opt( nx_p, nx_d, ny_p, ny_d, nz_p, nz_d );
+    BenchField3D *fref[9] = {&ref.Ex, &ref.Ey, &ref.Ez, &ref.Bx, &ref.By, &ref.Bz, &ref.Jx, &ref.Jy, &ref.Jz};
+    BenchField3D *fopt[9] = {&opt.Ex, &opt.Ey, &opt.Ez, &opt.Bx, &opt.By, &opt.Bz, &opt.Jx, &opt.Jy, &opt.Jz};
+    for( unsigned int i=0; i<9; i++ ) {
+        fopt[i]->copy( *fref[i] );
+    }
+
+    // Bytes streamed per call: E read, B read+write for Faraday; B, J read, E read+write for Ampere
+    double field_bytes = sizeof( double ) * ( double )ref.Ex.size();
+    double faraday_bytes = 9. * field_bytes;
+    double ampere_bytes = 12. * field_bytes;
+
+    cout << "3D Maxwell solver micro-benchmark: " << n_space[0] << "x" << n_space[1] << "x" << n_space[2]
+         << " cells, best of " << niter << " iterations" << endl;
+    cout << setw( 18 ) << "kernel" << setw( 14 ) << "former GB/s" << setw( 14 ) << "blocked GB/s"
+         << setw( 10 ) << "speedup" << setw( 16 ) << "max difference" << endl;
+
+    double t_ref = bestTime( [&]() {
+        faradayReference( ref, nx_p, nx_d, ny_p, ny_d, nz_p, nz_d, dt_ov_dx, dt_ov_dy, dt_ov_dz );
+    }, niter );
+    double t_new = bestTime( [&]() {
+        Solver3DKernels::faradayYee( opt.Bx.data_, opt.By.data_, opt.Bz.data_, opt.Ex.data_, opt.Ey.data_, opt.Ez.data_,
+                                     nx_p, nx_d, ny_p, ny_d, nz_p, nz_d, dt_ov_dx, dt_ov_dy, dt_ov_dz );
+    }, niter );
+    double diff = max( max( ref.Bx.maxdiff( opt.Bx ), ref.By.maxdiff( opt.By ) ), ref.Bz.maxdiff( opt.Bz ) );
+    report( "Faraday (Yee)", faraday_bytes, t_ref, t_new, diff );
+
+    // Coefficients of the Lehe scheme for cubic cells, as in MF_Solver3D_Lehe
+    double beta_yx = 1./8., beta_xy = 1./8., beta_xz = 1./8.;
+    double delta_x = ( 1./4. )*( 1.-pow( sin( M_PI*dt_ov_dx/2. )/dt_ov_dx, 2 ) );
+    double alpha_y = 1. - 2.*beta_yx;
+    double alpha_x = 1. - 2.*beta_xy - 2.*beta_xz - 3.*delta_x;
+    t_ref = bestTime( [&]() {
+        faradayLeheReference( ref, nx_p, nx_d, ny_p, ny_d, nz_p, nz_d, dt_ov_dx, dt_ov_dy, dt_ov_dz,
+                              alpha_x, alpha_y, beta_xy, beta_xz, beta_yx, delta_x );
+    }, niter );
+    t_new = bestTime( [&]() {
+        Solver3DKernels::faradayLehe( opt.Bx.data_, opt.By.data_, opt.Bz.data_, opt.Ex.data_, opt.Ey.data_, opt.Ez.data_,
+                                      nx_p, nx_d, ny_p, ny_d, nz_p, nz_d, dt_ov_dx, dt_ov_dy, dt_ov_dz,
+                                      alpha_x, alpha_y, beta_xy, beta_xz, beta_yx, delta_x );
+    }, niter );
+    diff = max( max( ref.Bx.maxdiff( opt.Bx ), ref.By.maxdiff( opt.By ) ), ref.Bz.maxdiff( opt.Bz ) );
+    report( "Faraday (Lehe)", faraday_bytes, t_ref, t_new, diff );
+
+    t_ref = bestTime( [&]() {
+        ampereReference( ref, nx_p, nx_d, ny_p, ny_d, nz_p, nz_d, dt, dt_ov_dx, dt_ov_dy, dt_ov_dz );
+    }, niter );
+    t_new = bestTime( [&]() {
+        Solver3DKernels::ampere( opt.Ex.data_, opt.Ey.data_, opt.Ez.data_, opt.Bx.data_, opt.By.data_, opt.Bz.data_,
+                                 opt.Jx.data_, opt.Jy.data_, opt.Jz.data_,
+                                 nx_p, nx_d, ny_p, ny_d, nz_p, nz_d, dt, dt_ov_dx, dt_ov_dy, dt_ov_dz );
+    }, niter );
+    diff = max( max( ref.Ex.maxdiff( opt.Ex ), ref.Ey.maxdiff( opt.Ey ) ), ref.Ez.maxdiff( opt.Ez ) );
+    report( "Ampere", ampere_bytes, t_ref, t_new, diff );
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS
+#
+# Plasma oscillations written by the field, probe and track diagnostics
+# from a background thread (async_diags). The particles are loaded regularly
+# without thermal spread, so that the outputs do not depend on the number of
+# processes: the reference was obtained with async_diags = 0 (synchronous writes).
+# ----------------------------------------------------------------------------------------
+
+import math
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.05 * L0,
+	simulation_time  = 4. * L0,
+	
+	cell_length = [0.1 * L0]*2,
+	grid_length  = [3.2 * L0]*2,
+	
+	number_of_patches = [ 4 ]*2,
+	
+	EM_boundary_conditions = [ ["periodic"] ],
+	print_every = 10,
+	
+	async_diags = 2,
+)
+
+Species(
+	name = "electron",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 4,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = 0.1,
+	mean_velocity = [
+		lambda x,y : 0.01*math.sin(2.*math.pi*x/Main.grid_length[0]),
+		lambda x,y : 0.01*math.sin(2.*math.pi*y/Main.grid_length[1]),
+		0.
+	],
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+Species(
+	name = "ion",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 4,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = 0.1,
+	time_frozen = 1000.,
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+
+DiagScalar(
+	every = 10,
+)
+DiagFields(
+	every = 10,
+	fields = ["Ex", "Ey", "Rho_electron"]
+)
+DiagProbe(
+	every = 10,
+	origin = [0., 0.5*L0],
+	corners = [[Main.grid_length[0], 0.5*L0]],
+	number = [32],
+	fields = ["Ex", "Ey", "Rho"]
+)
+DiagTrackParticles(
+	species = "electron",
+	every = 20,
+	filter = lambda particles: particles.y < 0.2*L0,
+	attributes = ["x", "y", "px", "py", "Ex", "Ey"]
+)
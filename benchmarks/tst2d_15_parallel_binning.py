@@ -0,0 +1,74 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS
+#
+# Particle binning diagnostics written in parallel (parallel_write = True),
+# each along with the same diagnostic written by the master process.
+# To be run with several MPI processes, so that each process writes a slice.
+# ----------------------------------------------------------------------------------------
+
+import math
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.05 * L0,
+	simulation_time  = 2. * L0,
+	
+	cell_length = [0.1 * L0]*2,
+	grid_length  = [3.2 * L0]*2,
+	
+	number_of_patches = [ 4 ]*2,
+	
+	EM_boundary_conditions = [ ["periodic"] ],
+	print_every = 10,
+)
+
+Species(
+	name = "electron",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 4,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = lambda x,y : 0.1*(1.+0.5*math.cos(2.*math.pi*x/Main.grid_length[0])),
+	mean_velocity = [0.01, 0., 0.],
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+Species(
+	name = "ion",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 4,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = lambda x,y : 0.1*(1.+0.5*math.cos(2.*math.pi*x/Main.grid_length[0])),
+	time_frozen = 1000.,
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+
+axes = [
+	[["x", 0., Main.grid_length[0], 64], ["px", -0.02, 0.04, 30]],
+	[["y", 0., Main.grid_length[1], 7]],
+	[["x", 0., Main.grid_length[0], 3], ["y", 0., Main.grid_length[1], 32]],
+]
+
+for axis in axes:
+	for parallel_write in [False, True]:
+		DiagParticleBinning(
+			deposited_quantity = "weight",
+			every = 10,
+			time_average = 2,
+			species = ["electron"],
+			axes = axis,
+			parallel_write = parallel_write
+		)
@@ -0,0 +1,71 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS
+#
+# Two identical species drifting across the patches, tracked with and without
+# ordered = True. To be run with several MPI processes, so that the particles
+# of the ordered track are written in the blocks of other processes.
+# ----------------------------------------------------------------------------------------
+
+import math
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.05 * L0,
+	simulation_time  = 3. * L0,
+	
+	cell_length = [0.1 * L0]*2,
+	grid_length  = [6.4 * L0, 3.2 * L0],
+	
+	number_of_patches = [ 8, 4 ],
+	
+	EM_boundary_conditions = [ ["periodic"] ],
+	print_every = 10,
+)
+
+for name in ["electron", "electron_ordered"]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "cold",
+		particles_per_cell = 1,
+		mass = 1.0,
+		charge = -1.0,
+		number_density = lambda x,y : 0.05 if y<0.8*L0 else 0.,
+		mean_velocity = [
+			lambda x,y : 0.5,
+			lambda x,y : 0.1*math.sin(2.*math.pi*x/Main.grid_length[0]),
+			0.
+		],
+		boundary_conditions = [
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+		],
+	)
+
+Species(
+	name = "ion",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 1,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = lambda x,y : 0.1 if y<0.8*L0 else 0.,
+	time_frozen = 1000.,
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+
+for species, ordered in [["electron", False], ["electron_ordered", True]]:
+	DiagTrackParticles(
+		species = species,
+		every = 6,
+		attributes = ["x", "y", "px", "py", "Ex", "Ey"],
+		ordered = ordered
+	)
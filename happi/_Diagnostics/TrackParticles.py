@@ -419,8 +419,30 @@ class TrackParticles(Diagnostic):
 				nparticles = group["id"].size
 				if nparticles == 0: continue
 
+				# If already ordered by Id, the particles of each MPI only need to be moved
+				if "ordered" in group.attrs.keys():
+					number_of_particles_t = (f["data"][tname]["latest_IDs"].value % (2**32)).astype('uint32')
+					offset_t = self._np.cumsum(number_of_particles_t) - number_of_particles_t
+					# Gather the MPIs whose particles are moved together
+					blocks = []
+					for rank in range(len(number_of_particles_t)):
+						n = int(number_of_particles_t[rank])
+						if n == 0: continue
+						start_t, start = int(offset_t[rank]), int(offset[rank])
+						if blocks and blocks[-1][0]+blocks[-1][2] == start_t and blocks[-1][1]+blocks[-1][2] == start:
+							blocks[-1][2] += n
+						else:
+							blocks += [[start_t, start, n]]
+					for k, name in properties.items():
+						if k not in group: continue
+						for start_t, start, n in blocks:
+							for first in range(0, n, chunksize):
+								last = min(first + chunksize, n)
+								data = group[k][start_t+first:start_t+last]
+								f0[name].write_direct(data, dest_sel=self._np.s_[it, start+first:start+last])
+
 				# If not too many particles, sort all at once
-				if nparticles < chunksize:
+				elif nparticles < chunksize:
 					# Get the Ids and find where they should be stored in the final file
 					locs = (
 						group["id"].value.astype("uint32") # takes the second hald of id (meaning particle number)
@@ -9,6 +9,11 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <algorithm>
 
 #include <mpi.h>
 
@@ -25,12 +30,146 @@
 #include "PatchesFactory.h"
 #include "DiagnosticScreen.h"
 #include "DiagnosticTrack.h"
+#include "DumpCompression.h"
 
 using namespace std;
 
 // static varable must be defined and initialized here
 int Checkpoint::signal_received=0;
 
+// Final mixing step of MurmurHash3
+static inline uint64_t fmix64( uint64_t k )
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+static inline uint64_t rotl64( uint64_t x, int r )
+{
+    return ( x << r ) | ( x >> ( 64-r ) );
+}
+
+// 128-bit hash of a memory block (MurmurHash3 x64_128), used to detect datasets unchanged since the base dump
+static void blockHash( const void *data, size_t bytes, uint64_t hash[2] )
+{
+    const unsigned char *c = static_cast<const unsigned char *>( data );
+    const uint64_t c1 = 0x87c37b91114253d5ULL, c2 = 0x4cf5ad432745937fULL;
+    uint64_t h1 = 0, h2 = 0;
+    size_t n = bytes/16;
+    for( size_t i=0; i<n; i++ ) {
+        uint64_t k1, k2;
+        memcpy( &k1, c+16*i, 8 );
+        memcpy( &k2, c+16*i+8, 8 );
+        k1 *= c1; k1 = rotl64( k1, 31 ); k1 *= c2; h1 ^= k1;
+        h1 = rotl64( h1, 27 ); h1 += h2; h1 = h1*5 + 0x52dce729;
+        k2 *= c2; k2 = rotl64( k2, 33 ); k2 *= c1; h2 ^= k2;
+        h2 = rotl64( h2, 31 ); h2 += h1; h2 = h2*5 + 0x38495ab5;
+    }
+    // Remaining bytes
+    uint64_t k1 = 0, k2 = 0;
+    size_t tail = bytes - 16*n;
+    for( size_t i=tail; i>8; i-- ) {
+        k2 ^= uint64_t( c[16*n+i-1] ) << ( 8*( i-9 ) );
+    }
+    for( size_t i=min( tail, ( size_t )8 ); i>0; i-- ) {
+        k1 ^= uint64_t( c[16*n+i-1] ) << ( 8*( i-1 ) );
+    }
+    if( tail > 8 ) {
+        k2 *= c2; k2 = rotl64( k2, 33 ); k2 *= c1; h2 ^= k2;
+    }
+    if( tail > 0 ) {
+        k1 *= c1; k1 = rotl64( k1, 31 ); k1 *= c2; h1 ^= k1;
+    }
+    h1 ^= bytes;
+    h2 ^= bytes;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64( h1 );
+    h2 = fmix64( h2 );
+    h1 += h2;
+    h2 += h1;
+    hash[0] = h1;
+    hash[1] = h2;
+}
+
+// Write a 1D dataset from raw data
+static void writeBlock( hid_t locationId, string name, const void *data, hsize_t size, hid_t type, int deflate, int compression, hid_t lcpl=H5P_DEFAULT )
+{
+    hid_t sid = H5Screate_simple( 1, &size, NULL );
+    hid_t pid = H5Pcreate( H5P_DATASET_CREATE );
+    if( compression != DumpCompression::none && size>0 ) {
+        hsize_t chunk = min( size, ( hsize_t )1048576 );
+        H5Pset_chunk( pid, 1, &chunk );
+        DumpCompression::setFilter( pid, type, compression );
+        if( deflate>0 ) {
+            H5Pset_deflate( pid, min( 9, deflate ) );
+        }
+    } else if( deflate>0 && size>0 ) {
+        H5Pset_chunk( pid, 1, &size );
+        H5Pset_deflate( pid, min( 9, deflate ) );
+    }
+    hid_t did = H5Dcreate( locationId, name.c_str(), type, sid, lcpl, pid, H5P_DEFAULT );
+    H5Dwrite( did, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data );
+    H5Dclose( did );
+    H5Pclose( pid );
+    H5Sclose( sid );
+}
+
+// Order of the particles sorted by cell within each bin, so that the dumped arrays compress well
+static void cellSortedOrder( Species *species, unsigned int nDim, vector<unsigned int> &order )
+{
+    Particles *particles = species->particles;
+    unsigned int npart = particles->size();
+    unsigned int ndim = min( nDim, ( unsigned int )species->min_loc_vec.size() );
+    vector<uint64_t> keys( npart );
+    for( unsigned int ip=0; ip<npart; ip++ ) {
+        uint64_t key = 0;
+        for( unsigned int idim=0; idim<ndim; idim++ ) {
+            int IX = floor( ( particles->position( idim, ip )-species->min_loc_vec[idim] ) * species->dx_inv_[idim] );
+            key = ( key << 16 ) | ( ( IX+1 ) & 0xffff );
+        }
+        keys[ip] = key;
+    }
+    order.resize( npart );
+    iota( order.begin(), order.end(), 0 );
+    for( unsigned int ibin=0; ibin<species->first_index.size(); ibin++ ) {
+        if( species->first_index[ibin] < species->last_index[ibin] && species->last_index[ibin] <= ( int )npart ) {
+            stable_sort( order.begin()+species->first_index[ibin], order.begin()+species->last_index[ibin],
+            [&keys]( unsigned int a, unsigned int b ) {
+                return keys[a] < keys[b];
+            } );
+        }
+    }
+}
+
+// Pointer to the data of v, or to a copy of v in the given order
+template<class T>
+static const T *reordered( const vector<T> &v, const vector<unsigned int> &order, vector<T> &buffer )
+{
+    if( order.empty() ) {
+        return v.data();
+    }
+    buffer.resize( v.size() );
+    for( size_t i=0; i<v.size(); i++ ) {
+        buffer[i] = v[order[i]];
+    }
+    return buffer.data();
+}
+
+// Undo the order applied by reordered() when the particles were dumped
+template<class T>
+static void restoreOrder( vector<T> &v, const vector<unsigned int> &order )
+{
+    vector<T> buffer( v );
+    for( size_t i=0; i<v.size(); i++ ) {
+        v[order[i]] = buffer[i];
+    }
+}
+
 Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     dump_number( 0 ),
     this_run_start_step( 0 ),
@@ -38,13 +177,24 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     dump_step( 0 ),
     dump_minutes( 0.0 ),
     exit_after_dump( true ),
+    async_dump( false ),
+    async_dump_max_memory( 1024. ),
+    incremental_dumps( 0 ),
     time_reference( MPI_Wtime() ),
     time_dump_step( 0 ),
     keep_n_dumps( 2 ),
     keep_n_dumps_max( 10000 ),
     dump_deflate( 0 ),
+    dump_compression( DumpCompression::none ),
     dump_request( smpi->getSize() ),
-    file_grouping( 0 )
+    file_grouping( 0 ),
+    base_number( 0 ),
+    dumps_since_base( 0 ),
+    base_fid( -1 ),
+    dump_bytes_written( 0 ),
+    dump_bytes_linked( 0 ),
+    dump_in_memory_( false ),
+    dump_size_max_( 0 )
 {
 
     if( PyTools::nComponents( "Checkpoints" ) > 0 ) {
@@ -71,10 +221,29 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             keep_n_dumps = keep_n_dumps_max;
         }
         
+        PyTools::extract( "incremental_dumps", incremental_dumps, "Checkpoints" );
+        // A base file is overwritten every 2*(incremental_dumps+1) dumps: it must not be referenced by a kept dump
+        if( incremental_dumps>0 && incremental_dumps+2 < keep_n_dumps ) {
+            WARNING( "incremental_dumps raised to keep_n_dumps-2 = " << keep_n_dumps-2 << " so that kept dumps remain valid" );
+            incremental_dumps = keep_n_dumps-2;
+        }
+        
         PyTools::extract( "exit_after_dump", exit_after_dump, "Checkpoints" );
         
         PyTools::extract( "dump_deflate", dump_deflate, "Checkpoints" );
         
+        string compression( "" );
+        PyTools::extract( "dump_compression", compression, "Checkpoints" );
+        if( ! DumpCompression::getMode( compression, dump_compression ) ) {
+            ERROR( "Checkpoints.dump_compression must be `none`, `shuffle` or `xor_delta`" );
+        }
+        if( dump_compression != DumpCompression::none ) {
+            MESSAGE( 1, "Dumps compressed with the `" << compression << "` method" );
+        }
+        
+        PyTools::extract( "async_dump", async_dump, "Checkpoints" );
+        PyTools::extract( "async_dump_max_memory", async_dump_max_memory, "Checkpoints" );
+        
         if( PyTools::extract( "file_grouping", file_grouping, "Checkpoints" ) && file_grouping > 0 ) {
             if( file_grouping > ( unsigned int )( smpi->getSize() ) ) {
                 file_grouping = smpi->getSize();
@@ -97,6 +266,9 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
                     restart_file=dump_name;
                     dump_number=num_dump;
                     H5::getAttr( fid, "dump_number", dump_number );
+                    if( H5Aexists( fid, "base_number" )>0 ) {
+                        H5::getAttr( fid, "base_number", base_number );
+                    }
                 }
                 H5Fclose( fid );
             }
@@ -130,6 +302,12 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             message << " keeping "<< keep_n_dumps << " dumps at maximum";
             MESSAGE( 1, message.str() );
         }
+        if( async_dump ) {
+            MESSAGE( 1, "Dump files will be written in the background, using up to " << async_dump_max_memory << " MB per process" );
+        }
+        if( incremental_dumps>0 ) {
+            MESSAGE( 1, "Each full dump will be followed by " << incremental_dumps << " incremental dumps" );
+        }
     }
     
     // registering signal handler
@@ -140,9 +318,17 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
         WARNING( "Cannot catch signal SIGUSR2" );
     }
     
+    // Needed to write and to read compressed dumps
+    DumpCompression::registerFilter();
+    
     nDim_particle=params.nDim_particle;
 }
 
+Checkpoint::~Checkpoint()
+{
+    waitDump();
+}
+
 void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *smpi, SimWindow *simWindow, Params &params )
 {
 
@@ -174,6 +360,8 @@ void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *s
         dumpAll( vecPatches, itime,  smpi, simWindow, params );
         if( exit_after_dump || ( ( signal_received!=0 ) && ( signal_received != SIGUSR2 ) ) ) {
             exit_asap=true;
+            // The dump must be on disk before the code exits
+            waitDump();
         }
         signal_received=0;
         time_dump_step=0;
@@ -182,6 +370,18 @@ void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *s
 
 void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin,  Params &params )
 {
+    // The writes of the diagnostics must be finished before using HDF5
+    vecPatches.diagWriter.wait();
+    
+    // The previous dump must be fully written before its buffers are released
+    // and before the same file names are reused by the keep_n_dumps rotation
+    waitDump();
+    
+    // In async mode, the dump is built in memory only if its image and the copy handed to the writer
+    // fit in async_dump_max_memory, judging from the largest dump so far. The first one is written
+    // synchronously, to measure it.
+    dump_in_memory_ = async_dump && dump_size_max_ > 0 && 2.*dump_size_max_ <= async_dump_max_memory*1048576.;
+    
     unsigned int num_dump=dump_number % keep_n_dumps;
     
     ostringstream nameDumpTmp( "" );
@@ -194,7 +394,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     std::string dumpName=nameDumpTmp.str();
     
     
-    hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+    hid_t fid = createDumpFile( dumpName );
     dump_number++;
     
 #ifdef  __DEBUG
@@ -202,13 +402,41 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
 #else
     MESSAGE( "Step " << itime << " : DUMP fields and particles " << num_dump );
 #endif
+    if( async_dump && dump_size_max_ > 0 && ! dump_in_memory_ ) {
+        MESSAGE( 1, "Written synchronously: the dump would exceed async_dump_max_memory" );
+    }
+    
     
+    // Incremental dumps: datasets unchanged since the last base dump are external links to the base file.
+    // Every incremental_dumps+1 dumps, a new base is written, alternating between two base files.
+    string baseName;
+    if( incremental_dumps>0 ) {
+        if( base_name.empty() || dumps_since_base >= incremental_dumps ) {
+            ostringstream nameBase( "" );
+            nameBase << "base-" << setfill( '0' ) << setw( 5 ) << base_number%2 << "-" << setfill( '0' ) << setw( 10 ) << smpi->getRank() << ".h5" ;
+            base_name = nameBase.str();
+            baseName = dumpName.substr( 0, dumpName.rfind( PATH_SEPARATOR )+1 ) + base_name;
+            base_fid = createDumpFile( baseName );
+            base_signatures.clear();
+            base_number++;
+            dumps_since_base = 0;
+        } else {
+            dumps_since_base++;
+        }
+    }
+    dump_bytes_written = 0;
+    dump_bytes_linked = 0;
+    DumpCompression::resetStats();
+    double compression_time = MPI_Wtime();
     
     // Write basic attributes
     H5::attr( fid, "Version", string( __VERSION ) );
     
     H5::attr( fid, "dump_step", itime );
     H5::attr( fid, "dump_number", dump_number );
+    if( incremental_dumps>0 ) {
+        H5::attr( fid, "base_number", base_number );
+    }
     
     H5::vect( fid, "patch_count", smpi->patch_count );
     
@@ -255,9 +483,6 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         
         dumpPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, params, patch_gid );
         
-        // Random number generator state
-        H5::attr( patch_gid, "xorshift32_state", vecPatches( ipatch )->xorshift32_state );
-        
         // Close a group
         H5Gclose( patch_gid );
         
@@ -277,8 +502,133 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         dumpMovingWindow( fid, simWin );
     }
     
+    // The base file is closed (and staged) first: it must be on disk before the dump referencing it
+    vector<pair<string, vector<char> > > staged;
+    uint64_t dump_size = 0;
+    if( base_fid >= 0 ) {
+        dump_size += closeDumpFile( base_fid, baseName, staged );
+        base_fid = -1;
+    }
+    dump_size += closeDumpFile( fid, dumpName, staged );
+    dump_size_max_ = max( dump_size_max_, dump_size );
+    
+    compression_time = MPI_Wtime() - compression_time;
+    if( dump_compression != DumpCompression::none && DumpCompression::bytes_out > 0. ) {
+        MESSAGE( 1, "Compression ratio " << DumpCompression::bytes_in / DumpCompression::bytes_out
+                 << ", encoding at " << DumpCompression::bytes_in / 1048576. / max( DumpCompression::encode_time, 1e-9 ) << " MB/s"
+                 << ", dump written at " << DumpCompression::bytes_in / 1048576. / max( compression_time, 1e-9 ) << " MB/s" );
+    }
+    if( incremental_dumps>0 ) {
+        // Totals over all ranks
+        uint64_t dump_bytes[2] = { dump_bytes_written, dump_bytes_linked }, dump_bytes_total[2] = { 0, 0 };
+        MPI_Reduce( dump_bytes, dump_bytes_total, 2, MPI_UINT64_T, MPI_SUM, 0, smpi->SMILEI_COMM_WORLD );
+        MESSAGE( 1, "Wrote " << dump_bytes_total[0]/1048576 << " MB, linked " << dump_bytes_total[1]/1048576 << " MB unchanged since " << base_name );
+    }
+    
+    if( dump_in_memory_ ) {
+        dump_images.swap( staged );
+        dump_writer = thread( &Checkpoint::writeDumpImages, this );
+    }
+    
+}
+
+hid_t Checkpoint::createDumpFile( string dumpName )
+{
+    // In async mode, the file is built in memory (HDF5 core driver without backing store)
+    // and its image is written to disk by a background thread
+    hid_t fapl = H5Pcreate( H5P_FILE_ACCESS );
+    if( dump_in_memory_ ) {
+        H5Pset_fapl_core( fapl, 16*1024*1024, 0 );
+    }
+    hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
+    H5Pclose( fapl );
+    return fid;
+}
+
+uint64_t Checkpoint::closeDumpFile( hid_t fid, string dumpName, vector<pair<string, vector<char> > > &staged )
+{
+    H5Fflush( fid, H5F_SCOPE_GLOBAL );
+    hsize_t size = 0;
+    H5Fget_filesize( fid, &size );
+    if( dump_in_memory_ ) {
+        staged.push_back( make_pair( dumpName, vector<char>( H5Fget_file_image( fid, NULL, 0 ) ) ) );
+        H5Fget_file_image( fid, staged.back().second.data(), staged.back().second.size() );
+    }
     H5Fclose( fid );
+    return size;
+}
+
+void Checkpoint::waitDump()
+{
+    if( dump_writer.joinable() ) {
+        dump_writer.join();
+    }
+    // ERROR cannot be called from dump_writer (it aborts the MPI run)
+    if( ! dump_error_.empty() ) {
+        ERROR( dump_error_ );
+    }
+}
+
+void Checkpoint::writeDumpImages()
+{
+    for( unsigned int i=0; i<dump_images.size(); i++ ) {
+        string &dumpName = dump_images[i].first;
+        vector<char> &image = dump_images[i].second;
+        // Write to a temporary file first so that an incomplete dump is never picked for a restart
+        string tmpName = dumpName + ".tmp";
+        ofstream file( tmpName.c_str(), ios::out | ios::binary | ios::trunc );
+        file.write( image.data(), image.size() );
+        file.close();
+        if( file.fail() || rename( tmpName.c_str(), dumpName.c_str() ) != 0 ) {
+            dump_error_ = "Cannot write checkpoint file " + dumpName;
+            return;
+        }
+    }
+}
+
+void Checkpoint::dumpBlock( hid_t gid, string name, const void *data, hsize_t size, hid_t type, int deflate )
+{
+    if( incremental_dumps == 0 ) {
+        writeBlock( gid, name, data, size, type, deflate, dump_compression );
+        return;
+    }
+    
+    // The dataset has the same path in the dump and in the base file
+    size_t bytes = size * H5Tget_size( type );
+    BlockSignature signature;
+    blockHash( data, bytes, signature.hash );
+    signature.size = size;
+    signature.type = type;
+    string path( H5Iget_name( gid, NULL, 0 ), '\0' );
+    H5Iget_name( gid, &path[0], path.size()+1 );
+    path += "/" + name;
+    
+    if( base_fid >= 0 ) {
+        // Base dump: store the data in the base file, creating its groups as needed
+        hid_t lcpl = H5Pcreate( H5P_LINK_CREATE );
+        H5Pset_create_intermediate_group( lcpl, 1 );
+        writeBlock( base_fid, path, data, size, type, deflate, dump_compression, lcpl );
+        H5Pclose( lcpl );
+        base_signatures[path] = signature;
+        dump_bytes_written += bytes;
+    } else {
+        // Incremental dump: store the data only if it changed since the base dump.
+        // The base data is not read back: the link requires the same size, the same type and the same 128-bit hash
+        map<string, BlockSignature>::iterator it = base_signatures.find( path );
+        if( it == base_signatures.end()
+                || it->second.size != size
+                || H5Tequal( it->second.type, type ) <= 0
+                || it->second.hash[0] != signature.hash[0]
+                || it->second.hash[1] != signature.hash[1] ) {
+            writeBlock( gid, name, data, size, type, deflate, dump_compression );
+            dump_bytes_written += bytes;
+            return;
+        }
+        dump_bytes_linked += bytes;
+    }
     
+    // The link is resolved by HDF5 relative to the directory of the dump file
+    H5Lcreate_external( base_name.c_str(), path.c_str(), gid, name.c_str(), H5P_DEFAULT, H5P_DEFAULT );
 }
 
 void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpecies, Params &params, hid_t patch_gid )
@@ -397,23 +747,45 @@ void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpe
         
         if( vecSpecies[ispec]->particles->size()>0 ) {
         
-            for( unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++ ) {
+            // Compressed dumps: particles are written sorted by cell within each bin,
+            // and the permutation is stored so that the restart recovers the original order
+            Particles *particles = vecSpecies[ispec]->particles;
+            vector<unsigned int> order;
+            if( dump_compression != DumpCompression::none && ! vecSpecies[ispec]->vectorized_operators ) {
+                cellSortedOrder( vecSpecies[ispec], nDim_particle, order );
+            }
+            vector<double> buffer;
+            
+            for( unsigned int i=0; i<particles->Position.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Position-" << i;
-                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Position[i], dump_deflate );
+                dumpBlock( gid, my_name.str(), reordered( particles->Position[i], order, buffer ), particles->Position[i].size(), H5T_NATIVE_DOUBLE, dump_deflate );
             }
             
-            for( unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++ ) {
+            // Momenta are dumped in their storage precision (see momentum_t)
+#ifdef __SINGLE_PRECISION_MOMENTUM
+            hid_t momentum_type = H5T_NATIVE_FLOAT;
+#else
+            hid_t momentum_type = H5T_NATIVE_DOUBLE;
+#endif
+            vector<momentum_t> momentum_buffer;
+            for( unsigned int i=0; i<particles->Momentum.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Momentum-" << i;
-                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Momentum[i], dump_deflate );
+                dumpBlock( gid, my_name.str(), reordered( particles->Momentum[i], order, momentum_buffer ), particles->Momentum[i].size(), momentum_type, dump_deflate );
             }
             
-            H5::vect( gid, "Weight", vecSpecies[ispec]->particles->Weight, dump_deflate );
-            H5::vect( gid, "Charge", vecSpecies[ispec]->particles->Charge, dump_deflate );
+            dumpBlock( gid, "Weight", reordered( particles->Weight, order, buffer ), particles->Weight.size(), H5T_NATIVE_DOUBLE, dump_deflate );
+            vector<short> charge_buffer;
+            dumpBlock( gid, "Charge", reordered( particles->Charge, order, charge_buffer ), particles->Charge.size(), H5T_NATIVE_SHORT, dump_deflate );
             
-            if( vecSpecies[ispec]->particles->tracked ) {
-                H5::vect( gid, "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64, dump_deflate );
+            if( particles->tracked ) {
+                vector<uint64_t> id_buffer;
+                dumpBlock( gid, "Id", reordered( particles->Id, order, id_buffer ), particles->Id.size(), H5T_NATIVE_UINT64, dump_deflate );
+            }
+            
+            if( ! order.empty() ) {
+                dumpBlock( gid, "Order", order.data(), order.size(), H5T_NATIVE_UINT, dump_deflate );
             }
             
             
@@ -524,9 +896,6 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI *smpi, SimWindo
         
         restartPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, params, patch_gid );
         
-        // Random number generator state
-        H5::getAttr( patch_gid, "xorshift32_state", vecPatches( ipatch )->xorshift32_state );
-        
         H5Gclose( patch_gid );
         
     }
@@ -708,6 +1077,27 @@ void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &ve
                 H5::getVect( gid, "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64 );
             }
             
+            // Particles dumped in cell-sorted order are put back in their original order
+            if( H5Lexists( gid, "Order", H5P_DEFAULT ) > 0 ) {
+                Particles *particles = vecSpecies[ispec]->particles;
+                vector<unsigned int> order;
+                H5::getVect( gid, "Order", order, true );
+                if( order.size() != partSize ) {
+                    ERROR( "Corrupted particle order in " << restart_file );
+                }
+                for( unsigned int i=0; i<particles->Position.size(); i++ ) {
+                    restoreOrder( particles->Position[i], order );
+                }
+                for( unsigned int i=0; i<particles->Momentum.size(); i++ ) {
+                    restoreOrder( particles->Momentum[i], order );
+                }
+                restoreOrder( particles->Weight, order );
+                restoreOrder( particles->Charge, order );
+                if( particles->tracked ) {
+                    restoreOrder( particles->Id, order );
+                }
+            }
+            
             if( params.vectorization_mode == "off" || params.vectorization_mode == "on" ) {
                 H5::getVect( gid, "first_index", vecSpecies[ispec]->first_index, true );
                 H5::getVect( gid, "last_index", vecSpecies[ispec]->last_index, true );
@@ -724,23 +1114,14 @@ void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &ve
 
 void Checkpoint::dumpFieldsPerProc( hid_t fid, Field *field )
 {
-    hsize_t dims[1]= {field->globalDims_};
-    hid_t sid = H5Screate_simple( 1, dims, NULL );
-    hid_t did = H5Dcreate( fid, field->name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT );
-    H5Dwrite( did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0] );
-    H5Dclose( did );
-    H5Sclose( sid );
+    dumpBlock( fid, field->name, field->data_, field->globalDims_, H5T_NATIVE_DOUBLE );
 }
 
 void Checkpoint::dump_cFieldsPerProc( hid_t fid, Field *field )
 {
     cField *cfield = static_cast<cField *>( field );
-    hsize_t dims[1]= {2*field->globalDims_}; //*2 : to manage complex data
-    hid_t sid = H5Screate_simple( 1, dims, NULL );
-    hid_t did = H5Dcreate( fid, field->name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT );
-    H5Dwrite( did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &cfield->cdata_[0] );
-    H5Dclose( did );
-    H5Sclose( sid );
+    //*2 : to manage complex data
+    dumpBlock( fid, field->name, cfield->cdata_, 2*field->globalDims_, H5T_NATIVE_DOUBLE );
 }
 
 void Checkpoint::restartFieldsPerProc( hid_t fid, Field *field )
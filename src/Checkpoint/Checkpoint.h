@@ -9,6 +9,8 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <thread>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -34,7 +36,7 @@ class Checkpoint
 public:
     Checkpoint( Params &params, SmileiMPI *smpi );
     //! Destructor for Checkpoint
-    virtual ~Checkpoint() {};
+    virtual ~Checkpoint();
     
     //! Space dimension of a particle
     unsigned int nDim_particle;
@@ -60,6 +62,9 @@ public:
     void dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin, Params &params );
     void dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpecies, Params &params, hid_t patch_gid );
     
+    //! wait for the background writing of the last dump (async_dump only)
+    void waitDump();
+    
     //! incremental number of times we've done a dump
     unsigned int dump_number;
     
@@ -96,6 +101,15 @@ public:
     //! exit once dump done
     bool exit_after_dump;
     
+    //! write the dump files in a background thread
+    bool async_dump;
+    
+    //! memory (MB per process) that async_dump may use; larger dumps are written synchronously
+    double async_dump_max_memory;
+    
+    //! number of incremental dumps written between two full (base) dumps; 0 disables incremental dumps
+    unsigned int incremental_dumps;
+    
 private:
 
     //! initialize the time zero of the simulation
@@ -108,6 +122,18 @@ private:
     //! dump moving window parameters
     void dumpMovingWindow( hid_t fid, SimWindow *simWindow );
     
+    //! create a dump file (in memory if dump_in_memory_)
+    hid_t createDumpFile( std::string dumpName );
+    
+    //! close a dump file and return its size; if dump_in_memory_, its image is appended to staged
+    uint64_t closeDumpFile( hid_t fid, std::string dumpName, std::vector<std::pair<std::string, std::vector<char> > > &staged );
+    
+    //! write the staged file images to disk (runs in dump_writer)
+    void writeDumpImages();
+    
+    //! write a dataset, or link it to the base dump if it did not change since then
+    void dumpBlock( hid_t gid, std::string name, const void *data, hsize_t size, hid_t type, int deflate=0 );
+    
     //! function that returns elapsed time from creator (uses private var time_reference)
     //double time_seconds();
     
@@ -131,6 +157,9 @@ private:
     //! int deflate dump value
     int dump_deflate;
     
+    //! compression method of the dump datasets (DumpCompression::Mode)
+    int dump_compression;
+    
     std::vector<MPI_Request> dump_request;
     MPI_Status dump_status_prob;
     MPI_Status dump_status_recv;
@@ -141,6 +170,46 @@ private:
     //! restart file
     std::string restart_file;
     
+    //! in-memory images (and file names) of the last dump files, being written by dump_writer
+    std::vector<std::pair<std::string, std::vector<char> > > dump_images;
+    
+    //! background thread writing dump_images
+    std::thread dump_writer;
+    
+    //! error met by dump_writer, reported by waitDump on the main thread
+    std::string dump_error_;
+    
+    //! number of base dumps done so far (incremental dumps only)
+    unsigned int base_number;
+    
+    //! number of incremental dumps since the last base dump
+    unsigned int dumps_since_base;
+    
+    //! base file being written during a base dump, negative otherwise
+    hid_t base_fid;
+    
+    //! name of the current base file, relative to the directory of the dump files
+    std::string base_name;
+    
+    //! size, type and 128-bit hash of a dataset stored in the base file
+    struct BlockSignature {
+        uint64_t hash[2];
+        hsize_t size;
+        hid_t type;
+    };
+    
+    //! signature of each dataset stored in the current base file, indexed by its path
+    std::map<std::string, BlockSignature> base_signatures;
+    
+    //! bytes written and linked to the base during the current dump
+    uint64_t dump_bytes_written, dump_bytes_linked;
+    
+    //! whether the current dump is built in memory and written in the background
+    bool dump_in_memory_;
+    
+    //! largest total size of the files of one dump so far (bytes)
+    uint64_t dump_size_max_;
+    
 };
 
 #endif /* CHECKPOINT_H_ */
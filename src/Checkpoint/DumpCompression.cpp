@@ -0,0 +1,279 @@
+/*
+ * DumpCompression.cpp
+ */
+
+#include "DumpCompression.h"
+
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include <mpi.h>
+
+using namespace std;
+
+double DumpCompression::bytes_in = 0.;
+double DumpCompression::bytes_out = 0.;
+double DumpCompression::encode_time = 0.;
+
+bool DumpCompression::getMode( string name, int &mode )
+{
+    if( name == "none" ) {
+        mode = none;
+    } else if( name == "shuffle" ) {
+        mode = shuffle;
+    } else if( name == "xor_delta" ) {
+        mode = xor_delta;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void DumpCompression::registerFilter()
+{
+    static const H5Z_class2_t filter_class = {
+        H5Z_CLASS_T_VERS, filter_id, 1, 1, "Smilei dump compression", NULL, NULL, DumpCompression::filter
+    };
+    if( H5Zfilter_avail( filter_id ) <= 0 ) {
+        H5Zregister( &filter_class );
+    }
+}
+
+void DumpCompression::setFilter( hid_t pid, hid_t type, int mode )
+{
+    unsigned int cd_values[3] = { ( unsigned int )H5Tget_size( type ), ( unsigned int )mode, format_version };
+    // Optional: chunks that do not compress are stored as they are
+    H5Pset_filter( pid, filter_id, H5Z_FLAG_OPTIONAL, 3, cd_values );
+}
+
+void DumpCompression::resetStats()
+{
+    bytes_in = 0.;
+    bytes_out = 0.;
+    encode_time = 0.;
+}
+
+size_t DumpCompression::decodedSize( const unsigned char *in )
+{
+    uint64_t nbytes;
+    memcpy( &nbytes, in, sizeof( uint64_t ) );
+    return nbytes;
+}
+
+size_t DumpCompression::writeSequence( const unsigned char *literals, size_t nliterals, size_t offset, size_t match, unsigned char *out, size_t o )
+{
+    size_t m = match > 0 ? match-4 : 0;
+    unsigned char *token = &out[o++];
+    *token = ( unsigned char )( ( min( nliterals, ( size_t )15 ) << 4 ) | min( m, ( size_t )15 ) );
+    if( nliterals >= 15 ) {
+        for( size_t l = nliterals-15; ; l -= 255 ) {
+            out[o++] = ( unsigned char ) min( l, ( size_t )255 );
+            if( l < 255 ) {
+                break;
+            }
+        }
+    }
+    if( nliterals > 0 ) {
+        memcpy( &out[o], literals, nliterals );
+    }
+    o += nliterals;
+    if( match > 0 ) {
+        out[o++] = ( unsigned char )( offset & 0xff );
+        out[o++] = ( unsigned char )( offset >> 8 );
+        if( m >= 15 ) {
+            for( size_t l = m-15; ; l -= 255 ) {
+                out[o++] = ( unsigned char ) min( l, ( size_t )255 );
+                if( l < 255 ) {
+                    break;
+                }
+            }
+        }
+    }
+    return o;
+}
+
+bool DumpCompression::readLength( const unsigned char *in, size_t encoded_size, unsigned int nibble, size_t &i, size_t &len )
+{
+    len = nibble;
+    if( nibble < 15 ) {
+        return true;
+    }
+    while( i < encoded_size ) {
+        unsigned char c = in[i++];
+        len += c;
+        if( c < 255 ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t DumpCompression::encode( const unsigned char *in, size_t nbytes, unsigned int elem_size, int mode, unsigned char *out )
+{
+    uint64_t header = nbytes;
+    memcpy( out, &header, sizeof( uint64_t ) );
+    
+    // Byte planes (XOR-ed with the previous element in xor_delta mode); the incomplete element remains at the end
+    vector<unsigned char> t( nbytes );
+    size_t n = nbytes / elem_size;
+    for( unsigned int k=0; k<elem_size && n>0; k++ ) {
+        unsigned char *plane = &t[k*n];
+        plane[0] = in[k];
+        if( mode == xor_delta ) {
+            for( size_t i=1; i<n; i++ ) {
+                plane[i] = in[i*elem_size+k] ^ in[( i-1 )*elem_size+k];
+            }
+        } else {
+            for( size_t i=1; i<n; i++ ) {
+                plane[i] = in[i*elem_size+k];
+            }
+        }
+    }
+    if( n*elem_size < nbytes ) {
+        memcpy( &t[n*elem_size], &in[n*elem_size], nbytes - n*elem_size );
+    }
+    
+    // LZ4-style sequences: a token (literal length in the high nibble, match length-4 in the low nibble),
+    // the literal bytes, then a 2-byte offset back to the match. A nibble equal to 15 is extended by
+    // additional bytes, added until one is below 255. The last sequence only holds literals.
+    // Runs of equal bytes are matches at offset 1.
+    const size_t min_match = 4;
+    const unsigned int hash_log = 14;
+    vector<uint32_t> table( 1 << hash_log, 0 );
+    size_t o = sizeof( uint64_t );
+    size_t anchor = 0;
+    size_t i = 0;
+    while( i+min_match <= nbytes ) {
+        uint32_t sequence;
+        memcpy( &sequence, &t[i], 4 );
+        uint32_t h = ( sequence * 2654435761U ) >> ( 32-hash_log );
+        size_t ref = table[h];
+        table[h] = i+1;
+        if( ref == 0 || i-( ref-1 ) > 65535 || memcmp( &t[ref-1], &t[i], min_match ) != 0 ) {
+            i++;
+            continue;
+        }
+        ref--;
+        size_t len = min_match;
+        while( i+len < nbytes && t[ref+len] == t[i+len] ) {
+            len++;
+        }
+        o = writeSequence( t.data()+anchor, i-anchor, i-ref, len, out, o );
+        i += len;
+        anchor = i;
+    }
+    return writeSequence( t.data()+anchor, nbytes-anchor, 0, 0, out, o );
+}
+
+size_t DumpCompression::decode( const unsigned char *in, size_t encoded_size, unsigned int elem_size, int mode, unsigned char *out, size_t out_size )
+{
+    if( encoded_size < sizeof( uint64_t ) ) {
+        return 0;
+    }
+    size_t nbytes = decodedSize( in );
+    if( nbytes > out_size ) {
+        return 0;
+    }
+    
+    vector<unsigned char> t( nbytes );
+    size_t i = sizeof( uint64_t );
+    size_t o = 0;
+    while( true ) {
+        if( i >= encoded_size ) {
+            return 0;
+        }
+        unsigned char token = in[i++];
+        size_t len;
+        if( ! readLength( in, encoded_size, token >> 4, i, len ) || o+len > nbytes || i+len > encoded_size ) {
+            return 0;
+        }
+        if( len > 0 ) {
+            memcpy( &t[o], &in[i], len );
+        }
+        i += len;
+        o += len;
+        if( o == nbytes ) {
+            break;
+        }
+        if( i+2 > encoded_size ) {
+            return 0;
+        }
+        size_t offset = in[i] | ( in[i+1] << 8 );
+        i += 2;
+        if( ! readLength( in, encoded_size, token & 15, i, len ) ) {
+            return 0;
+        }
+        len += 4;
+        if( offset == 0 || offset > o || o+len > nbytes ) {
+            return 0;
+        }
+        // Byte by byte: the match may overlap the bytes being written
+        for( size_t k=0; k<len; k++, o++ ) {
+            t[o] = t[o-offset];
+        }
+    }
+    
+    size_t n = nbytes / elem_size;
+    for( unsigned int k=0; k<elem_size && n>0; k++ ) {
+        const unsigned char *plane = &t[k*n];
+        out[k] = plane[0];
+        if( mode == xor_delta ) {
+            for( size_t i=1; i<n; i++ ) {
+                out[i*elem_size+k] = plane[i] ^ out[( i-1 )*elem_size+k];
+            }
+        } else {
+            for( size_t i=1; i<n; i++ ) {
+                out[i*elem_size+k] = plane[i];
+            }
+        }
+    }
+    if( n*elem_size < nbytes ) {
+        memcpy( &out[n*elem_size], &t[n*elem_size], nbytes - n*elem_size );
+    }
+    return nbytes;
+}
+
+size_t DumpCompression::filter( unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[],
+                                size_t nbytes, size_t *buf_size, void **buf )
+{
+    // Data encoded by a previous format (without version) is rejected rather than decoded wrongly
+    if( cd_nelmts < 3 || cd_values[2] != format_version ) {
+        return 0;
+    }
+    unsigned int elem_size = cd_values[0] > 0 ? cd_values[0] : 1;
+    int mode = cd_values[1];
+    const unsigned char *in = static_cast<const unsigned char *>( *buf );
+    unsigned char *out;
+    size_t out_size;
+    
+    if( flags & H5Z_FLAG_REVERSE ) {
+        if( nbytes < sizeof( uint64_t ) ) {
+            return 0;
+        }
+        out_size = decodedSize( in );
+        out = static_cast<unsigned char *>( H5allocate_memory( out_size, false ) );
+        if( decode( in, nbytes, elem_size, mode, out, out_size ) != out_size ) {
+            H5free_memory( out );
+            return 0;
+        }
+    } else {
+        double t0 = MPI_Wtime();
+        out = static_cast<unsigned char *>( H5allocate_memory( maxEncodedSize( nbytes ), false ) );
+        out_size = encode( in, nbytes, elem_size, mode, out );
+        encode_time += MPI_Wtime() - t0;
+        bytes_in += nbytes;
+        if( out_size >= nbytes ) {
+            // Not worth it: the chunk is stored uncompressed
+            H5free_memory( out );
+            bytes_out += nbytes;
+            return 0;
+        }
+        bytes_out += out_size;
+    }
+    
+    H5free_memory( *buf );
+    *buf = out;
+    *buf_size = out_size;
+    return out_size;
+}
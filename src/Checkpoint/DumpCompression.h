@@ -0,0 +1,76 @@
+/*
+ * DumpCompression.h
+ *
+ * Lossless compression of the checkpoint datasets, as an HDF5 filter
+ */
+
+#ifndef DUMPCOMPRESSION_H
+#define DUMPCOMPRESSION_H
+
+#include <string>
+#include <cstdint>
+
+#include <hdf5.h>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class DumpCompression
+//! Each chunk of n elements of s bytes is
+//!  - optionally XOR-ed with the previous element (xor_delta mode), so that close values give zero bytes
+//!  - byte-shuffled: the n first bytes of all elements, then the n second bytes, etc.
+//!  - encoded as LZ4-style sequences of literals and back-references, which remove the runs of zero bytes
+//!    produced by the previous steps as well as the byte patterns repeated along each plane
+//  --------------------------------------------------------------------------------------------------------------------
+class DumpCompression
+{
+public:
+    //! Compression modes, as selected by Checkpoints.dump_compression
+    enum Mode { none = 0, shuffle = 1, xor_delta = 2 };
+    
+    //! HDF5 filter identifier. It is not registered with The HDF Group: it is taken in the
+    //! range 256-511 that HDF5 leaves for testing filters, so it may clash with other private filters
+    static const H5Z_filter_t filter_id = 311;
+    
+    //! Version of the encoded format, stored in the filter parameters
+    static const unsigned int format_version = 2;
+    
+    //! Convert the namelist string to a mode (returns false if unknown)
+    static bool getMode( std::string name, int &mode );
+    
+    //! Register the filter in the HDF5 library (required to both write and read)
+    static void registerFilter();
+    
+    //! Add the filter to a dataset creation property list, for elements of the given type
+    static void setFilter( hid_t pid, hid_t type, int mode );
+    
+    //! Encode nbytes of data into out (must hold maxEncodedSize(nbytes)), returns the encoded size
+    static size_t encode( const unsigned char *in, size_t nbytes, unsigned int elem_size, int mode, unsigned char *out );
+    
+    //! Decode data into out (of size nbytes, stored in the encoded header), returns the decoded size or 0 if corrupt
+    static size_t decode( const unsigned char *in, size_t encoded_size, unsigned int elem_size, int mode, unsigned char *out, size_t out_size );
+    
+    //! Upper bound of the size of the encoded data
+    static size_t maxEncodedSize( size_t nbytes )
+    {
+        return sizeof( uint64_t ) + nbytes + nbytes/255 + 16;
+    }
+    
+    //! Decoded size stored in the header of encoded data
+    static size_t decodedSize( const unsigned char *in );
+    
+    //! Statistics of the compression, accumulated since the last reset
+    static void resetStats();
+    static double bytes_in, bytes_out, encode_time;
+
+private:
+    //! Append a sequence (literals, then a match of the given length and offset if match>0), returns the new size
+    static size_t writeSequence( const unsigned char *literals, size_t nliterals, size_t offset, size_t match, unsigned char *out, size_t o );
+    
+    //! Read a length starting from its token nibble and its extension bytes at in[i] (returns false if truncated)
+    static bool readLength( const unsigned char *in, size_t encoded_size, unsigned int nibble, size_t &i, size_t &len );
+    
+    //! HDF5 filter callback
+    static size_t filter( unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[],
+                          size_t nbytes, size_t *buf_size, void **buf );
+};
+
+#endif
@@ -238,7 +238,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         }
         // shuffle the index array
         for( unsigned int i=npart1; i>1; i-- ) {
-            unsigned int p = patch->xorshift32() % i;
+            unsigned int p = patch->rand_->integer() % i;
             swap( index1[i-1], index1[p] );
         }
         if( intra_collisions_ ) { // In the case of collisions within one species
@@ -340,9 +340,9 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             m12  = s1->mass / s2->mass; // mass ratio
             
             logL = coulomb_log_;
-            double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-            double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-            double phi = patch->xorshift32() * patch->xorshift32_invmax * twoPi;
+            double U1  = patch->rand_->uniform();
+            double U2  = patch->rand_->uniform();
+            double phi = patch->rand_->uniform() * twoPi;
             s = one_collision( p1, i1, s1->mass, p2, i2, m12, coeff1_, coeff2_, coeff3, coeff4, n123, n223, debye2, logL, U1, U2, phi );
             
             // Handle ionization
@@ -396,6 +396,9 @@ void Collisions::debug( Params &params, int itime, unsigned int icoll, VectorPat
             }
         }
         
+        // The writes of the diagnostics must be finished before using HDF5
+        vecPatches.diagWriter.wait();
+        
         // Open the HDF5 file
         hid_t file_access = H5Pcreate( H5P_FILE_ACCESS );
         H5Pset_fapl_mpio( file_access, MPI_COMM_WORLD, MPI_INFO_NULL );
@@ -87,7 +87,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             index1[i] = first_index1 + i;
         }
         for( unsigned int i=npairs; i>1; i-- ) {
-            unsigned int p = patch->xorshift32() % i;
+            unsigned int p = patch->rand_->integer() % i;
             swap( index1[i-1], index1[p] );
         }
         p1->swap_parts( index1 ); // exchange particles along the cycle defined by the shuffle
@@ -138,9 +138,9 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             i2 = first_index2 + i%N2max;
             
             logL = coulomb_log_;
-            double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-            double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-            double phi = patch->xorshift32() * patch->xorshift32_invmax * twoPi;
+            double U1  = patch->rand_->uniform();
+            double U2  = patch->rand_->uniform();
+            double phi = patch->rand_->uniform() * twoPi;
             
             s = one_collision( p1, i1, s1->mass, p2, i2, m12, coeff1_, coeff2_, coeff3, coeff4, n123, n223, debye2, logL, U1, U2, phi );
             
@@ -305,6 +305,9 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     
     #pragma omp master
     {
+        // The previous writes must be finished before modifying the file structure
+        vecPatches.diagWriter.wait();
+        
         // Calculate the structure of the file depending on 1D, 2D, ...
         refHindex = ( unsigned int )( vecPatches.refHindex_ );
         setFileSplitting( smpi, vecPatches );
@@ -347,37 +350,44 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         
         #pragma omp master
         {
-            // Create field dataset in HDF5
-            hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, dcreate, H5P_DEFAULT );
-            
-            // Write
-            writeField( dset_id, itime );
-            
-            // Attributes for openPMD
-            openPMD_->writeFieldAttributes( dset_id, subgrid_start_, subgrid_step_ );
-            openPMD_->writeRecordAttributes( dset_id, field_type[ifield] );
-            openPMD_->writeFieldRecordAttributes( dset_id );
-            openPMD_->writeComponentAttributes( dset_id, field_type[ifield] );
-            
-            // Close dataset
-            H5Dclose( dset_id );
+            // Stage the buffer, so that the next field can be copied while this one is written
+            function<void( hid_t )> write = stageField( itime );
+            vecPatches.diagWriter.stage( [this, write, ifield]() {
+                // Create field dataset in HDF5
+                hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, dcreate, H5P_DEFAULT );
+                
+                // Write
+                write( dset_id );
+                
+                // Attributes for openPMD
+                openPMD_->writeFieldAttributes( dset_id, subgrid_start_, subgrid_step_ );
+                openPMD_->writeRecordAttributes( dset_id, field_type[ifield] );
+                openPMD_->writeFieldRecordAttributes( dset_id );
+                openPMD_->writeComponentAttributes( dset_id, field_type[ifield] );
+                
+                // Close dataset
+                H5Dclose( dset_id );
+            } );
         }
     }
     
     #pragma omp master
     {
-        // write x_moved
         double x_moved = simWindow ? simWindow->getXmoved() : 0.;
-        H5::attr( iteration_group_id, "x_moved", x_moved );
-        
-        H5Gclose( iteration_group_id );
-        if( tmp_dset_id>0 ) {
-            H5Dclose( tmp_dset_id );
-        }
-        tmp_dset_id=0;
-        if( flush_timeSelection->theTimeIsNow( itime ) ) {
-            H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
-        }
+        bool flush = flush_timeSelection->theTimeIsNow( itime );
+        vecPatches.diagWriter.stage( [this, x_moved, flush]() {
+            // write x_moved
+            H5::attr( iteration_group_id, "x_moved", x_moved );
+            
+            H5Gclose( iteration_group_id );
+            if( tmp_dset_id>0 ) {
+                H5Dclose( tmp_dset_id );
+            }
+            tmp_dset_id=0;
+            if( flush ) {
+                H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+            }
+        } );
     }
 }
 
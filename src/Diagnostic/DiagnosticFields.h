@@ -2,6 +2,7 @@
 #define DIAGNOSTICFIELDS_H
 
 #include "Diagnostic.h"
+#include "DiagnosticWriter.h"
 
 class DiagnosticFields  : public Diagnostic
 {
@@ -23,7 +24,8 @@ public :
     
     virtual void run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers ) override;
     
-    virtual void writeField( hid_t, int ) = 0;
+    //! Move the buffer of the current field to the staging buffers and return the function writing it to a dataset
+    virtual std::function<void( hid_t )> stageField( int ) = 0;
     
     virtual bool needsRhoJs( int itime ) override;
     
@@ -75,6 +77,8 @@ protected :
     std::vector<unsigned int> patch_size;
     //! Buffer for the output of a field
     std::vector<double> data;
+    //! Buffers of the fields being written
+    StagingBuffers<double> staged_data;
     
     //! 1st patch index of vecPatches
     unsigned int refHindex;
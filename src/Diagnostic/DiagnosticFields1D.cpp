@@ -125,11 +125,22 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
 }
 
 
-// Write current buffer to file
-void DiagnosticFields1D::writeField( hid_t dset_id, int itime )
+// Move the current buffer to the staging buffers
+function<void( hid_t )> DiagnosticFields1D::stageField( int itime )
+{
+    shared_ptr<vector<double> > buffer = staged_data.stage( data );
+    return [this, buffer, itime]( hid_t dset_id ) {
+        writeField( dset_id, itime, *buffer );
+        staged_data.release( buffer );
+    };
+}
+
+
+// Write a buffer to file
+void DiagnosticFields1D::writeField( hid_t dset_id, int itime, vector<double> &buffer )
 {
 
-    H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, write_plist, &( data[0] ) );
+    H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, write_plist, &( buffer[0] ) );
     
 }
 
@@ -19,7 +19,11 @@ public:
     //! Copy patch field to current "data" buffer
     void getField( Patch *patch, unsigned int ) override;
     
-    void writeField( hid_t, int ) override;
+    //! Move the "data" buffer to the staging buffers and return the function writing it to a dataset
+    std::function<void( hid_t )> stageField( int ) override;
+    
+    //! Write a buffer to file
+    void writeField( hid_t, int, std::vector<double> & );
 private:
     unsigned int MPI_start_in_file, total_patch_size;
 };
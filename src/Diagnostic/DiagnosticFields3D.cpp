@@ -269,12 +269,23 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
 }
 
 
-// Write current buffer to file
-void DiagnosticFields3D::writeField( hid_t dset_id, int itime )
+// Move the current buffer to the staging buffers
+function<void( hid_t )> DiagnosticFields3D::stageField( int itime )
+{
+    shared_ptr<vector<double> > buffer = staged_data.stage( data );
+    return [this, buffer, itime]( hid_t dset_id ) {
+        writeField( dset_id, itime, *buffer );
+        staged_data.release( buffer );
+    };
+}
+
+
+// Write a buffer to file
+void DiagnosticFields3D::writeField( hid_t dset_id, int itime, vector<double> &buffer )
 {
 
     // Write the buffer in a temporary location
-    H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( data[0] ) );
+    H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( buffer[0] ) );
     
     // Read the file with the previously defined partition
     H5Dread( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_reread, filespace_reread, write_plist, &( data_reread[0] ) );
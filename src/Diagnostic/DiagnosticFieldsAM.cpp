@@ -197,12 +197,23 @@ void DiagnosticFieldsAM::getField( Patch *patch, unsigned int ifield )
 }
 
 
-// Write current buffer to file
-void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime )
+// Move the current buffer to the staging buffers
+function<void( hid_t )> DiagnosticFieldsAM::stageField( int itime )
+{
+    shared_ptr<vector<complex<double> > > buffer = staged_idata.stage( idata );
+    return [this, buffer, itime]( hid_t dset_id ) {
+        writeField( dset_id, itime, *buffer );
+        staged_idata.release( buffer );
+    };
+}
+
+
+// Write a buffer to file
+void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime, vector<complex<double> > &buffer )
 {
 
     // Write the buffer in a temporary location
-    H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( idata[0] ) );
+    H5Dwrite( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_firstwrite, filespace_firstwrite, write_plist, &( buffer[0] ) );
     
     // Read the file with the previously defined partition
     H5Dread( tmp_dset_id, H5T_NATIVE_DOUBLE, memspace_reread, filespace_reread, write_plist, &( idata_reread[0] ) );
@@ -19,7 +19,11 @@ public:
     //! Copy patch field to current "data" buffer
     void getField( Patch *patch, unsigned int ) override;
     
-    void writeField( hid_t, int ) override;
+    //! Move the "idata" buffer to the staging buffers and return the function writing it to a dataset
+    std::function<void( hid_t )> stageField( int ) override;
+    
+    //! Write a buffer to file
+    void writeField( hid_t, int, std::vector<std::complex<double> > & );
     
 private:
 
@@ -28,6 +32,9 @@ private:
     
     std::vector<std::complex<double>> idata_reread, idata_rewrite, idata;
     
+    //! Buffers of the fields being written
+    StagingBuffers<std::complex<double> > staged_idata;
+    
 };
 
 #endif
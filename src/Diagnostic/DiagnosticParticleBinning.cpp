@@ -7,6 +7,8 @@
 
 using namespace std;
 
+const unsigned int DiagnosticParticleBinning::chunk_size;
+
 
 // Constructor
 DiagnosticParticleBinning::DiagnosticParticleBinning( Params &params, SmileiMPI *smpi, Patch *patch, int diagId )
@@ -94,6 +96,31 @@ DiagnosticParticleBinning::DiagnosticParticleBinning( Params &params, SmileiMPI
     }
     output_size = ( unsigned int ) total_size;
     
+    // get parameter "parallel_write": the histogram is divided in slices of the first axis
+    // which are summed on each process and written in parallel
+    // (without axis, there is a single value summed by the master)
+    parallel_write = false;
+    PyTools::extract( "parallel_write", parallel_write, "DiagParticleBinning", n_diag_particles );
+    if( histogram->axes.size() == 0 ) {
+        parallel_write = false;
+    }
+    slice_start = 0;
+    slice_nbins = 0;
+    if( parallel_write ) {
+        int nproc = smpi->getSize();
+        unsigned int nbins0 = histogram->axes[0]->nbins, stride = output_size / nbins0;
+        slice_sizes.resize( nproc );
+        for( int iproc=0; iproc<nproc; iproc++ ) {
+            unsigned int start = ( uint64_t ) nbins0 * iproc / nproc;
+            unsigned int end   = ( uint64_t ) nbins0 * ( iproc+1 ) / nproc;
+            slice_sizes[iproc] = ( end - start ) * stride;
+            if( iproc == smpi->getRank() ) {
+                slice_start = start;
+                slice_nbins = end - start;
+            }
+        }
+    }
+    
     // Output info on diagnostics
     if( smpi->isMaster() ) {
         ostringstream mystream( "" );
@@ -115,9 +142,11 @@ DiagnosticParticleBinning::DiagnosticParticleBinning( Params &params, SmileiMPI
             }
             MESSAGE( 2, mystream.str() );
         }
-        
-        // init HDF files (by master, only if it doesn't yet exist)
-        mystream.str( "" ); // clear
+    }
+    
+    // init HDF files (by master, only if it doesn't yet exist, or by all processes in parallel_write mode)
+    if( smpi->isMaster() || parallel_write ) {
+        ostringstream mystream( "" );
         mystream << "ParticleBinning" << n_diag_particles << ".h5";
         filename = mystream.str();
     }
@@ -132,10 +161,10 @@ DiagnosticParticleBinning::~DiagnosticParticleBinning()
 } // END DiagnosticParticleBinning::~DiagnosticParticleBinning
 
 
-// Called only by patch master of process master
+// Called only by patch master of process master (by all processes in parallel_write mode)
 void DiagnosticParticleBinning::openFile( Params &params, SmileiMPI *smpi, bool newfile )
 {
-    if( !smpi->isMaster() ) {
+    if( !smpi->isMaster() && !parallel_write ) {
         return;
     }
     
@@ -143,8 +172,13 @@ void DiagnosticParticleBinning::openFile( Params &params, SmileiMPI *smpi, bool
         return;
     }
     
+    hid_t pid = H5Pcreate( H5P_FILE_ACCESS );
+    if( parallel_write ) {
+        H5Pset_fapl_mpio( pid, MPI_COMM_WORLD, MPI_INFO_NULL );
+    }
+    
     if( newfile ) {
-        fileId_ = H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+        fileId_ = H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, pid );
         // write all parameters as HDF5 attributes
         H5::attr( fileId_, "Version", string( __VERSION ) );
         H5::attr( fileId_, "deposited_quantity", histogram->deposited_quantity );
@@ -176,8 +210,9 @@ void DiagnosticParticleBinning::openFile( Params &params, SmileiMPI *smpi, bool
         }
         H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
     } else {
-        fileId_ = H5Fopen( filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT );
+        fileId_ = H5Fopen( filename.c_str(), H5F_ACC_RDWR, pid );
     }
+    H5Pclose( pid );
 }
 
 
@@ -214,13 +249,10 @@ bool DiagnosticParticleBinning::prepare( int timestep )
 } // END prepare
 
 
-// run one particle binning diagnostic
-void DiagnosticParticleBinning::run( Patch *patch, int timestep, SimWindow *simWindow )
+// Whether this patch is in the region useful for this diag
+bool DiagnosticParticleBinning::isUseful( Patch *patch, SimWindow *simWindow )
 {
-
-    vector<int> int_buffer;
-    vector<double> double_buffer;
-    unsigned int npart, ndim = spatial_min.size();
+    unsigned int ndim = spatial_min.size();
     
     // Update spatial_min and spatial_max if needed
     for( unsigned int i=0; i<histogram->axes.size(); i++ ) {
@@ -230,13 +262,39 @@ void DiagnosticParticleBinning::run( Patch *patch, int timestep, SimWindow *simW
         }
     }
     
-    // Verify that this patch is in a useful region for this diag
     for( unsigned int idim=0; idim<ndim; idim++ )
         if( patch->getDomainLocalMax( idim ) < spatial_min[idim]
                 || patch->getDomainLocalMin( idim ) > spatial_max[idim] ) {
-            return;
+            return false;
         }
-        
+    return true;
+}
+
+
+// bin a chunk of particles of one species
+void DiagnosticParticleBinning::runChunk( Species *s, unsigned int istart, vector<double> &double_buffer, vector<int> &int_buffer, SimWindow *simWindow )
+{
+    fill( int_buffer.begin(), int_buffer.end(), 0 );
+    
+    histogram->digitize( s, double_buffer, int_buffer, istart, simWindow );
+    histogram->valuate( s, double_buffer, int_buffer, istart );
+    histogram->distribute( double_buffer, int_buffer, data_sum );
+}
+
+
+// run one particle binning diagnostic
+void DiagnosticParticleBinning::run( Patch *patch, int timestep, SimWindow *simWindow )
+{
+
+    vector<int> int_buffer;
+    vector<double> double_buffer;
+    unsigned int npart;
+    
+    // Verify that this patch is in a useful region for this diag
+    if( ! isUseful( patch, simWindow ) ) {
+        return;
+    }
+    
     // loop species
     for( unsigned int ispec=0 ; ispec < species.size() ; ispec++ ) {
     
@@ -245,22 +303,72 @@ void DiagnosticParticleBinning::run( Patch *patch, int timestep, SimWindow *simW
         int_buffer   .resize( npart );
         double_buffer.resize( npart );
         
-        fill( int_buffer.begin(), int_buffer.end(), 0 );
-        
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
-        histogram->valuate( s, double_buffer, int_buffer );
-        histogram->distribute( double_buffer, int_buffer, data_sum );
+        runChunk( s, 0, double_buffer, int_buffer, simWindow );
         
     }
     
 } // END run
 
 
+// run several particle binning diagnostics, reading each particle once
+void DiagnosticParticleBinning::runFused( vector<DiagnosticParticleBinning *> &diags, Patch *patch, int timestep, SimWindow *simWindow )
+{
+    vector<int> int_buffer;
+    vector<double> double_buffer;
+    
+    // Keep only the diags useful in this patch
+    vector<DiagnosticParticleBinning *> useful_diags;
+    for( unsigned int idiag=0; idiag<diags.size(); idiag++ ) {
+        if( diags[idiag]->isUseful( patch, simWindow ) ) {
+            useful_diags.push_back( diags[idiag] );
+        }
+    }
+    
+    // loop species
+    vector<DiagnosticParticleBinning *> species_diags;
+    for( unsigned int ispec=0 ; ispec < patch->vecSpecies.size() ; ispec++ ) {
+    
+        // Diags accounting for this species
+        species_diags.resize( 0 );
+        for( unsigned int idiag=0; idiag<useful_diags.size(); idiag++ ) {
+            vector<unsigned int> &diag_species = useful_diags[idiag]->species;
+            if( find( diag_species.begin(), diag_species.end(), ispec ) != diag_species.end() ) {
+                species_diags.push_back( useful_diags[idiag] );
+            }
+        }
+        if( species_diags.empty() ) {
+            continue;
+        }
+        
+        // All the diags bin a chunk while it is in cache
+        Species *s = patch->vecSpecies[ispec];
+        unsigned int npart = s->particles->size();
+        // Python functions are called once per chunk, inside a critical section: then take all particles at once
+        unsigned int chunk = chunk_size;
+        for( unsigned int idiag=0; idiag<species_diags.size(); idiag++ ) {
+            if( species_diags[idiag]->histogram->uses_python ) {
+                chunk = npart;
+            }
+        }
+        for( unsigned int istart=0; istart<npart; istart+=chunk ) {
+            unsigned int n = min( chunk, npart-istart );
+            int_buffer   .resize( n );
+            double_buffer.resize( n );
+            for( unsigned int idiag=0; idiag<species_diags.size(); idiag++ ) {
+                species_diags[idiag]->runChunk( s, istart, double_buffer, int_buffer, simWindow );
+            }
+        }
+        
+    }
+    
+} // END runFused
+
+
 // Now the data_sum has been filled
 // if needed now, store result to hdf file
 void DiagnosticParticleBinning::write( int timestep, SmileiMPI *smpi )
 {
-    if( !smpi->isMaster() ) {
+    if( !smpi->isMaster() && !parallel_write ) {
         return;
     }
     
@@ -272,7 +380,7 @@ void DiagnosticParticleBinning::write( int timestep, SmileiMPI *smpi )
     // if time_average, then we need to divide by the number of timesteps
     if( time_average > 1 ) {
         coeff = 1./( ( double )time_average );
-        for( unsigned int i=0; i<output_size; i++ ) {
+        for( unsigned int i=0; i<data_sum.size(); i++ ) {
             data_sum[i] *= coeff;
         }
     }
@@ -296,7 +404,31 @@ void DiagnosticParticleBinning::write( int timestep, SmileiMPI *smpi )
         // create dataset
         hid_t did = H5Dcreate( fileId_, mystream.str().c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, pid, H5P_DEFAULT );
         // write vector in dataset
-        H5Dwrite( did, H5T_NATIVE_DOUBLE, sid, sid, H5P_DEFAULT, &data_sum[0] );
+        if( parallel_write ) {
+            // Each process writes its slice of the first axis
+            hsize_t offset[naxes], count[naxes];
+            for( unsigned int iaxis=0; iaxis<naxes; iaxis++ ) {
+                offset[iaxis] = 0;
+                count [iaxis] = dims[iaxis];
+            }
+            offset[0] = slice_start;
+            count [0] = max( slice_nbins, 1u );
+            hid_t memspace = H5Screate_simple( naxes, &count[0], NULL );
+            if( slice_nbins > 0 ) {
+                H5Sselect_hyperslab( sid, H5S_SELECT_SET, &offset[0], NULL, &count[0], NULL );
+            } else {
+                // Processes without slice take part in the collective write
+                H5Sselect_none( sid );
+                H5Sselect_none( memspace );
+            }
+            hid_t write_plist = H5Pcreate( H5P_DATASET_XFER );
+            H5Pset_dxpl_mpio( write_plist, H5FD_MPIO_COLLECTIVE );
+            H5Dwrite( did, H5T_NATIVE_DOUBLE, memspace, sid, write_plist, data_sum.data() );
+            H5Pclose( write_plist );
+            H5Sclose( memspace );
+        } else {
+            H5Dwrite( did, H5T_NATIVE_DOUBLE, sid, sid, H5P_DEFAULT, &data_sum[0] );
+        }
         // close all
         H5Dclose( did );
         H5Pclose( pid );
@@ -26,6 +26,10 @@ public :
     
     void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
     
+    //! Runs several particle binning diagnostics with a single sweep over the particles of a patch.
+    //! The particles are read by chunks, each chunk being binned by all the diags before going to the next.
+    static void runFused( std::vector<DiagnosticParticleBinning *> &diags, Patch *patch, int timestep, SimWindow *simWindow );
+    
     void write( int timestep, SmileiMPI *smpi ) override;
     
     //! Clear the array
@@ -45,6 +49,15 @@ public :
     
 private :
 
+    //! Whether this patch is in the region useful for this diag
+    bool isUseful( Patch *patch, SimWindow *simWindow );
+    
+    //! Bins the particles istart to istart+double_buffer.size() of a species
+    void runChunk( Species *s, unsigned int istart, std::vector<double> &double_buffer, std::vector<int> &int_buffer, SimWindow *simWindow );
+    
+    //! Number of particles in the chunks of the fused sweep (unless a python function is used)
+    static const unsigned int chunk_size = 1024;
+    
     //! number of timesteps during which outputs are averaged
     int time_average;
     
@@ -61,6 +74,18 @@ private :
     
     //! Minimum and maximum spatial coordinates that are useful for this diag
     std::vector<double> spatial_min, spatial_max;
+    
+    //! Whether the histogram is reduce-scattered among processes and written in parallel
+    bool parallel_write;
+    
+    //! Size of the slice of the histogram of each process, in parallel_write mode (slices of the first axis)
+    std::vector<int> slice_sizes;
+    
+    //! First bin of the first axis in the slice of this process, and number of bins of the first axis in this slice
+    unsigned int slice_start, slice_nbins;
+    
+    //! Receives the slice of this process during the reduction
+    std::vector<double> data_slice;
 };
 
 #endif
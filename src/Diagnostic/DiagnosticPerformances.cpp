@@ -167,6 +167,9 @@ void DiagnosticPerformances::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
 
     #pragma omp master
     {
+        // The writes of the other diagnostics must be finished before using HDF5
+        vecPatches.diagWriter.wait();
+        
         // Create group for this iteration
         ostringstream name_t;
         name_t.str( "" );
@@ -403,11 +403,22 @@ void DiagnosticProbes::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPa
 }
 
 
-void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, bool createFile, double x_moved )
+void DiagnosticProbes::createPoints( Patch *patch, double x_moved )
 {
-    nPart_MPI = 0;
-    offset_in_MPI .resize( vecPatches.size() );
-    offset_in_file.resize( vecPatches.size() );
+    ProbeParticles *probe = patch->probes[probe_n];
+    Particles *particles = &( probe->particles );
+    
+    // The points only depend on the patch position in the box: if already computed, follow the window
+    if( probe->hindex == ( int )patch->hindex ) {
+        if( probe->x_moved != x_moved ) {
+            for( unsigned int ip=0; ip<particles->size(); ip++ ) {
+                particles->position( 0, ip ) = probe->x_in_window[ip] + x_moved;
+            }
+            probe->x_moved = x_moved;
+        }
+        return;
+    }
+    
     unsigned int numCorners = 1<<nDim_particle; // number of patch corners
     unsigned int ntot, IP, ipart_local, i, k, iDim;
     bool is_in_domain;
@@ -415,132 +426,143 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
     vector<double> patchMin( nDim_particle ), patchMax( nDim_particle );
     vector<unsigned int> minI( nDim_particle ), maxI( nDim_particle ), nI( nDim_particle );
     
-    // Loop patches to create particles
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-    
-        // The first step is to reduce the area of the probe to search in this patch
-        if( geometry == "AMcylindrical" ) {
-            mins[0] = numeric_limits<double>::max();
-            maxs[0] = numeric_limits<double>::lowest();
-            patchMin[0] = ( vecPatches( ipatch )->Pcoordinates[0] )*patch_size[0];
-            patchMax[0] = ( vecPatches( ipatch )->Pcoordinates[0]+1 )*patch_size[0];
-            for( k=1; k<3; k++ ) {
-                mins[k] = numeric_limits<double>::max();
-                maxs[k] = -mins[k];
-                patchMax[k] = ( ( double )vecPatches( ipatch )->Pcoordinates[1]+1. )*( double )patch_size[1];
-                patchMin[k] = -1. *  patchMax[k] ; //patchMin = -rmax for the first filter
-            }
-        } else {
-            for( k=0; k<nDim_particle; k++ ) {
-                mins[k] = numeric_limits<double>::max();
-                maxs[k] =  numeric_limits<double>::lowest();
-                patchMin[k] = ( vecPatches( ipatch )->Pcoordinates[k] )*patch_size[k];
-                patchMax[k] = ( vecPatches( ipatch )->Pcoordinates[k]+1 )*patch_size[k];
-            }
+    // The first step is to reduce the area of the probe to search in this patch
+    if( geometry == "AMcylindrical" ) {
+        mins[0] = numeric_limits<double>::max();
+        maxs[0] = numeric_limits<double>::lowest();
+        patchMin[0] = ( patch->Pcoordinates[0] )*patch_size[0];
+        patchMax[0] = ( patch->Pcoordinates[0]+1 )*patch_size[0];
+        for( k=1; k<3; k++ ) {
+            mins[k] = numeric_limits<double>::max();
+            maxs[k] = -mins[k];
+            patchMax[k] = ( ( double )patch->Pcoordinates[1]+1. )*( double )patch_size[1];
+            patchMin[k] = -1. *  patchMax[k] ; //patchMin = -rmax for the first filter
         }
-        // loop patch corners
-        for( i=0; i<numCorners; i++ ) {
-            // Get coordinates of the current corner in terms of x,y,...
-            for( k=0; k<nDim_particle; k++ ) {
-                point[k] = ( ( ( ( i>>k )&1 )==0 ) ? patchMin[k] : patchMax[k] ) - origin[k];
+    } else {
+        for( k=0; k<nDim_particle; k++ ) {
+            mins[k] = numeric_limits<double>::max();
+            maxs[k] =  numeric_limits<double>::lowest();
+            patchMin[k] = ( patch->Pcoordinates[k] )*patch_size[k];
+            patchMax[k] = ( patch->Pcoordinates[k]+1 )*patch_size[k];
+        }
+    }
+    // loop patch corners
+    for( i=0; i<numCorners; i++ ) {
+        // Get coordinates of the current corner in terms of x,y,...
+        for( k=0; k<nDim_particle; k++ ) {
+            point[k] = ( ( ( ( i>>k )&1 )==0 ) ? patchMin[k] : patchMax[k] ) - origin[k];
+        }
+        // Get position of the current corner in the probe's coordinate system
+        point = matrixTimesVector( axesInverse, point );
+        // Store mins and maxs
+        for( k=0; k<nDim_particle; k++ ) {
+            if( point[k]<mins[k] ) {
+                mins[k]=point[k];
             }
-            // Get position of the current corner in the probe's coordinate system
-            point = matrixTimesVector( axesInverse, point );
-            // Store mins and maxs
-            for( k=0; k<nDim_particle; k++ ) {
-                if( point[k]<mins[k] ) {
-                    mins[k]=point[k];
-                }
-                if( point[k]>maxs[k] ) {
-                    maxs[k]=point[k];
-                }
+            if( point[k]>maxs[k] ) {
+                maxs[k]=point[k];
             }
         }
-        // Loop directions to figure out the range of useful indices
-        
+    }
+    // Loop directions to figure out the range of useful indices
+    
+    for( i=0; i<dimProbe; i++ ) {
+        if( mins[i]<0. ) {
+            mins[i]=0.;    // Why ?
+        }
+        if( mins[i]>1. ) {
+            mins[i]=1.;
+        }
+        minI[i] = ( ( unsigned int ) floor( mins[i]*( ( double )( vecNumber[i]-1 ) ) ) );
+        if( maxs[i]<0. ) {
+            maxs[i]=0.;
+        }
+        if( maxs[i]>1. ) {
+            maxs[i]=1.;
+        }
+        maxI[i] = ( ( unsigned int ) ceil( maxs[i]*( ( double )( vecNumber[i]-1 ) ) ) ) + 1;
+    }
+    for( i=dimProbe; i<nDim_particle; i++ ) {
+        minI[i] = 0;
+        maxI[i] = ( mins[i]*maxs[i]<=1.e-8 ) ? 1:0;
+    }
+    // Now, minI and maxI contain the min and max indexes of the probe, useful for this patch
+    // Calculate total number of useful points
+    ntot = 1;
+    for( i=0; i<nDim_particle; i++ ) {
+        nI[i] = maxI[i]-minI[i];
+        ntot *= nI[i];
+    }
+    if( ntot > 1000000000 ) {
+        ERROR( "Probe too large" );
+    }
+    // Initialize the list of "fake" particles (points) just as actual macro-particles
+    particles->initialize( ntot, nDim_particle );
+    probe->x_in_window.resize( ntot );
+    
+    // Loop useful probe points
+    ipart_local=0;
+    for( unsigned int ip=0; ip<ntot; ip++ ) {
+        // Find the coordinates of this point in the global probe array
+        IP = ip;
         for( i=0; i<dimProbe; i++ ) {
-            if( mins[i]<0. ) {
-                mins[i]=0.;    // Why ?
-            }
-            if( mins[i]>1. ) {
-                mins[i]=1.;
-            }
-            minI[i] = ( ( unsigned int ) floor( mins[i]*( ( double )( vecNumber[i]-1 ) ) ) );
-            if( maxs[i]<0. ) {
-                maxs[i]=0.;
-            }
-            if( maxs[i]>1. ) {
-                maxs[i]=1.;
-            }
-            maxI[i] = ( ( unsigned int ) ceil( maxs[i]*( ( double )( vecNumber[i]-1 ) ) ) ) + 1;
+            point[i] = ( ( double )( IP % nI[i] + minI[i] ) ) / ( ( double )( vecNumber[i]-1 ) );
+            IP /= nI[i];
         }
         for( i=dimProbe; i<nDim_particle; i++ ) {
-            minI[i] = 0;
-            maxI[i] = ( mins[i]*maxs[i]<=1.e-8 ) ? 1:0;
+            point[i] = 0.;
         }
-        // Now, minI and maxI contain the min and max indexes of the probe, useful for this patch
-        // Calculate total number of useful points
-        ntot = 1;
-        for( i=0; i<nDim_particle; i++ ) {
-            nI[i] = maxI[i]-minI[i];
-            ntot *= nI[i];
-        }
-        if( ntot > 1000000000 ) {
-            ERROR( "Probe too large" );
+        // Compute this point's coordinates in terms of x, y, ...
+        point = matrixTimesVector( axes, point );
+        //Redefine patchmin as rmin and not -rmax any more
+        if( geometry == "AMcylindrical" ) {
+            patchMin[1] = patchMax[1] - ( double )patch_size[1]  ;
         }
-        // Initialize the list of "fake" particles (points) just as actual macro-particles
-        Particles *particles = &( vecPatches( ipatch )->probes[probe_n]->particles );
-        particles->initialize( ntot, nDim_particle );
-        
-        // Loop useful probe points
-        ipart_local=0;
-        for( unsigned int ip=0; ip<ntot; ip++ ) {
-            // Find the coordinates of this point in the global probe array
-            IP = ip;
-            for( i=0; i<dimProbe; i++ ) {
-                point[i] = ( ( double )( IP % nI[i] + minI[i] ) ) / ( ( double )( vecNumber[i]-1 ) );
-                IP /= nI[i];
-            }
-            for( i=dimProbe; i<nDim_particle; i++ ) {
-                point[i] = 0.;
+        // Check if point is in patch
+        is_in_domain = true;
+        for( i=0; i<nDim_field; i++ ) {
+            if( i == 1 && geometry == "AMcylindrical" ) {
+                point[1] += origin[1];
+                point[2] += origin[2];
+                point[1] = sqrt( point[1]*point[1] + point[2]*point[2] );
+            } else {
+                point[i] += origin[i];
             }
-            // Compute this point's coordinates in terms of x, y, ...
-            point = matrixTimesVector( axes, point );
-            //Redefine patchmin as rmin and not -rmax any more
-            if( geometry == "AMcylindrical" ) {
-                patchMin[1] = patchMax[1] - ( double )patch_size[1]  ;
+            if( point[i] < patchMin[i] || point[i] >= patchMax[i] ) {
+                is_in_domain = false;
+                break;
             }
-            // Check if point is in patch
-            is_in_domain = true;
-            for( i=0; i<nDim_field; i++ ) {
-                if( i == 1 && geometry == "AMcylindrical" ) {
-                    point[1] += origin[1];
-                    point[2] += origin[2];
-                    point[1] = sqrt( point[1]*point[1] + point[2]*point[2] );
-                } else {
-                    point[i] += origin[i];
-                }
-                if( point[i] < patchMin[i] || point[i] >= patchMax[i] ) {
-                    is_in_domain = false;
-                    break;
-                }
-            }
-            if( is_in_domain ) {
-                point[0] += x_moved;
-                for( iDim=0; iDim<nDim_particle; iDim++ ) {
-                    particles->position( iDim, ipart_local ) = point[iDim];
-                }
-                ipart_local++;
+        }
+        if( is_in_domain ) {
+            probe->x_in_window[ipart_local] = point[0];
+            point[0] += x_moved;
+            for( iDim=0; iDim<nDim_particle; iDim++ ) {
+                particles->position( iDim, ipart_local ) = point[iDim];
             }
+            ipart_local++;
         }
-        
-        // Resize the array with only particles in this patch
-        particles->resize( ipart_local, nDim_particle );
-        particles->shrink_to_fit( nDim_particle );
-        
-        // Add the local offset
+    }
+    
+    // Resize the array with only particles in this patch
+    particles->resize( ipart_local, nDim_particle );
+    particles->shrink_to_fit( nDim_particle );
+    probe->x_in_window.resize( ipart_local );
+    probe->x_in_window.shrink_to_fit();
+    probe->hindex = patch->hindex;
+    probe->x_moved = x_moved;
+    
+}
+
+
+void DiagnosticProbes::computeOffsets( SmileiMPI *smpi, VectorPatch &vecPatches )
+{
+    // Locate each patch in the local buffer
+    nPart_MPI = 0;
+    offset_in_MPI .resize( vecPatches.size() );
+    offset_in_file.resize( vecPatches.size() );
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
         offset_in_MPI[ipatch] = nPart_MPI;
-        nPart_MPI += ipart_local;
+        nPart_MPI += vecPatches( ipatch )->probes[probe_n]->particles.size();
     }
     
     // Calculate the offset of each MPI in the final file
@@ -574,6 +596,9 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
     // Leave if this timestep has already been written
     #pragma omp master
     {
+        // The previous writes must be finished before reading or modifying the file
+        vecPatches.diagWriter.wait();
+        
         name_t.str( "" );
         name_t << "/" << setfill( '0' ) << setw( 10 ) << timestep;
         status = H5Lexists( fileId_, name_t.str().c_str(), H5P_DEFAULT );
@@ -583,11 +608,20 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
         return;
     }
     
+    // If the patches have been moved (moving window or load balancing) we must update the probes positions.
+    // Only the patches which changed position in the box, or arrived from another process, re-compute their points.
+    bool update_points = !positions_written || last_iteration_points_calculated <= vecPatches.lastIterationPatchesMoved;
+    if( update_points ) {
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            createPoints( vecPatches( ipatch ), x_moved );
+        }
+    }
+    
     #pragma omp master
     {
-        // If the patches have been moved (moving window or load balancing) we must re-compute the probes positions
-        if( !positions_written || last_iteration_points_calculated <= vecPatches.lastIterationPatchesMoved ) {
-            createPoints( smpi, vecPatches, false, x_moved );
+        if( update_points ) {
+            computeOffsets( smpi, vecPatches );
             last_iteration_points_calculated = timestep;
             
             // Store the positions of all particles, unless done already
@@ -738,51 +772,57 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
     
     #pragma omp master
     {
-        // Define size in memory
-        hsize_t mem_size[2];
-        mem_size[1] = nPart_MPI;
-        mem_size[0] = nFields;
-        hid_t memspace  = H5Screate_simple( 2, mem_size, NULL );
-        // Define size and location in file
-        hsize_t dimsf[2], offset[2], count[2], block[2];
-        dimsf[1] = nPart_total_actual;
-        dimsf[0] = nFields;
-        hid_t filespace = H5Screate_simple( 2, dimsf, NULL );
-        if( nPart_MPI>0 ) {
-            offset[1] = offset_in_file[0];
-            offset[0] = 0;
-            count[0] = 1;
-            count[1] = 1;
-            block[1] = nPart_MPI;
-            block[0] = nFields;
-            H5Sselect_hyperslab( filespace, H5S_SELECT_SET, offset, NULL, count, block );
-        } else {
-            H5Sselect_none( filespace );
-        }
-        // Create new dataset for this timestep
-        hid_t plist_id = H5Pcreate( H5P_DATASET_CREATE );
-        H5Pset_alloc_time( plist_id, H5D_ALLOC_TIME_EARLY );
-        hid_t dset_id  = H5Dcreate( fileId_, name_t.str().c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT );
-        H5Pclose( plist_id );
-        // Define transfer
-        hid_t transfer = H5Pcreate( H5P_DATASET_XFER );
-        H5Pset_dxpl_mpio( transfer, H5FD_MPIO_INDEPENDENT );
-        // Write
-        H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, transfer, probesArray->data_ );
-        
-        // Write x_moved
-        H5::attr( dset_id, "x_moved", x_moved );
-        
-        H5Dclose( dset_id );
-        H5Pclose( transfer );
-        H5Sclose( filespace );
-        H5Sclose( memspace );
-        
-        delete probesArray;
-        
-        if( flush_timeSelection->theTimeIsNow( timestep ) ) {
-            H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
-        }
+        // The array is handed over to the writer, which deletes it once written
+        Field2D *array = probesArray;
+        string dataset_name = name_t.str();
+        bool flush = flush_timeSelection->theTimeIsNow( timestep );
+        vecPatches.diagWriter.stage( [this, array, dataset_name, x_moved, flush]() {
+            // Define size in memory
+            hsize_t mem_size[2];
+            mem_size[1] = nPart_MPI;
+            mem_size[0] = nFields;
+            hid_t memspace  = H5Screate_simple( 2, mem_size, NULL );
+            // Define size and location in file
+            hsize_t dimsf[2], offset[2], count[2], block[2];
+            dimsf[1] = nPart_total_actual;
+            dimsf[0] = nFields;
+            hid_t filespace = H5Screate_simple( 2, dimsf, NULL );
+            if( nPart_MPI>0 ) {
+                offset[1] = offset_in_file[0];
+                offset[0] = 0;
+                count[0] = 1;
+                count[1] = 1;
+                block[1] = nPart_MPI;
+                block[0] = nFields;
+                H5Sselect_hyperslab( filespace, H5S_SELECT_SET, offset, NULL, count, block );
+            } else {
+                H5Sselect_none( filespace );
+            }
+            // Create new dataset for this timestep
+            hid_t plist_id = H5Pcreate( H5P_DATASET_CREATE );
+            H5Pset_alloc_time( plist_id, H5D_ALLOC_TIME_EARLY );
+            hid_t dset_id  = H5Dcreate( fileId_, dataset_name.c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT );
+            H5Pclose( plist_id );
+            // Define transfer
+            hid_t transfer = H5Pcreate( H5P_DATASET_XFER );
+            H5Pset_dxpl_mpio( transfer, H5FD_MPIO_INDEPENDENT );
+            // Write
+            H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, transfer, array->data_ );
+            
+            // Write x_moved
+            H5::attr( dset_id, "x_moved", x_moved );
+            
+            H5Dclose( dset_id );
+            H5Pclose( transfer );
+            H5Sclose( filespace );
+            H5Sclose( memspace );
+            
+            delete array;
+            
+            if( flush ) {
+                H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+            }
+        } );
     }
     #pragma omp barrier
 }
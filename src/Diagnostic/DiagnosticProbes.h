@@ -29,15 +29,19 @@ public :
     
     virtual bool needsRhoJs( int timestep ) override;
     
-    //! Creates the probe's particles (or "points")
-    void createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, bool createFile, double x_moved );
+    //! Creates the probe's particles (or "points") in one patch, unless they were already
+    //! computed for its position in the box, in which case they only follow the moving window
+    void createPoints( Patch *patch, double x_moved );
+    
+    //! Locates the points of each patch in the local buffer and in the file
+    void computeOffsets( SmileiMPI *smpi, VectorPatch &vecPatches );
     
     //! Get memory footprint of current diagnostic
     int getMemFootPrint() override
     {
         return nPart_MPI * (
-                   // Size of the simili particles structure
-                   ( nDim_particle+3+1 )*sizeof( double ) + sizeof( short )
+                   // Size of the simili particles structure, and x coordinate in the window
+                   ( nDim_particle+3+2 )*sizeof( double ) + sizeof( short )
                    // eval probesArray (even if temporary)
                    + 10*sizeof( double )
                );
@@ -128,8 +132,8 @@ private :
 class ProbeParticles
 {
 public :
-    ProbeParticles() {};
-    ProbeParticles( ProbeParticles *probe )
+    ProbeParticles() : hindex( -1 ), x_moved( 0. ) {};
+    ProbeParticles( ProbeParticles *probe ) : hindex( -1 ), x_moved( 0. )
     {
         offset_in_file=probe->offset_in_file;
     }
@@ -137,6 +141,15 @@ public :
     
     Particles particles;
     int offset_in_file;
+    
+    //! Hilbert index of the patch for which the points were computed (-1 if not computed yet)
+    int hindex;
+    
+    //! x coordinate of the points relative to the moving window
+    std::vector<double> x_in_window;
+    
+    //! Displacement of the moving window included in the points positions
+    double x_moved;
 };
 
 
@@ -381,8 +381,8 @@ void DiagnosticScreen::run( Patch *patch, int timestep, SimWindow *simWindow )
             continue;
         }
         
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
-        histogram->valuate( s, double_buffer, int_buffer );
+        histogram->digitize( s, double_buffer, int_buffer, 0, simWindow );
+        histogram->valuate( s, double_buffer, int_buffer, 0 );
         
         if( direction_type == 1 ) { // canceling
             for( ipart=0; ipart<npart; ipart++ )
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <sstream>
+#include <limits>
+#include <algorithm>
 
 #include "ParticleData.h"
 #include "PeekAtSpecies.h"
@@ -50,6 +52,11 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         vecPatches( ipatch )->vecSpecies[speciesId_]->tracking_diagnostic = idiag;
     }
     
+    // Get parameter "ordered": the particles are redistributed among processes in order to be written in slots
+    // given by their IDs (the particles created by each process are placed after those of the previous ones)
+    ordered = false;
+    PyTools::extract( "ordered", ordered, "DiagTrackParticles", iDiagTrackParticles );
+    
     // Get parameter "filter" which gives a python function to select particles
     filter = PyTools::extract_py( "filter", "DiagTrackParticles", iDiagTrackParticles );
     has_filter = ( filter != Py_None );
@@ -235,13 +242,13 @@ bool DiagnosticTrack::prepare( int itime )
 
 void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers )
 {
-    uint64_t nParticles_global = 0;
     string xyz = "xyz";
     
-    hid_t momentum_group=0, position_group=0, iteration_group=0, particles_group=0, species_group=0;
-    hid_t plist=0, file_space=0, mem_space=0;
     #pragma omp master
     {
+        // The previous writes must be finished before modifying the file
+        vecPatches.diagWriter.wait();
+        
         // Obtain the particle partition of all the patches in this MPI
         nParticles_local = 0;
         patch_start.resize( vecPatches.size() );
@@ -287,7 +294,7 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
                 nParticles_local += patch_selection[ipatch].size();
             }
 #endif
-            
+        
         } else {
             for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
                 patch_start[ipatch] = nParticles_local;
@@ -295,17 +302,39 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
             }
         }
         
+        uint64_t offset;
+        if( ordered ) {
+            // Each process has created IDs rank*2^32+1 to latest_Id: they are given consecutive slots
+            int nproc = smpi->getSize();
+            vector<uint64_t> latest_IDs( nproc );
+            MPI_Allgather( &latest_Id, 1, MPI_UNSIGNED_LONG_LONG, &latest_IDs[0], 1, MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD );
+            id_offset.resize( nproc+1 );
+            id_offset[0] = 0;
+            for( int iproc=0; iproc<nproc; iproc++ ) {
+                id_offset[iproc+1] = id_offset[iproc] + ( latest_IDs[iproc] & 4294967295 );
+            }
+            nParticles_global = id_offset[nproc];
+            // The slots are divided in contiguous blocks, one for each process
+            block_start.resize( nproc+1 );
+            for( int iproc=0; iproc<=nproc; iproc++ ) {
+                block_start[iproc] = ( nParticles_global * iproc ) / nproc;
+            }
+            offset = block_start[smpi->getRank()];
+            nParticles_written = block_start[smpi->getRank()+1] - offset;
+        } else {
+            // Get the number of offset for this MPI rank
+            uint64_t np_local = nParticles_local;
+            MPI_Scan( &np_local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
+            nParticles_global = offset;
+            offset -= np_local;
+            MPI_Bcast( &nParticles_global, 1, MPI_UNSIGNED_LONG_LONG, smpi->getSize()-1, MPI_COMM_WORLD );
+            nParticles_written = nParticles_local;
+        }
+        
         // Specify the memory dataspace (the size of the local buffer)
-        hsize_t count_ = nParticles_local;
+        hsize_t count_ = nParticles_written;
         mem_space = H5Screate_simple( 1, &count_, NULL );
         
-        // Get the number of offset for this MPI rank
-        uint64_t np_local = nParticles_local, offset;
-        MPI_Scan( &np_local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
-        nParticles_global = offset;
-        offset -= np_local;
-        MPI_Bcast( &nParticles_global, 1, MPI_UNSIGNED_LONG_LONG, smpi->getSize()-1, MPI_COMM_WORLD );
-        
         // Make a new group for this iteration
         ostringstream t( "" );
         t << setfill( '0' ) << setw( 10 ) << itime;
@@ -319,6 +348,9 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         openPMD_->writeParticlesAttributes( particles_group );
         // Add openPMD attributes ( path of a given species )
         openPMD_->writeSpeciesAttributes( species_group );
+        if( ordered ) {
+            H5::attr( species_group, "ordered", 1 );
+        }
         
         // Set the dataset parameters
         plist = H5Pcreate( H5P_DATASET_CREATE );
@@ -350,8 +382,8 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         file_space = H5Screate_simple( 1, &dims, NULL );
         
         // Select locations that this proc will write
-        if( nParticles_local>0 ) {
-            hsize_t start=offset, count=1, block=nParticles_local;
+        if( nParticles_written>0 ) {
+            hsize_t start=offset, count=1, block=nParticles_written;
             H5Sselect_hyperslab( file_space, H5S_SELECT_SET, &start, NULL, &count, &block );
         } else {
             H5Sselect_none( file_space );
@@ -388,8 +420,10 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     fill_buffer( vecPatches, 0, data_uint64 );
     #pragma omp master
     {
-        write_scalar( species_group, "id", data_uint64[0], H5T_NATIVE_UINT64, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
-        data_uint64.resize( 0 );
+        if( ordered ) {
+            prepare_ordering( smpi, data_uint64 );
+        }
+        stage_write( vecPatches.diagWriter, staged_uint64, data_uint64, "", "id", H5T_NATIVE_UINT64, SMILEI_UNIT_NONE );
     }
     
     // Charge
@@ -399,73 +433,69 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         #pragma omp barrier
         fill_buffer( vecPatches, 0, data_short );
         #pragma omp master
-        {
-            write_scalar( species_group, "charge", data_short[0], H5T_NATIVE_SHORT, file_space, mem_space, plist, SMILEI_UNIT_CHARGE, nParticles_global );
-            data_short.resize( 0 );
-        }
+        stage_write( vecPatches.diagWriter, staged_short, data_short, "", "charge", H5T_NATIVE_SHORT, SMILEI_UNIT_CHARGE );
     }
     
     #pragma omp master
     data_double.resize( nParticles_local, 0 );
     
+    // Indices of the momentum and of the weight in the lists of properties (see Particles::initialize)
+#ifdef __SINGLE_PRECISION_MOMENTUM
+    unsigned int imomentum = 0, iweight = nDim_particle;
+#else
+    unsigned int imomentum = nDim_particle, iweight = nDim_particle+3;
+#endif
+    
     // Weight
     if( write_weight ) {
         #pragma omp barrier
-        fill_buffer( vecPatches, nDim_particle+3, data_double );
+        fill_buffer( vecPatches, iweight, data_double );
         #pragma omp master
-        write_scalar( species_group, "weight", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_DENSITY, nParticles_global );
+        stage_write( vecPatches.diagWriter, staged_double, data_double, "", "weight", H5T_NATIVE_DOUBLE, SMILEI_UNIT_DENSITY );
     }
     
     // Momentum
     if( write_any_momentum ) {
         #pragma omp master
-        {
-            momentum_group = H5::group( species_group, "momentum" );
+        vecPatches.diagWriter.stage( [this]() {
+            hid_t momentum_group = H5::group( species_group, "momentum" );
             openPMD_->writeRecordAttributes( momentum_group, SMILEI_UNIT_MOMENTUM );
-        }
+            H5Gclose( momentum_group );
+        } );
         for( unsigned int idim=0; idim<3; idim++ ) {
             if( write_momentum[idim] ) {
                 #pragma omp barrier
-                fill_buffer( vecPatches, nDim_particle+idim, data_double );
+                fill_buffer<double, momentum_t>( vecPatches, imomentum+idim, data_double );
                 #pragma omp master
-                write_component( momentum_group, xyz.substr( idim, 1 ).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_MOMENTUM, nParticles_global );
+                stage_write( vecPatches.diagWriter, staged_double, data_double, "momentum", xyz.substr( idim, 1 ), H5T_NATIVE_DOUBLE, SMILEI_UNIT_MOMENTUM );
             }
         }
-        #pragma omp master
-        H5Gclose( momentum_group );
     }
     
     // Position
     if( write_any_position ) {
         #pragma omp master
-        {
-            position_group = H5::group( species_group, "position" );
+        vecPatches.diagWriter.stage( [this]() {
+            hid_t position_group = H5::group( species_group, "position" );
             openPMD_->writeRecordAttributes( position_group, SMILEI_UNIT_POSITION );
-        }
+            H5Gclose( position_group );
+        } );
         for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
             if( write_position[idim] ) {
                 #pragma omp barrier
                 fill_buffer( vecPatches, idim, data_double );
                 #pragma omp master
-                write_component( position_group, xyz.substr( idim, 1 ).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_POSITION, nParticles_global );
+                stage_write( vecPatches.diagWriter, staged_double, data_double, "position", xyz.substr( idim, 1 ), H5T_NATIVE_DOUBLE, SMILEI_UNIT_POSITION );
             }
         }
-        #pragma omp master
-        H5Gclose( position_group );
     }
     
     // Chi - quantum parameter
     if( write_chi ) {
         #pragma omp barrier
-// Position old exists in this case
-#ifdef  __DEBUG
-        fill_buffer( vecPatches, nDim_particle+3+3+1, data_double );
-// Else, position old does not exist
-#else
-        fill_buffer( vecPatches, nDim_particle+3+1, data_double );
-#endif
+        fill_buffer( vecPatches, iweight+1, data_double );
         #pragma omp master
-        write_scalar( species_group, "chi", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
+        stage_write( vecPatches.diagWriter, staged_double, data_double, "", "chi", H5T_NATIVE_DOUBLE, SMILEI_UNIT_NONE );
     }
     
     #pragma omp barrier
@@ -509,60 +539,80 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         // Write out the fields
         #pragma omp master
         {
-            if( write_any_E ) {
-                hid_t Efield_group = H5::group( species_group, "E" );
-                openPMD_->writeRecordAttributes( Efield_group, SMILEI_UNIT_EFIELD );
-                for( unsigned int idim=0; idim<3; idim++ ) {
-                    if( write_E[idim] ) {
-                        write_component( Efield_group, xyz.substr( idim, 1 ).c_str(), data_double[idim*nParticles_local], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_EFIELD, nParticles_global );
+            shared_ptr<vector<double> > buffer = staged_double.stage( data_double );
+            if( ordered ) {
+                vector<double> local;
+                local.swap( *buffer );
+                buffer->resize( nParticles_written*6 );
+                vector<double> block;
+                for( unsigned int ifield=0; ifield<6; ifield++ ) {
+                    if( ifield<3 ? write_E[ifield] : write_B[ifield-3] ) {
+                        order_buffer( &local[ifield*nParticles_local], block );
+                        copy( block.begin(), block.end(), buffer->begin() + ifield*nParticles_written );
                     }
                 }
-                H5Gclose( Efield_group );
             }
-            
-            if( write_any_B ) {
-                hid_t Bfield_group = H5::group( species_group, "B" );
-                openPMD_->writeRecordAttributes( Bfield_group, SMILEI_UNIT_BFIELD );
-                for( unsigned int idim=0; idim<3; idim++ ) {
-                    if( write_B[idim] ) {
-                        write_component( Bfield_group, xyz.substr( idim, 1 ).c_str(), data_double[( 3+idim )*nParticles_local], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_BFIELD, nParticles_global );
+            unsigned int npart = nParticles_written;
+            vecPatches.diagWriter.stage( [this, buffer, npart, xyz]() {
+                vector<double> &fields = *buffer;
+                if( write_any_E ) {
+                    hid_t Efield_group = H5::group( species_group, "E" );
+                    openPMD_->writeRecordAttributes( Efield_group, SMILEI_UNIT_EFIELD );
+                    for( unsigned int idim=0; idim<3; idim++ ) {
+                        if( write_E[idim] ) {
+                            write_component( Efield_group, xyz.substr( idim, 1 ).c_str(), fields[idim*npart], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_EFIELD, nParticles_global );
+                        }
                     }
+                    H5Gclose( Efield_group );
                 }
-                H5Gclose( Bfield_group );
-            }
+                
+                if( write_any_B ) {
+                    hid_t Bfield_group = H5::group( species_group, "B" );
+                    openPMD_->writeRecordAttributes( Bfield_group, SMILEI_UNIT_BFIELD );
+                    for( unsigned int idim=0; idim<3; idim++ ) {
+                        if( write_B[idim] ) {
+                            write_component( Bfield_group, xyz.substr( idim, 1 ).c_str(), fields[( 3+idim )*npart], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_BFIELD, nParticles_global );
+                        }
+                    }
+                    H5Gclose( Bfield_group );
+                }
+                staged_double.release( buffer );
+            } );
         }
     } // END if interpolate
     
     #pragma omp master
     {
         data_double.resize( 0 );
-        
-        // PositionOffset (for OpenPMD)
-        hid_t positionoffset_group = H5::group( species_group, "positionOffset" );
-        openPMD_->writeRecordAttributes( positionoffset_group, SMILEI_UNIT_POSITION );
-        vector<uint64_t> np = {nParticles_global};
-        for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
-            hid_t xyz_group = H5::group( positionoffset_group, xyz.substr( idim, 1 ) );
-            openPMD_->writeComponentAttributes( xyz_group, SMILEI_UNIT_POSITION );
-            H5::attr( xyz_group, "value", 0. );
-            H5::attr( xyz_group, "shape", np, H5T_NATIVE_UINT64 );
-            H5Gclose( xyz_group );
-        }
-        H5Gclose( positionoffset_group );
-        
-        // Close and flush
         patch_selection.resize( 0 );
         
-        H5Pclose( plist );
-        H5Sclose( file_space );
-        H5Sclose( mem_space );
-        H5Gclose( species_group );
-        H5Gclose( particles_group );
-        H5Gclose( iteration_group );
-        
-        if( flush_timeSelection->theTimeIsNow( itime ) ) {
-            H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
-        }
+        bool flush = flush_timeSelection->theTimeIsNow( itime );
+        vecPatches.diagWriter.stage( [this, xyz, flush]() {
+            // PositionOffset (for OpenPMD)
+            hid_t positionoffset_group = H5::group( species_group, "positionOffset" );
+            openPMD_->writeRecordAttributes( positionoffset_group, SMILEI_UNIT_POSITION );
+            vector<uint64_t> np = {nParticles_global};
+            for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+                hid_t xyz_group = H5::group( positionoffset_group, xyz.substr( idim, 1 ) );
+                openPMD_->writeComponentAttributes( xyz_group, SMILEI_UNIT_POSITION );
+                H5::attr( xyz_group, "value", 0. );
+                H5::attr( xyz_group, "shape", np, H5T_NATIVE_UINT64 );
+                H5Gclose( xyz_group );
+            }
+            H5Gclose( positionoffset_group );
+            
+            // Close and flush
+            H5Pclose( plist );
+            H5Sclose( file_space );
+            H5Sclose( mem_space );
+            H5Gclose( species_group );
+            H5Gclose( particles_group );
+            H5Gclose( iteration_group );
+            
+            if( flush ) {
+                H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+            }
+        } );
     }
     #pragma omp barrier
 }
@@ -598,11 +648,11 @@ void DiagnosticTrack::setIDs( Particles &particles )
 }
 
 
-template<typename T>
+template<typename T, typename U>
 void DiagnosticTrack::fill_buffer( VectorPatch &vecPatches, unsigned int iprop, vector<T> &buffer )
 {
     unsigned int patch_nParticles, i, j, nPatches=vecPatches.size();
-    vector<T> *property = NULL;
+    vector<U> *property = NULL;
     
     if( has_filter ) {
         #pragma omp for schedule(runtime)
@@ -659,6 +709,99 @@ void DiagnosticTrack::write_component( hid_t location, string name, T &buffer, h
 
 
 
+template<typename T>
+void DiagnosticTrack::stage_write( DiagnosticWriter &writer, StagingBuffers<T> &staged, vector<T> &data, string group, string name, hid_t dtype, unsigned int unit_type )
+{
+    shared_ptr<vector<T> > buffer = staged.stage( data );
+    if( ordered ) {
+        vector<T> block;
+        order_buffer( &( *buffer )[0], block );
+        buffer->swap( block );
+    }
+    writer.stage( [this, &staged, buffer, group, name, dtype, unit_type]() {
+        if( group.empty() ) {
+            write_scalar( species_group, name, ( *buffer )[0], dtype, file_space, mem_space, plist, unit_type, nParticles_global );
+        } else {
+            hid_t group_id = H5Gopen( species_group, group.c_str(), H5P_DEFAULT );
+            write_component( group_id, name, ( *buffer )[0], dtype, file_space, mem_space, plist, unit_type, nParticles_global );
+            H5Gclose( group_id );
+        }
+        staged.release( buffer );
+    } );
+}
+
+
+void DiagnosticTrack::prepare_ordering( SmileiMPI *smpi, vector<uint64_t> &ids )
+{
+    int nproc = smpi->getSize();
+    
+    // Find the slot of each particle and the process owning it
+    vector<uint64_t> slot( nParticles_local );
+    vector<int> owner( nParticles_local );
+    send_count.assign( nproc, 0 );
+    for( unsigned int ipart=0; ipart<nParticles_local; ipart++ ) {
+        slot[ipart] = id_offset[ids[ipart] >> 32] + ( ids[ipart] & 4294967295 ) - 1;
+        owner[ipart] = upper_bound( block_start.begin(), block_start.end(), slot[ipart] ) - block_start.begin() - 1;
+        send_count[owner[ipart]]++;
+    }
+    send_displ.resize( nproc );
+    send_displ[0] = 0;
+    for( int iproc=1; iproc<nproc; iproc++ ) {
+        send_displ[iproc] = send_displ[iproc-1] + send_count[iproc-1];
+    }
+    
+    // Particles are sent grouped by owner
+    vector<int> position( send_displ );
+    send_position.resize( nParticles_local );
+    vector<uint64_t> send_slot( nParticles_local );
+    for( unsigned int ipart=0; ipart<nParticles_local; ipart++ ) {
+        send_position[ipart] = position[owner[ipart]]++;
+        send_slot[send_position[ipart]] = slot[ipart];
+    }
+    
+    // Exchange the number of particles, then their slots
+    recv_count.resize( nproc );
+    MPI_Alltoall( &send_count[0], 1, MPI_INT, &recv_count[0], 1, MPI_INT, MPI_COMM_WORLD );
+    recv_displ.resize( nproc );
+    recv_displ[0] = 0;
+    for( int iproc=1; iproc<nproc; iproc++ ) {
+        recv_displ[iproc] = recv_displ[iproc-1] + recv_count[iproc-1];
+    }
+    unsigned int nrecv = recv_displ[nproc-1] + recv_count[nproc-1];
+    vector<uint64_t> slots( nrecv );
+    MPI_Alltoallv( send_slot.data(), &send_count[0], &send_displ[0], MPI_UNSIGNED_LONG_LONG,
+                   slots.data(), &recv_count[0], &recv_displ[0], MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD );
+    recv_slot.resize( nrecv );
+    uint64_t first_slot = block_start[smpi->getRank()];
+    for( unsigned int ipart=0; ipart<nrecv; ipart++ ) {
+        recv_slot[ipart] = slots[ipart] - first_slot;
+    }
+}
+
+
+template<typename T>
+void DiagnosticTrack::order_buffer( const T *local, vector<T> &block )
+{
+    vector<T> send( nParticles_local ), recv( recv_slot.size() );
+    for( unsigned int ipart=0; ipart<nParticles_local; ipart++ ) {
+        send[send_position[ipart]] = local[ipart];
+    }
+    
+    MPI_Datatype type;
+    MPI_Type_contiguous( sizeof( T ), MPI_BYTE, &type );
+    MPI_Type_commit( &type );
+    MPI_Alltoallv( send.data(), &send_count[0], &send_displ[0], type,
+                   recv.data(), &recv_count[0], &recv_displ[0], type, MPI_COMM_WORLD );
+    MPI_Type_free( &type );
+    
+    // Empty slots (particles which do not exist anymore) get the ID 0, and NaN values
+    block.assign( nParticles_written, numeric_limits<T>::has_quiet_NaN ? numeric_limits<T>::quiet_NaN() : 0 );
+    for( unsigned int ipart=0; ipart<recv.size(); ipart++ ) {
+        block[recv_slot[ipart]] = recv[ipart];
+    }
+}
+
+
 // SUPPOSED TO BE EXECUTED ONLY BY MASTER MPI
 uint64_t DiagnosticTrack::getDiskFootPrint( int istart, int istop, Patch *patch )
 {
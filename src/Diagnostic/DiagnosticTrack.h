@@ -2,6 +2,7 @@
 #define DIAGNOSTICTRACK_H
 
 #include "Diagnostic.h"
+#include "DiagnosticWriter.h"
 
 class Patch;
 class Params;
@@ -36,8 +37,8 @@ public :
     //! Get disk footprint of current diagnostic
     uint64_t getDiskFootPrint( int istart, int istop, Patch *patch ) override;
     
-    //! Fills a buffer with the required particle property
-    template<typename T> void fill_buffer( VectorPatch &vecPatches, unsigned int iprop, std::vector<T> &buffer );
+    //! Fills a buffer with the required particle property (stored with type U)
+    template<typename T, typename U=T> void fill_buffer( VectorPatch &vecPatches, unsigned int iprop, std::vector<T> &buffer );
     
     //! Write a scalar dataset with the given buffer
     template<typename T> void write_scalar( hid_t, std::string, T &, hid_t, hid_t, hid_t, hid_t, unsigned int, unsigned int );
@@ -45,6 +46,15 @@ public :
     //! Write a vector component dataset with the given buffer
     template<typename T> void write_component( hid_t, std::string, T &, hid_t, hid_t, hid_t, hid_t, unsigned int, unsigned int );
     
+    //! Hand over a buffer to the writer, which writes it in the species group (scalar) or in one of its subgroups (component)
+    template<typename T> void stage_write( DiagnosticWriter &, StagingBuffers<T> &, std::vector<T> &, std::string, std::string, hid_t, unsigned int );
+    
+    //! Sends the local particles to the processes owning their slots in the file, given their IDs
+    void prepare_ordering( SmileiMPI *smpi, std::vector<uint64_t> &ids );
+    
+    //! Redistributes a property of the local particles into the block of slots owned by this process
+    template<typename T> void order_buffer( const T *local, std::vector<T> &block );
+    
     //! Set a given patch's particles with the required IDs
     void setIDs( Patch * );
     
@@ -65,6 +75,12 @@ private :
     //! HDF5 objects
     hid_t data_group_id, transfer;
     
+    //! HDF5 objects of the iteration being written
+    hid_t iteration_group, particles_group, species_group, plist, file_space, mem_space;
+    
+    //! Number of particles of the iteration being written
+    uint64_t nParticles_global;
+    
     //! Number of spatial dimensions
     unsigned int nDim_particle;
     
@@ -87,12 +103,38 @@ private :
     //! Buffer for the output of uint64 array
     std::vector<uint64_t> data_uint64;
     
+    //! Buffers being written
+    StagingBuffers<double> staged_double;
+    StagingBuffers<short> staged_short;
+    StagingBuffers<uint64_t> staged_uint64;
+    
     //! Approximate total number of particles
     double npart_total;
     
     //! Number of particles shared among patches in this proc
     uint32_t nParticles_local;
     
+    //! Whether the particles are written in the order of their IDs
+    bool ordered;
+    
+    //! First slot of the file owned by each process, when ordered
+    std::vector<uint64_t> block_start;
+    
+    //! First slot of the particles created by each process, when ordered
+    std::vector<uint64_t> id_offset;
+    
+    //! Number of particles written by this proc (nParticles_local, or the size of its block when ordered)
+    unsigned int nParticles_written;
+    
+    //! Position of each local particle in the buffer sent to the other processes
+    std::vector<unsigned int> send_position;
+    
+    //! Number of particles sent to and received from each process, and their displacements in the buffers
+    std::vector<int> send_count, send_displ, recv_count, recv_displ;
+    
+    //! Slot of each received particle in the block of this process
+    std::vector<unsigned int> recv_slot;
+    
     //! Booleans to determine which attributes to write out
     std::vector<bool> write_position;
     std::vector<bool> write_momentum;
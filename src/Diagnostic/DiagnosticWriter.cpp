@@ -0,0 +1,76 @@
+#include "DiagnosticWriter.h"
+
+using namespace std;
+
+DiagnosticWriter::DiagnosticWriter() :
+    ring_size_( 0 ),
+    writing_( false ),
+    stop_( false )
+{
+}
+
+DiagnosticWriter::~DiagnosticWriter()
+{
+    if( writer_.joinable() ) {
+        {
+            lock_guard<mutex> lock( mutex_ );
+            stop_ = true;
+        }
+        staged_.notify_one();
+        writer_.join();
+    }
+}
+
+void DiagnosticWriter::start( unsigned int ring_size )
+{
+    ring_size_ = ring_size;
+    if( ring_size_ > 0 && ! writer_.joinable() ) {
+        writer_ = thread( &DiagnosticWriter::writeLoop, this );
+    }
+}
+
+void DiagnosticWriter::stage( function<void()> write )
+{
+    if( ring_size_ == 0 ) {
+        write();
+        return;
+    }
+    
+    unique_lock<mutex> lock( mutex_ );
+    // Backpressure: wait for a free slot in the ring
+    written_.wait( lock, [this] { return ring_.size() + ( writing_ ? 1 : 0 ) < ring_size_; } );
+    ring_.push_back( move( write ) );
+    lock.unlock();
+    staged_.notify_one();
+}
+
+void DiagnosticWriter::wait()
+{
+    if( ring_size_ == 0 ) {
+        return;
+    }
+    
+    unique_lock<mutex> lock( mutex_ );
+    written_.wait( lock, [this] { return ring_.empty() && ! writing_; } );
+}
+
+void DiagnosticWriter::writeLoop()
+{
+    unique_lock<mutex> lock( mutex_ );
+    while( true ) {
+        staged_.wait( lock, [this] { return stop_ || ! ring_.empty(); } );
+        if( ring_.empty() ) {
+            return;
+        }
+        function<void()> write = move( ring_.front() );
+        ring_.pop_front();
+        writing_ = true;
+        lock.unlock();
+        
+        write();
+        
+        lock.lock();
+        writing_ = false;
+        written_.notify_all();
+    }
+}
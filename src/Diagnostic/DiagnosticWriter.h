@@ -0,0 +1,92 @@
+#ifndef DIAGNOSTICWRITER_H
+#define DIAGNOSTICWRITER_H
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//! Background thread writing the local diagnostics (fields, probes, tracks).
+//! The diagnostics stage their HDF5 writes, together with a copy of their data, and the writer
+//! executes them in the staging order. This order is the same on all processes so that the collective
+//! HDF5 operations match. At most ring_size writes may be staged at once: when the ring is full,
+//! staging waits for the oldest write to complete.
+//! As the HDF5 library is not thread-safe, any other HDF5 call must be preceded by wait().
+//! Without ring (ring_size=0), the writes are executed immediately by the calling thread.
+class DiagnosticWriter
+{
+public:
+    DiagnosticWriter();
+    ~DiagnosticWriter();
+    
+    //! Starts the background thread with a ring of ring_size writes (none if 0)
+    void start( unsigned int ring_size );
+    
+    //! Stages a write
+    void stage( std::function<void()> write );
+    
+    //! Waits for the completion of all the staged writes
+    void wait();
+    
+private:
+    //! Loop of the background thread
+    void writeLoop();
+    
+    //! Maximum number of staged writes, including the one being executed
+    unsigned int ring_size_;
+    
+    //! Staged writes, oldest first
+    std::deque<std::function<void()> > ring_;
+    
+    //! Whether the background thread is executing a write
+    bool writing_;
+    
+    //! Tells the background thread to finish
+    bool stop_;
+    
+    std::mutex mutex_;
+    std::condition_variable staged_, written_;
+    std::thread writer_;
+};
+
+
+//! Buffers holding the data of the staged writes of a diagnostic, recycled once written
+//! so that a diagnostic does not allocate new buffers at each output.
+template<typename T>
+class StagingBuffers
+{
+public:
+    //! Swaps the content of data with a free buffer, which is returned. data gets the same size as before.
+    std::shared_ptr<std::vector<T> > stage( std::vector<T> &data )
+    {
+        std::shared_ptr<std::vector<T> > buffer;
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            if( free_.empty() ) {
+                buffer = std::make_shared<std::vector<T> >();
+            } else {
+                buffer = free_.back();
+                free_.pop_back();
+            }
+        }
+        buffer->swap( data );
+        data.resize( buffer->size() );
+        return buffer;
+    }
+    
+    //! Gives back a buffer once written
+    void release( std::shared_ptr<std::vector<T> > buffer )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        free_.push_back( buffer );
+    }
+    
+private:
+    std::vector<std::shared_ptr<std::vector<T> > > free_;
+    std::mutex mutex_;
+};
+
+#endif
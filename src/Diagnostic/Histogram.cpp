@@ -10,15 +10,16 @@ using namespace std;
 void Histogram::digitize( Species *s,
                           std::vector<double> &double_buffer,
                           std::vector<int>    &int_buffer,
+                          unsigned int istart,
                           SimWindow *simWindow )
 {
-    unsigned int ipart, npart=s->particles->size();
+    unsigned int ipart, npart=int_buffer.size();
     int ind;
     
     for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
     
         // first loop on particles to store the indexing (axis) quantity
-        axes[iaxis]->digitize( s, double_buffer, int_buffer, npart, simWindow );
+        axes[iaxis]->digitize( s, double_buffer, int_buffer, istart, npart, simWindow );
         // Now, double_buffer has the location of each particle along the axis
         
         // if log scale, loop again and convert to log
@@ -17,8 +17,8 @@ public:
     
     void init( std::string, double, double, int, bool, bool, std::vector<double> );
     
-    //! Function that goes through the particles and find where they should go in the axis
-    virtual void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int, SimWindow * ) {};
+    //! Function that goes through the particles istart to istart+npart and find where they should go in the axis
+    virtual void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int, unsigned int, SimWindow * ) {};
     
     //! quantity of the axis (e.g. 'x', 'px', ...)
     std::string type;
@@ -47,75 +47,79 @@ public:
 class Histogram
 {
 public:
-    Histogram() {};
+    Histogram() : uses_python( false ) {};
     ~Histogram() {};
     
     //! Compute the index of each particle in the final histogram
-    void digitize( Species *, std::vector<double> &, std::vector<int> &, SimWindow * );
+    //! (particles istart to istart+N, N being the size of the buffers)
+    void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int, SimWindow * );
     //! Calculate the quantity of each particle to be summed in the histogram
-    virtual void valuate( Species *, std::vector<double> &, std::vector<int> & ) {};
+    virtual void valuate( Species *, std::vector<double> &, std::vector<int> &, unsigned int ) {};
     //! Add the contribution of each particle in the histogram
     void distribute( std::vector<double> &, std::vector<int> &, std::vector<double> & );
     
     std::string deposited_quantity;
     
     std::vector<HistogramAxis *> axes;
+    
+    //! Whether the deposited quantity or an axis is a python function
+    bool uses_python;
 };
 
 
 
 class HistogramAxis_x : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[0][ipart];
+            array[ipart] = s->particles->Position[0][istart+ipart];
         }
     };
 };
 class HistogramAxis_moving_x : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         double x_moved = simWindow->getXmoved();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[0][ipart]-x_moved;
+            array[ipart] = s->particles->Position[0][istart+ipart]-x_moved;
         }
     };
 };
 class HistogramAxis_y : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[1][ipart];
+            array[ipart] = s->particles->Position[1][istart+ipart];
         }
     };
 };
 class HistogramAxis_z : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[2][ipart];
+            array[ipart] = s->particles->Position[2][istart+ipart];
         }
     };
 };
 class HistogramAxis_vector : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         unsigned int idim, ndim = coefficients.size()/2;
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -124,37 +128,37 @@ class HistogramAxis_vector : public HistogramAxis
             }
             array[ipart] = 0.;
             for( idim=0; idim<ndim; idim++ ) {
-                array[ipart] += ( s->particles->Position[idim][ipart] - coefficients[idim] ) * coefficients[idim+ndim];
+                array[ipart] += ( s->particles->Position[idim][istart+ipart] - coefficients[idim] ) * coefficients[idim+ndim];
             }
         }
     };
 };
 class HistogramAxis_theta2D : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         double X, Y;
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            X = s->particles->Position[0][ipart] - coefficients[0];
-            Y = s->particles->Position[1][ipart] - coefficients[1];
+            X = s->particles->Position[0][istart+ipart] - coefficients[0];
+            Y = s->particles->Position[1][istart+ipart] - coefficients[1];
             array[ipart] = atan2( coefficients[2]*Y - coefficients[3]*X, coefficients[2]*X + coefficients[3]*Y );
         }
     };
 };
 class HistogramAxis_theta3D : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = ( s->particles->Position[0][ipart] - coefficients[0] ) * coefficients[3]
-                           + ( s->particles->Position[1][ipart] - coefficients[1] ) * coefficients[4]
-                           + ( s->particles->Position[2][ipart] - coefficients[2] ) * coefficients[5];
+            array[ipart] = ( s->particles->Position[0][istart+ipart] - coefficients[0] ) * coefficients[3]
+                           + ( s->particles->Position[1][istart+ipart] - coefficients[1] ) * coefficients[4]
+                           + ( s->particles->Position[2][istart+ipart] - coefficients[2] ) * coefficients[5];
             if( array[ipart]> 1. ) {
                 array[ipart] = 0.;
             } else if( array[ipart]<-1. ) {
@@ -167,7 +171,7 @@ class HistogramAxis_theta3D : public HistogramAxis
 };
 class HistogramAxis_phi : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         unsigned int idim;
         double a, b;
@@ -178,8 +182,8 @@ class HistogramAxis_phi : public HistogramAxis
             a = 0.;
             b = 0.;
             for( idim=0; idim<3; idim++ ) {
-                a += ( s->particles->Position[idim][ipart] - coefficients[idim] ) * coefficients[idim+3];
-                b += ( s->particles->Position[idim][ipart] - coefficients[idim] ) * coefficients[idim+6];
+                a += ( s->particles->Position[idim][istart+ipart] - coefficients[idim] ) * coefficients[idim+3];
+                b += ( s->particles->Position[idim][istart+ipart] - coefficients[idim] ) * coefficients[idim+6];
             }
             array[ipart] = atan2( b, a );
         }
@@ -187,7 +191,7 @@ class HistogramAxis_phi : public HistogramAxis
 };
 class HistogramAxis_px : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -195,7 +199,7 @@ class HistogramAxis_px : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Momentum[0][ipart];
+                array[ipart] = s->mass * s->particles->Momentum[0][istart+ipart];
             }
         }
         // Photons
@@ -204,14 +208,14 @@ class HistogramAxis_px : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[0][ipart];
+                array[ipart] = s->particles->Momentum[0][istart+ipart];
             }
         }
     };
 };
 class HistogramAxis_py : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -219,7 +223,7 @@ class HistogramAxis_py : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Momentum[1][ipart];
+                array[ipart] = s->mass * s->particles->Momentum[1][istart+ipart];
             }
         }
         // Photons
@@ -228,14 +232,14 @@ class HistogramAxis_py : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[1][ipart];
+                array[ipart] = s->particles->Momentum[1][istart+ipart];
             }
         }
     };
 };
 class HistogramAxis_pz : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -243,7 +247,7 @@ class HistogramAxis_pz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Momentum[2][ipart];
+                array[ipart] = s->mass * s->particles->Momentum[2][istart+ipart];
             }
         }
         // Photons
@@ -252,14 +256,14 @@ class HistogramAxis_pz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[2][ipart];
+                array[ipart] = s->particles->Momentum[2][istart+ipart];
             }
         }
     };
 };
 class HistogramAxis_p : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -267,9 +271,9 @@ class HistogramAxis_p : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                               + pow( s->particles->Momentum[1][ipart], 2 )
-                                               + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                               + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                               + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -278,16 +282,16 @@ class HistogramAxis_p : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_gamma : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -295,9 +299,9 @@ class HistogramAxis_gamma : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -306,16 +310,16 @@ class HistogramAxis_gamma : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_ekin : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -323,9 +327,9 @@ class HistogramAxis_ekin : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * ( sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                                 + pow( s->particles->Momentum[1][ipart], 2 )
-                                                 + pow( s->particles->Momentum[2][ipart], 2 ) ) - 1. );
+                array[ipart] = s->mass * ( sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) - 1. );
             }
         }
         // Photons
@@ -334,16 +338,16 @@ class HistogramAxis_ekin : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_vx : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -351,10 +355,10 @@ class HistogramAxis_vx : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[0][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[0][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -363,17 +367,17 @@ class HistogramAxis_vx : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[0][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[0][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_vy : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -381,10 +385,10 @@ class HistogramAxis_vy : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[1][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[1][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -393,17 +397,17 @@ class HistogramAxis_vy : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[1][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[1][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_vz : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -411,10 +415,10 @@ class HistogramAxis_vz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -423,31 +427,31 @@ class HistogramAxis_vz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_v : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = pow( 1. + 1./( pow( s->particles->Momentum[0][ipart], 2 )
-                                          + pow( s->particles->Momentum[1][ipart], 2 )
-                                          + pow( s->particles->Momentum[2][ipart], 2 ) ), -0.5 );
+            array[ipart] = pow( 1. + 1./( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                          + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                          + pow( s->particles->Momentum[2][istart+ipart], 2 ) ), -0.5 );
         }
     };
 };
 class HistogramAxis_vperp2 : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass > 0 ) {
@@ -455,11 +459,11 @@ class HistogramAxis_vperp2 : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = ( pow( s->particles->Momentum[1][ipart], 2 )
-                                 + pow( s->particles->Momentum[2][ipart], 2 )
-                               ) / ( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = ( pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                 + pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               ) / ( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -468,36 +472,36 @@ class HistogramAxis_vperp2 : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = ( pow( s->particles->Momentum[1][ipart], 2 )
-                                 + pow( s->particles->Momentum[2][ipart], 2 )
-                               ) / ( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = ( pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                 + pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               ) / ( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class HistogramAxis_charge : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = ( double ) s->particles->Charge[ipart];
+            array[ipart] = ( double ) s->particles->Charge[istart+ipart];
         }
     };
 };
 class HistogramAxis_chi : public HistogramAxis
 {
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Chi[ipart];
+            array[ipart] = s->particles->Chi[istart+ipart];
         }
     };
 };
@@ -516,12 +520,13 @@ public:
         Py_DECREF( function );
     };
 private:
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         #pragma omp critical
         {
             // Expose particle data as numpy arrays
             particleData.resize( npart );
+            particleData.startAt( istart );
             particleData.set( s->particles );
             // run the function
             PyArrayObject *ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( function, particleData.get(), NULL );
@@ -547,33 +552,33 @@ private:
 //! Children classes, for various manners to fill the histogram
 class Histogram_number : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Weight[ipart];
+            array[ipart] = s->particles->Weight[istart+ipart];
         }
     };
 };
 class Histogram_charge : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] );
+            array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] );
         }
     };
 };
 class Histogram_jx : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -582,11 +587,11 @@ class Histogram_jx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] )
-                               * s->particles->Momentum[0][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] )
+                               * s->particles->Momentum[0][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -595,18 +600,18 @@ class Histogram_jx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_jy : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -615,11 +620,11 @@ class Histogram_jy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] )
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] )
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -628,18 +633,18 @@ class Histogram_jy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_jz : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -648,11 +653,11 @@ class Histogram_jz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] )
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] )
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -661,18 +666,18 @@ class Histogram_jz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_ekin : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -681,10 +686,10 @@ class Histogram_ekin : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * ( sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                         + pow( s->particles->Momentum[1][ipart], 2 )
-                                         + pow( s->particles->Momentum[2][ipart], 2 ) ) - 1. );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * ( sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) - 1. );
             }
         }
         // Photons
@@ -693,10 +698,10 @@ class Histogram_ekin : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * ( sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                         + pow( s->particles->Momentum[1][ipart], 2 )
-                                         + pow( s->particles->Momentum[2][ipart], 2 ) ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * ( sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) );
             }
         }
     };
@@ -716,21 +721,21 @@ public:
             }
     };
 private:
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Weight[ipart]
-                           * s->particles->Chi[ipart];
+            array[ipart] = s->particles->Weight[istart+ipart]
+                           * s->particles->Chi[istart+ipart];
         }
     };
 };
 class Histogram_p : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -739,10 +744,10 @@ class Histogram_p : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -751,17 +756,17 @@ class Histogram_p : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_px : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -770,7 +775,7 @@ class Histogram_px : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart] * s->particles->Momentum[0][ipart];
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart] * s->particles->Momentum[0][istart+ipart];
             }
         }
         // Photons
@@ -779,14 +784,14 @@ class Histogram_px : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * s->particles->Momentum[0][ipart];
+                array[ipart] = s->particles->Weight[istart+ipart] * s->particles->Momentum[0][istart+ipart];
             }
         }
     };
 };
 class Histogram_py : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -795,7 +800,7 @@ class Histogram_py : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart] * s->particles->Momentum[1][ipart];
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart] * s->particles->Momentum[1][istart+ipart];
             }
         }
         // Photons
@@ -804,14 +809,14 @@ class Histogram_py : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * s->particles->Momentum[1][ipart];
+                array[ipart] = s->particles->Weight[istart+ipart] * s->particles->Momentum[1][istart+ipart];
             }
         }
     };
 };
 class Histogram_pz : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -820,7 +825,7 @@ class Histogram_pz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart] * s->particles->Momentum[2][ipart];
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart] * s->particles->Momentum[2][istart+ipart];
             }
         }
         // Photons
@@ -829,14 +834,14 @@ class Histogram_pz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * s->particles->Momentum[2][ipart];
+                array[ipart] = s->particles->Weight[istart+ipart] * s->particles->Momentum[2][istart+ipart];
             }
         }
     };
 };
 class Histogram_pressure_xx : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -845,11 +850,11 @@ class Histogram_pressure_xx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[0][ipart], 2 )
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[0][istart+ipart], 2 )
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -858,18 +863,18 @@ class Histogram_pressure_xx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[0][ipart], 2 )
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[0][istart+ipart], 2 )
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_pressure_yy : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -878,11 +883,11 @@ class Histogram_pressure_yy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[1][ipart], 2 )
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[1][istart+ipart], 2 )
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -891,18 +896,18 @@ class Histogram_pressure_yy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[1][ipart], 2 )
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[1][istart+ipart], 2 )
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_pressure_zz : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -911,11 +916,11 @@ class Histogram_pressure_zz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[2][ipart], 2 )
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -924,18 +929,18 @@ class Histogram_pressure_zz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[2][ipart], 2 )
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_pressure_xy : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -944,12 +949,12 @@ class Histogram_pressure_xy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -958,19 +963,19 @@ class Histogram_pressure_xy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_pressure_xz : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -979,12 +984,12 @@ class Histogram_pressure_xz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -993,19 +998,19 @@ class Histogram_pressure_xz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_pressure_yz : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -1014,12 +1019,12 @@ class Histogram_pressure_yz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * s->particles->Momentum[1][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -1028,19 +1033,19 @@ class Histogram_pressure_yz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[1][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
 };
 class Histogram_ekin_vx : public Histogram
 {
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         // Matter Particles
@@ -1049,11 +1054,11 @@ class Histogram_ekin_vx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass * s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * ( 1. - 1./sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                                 + pow( s->particles->Momentum[1][ipart], 2 )
-                                                 + pow( s->particles->Momentum[2][ipart], 2 ) ) );
+                array[ipart] = s->mass * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * ( 1. - 1./sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) );
             }
         }
         // Photons
@@ -1062,11 +1067,11 @@ class Histogram_ekin_vx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -1086,13 +1091,14 @@ public:
         Py_DECREF( function );
     };
 private:
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart )
     {
         unsigned int npart = array.size();
         #pragma omp critical
         {
             // Expose particle data as numpy arrays
             particleData.resize( npart );
+            particleData.startAt( istart );
             particleData.set( s->particles );
             // run the function
             PyArrayObject *ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( function, particleData.get(), NULL );
@@ -87,6 +87,7 @@ public:
             ParticleData test( params.nDim_particle, deposited_quantity_object, deposited_quantityPrefix, dummy );
             histogram = new Histogram_user_function( deposited_quantity_object );
             histogram->deposited_quantity = "user_function";
+            histogram->uses_python = true;
 #else
             ERROR( deposited_quantityPrefix << " should be a string" );
 #endif
@@ -246,7 +247,7 @@ public:
 #ifdef SMILEI_USE_NUMPY
             else if( type.substr( 0, 13 ) == "user_function" ) {
                 axis = new HistogramAxis_user_function( type_object );
-                
+                histogram->uses_python = true;
             }
 #endif
             else {
@@ -5,6 +5,7 @@
 #include "H5.h"
 
 #include <cmath>
+#include <limits>
 #include <string>
 
 using namespace std;
@@ -247,6 +248,7 @@ LaserProfileSeparable::LaserProfileSeparable(
 {
     space_envelope = NULL;
     phase = NULL;
+    amplitudes_time_ = std::numeric_limits<double>::quiet_NaN();
 }
 // Separable laser profile cloning constructor
 LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
@@ -260,6 +262,7 @@ LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
 {
     space_envelope = NULL;
     phase = NULL;
+    amplitudes_time_ = std::numeric_limits<double>::quiet_NaN();
 }
 // Separable laser profile destructor
 LaserProfileSeparable::~LaserProfileSeparable()
@@ -393,16 +396,42 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
 }
 
 // Amplitude of a separable laser profile
-double LaserProfileSeparable::getAmplitude( std::vector<double> pos, double t, int j, int k )
+// All the cells of the boundary are computed at the first call of each timestep
+double LaserProfileSeparable::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
 {
-    double amp;
+    if( t != amplitudes_time_ ) {
+        computeAmplitudes( t );
+    }
+    return amplitudes_[j*space_envelope->dims_[1]+k];
+}
+
+// The chirp is evaluated once, and the time envelope once per group of consecutive cells with the same phase
+// (only once when the phase is uniform). The rest is an outer product with the space envelope.
+void LaserProfileSeparable::computeAmplitudes( double t )
+{
+    unsigned int n = space_envelope->globalDims_;
+    amplitudes_.resize( n );
+    double *amp = &amplitudes_[0];
+    double *env = space_envelope->data();
+    double *phi = phase->data();
+    double omega;
     #pragma omp critical
     {
-        double omega = omega_ * chirpProfile_->valueAt( t );
-        double phi = ( *phase )( j, k );
-        amp = timeProfile_->valueAt( t-( phi+delay_phase_ )/omega ) * ( *space_envelope )( j, k ) * sin( omega*t - phi );
+        omega = omega_ * chirpProfile_->valueAt( t );
+        double phi_prev = 0., time_prev = 0.;
+        for( unsigned int i=0 ; i<n ; i++ ) {
+            if( i==0 || phi[i] != phi_prev ) {
+                phi_prev = phi[i];
+                time_prev = timeProfile_->valueAt( t-( phi_prev+delay_phase_ )/omega );
+            }
+            amp[i] = time_prev;
+        }
     }
-    return amp;
+    #pragma omp simd
+    for( unsigned int i=0 ; i<n ; i++ ) {
+        amp[i] = amp[i] * env[i] * sin( omega*t - phi[i] );
+    }
+    amplitudes_time_ = t;
 }
 
 //Destructor
@@ -509,7 +538,7 @@ void LaserProfileFile::initFields( Params &params, Patch *patch )
 }
 
 // Amplitude of a laser profile from a file (see LaserOffset)
-double LaserProfileFile::getAmplitude( std::vector<double> pos, double t, int j, int k )
+double LaserProfileFile::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
 {
     double amp = 0;
     unsigned int n = omega.size();
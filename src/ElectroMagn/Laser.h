@@ -24,7 +24,7 @@ class LaserProfile
 public:
     LaserProfile() {};
     virtual ~LaserProfile() {};
-    virtual double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    virtual double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
@@ -53,12 +53,12 @@ public:
     void clean();
     
     //! Gets the amplitude from both time and space profiles (By)
-    inline double getAmplitude0( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude0( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[0]->getAmplitude( pos, t, j, k );
     }
     //! Gets the amplitude from both time and space profiles (Bz)
-    inline double getAmplitude1( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude1( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[1]->getAmplitude( pos, t, j, k );
     }
@@ -106,14 +106,20 @@ public:
     ~LaserProfileSeparable();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
 protected:
     Field *space_envelope, *phase;
 private:
+    //! Computes the amplitude of all the cells of the boundary at time t
+    void computeAmplitudes( double t );
+    
     bool primal_;
     double omega_;
     Profile *timeProfile_, *chirpProfile_, *spaceProfile_, *phaseProfile_;
     double delay_phase_;
+    //! Amplitudes of all the cells (same layout as space_envelope), and the time at which they were computed
+    std::vector<double> amplitudes_;
+    double amplitudes_time_;
 };
 
 // Laser profile for non-separable space and time
@@ -126,7 +132,7 @@ public:
     LaserProfileNonSeparable( LaserProfileNonSeparable *lp )
         : spaceAndTimeProfile_( new Profile( lp->spaceAndTimeProfile_ ) ) {};
     ~LaserProfileNonSeparable();
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         double amp;
         #pragma omp critical
@@ -149,7 +155,7 @@ public:
     ~LaserProfileFile();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
 protected:
     Field3D *magnitude, *phase;
 private:
@@ -166,7 +172,7 @@ public:
     LaserProfileNULL() {};
     ~LaserProfileNULL() {};
     
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     }
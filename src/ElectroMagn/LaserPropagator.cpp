@@ -1,8 +1,9 @@
 #include "Tools.h"
 #include "Params.h"
 #include "LaserPropagator.h"
-#include "Field2D.h"
-#include "Field3D.h"
+#include "Field1D.h"
+#include "Profile.h"
+#include "FFT.h"
 #include "H5.h"
 
 #include <cmath>
@@ -59,22 +60,23 @@ vector<unsigned int> partial_reverse_argsort( vector<double> x, unsigned int nma
 }
 
 
-// Call a python function
-PyObject *PyCall( PyObject *callable, PyObject *args, PyObject *kwargs )
+// reverse the axes of the array in (of shape n0 x n1 x n2, C order) into out (of shape n2 x n1 x n0)
+void reverse_axes( complex<double> *in, complex<double> *out, unsigned int n0, unsigned int n1, unsigned int n2 )
 {
-    PyObject *a = PyObject_Call( callable, args, kwargs );
-    Py_DECREF( args );
-    if( kwargs ) {
-        Py_DECREF( kwargs );
+    #pragma omp parallel for schedule(static)
+    for( int l=0; l<( int )n2; l++ ) {
+        for( unsigned int k=0; k<n1; k++ ) {
+            for( unsigned int j=0; j<n0; j++ ) {
+                out[( l*n1 + k )*n0 + j] = in[( j*n1 + k )*n2 + l];
+            }
+        }
     }
-    return a;
 }
 
 
 void LaserPropagator::init( Params *params, SmileiMPI *smpi, unsigned int side )
 {
 
-#ifdef SMILEI_USE_NUMPY
     ndim = params->nDim_field;
     _2D = ndim==2;
     MPI_size = smpi->getSize();
@@ -119,121 +121,96 @@ void LaserPropagator::init( Params *params, SmileiMPI *smpi, unsigned int side )
         fftfreq( local_k[2], N[2], L[2]/N[2], 0, N[2] );
     }
     
-#else
-    ERROR( "Cannot use LaserOffset without numpy" );
-#endif
-    
 }
 
 void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profiles_n, double offset, string file, int keep_n_strongest_modes, double angle_z )
 {
-#ifdef SMILEI_USE_NUMPY
     //const complex<double> i_ (0., 1.); // the imaginary number
     
     unsigned int nprofiles = profiles.size();
     
-    // Import several functions from numpy
-    PyObject *numpy = PyImport_AddModule( "numpy" );
-    PyObject *numpyfft = PyObject_GetAttrString( numpy, "fft" );
-    PyObject *fft      = PyObject_GetAttrString( numpyfft, "fft" );
-    PyObject *ifft     = PyObject_GetAttrString( numpyfft, "ifft" );
-    PyObject *fft2     = PyObject_GetAttrString( numpyfft, "fft2" );
-    Py_DECREF( numpyfft );
-    int complex_type_num=0;
+    // The arrays are decomposed in slabs: first along y (the transverse directions and time
+    // are local to each process), then along the second dimension (z in 3D, t in 2D)
+    unsigned int N2 = _2D ? 1 : N[2]; // size of the last dimension, common to both decompositions
+    unsigned int local_size = Nlocal[0]*N[1]*N2;
+    unsigned int block_size = Nlocal[0]*Nlocal[1]*N2; // data sent by a process to another
+    
+    // Fourier transforms along each dimension
+    FFT1D fft0( N[0] ), fft1( N[1] ), fft2( N2 );
     
     // 1- Calculate the value of the profiles at all points (y,z,t)
     // --------------------------------
     
-    // Make coordinates array
-    vector<PyObject *> coords( ndim );
-    for( unsigned int i=0; i<ndim; i++ ) {
-        npy_intp dims = local_x[i].size();
-        coords[i] = PyArray_SimpleNewFromData( 1, &dims, NPY_DOUBLE, ( double * )( local_x[i].data() ) );
-    }
-    
-    // Make a "meshgrid" using the coordinates
-    PyObject *meshgrid = PyObject_GetAttrString( numpy, "meshgrid" );
-    PyObject *m;
-    if( _2D ) {
-        m = PyCall( meshgrid, Py_BuildValue( "(O,O)", coords[0], coords[1] ), Py_BuildValue( "{s:s}", "indexing", "ij" ) );
-    } else {
-        m = PyCall( meshgrid, Py_BuildValue( "(O,O,O)", coords[0], coords[1], coords[2] ), Py_BuildValue( "{s:s}", "indexing", "ij" ) );
+    // Make a "meshgrid" using the coordinates (C order)
+    vector<Field *> coords( ndim );
+    for( unsigned int idim=0; idim<ndim; idim++ ) {
+        coords[idim] = new Field1D( vector<unsigned int>( 1, local_size ) );
     }
-    PyObject *mesh = PySequence_Tuple( m );
-    for( unsigned int i=0; i<ndim; i++ ) {
-        Py_DECREF( coords[i] );
+    for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+        for( unsigned int k=0; k<N[1]; k++ ) {
+            for( unsigned int l=0; l<N2; l++ ) {
+                unsigned int i = ( j*N[1] + k )*N2 + l;
+                ( *coords[0] )( i ) = local_x[0][j];
+                ( *coords[1] )( i ) = local_x[1][k];
+                if( ! _2D ) {
+                    ( *coords[2] )( i ) = local_x[2][l];
+                }
+            }
+        }
     }
-    Py_DECREF( meshgrid );
-    Py_DECREF( m );
     
-    // Apply each profile
-    vector<PyObject *> arrays( nprofiles );
+    // Apply each profile (translated into a native expression when possible)
+    vector<vector<complex<double> > > arrays( nprofiles );
+    Field1D values( vector<unsigned int>( 1, local_size ) );
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        // Vectorize the profile
-        string mode( "vectorize" );
-        string bigO( "O" );
-        PyObject *profile = PyObject_CallMethod( numpy, &mode[0], &bigO[0], profiles[i] );
-        // Apply to the mesh
-        arrays[i] = PyObject_CallObject( profile, mesh );
-        Py_DECREF( profile );
+        ostringstream name( "" );
+        name << "LaserOffset profile " << profiles_n[i];
+        Profile profile( profiles[i], ndim, name.str(), true );
+        profile.valuesAt( coords, values );
+        arrays[i].resize( local_size );
+        for( unsigned int j=0; j<local_size; j++ ) {
+            arrays[i][j] = values( j );
+        }
+    }
+    for( unsigned int idim=0; idim<ndim; idim++ ) {
+        delete coords[idim];
     }
-    Py_DECREF( mesh );
     
     // 2- Fourier transform of the fields at destination
     // --------------------------------
     
+    vector<complex<double> > buffer( local_size );
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        PyObject *a;
+        complex<double> *a = &arrays[i][0];
         
-        // Call FFT along the last direction(s)
+        // FFT along the last direction(s)
         if( _2D ) {
-            a = PyCall( fft, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:i}", "axis", 1 ) );
+            fft1.forward( a, Nlocal[0], 1, N[1] );
         } else {
-            a = PyCall( fft2, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:(i,i)}", "axes", 1, 2 ) );
+            fft2.forward( a, Nlocal[0]*N[1], 1, N2 );
+            for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+                fft1.forward( a + j*N[1]*N2, N2, N2, 1 );
+            }
         }
-        Py_DECREF( arrays[i] );
-        
-        // Change the array shape to prepare the MPI comms (reshape, transpose, C ordering)
-        npy_intp D[4] = {Nlocal[0], MPI_size, Nlocal[1], N[2]};
-        PyArray_Dims shape;
-        shape.len=ndim+1;
-        shape.ptr=D;
-        arrays[i] = PyArray_Newshape( ( PyArrayObject * )a, &shape, NPY_CORDER );
-        Py_DECREF( a );
-        npy_intp P[4] = {1, 0, 2, 3};
-        PyArray_Dims permute;
-        permute.len=ndim+1;
-        permute.ptr=P;
-        a = PyArray_Transpose( ( PyArrayObject * )arrays[i], &permute );
-        Py_DECREF( arrays[i] );
-        arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-        Py_DECREF( a );
-        
-        
-        // Obtain the number associated to the complex type in numpy
-        complex_type_num = PyArray_TYPE( ( PyArrayObject * ) arrays[i] );
         
-        // Make a new empty array for MPI comms
-        npy_intp dims[ndim];
-        dims[0] = N[0];
-        dims[1] = Nlocal[1];
-        if( ! _2D ) {
-            dims[2] = N[2];
+        // Order the blocks by destination process: (Nlocal[0], MPI_size, Nlocal[1], N2) -> (MPI_size, Nlocal[0], Nlocal[1], N2)
+        for( unsigned int p=0; p<MPI_size; p++ ) {
+            for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+                copy( a + ( j*N[1] + p*Nlocal[1] )*N2, a + ( j*N[1] + ( p+1 )*Nlocal[1] )*N2, &buffer[( p*Nlocal[0] + j )*Nlocal[1]*N2] );
+            }
         }
-        a = PyArray_EMPTY( ndim, dims, complex_type_num, 0 );
         
-        // Communicate blocks to transpose the MPI decomposition
-        int block_size = Nlocal[0]*Nlocal[1]* ( _2D?1:N[2] );
+        // Communicate blocks to transpose the MPI decomposition: the result is (N[0], Nlocal[1], N2)
         MPI_Alltoall(
-            PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 ), 2*block_size, MPI_DOUBLE,
-            PyArray_GETPTR1( ( PyArrayObject * ) a, 0 ), 2*block_size, MPI_DOUBLE,
+            &buffer[0], 2*block_size, MPI_DOUBLE,
+            a, 2*block_size, MPI_DOUBLE,
             MPI_COMM_WORLD
         );
-        Py_DECREF( arrays[i] );
         
-        // Call FFT along the first direction
-        arrays[i] = PyCall( fft, Py_BuildValue( "(O)", a ), Py_BuildValue( "{s:i}", "axis", 0 ) );
-        Py_DECREF( a );
+        // Make y the fastest index, then FFT along y
+        reverse_axes( a, &buffer[0], N[0], Nlocal[1], N2 );
+        arrays[i].swap( buffer );
+        fft0.forward( &arrays[i][0], Nlocal[1]*N2, 1, N[0] );
     }
     
     // 3- Select only interesting omegas
@@ -245,7 +222,7 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
         // Compute the spectrum locally
         vector<double> local_spectrum( Nlocal[1], 0. );
         for( unsigned int i=0; i<nprofiles; i++ ) {
-            complex<double> *z = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
+            complex<double> *z = &arrays[i][0];
             for( unsigned int k=0; k<Nlocal[1]; k++ )
                 for( unsigned int j=0; j<N[0]; j++ ) {
                     local_spectrum[k] += abs( z[j + N[0]*k] );
@@ -267,7 +244,7 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
         unsigned int lmax = N[2]/2;
         vector<double> local_spectrum( lmax, 0. );
         for( unsigned int i=0; i<nprofiles; i++ ) {
-            complex<double> *z = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
+            complex<double> *z = &arrays[i][0];
             for( unsigned int l=0; l<lmax; l++ )
                 for( unsigned int k=0; k<Nlocal[1]; k++ )
                     for( unsigned int j=0; j<N[0]; j++ ) {
@@ -355,10 +332,9 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
     double omega2;
     for( unsigned int i=0; i<nprofiles; i++ ) {
         if( _2D ) {
-            npy_intp dims[2] = {N[0], n_omega_local};
-            PyObject *a = PyArray_New( &PyArray_Type, 2, dims, complex_type_num, NULL, NULL, 128, NPY_ARRAY_F_CONTIGUOUS, NULL );
-            complex<double> *z0 = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
-            complex<double> *z  = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) a, 0 );
+            vector<complex<double> > a( N[0]*n_omega_local ); // (N[0], n_omega_local), y fastest
+            complex<double> *z0 = arrays[i].data();
+            complex<double> *z  = a.data();
             for( unsigned int k=0; k<n_omega_local; k++ ) {
                 omega2 = omega[k] * omega[k];
                 i1 = N[0]*k;
@@ -383,13 +359,11 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
                     }
                 }
             }
-            Py_DECREF( arrays[i] );
-            arrays[i] = a;
+            arrays[i].swap( a );
         } else {
-            npy_intp dims[3] = {N[0], Nlocal[1], n_omega_local};
-            PyObject *a = PyArray_New( &PyArray_Type, 3, dims, complex_type_num, NULL, NULL, 128, NPY_ARRAY_F_CONTIGUOUS, NULL );
-            complex<double> *z0 = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
-            complex<double> *z  = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) a, 0 );
+            vector<complex<double> > a( N[0]*Nlocal[1]*n_omega_local ); // (N[0], Nlocal[1], n_omega_local), y fastest
+            complex<double> *z0 = arrays[i].data();
+            complex<double> *z  = a.data();
             for( unsigned int l=0; l<n_omega_local; l++ ) {
                 omega2 = omega[l] * omega[l];
                 for( unsigned int k=0; k<Nlocal[1]; k++ ) {
@@ -416,88 +390,65 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
                     }
                 }
             }
-            Py_DECREF( arrays[i] );
-            arrays[i] = a;
+            arrays[i].swap( a );
         }
     }
     
     // 5- Fourier transform back to real space, excluding the omega axis
     // --------------------------------
     
+    unsigned int n_transverse = _2D ? 1 : Nlocal[1]; // number of transverse points after y, on this process
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        PyObject *a;
-        
-        // Call FFT along the first direction
-        a = PyCall( ifft, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:i}", "axis", 0 ) );
-        Py_DECREF( arrays[i] );
+        unsigned int size = N[0]*n_transverse*n_omega_local;
+        buffer.resize( size );
         
-        // Convert the array to C order
-        arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-        Py_DECREF( a );
+        // FFT along the first direction, then convert the array to C order
+        fft0.backward( arrays[i].data(), n_transverse*n_omega_local, 1, N[0] );
+        reverse_axes( arrays[i].data(), buffer.data(), n_omega_local, n_transverse, N[0] );
+        arrays[i].swap( buffer );
         
         if( ! _2D ) {
         
-            // Make a new empty array for MPI comms
-            npy_intp dims[4];
-            dims[0] = MPI_size;
-            dims[1] = Nlocal[0];
-            dims[2] = Nlocal[1];
-            dims[3] = n_omega_local;
-            a = PyArray_EMPTY( 4, dims, complex_type_num, 0 );
-            
-            // Communicate blocks to transpose the MPI decomposition
+            // Communicate blocks to transpose the MPI decomposition: the result is (MPI_size, Nlocal[0], Nlocal[1], n_omega_local)
             int block_size = Nlocal[0]*Nlocal[1]*n_omega_local;
             MPI_Alltoall(
-                PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 ), 2*block_size, MPI_DOUBLE,
-                PyArray_GETPTR1( ( PyArrayObject * ) a, 0 ), 2*block_size, MPI_DOUBLE,
+                arrays[i].data(), 2*block_size, MPI_DOUBLE,
+                buffer.data(), 2*block_size, MPI_DOUBLE,
                 MPI_COMM_WORLD
             );
-            Py_DECREF( arrays[i] );
-            
-            // Change the array shape to accomodate the MPI comms
-            npy_intp P[4] = {1, 0, 2, 3};
-            PyArray_Dims permute;
-            permute.len=4;
-            permute.ptr=P;
-            arrays[i] = PyArray_Transpose( ( PyArrayObject * )a, &permute );
-            Py_DECREF( a );
-            npy_intp D[3] = {Nlocal[0], N[1], n_omega_local};
-            PyArray_Dims shape;
-            shape.len=3;
-            shape.ptr=D;
-            a = PyArray_Newshape( ( PyArrayObject * )arrays[i], &shape, NPY_CORDER );
-            Py_DECREF( arrays[i] );
-            arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-            Py_DECREF( a );
             
-            // Call FFT along the second direction
-            a = PyCall( ifft, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:i}", "axis", 1 ) );
-            Py_DECREF( arrays[i] );
+            // Change the array shape to accomodate the MPI comms: (Nlocal[0], N[1], n_omega_local)
+            unsigned int row = Nlocal[1]*n_omega_local;
+            for( unsigned int p=0; p<MPI_size; p++ ) {
+                for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+                    copy( &buffer[( p*Nlocal[0] + j )*row], &buffer[( p*Nlocal[0] + j + 1 )*row], &arrays[i][( j*MPI_size + p )*row] );
+                }
+            }
             
-            // Convert the array to C order
-            arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-            Py_DECREF( a );
+            // FFT along the second direction
+            for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+                fft1.backward( &arrays[i][j*N[1]*n_omega_local], n_omega_local, n_omega_local, 1 );
+            }
         }
     }
     
     // 6- Obtain the magnitude and the phase of the complex values
     // --------------------------------
-    unsigned int local_size = ( _2D ? N[0] : Nlocal[0]*N[1] ) * n_omega_local;
+    unsigned int output_size = ( _2D ? N[0] : Nlocal[0]*N[1] ) * n_omega_local;
     vector<vector<double> > magnitude( nprofiles ), phase( nprofiles );
     
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        complex<double> *z = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
-        magnitude[i].resize( local_size );
-        phase    [i].resize( local_size );
+        complex<double> *z = arrays[i].data();
+        magnitude[i].resize( output_size );
+        phase    [i].resize( output_size );
         double coeff_magnitude = 2./N[ndim-1]; // multiply by omega increment
         if( profiles_n[i]==1 ) {
             coeff_magnitude *= cz;    // multiply by cosine for By only
         }
-        for( unsigned int j=0; j<local_size; j++ ) {
+        for( unsigned int j=0; j<output_size; j++ ) {
             magnitude[i][j] = abs( z[j] ) * coeff_magnitude;
             phase    [i][j] = arg( z[j] );
         }
-        Py_DECREF( arrays[i] );
     }
     
     // 7- Store all info in HDF5 file
@@ -578,10 +529,5 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
     H5Pclose( transfer );
     H5Fclose( fid );
     
-    Py_DECREF( fft );
-    Py_DECREF( ifft );
-    Py_DECREF( fft2 );
-    
-#endif
 }
 
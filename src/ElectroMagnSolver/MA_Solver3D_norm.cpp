@@ -3,6 +3,7 @@
 
 #include "ElectroMagn.h"
 #include "Field3D.h"
+#include "Solver3DKernels.h"
 
 MA_Solver3D_norm::MA_Solver3D_norm( Params &params )
     : Solver3D( params )
@@ -27,38 +28,12 @@ void MA_Solver3D_norm::operator()( ElectroMagn *fields )
     Field3D *Jy3D = static_cast<Field3D *>( fields->Jy_ );
     Field3D *Jz3D = static_cast<Field3D *>( fields->Jz_ );
     
-    // Electric field Ex^(d,p,p)
-    for( unsigned int i=0 ; i<nx_d ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Ex3D )( i, j, k ) += -dt*( *Jx3D )( i, j, k )
-                                        +                 dt_ov_dy * ( ( *Bz3D )( i, j+1, k ) - ( *Bz3D )( i, j, k ) )
-                                        -                 dt_ov_dz * ( ( *By3D )( i, j, k+1 ) - ( *By3D )( i, j, k ) );
-            }
-        }
-    }
-    
-    // Electric field Ey^(p,d,p)
-    for( unsigned int i=0 ; i<nx_p ; i++ ) {
-        for( unsigned int j=0 ; j<ny_d ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Ey3D )( i, j, k ) += -dt*( *Jy3D )( i, j, k )
-                                        -                  dt_ov_dx * ( ( *Bz3D )( i+1, j, k ) - ( *Bz3D )( i, j, k ) )
-                                        +                  dt_ov_dz * ( ( *Bx3D )( i, j, k+1 ) - ( *Bx3D )( i, j, k ) );
-            }
-        }
-    }
-    
-    // Electric field Ez^(p,p,d)
-    for( unsigned int i=0 ;  i<nx_p ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=0 ; k<nz_d ; k++ ) {
-                ( *Ez3D )( i, j, k ) += -dt*( *Jz3D )( i, j, k )
-                                        +                  dt_ov_dx * ( ( *By3D )( i+1, j, k ) - ( *By3D )( i, j, k ) )
-                                        -                  dt_ov_dy * ( ( *Bx3D )( i, j+1, k ) - ( *Bx3D )( i, j, k ) );
-            }
-        }
-    }
+    // Electric fields Ex^(d,p,p), Ey^(p,d,p) and Ez^(p,p,d) updated in a single cache-blocked sweep
+    Solver3DKernels::ampere( Ex3D->data_, Ey3D->data_, Ez3D->data_,
+                             Bx3D->data_, By3D->data_, Bz3D->data_,
+                             Jx3D->data_, Jy3D->data_, Jz3D->data_,
+                             nx_p, nx_d, ny_p, ny_d, nz_p, nz_d,
+                             dt, dt_ov_dx, dt_ov_dy, dt_ov_dz );
     
 }
 
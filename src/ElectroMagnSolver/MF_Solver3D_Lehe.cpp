@@ -4,6 +4,7 @@
 #include "ElectroMagn.h"
 #include "ElectroMagn3D.h"
 #include "Field3D.h"
+#include "Solver3DKernels.h"
 
 #include <algorithm>
 
@@ -41,49 +42,12 @@ void MF_Solver3D_Lehe::operator()( ElectroMagn *fields )
     ElectroMagn3D *EM3D = static_cast<ElectroMagn3D *>( fields );
     
     
-    // Magnetic field Bx^(p,d,d)
-    for( unsigned int i=1 ; i<nx_p-1;  i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *Bx3D )( i, j, k ) += -dt_ov_dy * ( alpha_y * ( ( *Ez3D )( i,  j, k )  - ( *Ez3D )( i,  j-1, k ) )
-                                                      + beta_yx * ( ( *Ez3D )( i+1, j, k )  - ( *Ez3D )( i+1, j-1, k ) + ( *Ez3D )( i-1, j, k )-( *Ez3D )( i-1, j-1, k ) )
-                                                    )
-                                        +dt_ov_dz * ( /*alpha_z*/ alpha_y * ( ( *Ey3D )( i, j, k )-( *Ey3D )( i, j, k-1 ) )
-                                                +/*beta_zx*/ beta_yx * ( ( *Ey3D )( i+1, j, k )-( *Ey3D )( i+1, j, k-1 ) + ( *Ey3D )( i-1, j, k )-( *Ey3D )( i-1, j, k-1 ) )
-                                                    );
-            }
-        }
-    }
-    
-    // Magnetic field By^(d,p,d)
-    for( unsigned int i=2 ; i<nx_d-2 ; i++ ) {
-        for( unsigned int j=1 ; j<ny_p-1 ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *By3D )( i, j, k ) += dt_ov_dx * ( alpha_x * ( ( *Ez3D )( i,  j, k ) - ( *Ez3D )( i-1, j, k ) )
-                                                     + beta_xy * ( ( *Ez3D )( i,  j+1, k ) - ( *Ez3D )( i-1, j+1, k ) + ( *Ez3D )( i, j-1, k )-( *Ez3D )( i-1, j-1, k ) )
-                                                     + beta_xz * ( ( *Ez3D )( i, j, k+1 ) - ( *Ez3D )( i-1, j, k+1 ) + ( *Ez3D )( i, j, k-1 )-( *Ez3D )( i-1, j, k-1 ) )
-                                                     + delta_x * ( ( *Ez3D )( i+1, j, k ) - ( *Ez3D )( i-2, j, k ) ) )
-                                        -dt_ov_dz * ( /*alpha_z*/ alpha_y * ( ( *Ex3D )( i, j, k )-( *Ex3D )( i, j, k-1 ) )
-                                                +/*beta_zx*/ beta_yx * ( ( *Ex3D )( i+1, j, k )-( *Ex3D )( i+1, j, k-1 ) + ( *Ex3D )( i-1, j, k )-( *Ex3D )( i-1, j, k-1 ) )
-                                                    );
-            }
-        }
-    }
-    
-    
-    // Magnetic field Bz^(d,d,p)
-    for( unsigned int i=2 ; i<nx_d-2 ; i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=1 ; k<nz_p-1 ; k++ ) {
-                ( *Bz3D )( i, j, k ) += dt_ov_dy * ( alpha_y * ( ( *Ex3D )( i, j, k )-( *Ex3D )( i, j-1, k ) )
-                                                     + beta_yx * ( ( *Ex3D )( i+1, j, k )-( *Ex3D )( i+1, j-1, k )   + ( *Ex3D )( i-1, j, k )-( *Ex3D )( i-1, j-1, k ) ) )
-                                        - dt_ov_dx * ( alpha_x * ( ( *Ey3D )( i, j, k )-( *Ey3D )( i-1, j, k ) )
-                                                       + beta_xy * ( ( *Ey3D )( i, j+1, k )-( *Ey3D )( i-1, j+1, k )   + ( *Ey3D )( i, j-1, k )-( *Ey3D )( i-1, j-1, k ) )
-                                                       + beta_xz * ( ( *Ey3D )( i, j, k+1 )-( *Ey3D )( i-1, j, k+1 ) + ( *Ey3D )( i, j, k-1 )-( *Ey3D )( i-1, j, k-1 ) )
-                                                       + delta_x * ( ( *Ey3D )( i+1, j, k )-( *Ey3D )( i-2, j, k ) ) );
-            }
-        }
-    }
+    // Magnetic fields Bx^(p,d,d), By^(d,p,d) and Bz^(d,d,p) in the bulk, updated in a single cache-blocked sweep
+    Solver3DKernels::faradayLehe( Bx3D->data_, By3D->data_, Bz3D->data_,
+                                  Ex3D->data_, Ey3D->data_, Ez3D->data_,
+                                  nx_p, nx_d, ny_p, ny_d, nz_p, nz_d,
+                                  dt_ov_dx, dt_ov_dy, dt_ov_dz,
+                                  alpha_x, alpha_y, beta_xy, beta_xz, beta_yx, delta_x );
     
     //Additional boundaries treatment on the primal direction of each B field
     
@@ -3,6 +3,7 @@
 
 #include "ElectroMagn.h"
 #include "Field3D.h"
+#include "Solver3DKernels.h"
 
 MF_Solver3D_Yee::MF_Solver3D_Yee( Params &params )
     : Solver3D( params )
@@ -23,32 +24,11 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     Field3D *By3D = static_cast<Field3D *>( fields->By_ );
     Field3D *Bz3D = static_cast<Field3D *>( fields->Bz_ );
     
-    // Magnetic field Bx^(p,d,d)
-    for( unsigned int i=0 ; i<nx_p;  i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *Bx3D )( i, j, k ) += -dt_ov_dy * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i, j-1, k ) ) + dt_ov_dz * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i, j, k-1 ) );
-            }
-        }
-    }
-    
-    // Magnetic field By^(d,p,d)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
-        for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *By3D )( i, j, k ) += -dt_ov_dz * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j, k-1 ) ) + dt_ov_dx * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i-1, j, k ) );
-            }
-        }
-    }
-    
-    // Magnetic field Bz^(d,d,p)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
-        for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Bz3D )( i, j, k ) += -dt_ov_dx * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i-1, j, k ) ) + dt_ov_dy * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j-1, k ) );
-            }
-        }
-    }
+    // Magnetic fields Bx^(p,d,d), By^(d,p,d) and Bz^(d,d,p) updated in a single cache-blocked sweep
+    Solver3DKernels::faradayYee( Bx3D->data_, By3D->data_, Bz3D->data_,
+                                 Ex3D->data_, Ey3D->data_, Ez3D->data_,
+                                 nx_p, nx_d, ny_p, ny_d, nz_p, nz_d,
+                                 dt_ov_dx, dt_ov_dy, dt_ov_dz );
     
 }
 
@@ -0,0 +1,507 @@
+/*
+ * PoissonMultigrid.cpp
+ */
+
+#include "PoissonMultigrid.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include <omp.h>
+
+#include "Params.h"
+#include "SmileiMPI.h"
+#include "VectorPatch.h"
+#include "SyncVectorPatch.h"
+#include "Field1D.h"
+#include "Field2D.h"
+#include "Field3D.h"
+
+using namespace std;
+
+PoissonMultigrid::PoissonMultigrid( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, double gamma_mean ) :
+    nDim_( params.nDim_field ),
+    omega_( 0.8 ),
+    npatches_( params.tot_number_of_patches )
+{
+    for( unsigned int d=0; d<3; d++ ) {
+        c_[d] = d<nDim_ ? 1./( params.cell_length[d]*params.cell_length[d] ) : 0.;
+    }
+    c_[0] /= gamma_mean*gamma_mean;
+    double diag0 = 0.;
+    for( unsigned int d=0; d<nDim_; d++ ) {
+        diag0 -= 2.*c_[d];
+    }
+    
+    // Galerkin projection of the operator on the functions constant over each patch:
+    //   the links inside a patch add 2w to the diagonal, those towards the neighbors are weighted by the face area
+    unsigned int nlinks = 2*nDim_;
+    coarse_diag_  .resize( npatches_, 0. );
+    coarse_link_  .resize( npatches_*nlinks, 0 );
+    coarse_weight_.resize( npatches_*nlinks, 0. );
+    coarse_order_ .resize( npatches_, 0 );
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        ElectroMagn *EMfields = patch->EMfields;
+        unsigned int h = patch->hindex;
+        // There are no links across the x borders: with x varying slowest, the bandwidth is the size of a YZ slice
+        int position = 0;
+        for( unsigned int d=0; d<nDim_; d++ ) {
+            position = position*params.number_of_patches[d] + patch->Pcoordinates[d];
+        }
+        coarse_order_[h] = position;
+        double n[3] = { 1., 1., 1. };
+        for( unsigned int d=0; d<nDim_; d++ ) {
+            n[d] = EMfields->index_max_p_[d] - EMfields->index_min_p_[d] + 1;
+        }
+        double volume = n[0]*n[1]*n[2];
+        coarse_diag_[h] = volume*diag0;
+        for( unsigned int d=0; d<nDim_; d++ ) {
+            double face = volume/n[d];
+            coarse_diag_[h] += 2.*c_[d]*( n[d]-1. )*face;
+            for( unsigned int way=0; way<2; way++ ) {
+                // compute_Ap sets phi = 0 beyond the x borders, even with periodic boundaries
+                int neighbor = patch->neighbor_[d][way];
+                if( neighbor == MPI_PROC_NULL || ( d==0 && ( way==0 ? patch->isXmin() : patch->isXmax() ) ) ) {
+                    continue;
+                }
+                if( neighbor == ( int )h ) {
+                    coarse_diag_[h] += c_[d]*face;
+                } else {
+                    coarse_link_  [h*nlinks+2*d+way] = neighbor+1;
+                    coarse_weight_[h*nlinks+2*d+way] = c_[d]*face;
+                }
+            }
+        }
+        
+        vector<unsigned int> dims = EMfields->r_->dims_;
+        if( nDim_ == 1 ) {
+            z_.push_back( new Field1D( dims ) );
+        } else if( nDim_ == 2 ) {
+            z_.push_back( new Field2D( dims ) );
+        } else {
+            z_.push_back( new Field3D( dims ) );
+        }
+    }
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_diag_[0], npatches_, MPI_DOUBLE, MPI_SUM, smpi->getGlobalComm() );
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_link_[0], npatches_*nlinks, MPI_INT, MPI_SUM, smpi->getGlobalComm() );
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_weight_[0], npatches_*nlinks, MPI_DOUBLE, MPI_SUM, smpi->getGlobalComm() );
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_order_[0], npatches_, MPI_INT, MPI_SUM, smpi->getGlobalComm() );
+    
+    coarse_b_ .resize( npatches_ );
+    coarse_x_ .resize( npatches_ );
+    coarse_r_ .resize( npatches_ );
+    coarse_p_ .resize( npatches_ );
+    coarse_Ap_.resize( npatches_ );
+    
+    coarse_lambda_max_ = 0.;
+    for( unsigned int h=0; h<npatches_; h++ ) {
+        double s = 0.;
+        for( unsigned int l=0; l<nlinks; l++ ) {
+            s += abs( coarse_weight_[h*nlinks+l] );
+        }
+        coarse_lambda_max_ = max( coarse_lambda_max_, 1. + s/abs( coarse_diag_[h] ) );
+    }
+    
+    // Each thread needs its own work arrays
+#ifdef _OPENMP
+    hierarchies_.resize( omp_get_max_threads() );
+#else
+    hierarchies_.resize( 1 );
+#endif
+    
+    coarse_band_ = 0;
+    if( ! coarseFactorize() ) {
+        coarse_chol_.clear();
+        WARNING( "Multigrid preconditioner: the coarse problem cannot be factorized, it is solved approximately" );
+    }
+}
+
+PoissonMultigrid::~PoissonMultigrid()
+{
+    for( unsigned int ipatch=0 ; ipatch<z_.size() ; ipatch++ ) {
+        delete z_[ipatch];
+    }
+}
+
+vector<PoissonMultigrid::Level> &PoissonMultigrid::hierarchy( vector<unsigned int> n )
+{
+#ifdef _OPENMP
+    map<vector<unsigned int>, vector<Level> > &hierarchies = hierarchies_[omp_get_thread_num()];
+#else
+    map<vector<unsigned int>, vector<Level> > &hierarchies = hierarchies_[0];
+#endif
+    map<vector<unsigned int>, vector<Level> >::iterator it = hierarchies.find( n );
+    if( it != hierarchies.end() ) {
+        return it->second;
+    }
+    
+    vector<Level> &levels = hierarchies[n];
+    
+    // Finest level: the laplacian with zero values outside the box
+    levels.resize( 1 );
+    Level &L0 = levels[0];
+    unsigned int size = 1;
+    for( unsigned int d=0; d<3; d++ ) {
+        L0.n[d] = n[d];
+        size *= n[d];
+    }
+    double diag0 = 0.;
+    for( unsigned int d=0; d<nDim_; d++ ) {
+        diag0 -= 2.*c_[d];
+    }
+    L0.diag.assign( size, diag0 );
+    for( unsigned int d=0; d<3; d++ ) {
+        L0.w[d].assign( size, 0. );
+    }
+    for( unsigned int i=0; i<L0.n[0]; i++ ) {
+        for( unsigned int j=0; j<L0.n[1]; j++ ) {
+            for( unsigned int k=0; k<L0.n[2]; k++ ) {
+                unsigned int idx = ( i*L0.n[1]+j )*L0.n[2]+k;
+                L0.w[0][idx] = i+1<L0.n[0] ? c_[0] : 0.;
+                L0.w[1][idx] = j+1<L0.n[1] ? c_[1] : 0.;
+                L0.w[2][idx] = k+1<L0.n[2] ? c_[2] : 0.;
+            }
+        }
+    }
+    
+    // Coarser levels: aggregation of 2 nodes in each direction, down to 2 nodes per direction
+    while( max( levels.back().n[0], max( levels.back().n[1], levels.back().n[2] ) ) > 2 ) {
+        levels.resize( levels.size()+1 );
+        Level &F = levels[levels.size()-2];
+        Level &C = levels.back();
+        unsigned int csize = 1;
+        for( unsigned int d=0; d<3; d++ ) {
+            C.n[d] = ( F.n[d]+1 )/2;
+            csize *= C.n[d];
+        }
+        C.diag.assign( csize, 0. );
+        for( unsigned int d=0; d<3; d++ ) {
+            C.w[d].assign( csize, 0. );
+        }
+        for( unsigned int i=0; i<F.n[0]; i++ ) {
+            for( unsigned int j=0; j<F.n[1]; j++ ) {
+                for( unsigned int k=0; k<F.n[2]; k++ ) {
+                    unsigned int f = ( i*F.n[1]+j )*F.n[2]+k;
+                    unsigned int ic[3] = { i/2, j/2, k/2 };
+                    unsigned int c = ( ic[0]*C.n[1]+ic[1] )*C.n[2]+ic[2];
+                    unsigned int ifine[3] = { i, j, k };
+                    C.diag[c] += F.diag[f];
+                    for( unsigned int d=0; d<3; d++ ) {
+                        if( F.w[d][f] == 0. ) {
+                            continue;
+                        }
+                        if( ifine[d]%2 == 0 ) {
+                            C.diag[c] += 2.*F.w[d][f];
+                        } else {
+                            C.w[d][c] += F.w[d][f];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    for( unsigned int l=0; l<levels.size(); l++ ) {
+        levels[l].x.resize( levels[l].diag.size() );
+        levels[l].b.resize( levels[l].diag.size() );
+        levels[l].t.resize( levels[l].diag.size() );
+    }
+    return levels;
+}
+
+void PoissonMultigrid::residual( Level &L )
+{
+    unsigned int s[3] = { L.n[1]*L.n[2], L.n[2], 1 };
+    unsigned int size = L.diag.size();
+    for( unsigned int idx=0; idx<size; idx++ ) {
+        L.t[idx] = L.b[idx] - L.diag[idx]*L.x[idx];
+    }
+    for( unsigned int d=0; d<3; d++ ) {
+        for( unsigned int idx=0; idx+s[d]<size; idx++ ) {
+            double w = L.w[d][idx];
+            L.t[idx]      -= w*L.x[idx+s[d]];
+            L.t[idx+s[d]] -= w*L.x[idx];
+        }
+    }
+}
+
+void PoissonMultigrid::smooth( Level &L, unsigned int nsweeps )
+{
+    unsigned int size = L.diag.size();
+    for( unsigned int isweep=0; isweep<nsweeps; isweep++ ) {
+        residual( L );
+        for( unsigned int idx=0; idx<size; idx++ ) {
+            L.x[idx] += omega_*L.t[idx]/L.diag[idx];
+        }
+    }
+}
+
+void PoissonMultigrid::vcycle( vector<Level> &levels, unsigned int l )
+{
+    Level &L = levels[l];
+    L.x.assign( L.x.size(), 0. );
+    
+    // The coarsest level only has a few nodes: more sweeps make it almost exact
+    if( l+1 == levels.size() ) {
+        smooth( L, 8 );
+        return;
+    }
+    
+    smooth( L, 2 );
+    residual( L );
+    
+    Level &C = levels[l+1];
+    C.b.assign( C.b.size(), 0. );
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            for( unsigned int k=0; k<L.n[2]; k++ ) {
+                C.b[( ( i/2 )*C.n[1]+j/2 )*C.n[2]+k/2] += L.t[( i*L.n[1]+j )*L.n[2]+k];
+            }
+        }
+    }
+    vcycle( levels, l+1 );
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            for( unsigned int k=0; k<L.n[2]; k++ ) {
+                L.x[( i*L.n[1]+j )*L.n[2]+k] += C.x[( ( i/2 )*C.n[1]+j/2 )*C.n[2]+k/2];
+            }
+        }
+    }
+    
+    smooth( L, 2 );
+}
+
+void PoissonMultigrid::coarseProduct( vector<double> &x, vector<double> &y )
+{
+    unsigned int nlinks = 2*nDim_;
+    for( unsigned int h=0; h<npatches_; h++ ) {
+        double s = coarse_diag_[h]*x[h];
+        for( unsigned int l=0; l<nlinks; l++ ) {
+            if( coarse_link_[h*nlinks+l] > 0 ) {
+                s += coarse_weight_[h*nlinks+l]*x[coarse_link_[h*nlinks+l]-1];
+            }
+        }
+        y[h] = s;
+    }
+}
+
+bool PoissonMultigrid::coarseFactorize()
+{
+    unsigned int nlinks = 2*nDim_;
+    for( unsigned int h=0; h<npatches_; h++ ) {
+        for( unsigned int l=0; l<nlinks; l++ ) {
+            if( coarse_link_[h*nlinks+l] > 0 ) {
+                int distance = abs( coarse_order_[h] - coarse_order_[coarse_link_[h*nlinks+l]-1] );
+                coarse_band_ = max( coarse_band_, ( unsigned int )distance );
+            }
+        }
+    }
+    // The factor is stored redundantly by each process: limit its size to 32 MB
+    unsigned int width = coarse_band_+1;
+    if( ( double )npatches_*width > 4194304. ) {
+        return false;
+    }
+    
+    // Lower half of the band of -A0 (positive definite), where L(i,j) is stored at i*width+j-i+coarse_band_
+    coarse_chol_.assign( npatches_*width, 0. );
+    for( unsigned int h=0; h<npatches_; h++ ) {
+        unsigned int i = coarse_order_[h];
+        coarse_chol_[i*width+coarse_band_] -= coarse_diag_[h];
+        for( unsigned int l=0; l<nlinks; l++ ) {
+            if( coarse_link_[h*nlinks+l] > 0 ) {
+                unsigned int j = coarse_order_[coarse_link_[h*nlinks+l]-1];
+                if( j < i ) {
+                    coarse_chol_[i*width+j+coarse_band_-i] -= coarse_weight_[h*nlinks+l];
+                }
+            }
+        }
+    }
+    
+    // Cholesky factorization in place, row by row
+    for( unsigned int i=0; i<npatches_; i++ ) {
+        double *Li = &coarse_chol_[i*width+coarse_band_-i];
+        unsigned int jmin = i>coarse_band_ ? i-coarse_band_ : 0;
+        for( unsigned int j=jmin; j<=i; j++ ) {
+            double *Lj = &coarse_chol_[j*width+coarse_band_-j];
+            double s = Li[j];
+            for( unsigned int k=jmin; k<j; k++ ) {
+                s -= Li[k]*Lj[k];
+            }
+            if( j < i ) {
+                Li[j] = s/Lj[j];
+            } else if( s > 0. ) {
+                Li[i] = sqrt( s );
+            } else {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void PoissonMultigrid::coarseSolve( vector<double> &b, vector<double> &x )
+{
+    // Small system, solved redundantly by each process
+    if( ! coarse_chol_.empty() ) {
+        // -A0 = L L^T: solve L y = -b, then L^T x = y, in the cartesian ordering
+        unsigned int width = coarse_band_+1;
+        for( unsigned int h=0; h<npatches_; h++ ) {
+            coarse_r_[coarse_order_[h]] = -b[h];
+        }
+        for( unsigned int i=0; i<npatches_; i++ ) {
+            const double *Li = &coarse_chol_[i*width+coarse_band_-i];
+            double s = coarse_r_[i];
+            for( unsigned int k=( i>coarse_band_ ? i-coarse_band_ : 0 ); k<i; k++ ) {
+                s -= Li[k]*coarse_r_[k];
+            }
+            coarse_r_[i] = s/Li[i];
+        }
+        for( int i=npatches_-1; i>=0; i-- ) {
+            double s = coarse_r_[i];
+            for( unsigned int k=i+1; k<min( npatches_, i+width ); k++ ) {
+                s -= coarse_chol_[k*width+coarse_band_-k+i]*coarse_r_[k];
+            }
+            coarse_r_[i] = s/coarse_chol_[i*width+coarse_band_];
+        }
+        for( unsigned int h=0; h<npatches_; h++ ) {
+            x[h] = coarse_r_[coarse_order_[h]];
+        }
+        return;
+    }
+    
+    // Otherwise, a Chebyshev polynomial of fixed degree in D0^-1 A0, from x = 0. Contrary to a conjugate gradient
+    // stopped by a tolerance, this is a fixed symmetric operator with the sign of A0^-1, so that the outer conjugate
+    // gradient still converges. Its interval only needs to contain the largest eigenvalues: the smallest ones are
+    // also reduced, but more slowly.
+    const unsigned int degree = 20;
+    double theta = 0.505*coarse_lambda_max_;
+    double delta = 0.495*coarse_lambda_max_;
+    double sigma = theta/delta;
+    double rho = 1./sigma;
+    x.assign( npatches_, 0. );
+    coarse_r_ = b;
+    for( unsigned int h=0; h<npatches_; h++ ) {
+        coarse_p_[h] = coarse_r_[h]/( theta*coarse_diag_[h] );
+    }
+    for( unsigned int k=0; k<degree; k++ ) {
+        for( unsigned int h=0; h<npatches_; h++ ) {
+            x[h] += coarse_p_[h];
+        }
+        if( k+1 == degree ) {
+            break;
+        }
+        coarseProduct( coarse_p_, coarse_Ap_ );
+        double rho_new = 1./( 2.*sigma - rho );
+        for( unsigned int h=0; h<npatches_; h++ ) {
+            coarse_r_[h] -= coarse_Ap_[h];
+            coarse_p_[h] = rho_new*rho*coarse_p_[h] + 2.*rho_new/delta*coarse_r_[h]/coarse_diag_[h];
+        }
+        rho = rho_new;
+    }
+}
+
+void PoissonMultigrid::apply( VectorPatch &vecPatches, SmileiMPI *smpi, double &r_dot_r, double &r_dot_z )
+{
+    coarse_b_.assign( npatches_, 0. );
+    
+    // Independent V-cycles: the patches are shared between threads
+    #pragma omp parallel for schedule(dynamic)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches( ipatch )->EMfields;
+        Field *r = EMfields->r_;
+        Field *z = z_[ipatch];
+        
+        // Owned box, and strides in the patch arrays
+        vector<unsigned int> n( 3, 1 ), lo( 3, 0 ), s( 3, 0 );
+        for( unsigned int d=0; d<nDim_; d++ ) {
+            lo[d] = EMfields->index_min_p_[d];
+            n[d] = EMfields->index_max_p_[d] - lo[d] + 1;
+        }
+        s[nDim_-1] = 1;
+        for( int d=nDim_-2; d>=0; d-- ) {
+            s[d] = s[d+1]*r->dims_[d+1];
+        }
+        
+        // Nodes outside the box are either synchronized below or beyond a non-periodic border, where phi remains zero
+        memset( z->data_, 0, z->globalDims_*sizeof( double ) );
+        
+        vector<Level> &levels = hierarchy( n );
+        Level &L = levels[0];
+        double sum = 0.;
+        for( unsigned int i=0; i<n[0]; i++ ) {
+            for( unsigned int j=0; j<n[1]; j++ ) {
+                for( unsigned int k=0; k<n[2]; k++ ) {
+                    double v = r->data_[( lo[0]+i )*s[0] + ( lo[1]+j )*s[1] + ( lo[2]+k )*s[2]];
+                    L.b[( i*n[1]+j )*n[2]+k] = v;
+                    sum += v;
+                }
+            }
+        }
+        coarse_b_[vecPatches( ipatch )->hindex] = sum;
+        
+        vcycle( levels, 0 );
+        
+        for( unsigned int i=0; i<n[0]; i++ ) {
+            for( unsigned int j=0; j<n[1]; j++ ) {
+                for( unsigned int k=0; k<n[2]; k++ ) {
+                    z->data_[( lo[0]+i )*s[0] + ( lo[1]+j )*s[1] + ( lo[2]+k )*s[2]] = L.x[( i*n[1]+j )*n[2]+k];
+                }
+            }
+        }
+    }
+    
+    // Coarse correction, constant over each patch
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_b_[0], npatches_, MPI_DOUBLE, MPI_SUM, smpi->getGlobalComm() );
+    coarseSolve( coarse_b_, coarse_x_ );
+    
+    double r_dot_r_local = 0., r_dot_z_local = 0.;
+    #pragma omp parallel for schedule(static) reduction(+:r_dot_r_local,r_dot_z_local)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches( ipatch )->EMfields;
+        Field *r = EMfields->r_;
+        Field *z = z_[ipatch];
+        double e = coarse_x_[vecPatches( ipatch )->hindex];
+        vector<unsigned int> lo( 3, 0 ), hi( 3, 0 ), s( 3, 0 );
+        for( unsigned int d=0; d<nDim_; d++ ) {
+            lo[d] = EMfields->index_min_p_[d];
+            hi[d] = EMfields->index_max_p_[d];
+        }
+        s[nDim_-1] = 1;
+        for( int d=nDim_-2; d>=0; d-- ) {
+            s[d] = s[d+1]*r->dims_[d+1];
+        }
+        for( unsigned int i=lo[0]; i<=hi[0]; i++ ) {
+            for( unsigned int j=lo[1]; j<=hi[1]; j++ ) {
+                for( unsigned int k=lo[2]; k<=hi[2]; k++ ) {
+                    unsigned int idx = i*s[0] + j*s[1] + k*s[2];
+                    z->data_[idx] += e;
+                    r_dot_r_local += r->data_[idx]*r->data_[idx];
+                    r_dot_z_local += r->data_[idx]*z->data_[idx];
+                }
+            }
+        }
+    }
+    double dots[2] = { r_dot_r_local, r_dot_z_local };
+    MPI_Allreduce( MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, smpi->getGlobalComm() );
+    r_dot_r = dots[0];
+    r_dot_z = dots[1];
+    
+    // z is zero outside the owned nodes: summing the patches copies each node to all patches where it is present
+    SyncVectorPatch::sum_noomp( z_, vecPatches, smpi );
+}
+
+void PoissonMultigrid::update_p( VectorPatch &vecPatches, double beta )
+{
+    #pragma omp parallel for schedule(static)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        double *p = vecPatches( ipatch )->EMfields->p_->data_;
+        double *z = z_[ipatch]->data_;
+        unsigned int size = z_[ipatch]->globalDims_;
+        for( unsigned int i=0; i<size; i++ ) {
+            p[i] = z[i] + beta*p[i];
+        }
+    }
+}
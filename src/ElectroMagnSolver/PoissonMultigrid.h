@@ -0,0 +1,105 @@
+/*
+ * PoissonMultigrid.h
+ *
+ * Multigrid preconditioner for the conjugate gradient of the Poisson solvers
+ */
+
+#ifndef POISSONMULTIGRID_H
+#define POISSONMULTIGRID_H
+
+#include <vector>
+#include <map>
+
+class Params;
+class SmileiMPI;
+class VectorPatch;
+class Field;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PoissonMultigrid
+//! Approximates z = A^-1 r, where A is the discrete laplacian of ElectroMagn::compute_Ap (with a x coefficient divided
+//! by gamma^2 for the relativistic Poisson problem). Two symmetric corrections are added:
+//!  - inside each patch, a V-cycle on the nodes owned by the patch (zero outside), with damped Jacobi smoothing
+//!    and coarse levels obtained by aggregating 2x2x2 nodes
+//!  - on the whole domain, a coarse problem with one unknown per patch, solved by all MPI processes
+//! The preconditioner is symmetric and has the sign of A, as required by the conjugate gradient.
+//  --------------------------------------------------------------------------------------------------------------------
+class PoissonMultigrid
+{
+public:
+    //! Build the coarse problems, once the patches have been initialized by ElectroMagn::initPoisson
+    PoissonMultigrid( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, double gamma_mean = 1. );
+    ~PoissonMultigrid();
+    
+    //! Compute z = M^-1 r, synchronized between patches, and the global scalar products r.r and r.z
+    void apply( VectorPatch &vecPatches, SmileiMPI *smpi, double &r_dot_r, double &r_dot_z );
+    
+    //! New direction p = z + beta p
+    void update_p( VectorPatch &vecPatches, double beta );
+
+private:
+    //! One level of the patch hierarchy: operator stored as a diagonal and the weights of the links towards +x, +y, +z
+    struct Level {
+        unsigned int n[3];
+        std::vector<double> diag, w[3], x, b, t;
+    };
+    
+    //! Hierarchies of levels, per thread and per size of the box owned by the patches (patches on the x borders own
+    //! more nodes)
+    std::vector<std::map<std::vector<unsigned int>, std::vector<Level> > > hierarchies_;
+    
+    //! Get (or build) the hierarchy of the current thread for the given box size
+    std::vector<Level> &hierarchy( std::vector<unsigned int> n );
+    
+    //! t = b - A x
+    void residual( Level &L );
+    
+    //! Damped Jacobi iterations
+    void smooth( Level &L, unsigned int nsweeps );
+    
+    //! V-cycle from x=0 on level l
+    void vcycle( std::vector<Level> &levels, unsigned int l );
+    
+    //! Global coarse problem: y = A0 x
+    void coarseProduct( std::vector<double> &x, std::vector<double> &y );
+    
+    //! Global coarse problem: banded Cholesky factorization of -A0, done once (returns false if not possible)
+    bool coarseFactorize();
+    
+    //! Global coarse problem: solve A0 x = b with the factorization, or else approximately by a Chebyshev polynomial
+    //! of fixed degree, so that the preconditioner remains a fixed linear operator
+    void coarseSolve( std::vector<double> &b, std::vector<double> &x );
+    
+    //! Number of dimensions
+    unsigned int nDim_;
+    
+    //! Weights of the links of the fine operator in each direction (1/dx^2)
+    double c_[3];
+    
+    //! Damping factor of the Jacobi smoother
+    double omega_;
+    
+    //! Preconditioned residual, per patch
+    std::vector<Field *> z_;
+    
+    //! Global coarse operator: diagonal and links (hindex+1 of the neighbor patch, 0 if none) of each patch
+    unsigned int npatches_;
+    std::vector<double> coarse_diag_;
+    std::vector<int> coarse_link_;
+    std::vector<double> coarse_weight_;
+    
+    //! Position of each patch (indexed by hindex) in the cartesian ordering of the patches, x varying slowest
+    std::vector<int> coarse_order_;
+    
+    //! Bandwidth of A0 in this ordering, and rows of its Cholesky factor L (band only, empty if not factorized)
+    unsigned int coarse_band_;
+    std::vector<double> coarse_chol_;
+    
+    //! Upper bound of the eigenvalues of D0^-1 A0 (Gershgorin), for the Chebyshev polynomial
+    double coarse_lambda_max_;
+    
+    //! Work vectors of the global coarse problem
+    std::vector<double> coarse_b_, coarse_x_, coarse_r_, coarse_p_, coarse_Ap_;
+};
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef SOLVER3DKERNELS_H
+#define SOLVER3DKERNELS_H
+
+#include <algorithm>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Solver3DKernels
+//!   Cache-blocked 3D finite-difference Maxwell kernels working directly on the contiguous data_ of Field3D.
+//!   The three components are updated in the same sweep: the domain is cut in blocks of rows along y,
+//!   the x planes of each block are browsed so that the planes i-1 and i (i-2 to i+1 for Lehe) stay in cache,
+//!   and the innermost (z) loop is vectorized.
+//!   Fields are indexed as data_[(i*ny + j)*nz + k] with (nx, ny, nz) the primal/dual dimensions of each component.
+//!   The arithmetic of each cell is unchanged with respect to the Field3D::operator() implementation.
+//  --------------------------------------------------------------------------------------------------------------------
+class Solver3DKernels
+{
+
+public:
+    //! Number of rows along y in a cache block
+    static const unsigned int block_size = 16;
+
+    //! Maxwell-Faraday with the Yee scheme: B -= dt curl E
+    static inline void faradayYee( double *Bx, double *By, double *Bz,
+                                   const double *Ex, const double *Ey, const double *Ez,
+                                   unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d,
+                                   double dt_ov_dx, double dt_ov_dy, double dt_ov_dz )
+    {
+        for( unsigned int jb=0 ; jb<ny_d ; jb+=block_size ) {
+            unsigned int je = std::min( jb+block_size, ny_d );
+            for( unsigned int i=0 ; i<nx_d ; i++ ) {
+                for( unsigned int j=jb ; j<je ; j++ ) {
+
+                    // Magnetic field Bx^(p,d,d)
+                    if( i<nx_p && j>=1 && j<ny_d-1 ) {
+                        double *__restrict__ bx = Bx + ( i*ny_d+j )*nz_d;
+                        const double *__restrict__ ez   = Ez + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ ezjm = Ez + ( i*ny_p+j-1 )*nz_d;
+                        const double *__restrict__ ey   = Ey + ( i*ny_d+j )*nz_p;
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                            bx[k] += -dt_ov_dy * ( ez[k] - ezjm[k] ) + dt_ov_dz * ( ey[k] - ey[k-1] );
+                        }
+                    }
+
+                    if( i<1 || i>=nx_d-1 ) {
+                        continue;
+                    }
+
+                    // Magnetic field By^(d,p,d)
+                    if( j<ny_p ) {
+                        double *__restrict__ by = By + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ ex   = Ex + ( i*ny_p+j )*nz_p;
+                        const double *__restrict__ ez   = Ez + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ ezim = Ez + ( ( i-1 )*ny_p+j )*nz_d;
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                            by[k] += -dt_ov_dz * ( ex[k] - ex[k-1] ) + dt_ov_dx * ( ez[k] - ezim[k] );
+                        }
+                    }
+
+                    // Magnetic field Bz^(d,d,p)
+                    if( j>=1 && j<ny_d-1 ) {
+                        double *__restrict__ bz = Bz + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ ey   = Ey + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ eyim = Ey + ( ( i-1 )*ny_d+j )*nz_p;
+                        const double *__restrict__ ex   = Ex + ( i*ny_p+j )*nz_p;
+                        const double *__restrict__ exjm = Ex + ( i*ny_p+j-1 )*nz_p;
+                        #pragma omp simd
+                        for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                            bz[k] += -dt_ov_dx * ( ey[k] - eyim[k] ) + dt_ov_dy * ( ex[k] - exjm[k] );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //! Maxwell-Ampere: E += dt ( curl B - J )
+    static inline void ampere( double *Ex, double *Ey, double *Ez,
+                               const double *Bx, const double *By, const double *Bz,
+                               const double *Jx, const double *Jy, const double *Jz,
+                               unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d,
+                               double dt, double dt_ov_dx, double dt_ov_dy, double dt_ov_dz )
+    {
+        for( unsigned int jb=0 ; jb<ny_d ; jb+=block_size ) {
+            unsigned int je = std::min( jb+block_size, ny_d );
+            for( unsigned int i=0 ; i<nx_d ; i++ ) {
+                for( unsigned int j=jb ; j<je ; j++ ) {
+
+                    // Electric field Ex^(d,p,p)
+                    if( j<ny_p ) {
+                        double *__restrict__ ex = Ex + ( i*ny_p+j )*nz_p;
+                        const double *__restrict__ jx   = Jx + ( i*ny_p+j )*nz_p;
+                        const double *__restrict__ bz   = Bz + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ bzjp = Bz + ( i*ny_d+j+1 )*nz_p;
+                        const double *__restrict__ by   = By + ( i*ny_p+j )*nz_d;
+                        #pragma omp simd
+                        for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                            ex[k] += -dt*jx[k]
+                                     +                 dt_ov_dy * ( bzjp[k] - bz[k] )
+                                     -                 dt_ov_dz * ( by[k+1] - by[k] );
+                        }
+                    }
+
+                    if( i>=nx_p ) {
+                        continue;
+                    }
+
+                    // Electric field Ey^(p,d,p)
+                    {
+                        double *__restrict__ ey = Ey + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ jy   = Jy + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ bz   = Bz + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ bzip = Bz + ( ( i+1 )*ny_d+j )*nz_p;
+                        const double *__restrict__ bx   = Bx + ( i*ny_d+j )*nz_d;
+                        #pragma omp simd
+                        for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                            ey[k] += -dt*jy[k]
+                                     -                  dt_ov_dx * ( bzip[k] - bz[k] )
+                                     +                  dt_ov_dz * ( bx[k+1] - bx[k] );
+                        }
+                    }
+
+                    // Electric field Ez^(p,p,d)
+                    if( j<ny_p ) {
+                        double *__restrict__ ez = Ez + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ jz   = Jz + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ by   = By + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ byip = By + ( ( i+1 )*ny_p+j )*nz_d;
+                        const double *__restrict__ bx   = Bx + ( i*ny_d+j )*nz_d;
+                        const double *__restrict__ bxjp = Bx + ( i*ny_d+j+1 )*nz_d;
+                        #pragma omp simd
+                        for( unsigned int k=0 ; k<nz_d ; k++ ) {
+                            ez[k] += -dt*jz[k]
+                                     +                  dt_ov_dx * ( byip[k] - by[k] )
+                                     -                  dt_ov_dy * ( bxjp[k] - bx[k] );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //! Maxwell-Faraday with the Lehe scheme, bulk of the domain only (borders are treated by MF_Solver3D_Lehe)
+    static inline void faradayLehe( double *Bx, double *By, double *Bz,
+                                    const double *Ex, const double *Ey, const double *Ez,
+                                    unsigned int nx_p, unsigned int nx_d, unsigned int ny_p, unsigned int ny_d, unsigned int nz_p, unsigned int nz_d,
+                                    double dt_ov_dx, double dt_ov_dy, double dt_ov_dz,
+                                    double alpha_x, double alpha_y, double beta_xy, double beta_xz, double beta_yx, double delta_x )
+    {
+        for( unsigned int jb=0 ; jb<ny_d ; jb+=block_size ) {
+            unsigned int je = std::min( jb+block_size, ny_d );
+            for( unsigned int i=1 ; i<nx_p-1 ; i++ ) {
+                for( unsigned int j=std::max( jb, 1u ) ; j<std::min( je, ny_d-1 ) ; j++ ) {
+
+                    // Magnetic field Bx^(p,d,d)
+                    {
+                        double *__restrict__ bx = Bx + ( i*ny_d+j )*nz_d;
+                        const double *__restrict__ ez     = Ez + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ ezjm   = Ez + ( i*ny_p+j-1 )*nz_d;
+                        const double *__restrict__ ezip   = Ez + ( ( i+1 )*ny_p+j )*nz_d;
+                        const double *__restrict__ ezipjm = Ez + ( ( i+1 )*ny_p+j-1 )*nz_d;
+                        const double *__restrict__ ezim   = Ez + ( ( i-1 )*ny_p+j )*nz_d;
+                        const double *__restrict__ ezimjm = Ez + ( ( i-1 )*ny_p+j-1 )*nz_d;
+                        const double *__restrict__ ey     = Ey + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ eyip   = Ey + ( ( i+1 )*ny_d+j )*nz_p;
+                        const double *__restrict__ eyim   = Ey + ( ( i-1 )*ny_d+j )*nz_p;
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                            bx[k] += -dt_ov_dy * ( alpha_y * ( ez[k] - ezjm[k] )
+                                                   + beta_yx * ( ezip[k] - ezipjm[k] + ezim[k] - ezimjm[k] )
+                                                 )
+                                     +dt_ov_dz * ( alpha_y * ( ey[k] - ey[k-1] )
+                                                   + beta_yx * ( eyip[k] - eyip[k-1] + eyim[k] - eyim[k-1] )
+                                                 );
+                        }
+                    }
+
+                    if( i<2 || i>=nx_d-2 ) {
+                        continue;
+                    }
+
+                    // Magnetic field By^(d,p,d)
+                    if( j<ny_p-1 ) {
+                        double *__restrict__ by = By + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ ez     = Ez + ( i*ny_p+j )*nz_d;
+                        const double *__restrict__ ezim   = Ez + ( ( i-1 )*ny_p+j )*nz_d;
+                        const double *__restrict__ ezjp   = Ez + ( i*ny_p+j+1 )*nz_d;
+                        const double *__restrict__ ezimjp = Ez + ( ( i-1 )*ny_p+j+1 )*nz_d;
+                        const double *__restrict__ ezjm   = Ez + ( i*ny_p+j-1 )*nz_d;
+                        const double *__restrict__ ezimjm = Ez + ( ( i-1 )*ny_p+j-1 )*nz_d;
+                        const double *__restrict__ ezip   = Ez + ( ( i+1 )*ny_p+j )*nz_d;
+                        const double *__restrict__ ezim2  = Ez + ( ( i-2 )*ny_p+j )*nz_d;
+                        const double *__restrict__ ex     = Ex + ( i*ny_p+j )*nz_p;
+                        const double *__restrict__ exip   = Ex + ( ( i+1 )*ny_p+j )*nz_p;
+                        const double *__restrict__ exim   = Ex + ( ( i-1 )*ny_p+j )*nz_p;
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                            by[k] += dt_ov_dx * ( alpha_x * ( ez[k] - ezim[k] )
+                                                  + beta_xy * ( ezjp[k] - ezimjp[k] + ezjm[k] - ezimjm[k] )
+                                                  + beta_xz * ( ez[k+1] - ezim[k+1] + ez[k-1] - ezim[k-1] )
+                                                  + delta_x * ( ezip[k] - ezim2[k] ) )
+                                     -dt_ov_dz * ( alpha_y * ( ex[k] - ex[k-1] )
+                                                   + beta_yx * ( exip[k] - exip[k-1] + exim[k] - exim[k-1] )
+                                                 );
+                        }
+                    }
+
+                    // Magnetic field Bz^(d,d,p)
+                    {
+                        double *__restrict__ bz = Bz + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ ex     = Ex + ( i*ny_p+j )*nz_p;
+                        const double *__restrict__ exjm   = Ex + ( i*ny_p+j-1 )*nz_p;
+                        const double *__restrict__ exip   = Ex + ( ( i+1 )*ny_p+j )*nz_p;
+                        const double *__restrict__ exipjm = Ex + ( ( i+1 )*ny_p+j-1 )*nz_p;
+                        const double *__restrict__ exim   = Ex + ( ( i-1 )*ny_p+j )*nz_p;
+                        const double *__restrict__ eximjm = Ex + ( ( i-1 )*ny_p+j-1 )*nz_p;
+                        const double *__restrict__ ey     = Ey + ( i*ny_d+j )*nz_p;
+                        const double *__restrict__ eyim   = Ey + ( ( i-1 )*ny_d+j )*nz_p;
+                        const double *__restrict__ eyjp   = Ey + ( i*ny_d+j+1 )*nz_p;
+                        const double *__restrict__ eyimjp = Ey + ( ( i-1 )*ny_d+j+1 )*nz_p;
+                        const double *__restrict__ eyjm   = Ey + ( i*ny_d+j-1 )*nz_p;
+                        const double *__restrict__ eyimjm = Ey + ( ( i-1 )*ny_d+j-1 )*nz_p;
+                        const double *__restrict__ eyip   = Ey + ( ( i+1 )*ny_d+j )*nz_p;
+                        const double *__restrict__ eyim2  = Ey + ( ( i-2 )*ny_d+j )*nz_p;
+                        #pragma omp simd
+                        for( unsigned int k=1 ; k<nz_p-1 ; k++ ) {
+                            bz[k] += dt_ov_dy * ( alpha_y * ( ex[k] - exjm[k] )
+                                                  + beta_yx * ( exip[k] - exipjm[k] + exim[k] - eximjm[k] ) )
+                                     - dt_ov_dx * ( alpha_x * ( ey[k] - eyim[k] )
+                                                    + beta_xy * ( eyjp[k] - eyimjp[k] + eyjm[k] - eyimjm[k] )
+                                                    + beta_xz * ( ey[k+1] - eyim[k+1] + ey[k-1] - eyim[k-1] )
+                                                    + delta_x * ( eyip[k] - eyim2[k] ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+};//END class
+
+#endif
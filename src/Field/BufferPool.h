@@ -0,0 +1,74 @@
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <map>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class BufferPool
+//! Arrays of the fields (T = double or std::complex<double>). Between open() and close(), the arrays released by the
+//! fields are kept, sorted by size, and given to the fields allocated in the meantime: this is how a recycled patch
+//! (see Patch::recycle) rebuilds its fields in the memory of its previous fields. Outside, the arrays are simply
+//! allocated and deleted. The pool is specific to each thread.
+//  --------------------------------------------------------------------------------------------------------------------
+template<typename T>
+class BufferPool
+{
+public:
+    //! Start keeping the released arrays
+    static void open()
+    {
+        active() = true;
+    }
+
+    //! Delete the arrays that were not reused, and stop keeping the released ones
+    static void close()
+    {
+        for( auto &buffer : buffers() ) {
+            delete [] buffer.second;
+        }
+        buffers().clear();
+        active() = false;
+    }
+
+    //! Array of n elements (not initialized)
+    static T *allocate( unsigned int n )
+    {
+        if( active() ) {
+            auto it = buffers().find( n );
+            if( it != buffers().end() ) {
+                T *data = it->second;
+                buffers().erase( it );
+                return data;
+            }
+        }
+        return new T[n];
+    }
+
+    //! Release an array of n elements obtained from allocate
+    static void release( T *data, unsigned int n )
+    {
+        if( !data ) {
+            return;
+        }
+        if( active() ) {
+            buffers().insert( std::make_pair( n, data ) );
+        } else {
+            delete [] data;
+        }
+    }
+
+private:
+    static bool &active()
+    {
+        static thread_local bool active_ = false;
+        return active_;
+    }
+
+    static std::multimap<unsigned int, T *> &buffers()
+    {
+        static thread_local std::multimap<unsigned int, T *> buffers_;
+        return buffers_;
+    }
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "Field1D.h"
+#include "BufferPool.h"
 
 #include <iostream>
 #include <vector>
@@ -58,7 +59,7 @@ Field1D::Field1D( string name_in, vector<unsigned int> dims ) : Field( dims, nam
 Field1D::~Field1D()
 {
     if( data_!=NULL ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
     }
 }
 
@@ -75,7 +76,7 @@ void Field1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[ dims_[0] ];
+    data_ = BufferPool<double>::allocate( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         data_[i]=0.0;
@@ -87,7 +88,7 @@ void Field1D::allocateDims()
 
 void Field1D::deallocateDims()
 {
-    delete [] data_;
+    BufferPool<double>::release( data_, globalDims_ );
     data_=NULL;
 }
 
@@ -125,7 +126,7 @@ void Field1D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[ dims_[0] ];
+    data_ = BufferPool<double>::allocate( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         data_[i]=0.0;
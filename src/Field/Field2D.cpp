@@ -1,4 +1,5 @@
 #include "Field2D.h"
+#include "BufferPool.h"
 
 #include <iostream>
 #include <vector>
@@ -65,7 +66,7 @@ Field2D::~Field2D()
 {
 
     if( data_!=NULL ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
         delete [] data_2D;
     }
 }
@@ -81,12 +82,12 @@ void Field2D::allocateDims()
         ERROR( "Alloc error must be 2 : " << dims_.size() );
     }
     if( data_!=NULL ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]];
+    data_ = BufferPool<double>::allocate( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
     
     data_2D= new double*[dims_[0]];
@@ -103,7 +104,7 @@ void Field2D::allocateDims()
 
 void Field2D::deallocateDims()
 {
-    delete [] data_;
+    BufferPool<double>::release( data_, globalDims_ );
     data_ = NULL;
     delete [] data_2D;
     data_2D = NULL;
@@ -128,7 +129,7 @@ void Field2D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 2 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -145,7 +146,7 @@ void Field2D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]];
+    data_ = BufferPool<double>::allocate( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
     
     data_2D= new double*[dims_[0]];
@@ -1,4 +1,5 @@
 #include "Field3D.h"
+#include "BufferPool.h"
 
 #include <iostream>
 #include <vector>
@@ -66,7 +67,7 @@ Field3D::Field3D( string name_in, vector<unsigned int> dims ) : Field( dims, nam
 Field3D::~Field3D()
 {
     if( data_!=NULL ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
         for( unsigned int i=0; i<dims_[0]; i++ ) {
             delete [] this->data_3D[i];
         }
@@ -84,12 +85,12 @@ void Field3D::allocateDims()
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = BufferPool<double>::allocate( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!!}
     data_3D= new double **[dims_[0]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
@@ -108,7 +109,7 @@ void Field3D::allocateDims()
 
 void Field3D::deallocateDims()
 {
-    delete [] data_;
+    BufferPool<double>::release( data_, globalDims_ );
     data_ = NULL;
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         delete [] data_3D[i];
@@ -138,7 +139,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        BufferPool<double>::release( data_, globalDims_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -155,7 +156,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = BufferPool<double>::allocate( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!!}
     data_3D= new double **[dims_[0]*dims_[1]];
     for( unsigned int i=0; i<dims_[0]; i++ ) {
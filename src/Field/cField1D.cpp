@@ -1,4 +1,5 @@
 #include "cField1D.h"
+#include "BufferPool.h"
 
 #include <iostream>
 #include <vector>
@@ -58,7 +59,7 @@ cField1D::cField1D( string name, vector<unsigned int> dims ) : cField( dims, nam
 cField1D::~cField1D()
 {
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
     }
 }
 
@@ -75,7 +76,7 @@ void cField1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    cdata_ = new complex<double>[ dims_[0] ];
+    cdata_ = BufferPool<complex<double> >::allocate( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         cdata_[i]=0.0;
@@ -87,7 +88,7 @@ void cField1D::allocateDims()
 
 void cField1D::deallocateDims()
 {
-    delete [] cdata_;
+    BufferPool<complex<double> >::release( cdata_, globalDims_ );
     cdata_=NULL;
 }
 
@@ -125,7 +126,7 @@ void cField1D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    cdata_ = new complex<double>[ dims_[0] ];
+    cdata_ = BufferPool<complex<double> >::allocate( dims_[0] );
     //! \todo{change to memset (JD)}
     for( unsigned int i=0; i<dims_[0]; i++ ) {
         cdata_[i]=0.0;
@@ -1,4 +1,5 @@
 #include "cField2D.h"
+#include "BufferPool.h"
 
 #include <iostream>
 #include <vector>
@@ -66,7 +67,7 @@ cField2D::~cField2D()
 {
 
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
         delete [] data_2D;
     }
 }
@@ -82,12 +83,12 @@ void cField2D::allocateDims()
         ERROR( "Alloc error must be 2 : " << dims_.size() );
     }
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]];
+    cdata_ = BufferPool<complex<double> >::allocate( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
     
     data_2D= new complex<double> *[dims_[0]];
@@ -104,7 +105,7 @@ void cField2D::allocateDims()
 
 void cField2D::deallocateDims()
 {
-    delete [] cdata_;
+    BufferPool<complex<double> >::release( cdata_, globalDims_ );
     cdata_ = NULL;
     delete [] data_2D;
     data_2D = NULL;
@@ -129,7 +130,7 @@ void cField2D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 2 : " << dims_.size() );
     }
     if( cdata_ ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -146,7 +147,7 @@ void cField2D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]];
+    cdata_ = BufferPool<complex<double> >::allocate( dims_[0]*dims_[1] );
     //! \todo{check row major order!!! (JD)}
     
     data_2D= new complex<double> *[dims_[0]];
@@ -1,4 +1,5 @@
 #include "cField3D.h"
+#include "BufferPool.h"
 
 #include <iostream>
 #include <vector>
@@ -62,7 +63,7 @@ cField3D::~cField3D()
 {
 
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
         for( unsigned int i=0; i<dims_[0]; i++ ) {
             delete [] data_3D[i];
         }
@@ -81,12 +82,12 @@ void cField3D::allocateDims()
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( cdata_!=NULL ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]*dims_[2]];
+    cdata_ = BufferPool<complex<double> >::allocate( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!! (JD)}
     
     data_3D= new complex<double> **[dims_[0]];
@@ -105,7 +106,7 @@ void cField3D::allocateDims()
 
 void cField3D::deallocateDims()
 {
-    delete [] cdata_;
+    BufferPool<complex<double> >::release( cdata_, globalDims_ );
     cdata_ = NULL;
     delete [] data_3D;
     data_3D = NULL;
@@ -131,7 +132,7 @@ void cField3D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( cdata_ ) {
-        delete [] cdata_;
+        BufferPool<complex<double> >::release( cdata_, globalDims_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -148,7 +149,7 @@ void cField3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    cdata_ = new complex<double>[dims_[0]*dims_[1]*dims_[2]];
+    cdata_ = BufferPool<complex<double> >::allocate( dims_[0]*dims_[1]*dims_[2] );
     //! \todo{check row major order!!! (JD)}
     
     data_3D= new complex<double> **[dims_[0]];
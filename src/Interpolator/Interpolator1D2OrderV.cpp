@@ -0,0 +1,214 @@
+#include "Interpolator1D2OrderV.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "ElectroMagn.h"
+#include "Field1D.h"
+#include "Particles.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Creator for Interpolator1D2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+Interpolator1D2OrderV::Interpolator1D2OrderV( Params &params, Patch *patch ) : Interpolator1D( params, patch )
+{
+    dx_inv_ = 1.0/params.cell_length[0];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 2nd Order Interpolation of the fields at a the particle position (3 nodes are used)
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator1D2OrderV::fields( ElectroMagn *EMfields, Particles &particles, int ipart, int nparts, double *ELoc, double *BLoc )
+{
+    // Static cast of the electromagnetic fields
+    Field1D *Ex1D     = static_cast<Field1D *>( EMfields->Ex_ );
+    Field1D *Ey1D     = static_cast<Field1D *>( EMfields->Ey_ );
+    Field1D *Ez1D     = static_cast<Field1D *>( EMfields->Ez_ );
+    Field1D *Bx1D_m   = static_cast<Field1D *>( EMfields->Bx_m );
+    Field1D *By1D_m   = static_cast<Field1D *>( EMfields->By_m );
+    Field1D *Bz1D_m   = static_cast<Field1D *>( EMfields->Bz_m );
+    
+    // Particle position (in units of the spatial-step)
+    double xpn = particles.position( 0, ipart )*dx_inv_;
+    int idx  = round( xpn );
+    int idxO = idx - index_domain_begin - 1;
+    
+    double coeff[2][3], delta;
+    int dual;
+    coeffs( xpn, idx, coeff, &dual, &delta );
+    
+    // Interpolate the fields from the Dual grid : Ex, By, Bz
+    *( ELoc+0*nparts ) = compute( &coeff[1][1], 1, dual, Ex1D,   idxO );
+    *( BLoc+1*nparts ) = compute( &coeff[1][1], 1, dual, By1D_m, idxO );
+    *( BLoc+2*nparts ) = compute( &coeff[1][1], 1, dual, Bz1D_m, idxO );
+    
+    // Interpolate the fields from the Primal grid : Ey, Ez, Bx
+    *( ELoc+1*nparts ) = compute( &coeff[0][1], 1, 0, Ey1D,   idxO );
+    *( ELoc+2*nparts ) = compute( &coeff[0][1], 1, 0, Ez1D,   idxO );
+    *( BLoc+0*nparts ) = compute( &coeff[0][1], 1, 0, Bx1D_m, idxO );
+    
+}//END Interpolator1D2OrderV
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 2nd Order Interpolation of the fields for the particles of a cell, by packs of 32 particles
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator1D2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    if( istart[0] == iend[0] ) {
+        return;    //Don't treat empty cells.
+    }
+    
+    int nparts( ( smpi->dynamics_invgf[ithread] ).size() );
+    
+    double *Epart[3], *Bpart[3];
+    
+    double *deltaO = &( smpi->dynamics_deltaold[ithread][0] );
+    
+    for( unsigned int k=0; k<3; k++ ) {
+        Epart[k]= &( smpi->dynamics_Epart[ithread][k*nparts] );
+        Bpart[k]= &( smpi->dynamics_Bpart[ithread][k*nparts] );
+    }
+    
+    //Primal index is constant over the all cell
+    int idx  = round( particles.position( 0, *istart ) * dx_inv_ );
+    int idxO = idx - index_domain_begin - 1;
+    
+    Field1D *Ex1D     = static_cast<Field1D *>( EMfields->Ex_ );
+    Field1D *Ey1D     = static_cast<Field1D *>( EMfields->Ey_ );
+    Field1D *Ez1D     = static_cast<Field1D *>( EMfields->Ez_ );
+    Field1D *Bx1D_m   = static_cast<Field1D *>( EMfields->Bx_m );
+    Field1D *By1D_m   = static_cast<Field1D *>( EMfields->By_m );
+    Field1D *Bz1D_m   = static_cast<Field1D *>( EMfields->Bz_m );
+    
+    double coeff[2][3][32];
+    int dual[32]; // Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
+    
+    int vecSize = 32;
+    
+    int cell_nparts( ( int )iend[0]-( int )istart[0] );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+        
+            double delta0 = particles.position( 0, ipart+ivect+istart[0] )*dx_inv_;
+            dual[ipart] = ( delta0 - ( double )idx >=0. );
+            
+            for( int j=0; j<2; j++ ) { // for dual
+            
+                double delta  = delta0 - ( double )idx + ( double )j*( 0.5-dual[ipart] );
+                double delta2 = delta*delta;
+                
+                coeff[j][0][ipart] = 0.5 * ( delta2-delta+0.25 );
+                coeff[j][1][ipart] = ( 0.75-delta2 );
+                coeff[j][2][ipart] = 0.5 * ( delta2+delta+0.25 );
+                
+                if( j==0 ) {
+                    deltaO[ipart-ipart_ref+ivect+istart[0]] = delta;
+                }
+            }
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+        
+            double *coeffp = &( coeff[0][1][ipart] );
+            double *coeffd = &( coeff[1][1][ipart] );
+            
+            // Interpolate the fields from the Dual grid : Ex, By, Bz
+            Epart[0][ipart-ipart_ref+ivect+istart[0]] = compute( coeffd, vecSize, dual[ipart], Ex1D,   idxO );
+            Bpart[1][ipart-ipart_ref+ivect+istart[0]] = compute( coeffd, vecSize, dual[ipart], By1D_m, idxO );
+            Bpart[2][ipart-ipart_ref+ivect+istart[0]] = compute( coeffd, vecSize, dual[ipart], Bz1D_m, idxO );
+            
+            // Interpolate the fields from the Primal grid : Ey, Ez, Bx
+            Epart[1][ipart-ipart_ref+ivect+istart[0]] = compute( coeffp, vecSize, 0, Ey1D,   idxO );
+            Epart[2][ipart-ipart_ref+ivect+istart[0]] = compute( coeffp, vecSize, 0, Ez1D,   idxO );
+            Bpart[0][ipart-ipart_ref+ivect+istart[0]] = compute( coeffp, vecSize, 0, Bx1D_m, idxO );
+        }
+    }
+} // END Interpolator1D2OrderV
+
+
+void Interpolator1D2OrderV::fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc )
+{
+    // probes are interpolated one by one for now
+    int ipart = *istart;
+    int nparts( particles.size() );
+    
+    double *ELoc = &( smpi->dynamics_Epart[ithread][ipart] );
+    double *BLoc = &( smpi->dynamics_Bpart[ithread][ipart] );
+    
+    Field1D *Jx1D     = static_cast<Field1D *>( EMfields->Jx_ );
+    Field1D *Jy1D     = static_cast<Field1D *>( EMfields->Jy_ );
+    Field1D *Jz1D     = static_cast<Field1D *>( EMfields->Jz_ );
+    Field1D *Rho1D    = static_cast<Field1D *>( EMfields->rho_ );
+    
+    fields( EMfields, particles, ipart, nparts, ELoc, BLoc );
+    
+    double xpn = particles.position( 0, ipart )*dx_inv_;
+    int idx  = round( xpn );
+    int idxO = idx - index_domain_begin - 1;
+    
+    double coeff[2][3], delta;
+    int dual;
+    coeffs( xpn, idx, coeff, &dual, &delta );
+    
+    // Interpolate the fields from the Primal grid : Jy, Jz, Rho
+    JLoc->y = compute( &coeff[0][1], 1, 0, Jy1D,  idxO );
+    JLoc->z = compute( &coeff[0][1], 1, 0, Jz1D,  idxO );
+    ( *RhoLoc ) = compute( &coeff[0][1], 1, 0, Rho1D, idxO );
+    
+    // Interpolate the fields from the Dual grid : Jx
+    JLoc->x = compute( &coeff[1][1], 1, dual, Jx1D,  idxO );
+    
+}
+
+// Interpolator on another field than the basic ones
+void Interpolator1D2OrderV::oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc )
+{
+    ERROR( "Single field 1D2O interpolator not available in vectorized mode" );
+}
+
+// Interpolator specific to tracked particles. A selection of particles may be provided
+void Interpolator1D2OrderV::fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, vector<unsigned int> *selection )
+{
+    if( selection ) {
+    
+        int nsel_tot = selection->size();
+        for( int isel=0 ; isel<nsel_tot; isel++ ) {
+            fields( EMfields, particles, ( *selection )[isel], offset, buffer+isel, buffer+isel+3*offset );
+        }
+        
+    } else {
+    
+        int npart_tot = particles.size();
+        for( int ipart=0 ; ipart<npart_tot; ipart++ ) {
+            fields( EMfields, particles, ipart, offset, buffer+ipart, buffer+ipart+3*offset );
+        }
+        
+    }
+}
+
+
+void Interpolator1D2OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    ERROR( "Vectorized interpolation for the envelope model is not implemented for 1D geometry" );
+}
+
+
+void Interpolator1D2OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    ERROR( "Vectorized interpolation for the envelope model is not implemented for 1D geometry" );
+}
+
+// probes like diagnostic !
+void Interpolator1D2OrderV::envelopeAndSusceptibility( ElectroMagn *EMfields, Particles &particles, int ipart, double *Env_A_abs_Loc, double *Env_Chi_Loc, double *Env_E_abs_Loc )
+{
+    ERROR( "Vectorized interpolation for the envelope model is not implemented for 1D geometry" );
+}
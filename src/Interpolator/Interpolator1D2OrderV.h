@@ -0,0 +1,60 @@
+#ifndef INTERPOLATOR1D2ORDERV_H
+#define INTERPOLATOR1D2ORDERV_H
+
+
+#include "Interpolator1D.h"
+#include "Field1D.h"
+
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class for vectorized 2nd order interpolator for 1Dcartesian simulations (particles sorted per cell)
+//  --------------------------------------------------------------------------------------------------------------------
+class Interpolator1D2OrderV : public Interpolator1D
+{
+
+public:
+    Interpolator1D2OrderV( Params &, Patch * );
+    ~Interpolator1D2OrderV() override final {};
+    
+    inline void fields( ElectroMagn *EMfields, Particles &particles, int ipart, int nparts, double *ELoc, double *BLoc );
+    void fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc ) override final;
+    void fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
+    void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
+    void oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc ) override final;
+    
+    //! Interpolation of f at the particle position
+    //! coeff points to the central coefficient, stride is the distance between 2 coefficients of a particle
+    //! dual (0 or 1) shifts the stencil of the dual fields, idx is the primal index of the cell minus 1
+    inline double compute( double *coeff, int stride, int dual, Field1D *f, int idx )
+    {
+        double interp_res( 0. );
+        for( int iloc=-1 ; iloc<2 ; iloc++ ) {
+            interp_res += *( coeff+iloc*stride ) * ( ( double )( 1-dual )*( *f )( idx+1+iloc ) + ( double )dual*( *f )( idx+2+iloc ) );
+        }
+        return interp_res;
+    };
+    
+    void fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
+    void timeCenteredEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
+    void envelopeAndSusceptibility( ElectroMagn *EMfields, Particles &particles, int ipart, double *Env_A_abs_Loc, double *Env_Chi_Loc, double *Env_E_abs_Loc ) override final;
+    
+private:
+    //! Primal (coeff[0]) and dual (coeff[1]) coefficients of a single particle, dual index shift and primal distance
+    inline void coeffs( double xpn, int idx, double coeff[2][3], int *dual, double *delta_p )
+    {
+        *dual = ( xpn - ( double )idx >=0. );
+        for( int j=0; j<2; j++ ) { // for dual
+            double delta  = xpn - ( double )idx + ( double )j*( 0.5-*dual );
+            double delta2 = delta*delta;
+            coeff[j][0] = 0.5 * ( delta2-delta+0.25 );
+            coeff[j][1] = ( 0.75-delta2 );
+            coeff[j][2] = 0.5 * ( delta2+delta+0.25 );
+            if( j==0 ) {
+                *delta_p = delta;
+            }
+        }
+    }
+    
+};//END class
+
+#endif
@@ -121,13 +121,13 @@ void Interpolator1D3Order::fieldsWrapper( ElectroMagn *EMfields, Particles &part
     std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     
     //Loop on bin particles
-    int npart_tot = particles.size();
+    int npart_tot = smpi->dynamics_invgf[ithread].size();
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
         //Interpolation on current particle
-        fields( EMfields, particles, ipart, npart_tot, &( *Epart )[ipart], &( *Bpart )[ipart] );
+        fields( EMfields, particles, ipart, npart_tot, &( *Epart )[ipart-ipart_ref], &( *Bpart )[ipart-ipart_ref] );
         //Buffering of iol and delta
-        ( *iold )[ipart] = ip_;
-        ( *delta )[ipart] = xi;
+        ( *iold )[ipart-ipart_ref] = ip_;
+        ( *delta )[ipart-ipart_ref] = xi;
     }
     
 }
@@ -146,15 +146,15 @@ void Interpolator2D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &part
     std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     
     //Loop on bin particles
-    int nparts( particles.size() );
+    int nparts( ( smpi->dynamics_invgf[ithread] ).size() );
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
         //Interpolation on current particle
-        fields( EMfields, particles, ipart, nparts, &( *Epart )[ipart], &( *Bpart )[ipart] );
+        fields( EMfields, particles, ipart, nparts, &( *Epart )[ipart-ipart_ref], &( *Bpart )[ipart-ipart_ref] );
         //Buffering of iol and delta
-        ( *iold )[ipart+0*nparts]  = ip_;
-        ( *iold )[ipart+1*nparts]  = jp_;
-        ( *delta )[ipart+0*nparts] = deltax;
-        ( *delta )[ipart+1*nparts] = deltay;
+        ( *iold )[ipart-ipart_ref+0*nparts]  = ip_;
+        ( *iold )[ipart-ipart_ref+1*nparts]  = jp_;
+        ( *delta )[ipart-ipart_ref+0*nparts] = deltax;
+        ( *delta )[ipart-ipart_ref+1*nparts] = deltay;
     }
     
 }
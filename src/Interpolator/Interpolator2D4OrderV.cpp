@@ -0,0 +1,264 @@
+#include "Interpolator2D4OrderV.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "ElectroMagn.h"
+#include "Field2D.h"
+#include "Particles.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Creator for Interpolator2D4OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+Interpolator2D4OrderV::Interpolator2D4OrderV( Params &params, Patch *patch ) : Interpolator2D( params, patch )
+{
+
+    dx_inv_ = 1.0/params.cell_length[0];
+    dy_inv_ = 1.0/params.cell_length[1];
+    D_inv[0] = 1.0/params.cell_length[0];
+    D_inv[1] = 1.0/params.cell_length[1];
+    
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 4th Order Interpolation of the fields at a the particle position (5 nodes are used)
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator2D4OrderV::fields( ElectroMagn *EMfields, Particles &particles, int ipart, int nparts, double *ELoc, double *BLoc )
+{
+    // Static cast of the electromagnetic fields
+    Field2D *Ex2D = static_cast<Field2D *>( EMfields->Ex_ );
+    Field2D *Ey2D = static_cast<Field2D *>( EMfields->Ey_ );
+    Field2D *Ez2D = static_cast<Field2D *>( EMfields->Ez_ );
+    Field2D *Bx2D = static_cast<Field2D *>( EMfields->Bx_m );
+    Field2D *By2D = static_cast<Field2D *>( EMfields->By_m );
+    Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_m );
+    
+    // Normalized particle position
+    double xpn[2];
+    xpn[0] = particles.position( 0, ipart )*D_inv[0];
+    xpn[1] = particles.position( 1, ipart )*D_inv[1];
+    
+    int idx[2], idxO[2];
+    idx[0]  = round( xpn[0] );
+    idxO[0] = idx[0] - i_domain_begin;
+    idx[1]  = round( xpn[1] );
+    idxO[1] = idx[1] - j_domain_begin;
+    
+    double coeff[2][2][5], delta[2];
+    int dual[2];
+    coeffs( xpn, idx, coeff, dual, delta );
+    
+    double *coeffxp = &( coeff[0][0][2] );
+    double *coeffxd = &( coeff[0][1][2] );
+    double *coeffyp = &( coeff[1][0][2] );
+    double *coeffyd = &( coeff[1][1][2] );
+    
+    // Interpolation of Ex^(d,p)
+    *( ELoc+0*nparts ) = compute( coeffxd, coeffyp, 1, dual[0], 0, Ex2D, idxO[0], idxO[1] );
+    // Interpolation of Ey^(p,d)
+    *( ELoc+1*nparts ) = compute( coeffxp, coeffyd, 1, 0, dual[1], Ey2D, idxO[0], idxO[1] );
+    // Interpolation of Ez^(p,p)
+    *( ELoc+2*nparts ) = compute( coeffxp, coeffyp, 1, 0, 0, Ez2D, idxO[0], idxO[1] );
+    // Interpolation of Bx^(p,d)
+    *( BLoc+0*nparts ) = compute( coeffxp, coeffyd, 1, 0, dual[1], Bx2D, idxO[0], idxO[1] );
+    // Interpolation of By^(d,p)
+    *( BLoc+1*nparts ) = compute( coeffxd, coeffyp, 1, dual[0], 0, By2D, idxO[0], idxO[1] );
+    // Interpolation of Bz^(d,d)
+    *( BLoc+2*nparts ) = compute( coeffxd, coeffyd, 1, dual[0], dual[1], Bz2D, idxO[0], idxO[1] );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 4th Order Interpolation of the fields for the particles of a cell, by packs of 32 particles
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator2D4OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    if( istart[0] == iend[0] ) {
+        return;    //Don't treat empty cells.
+    }
+    
+    int nparts( ( smpi->dynamics_invgf[ithread] ).size() );
+    
+    double *Epart[3], *Bpart[3];
+    
+    double *deltaO[2];
+    deltaO[0] = &( smpi->dynamics_deltaold[ithread][0] );
+    deltaO[1] = &( smpi->dynamics_deltaold[ithread][nparts] );
+    
+    for( unsigned int k=0; k<3; k++ ) {
+        Epart[k]= &( smpi->dynamics_Epart[ithread][k*nparts] );
+        Bpart[k]= &( smpi->dynamics_Bpart[ithread][k*nparts] );
+    }
+    
+    int idx[2], idxO[2];
+    //Primal indices are constant over the all cell
+    idx[0]  = round( particles.position( 0, *istart ) * D_inv[0] );
+    idxO[0] = idx[0] - i_domain_begin  ;
+    idx[1]  = round( particles.position( 1, *istart ) * D_inv[1] );
+    idxO[1] = idx[1] - j_domain_begin  ;
+    
+    Field2D *Ex2D = static_cast<Field2D *>( EMfields->Ex_ );
+    Field2D *Ey2D = static_cast<Field2D *>( EMfields->Ey_ );
+    Field2D *Ez2D = static_cast<Field2D *>( EMfields->Ez_ );
+    Field2D *Bx2D = static_cast<Field2D *>( EMfields->Bx_m );
+    Field2D *By2D = static_cast<Field2D *>( EMfields->By_m );
+    Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_m );
+    
+    double coeff[2][2][5][32];
+    int dual[2][32]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
+    
+    int vecSize = 32;
+    
+    int cell_nparts( ( int )iend[0]-( int )istart[0] );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+        
+            double delta0, delta;
+            double delta2, delta3, delta4;
+            
+            
+            for( int i=0; i<2; i++ ) { // for X/Y
+                delta0 = particles.position( i, ipart+ivect+istart[0] )*D_inv[i];
+                dual [i][ipart] = ( delta0 - ( double )idx[i] >=0. );
+                
+                for( int j=0; j<2; j++ ) { // for dual
+                
+                    delta   = delta0 - ( double )idx[i] + ( double )j*( 0.5-dual[i][ipart] );
+                    delta2  = delta*delta;
+                    delta3  = delta2*delta;
+                    delta4  = delta3*delta;
+                    
+                    coeff[i][j][0][ipart] = dble_1_ov_384   - dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+                    coeff[i][j][1][ipart] = dble_19_ov_96   - dble_11_ov_24 * delta  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+                    coeff[i][j][2][ipart] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+                    coeff[i][j][3][ipart] = dble_19_ov_96   + dble_11_ov_24 * delta  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+                    coeff[i][j][4][ipart] = dble_1_ov_384   + dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+                    
+                    if( j==0 ) {
+                        deltaO[i][ipart-ipart_ref+ivect+istart[0]] = delta;
+                    }
+                }
+            }
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+        
+            double *coeffxp = &( coeff[0][0][2][ipart] );
+            double *coeffxd = &( coeff[0][1][2][ipart] );
+            double *coeffyp = &( coeff[1][0][2][ipart] );
+            double *coeffyd = &( coeff[1][1][2][ipart] );
+            
+            //Ex(dual, primal)
+            Epart[0][ipart-ipart_ref+ivect+istart[0]] = compute( coeffxd, coeffyp, vecSize, dual[0][ipart], 0, Ex2D, idxO[0], idxO[1] );
+            //Ey(primal, dual)
+            Epart[1][ipart-ipart_ref+ivect+istart[0]] = compute( coeffxp, coeffyd, vecSize, 0, dual[1][ipart], Ey2D, idxO[0], idxO[1] );
+            //Ez(primal, primal)
+            Epart[2][ipart-ipart_ref+ivect+istart[0]] = compute( coeffxp, coeffyp, vecSize, 0, 0, Ez2D, idxO[0], idxO[1] );
+            //Bx(primal, dual)
+            Bpart[0][ipart-ipart_ref+ivect+istart[0]] = compute( coeffxp, coeffyd, vecSize, 0, dual[1][ipart], Bx2D, idxO[0], idxO[1] );
+            //By(dual, primal)
+            Bpart[1][ipart-ipart_ref+ivect+istart[0]] = compute( coeffxd, coeffyp, vecSize, dual[0][ipart], 0, By2D, idxO[0], idxO[1] );
+            //Bz(dual, dual)
+            Bpart[2][ipart-ipart_ref+ivect+istart[0]] = compute( coeffxd, coeffyd, vecSize, dual[0][ipart], dual[1][ipart], Bz2D, idxO[0], idxO[1] );
+        }
+    }
+} // END Interpolator2D4OrderV
+
+
+void Interpolator2D4OrderV::fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc )
+{
+    // probes are interpolated one by one for now
+    int ipart = *istart;
+    int nparts( particles.size() );
+    
+    double *ELoc = &( smpi->dynamics_Epart[ithread][ipart] );
+    double *BLoc = &( smpi->dynamics_Bpart[ithread][ipart] );
+    
+    Field2D *Jx2D = static_cast<Field2D *>( EMfields->Jx_ );
+    Field2D *Jy2D = static_cast<Field2D *>( EMfields->Jy_ );
+    Field2D *Jz2D = static_cast<Field2D *>( EMfields->Jz_ );
+    Field2D *Rho2D= static_cast<Field2D *>( EMfields->rho_ );
+    
+    fields( EMfields, particles, ipart, nparts, ELoc, BLoc );
+    
+    // Normalized particle position
+    double xpn[2];
+    xpn[0] = particles.position( 0, ipart )*D_inv[0];
+    xpn[1] = particles.position( 1, ipart )*D_inv[1];
+    
+    int idx[2], idxO[2];
+    idx[0]  = round( xpn[0] );
+    idxO[0] = idx[0] - i_domain_begin;
+    idx[1]  = round( xpn[1] );
+    idxO[1] = idx[1] - j_domain_begin;
+    
+    double coeff[2][2][5], delta[2];
+    int dual[2];
+    coeffs( xpn, idx, coeff, dual, delta );
+    
+    double *coeffxp = &( coeff[0][0][2] );
+    double *coeffxd = &( coeff[0][1][2] );
+    double *coeffyp = &( coeff[1][0][2] );
+    double *coeffyd = &( coeff[1][1][2] );
+    
+    // Interpolation of Jx^(d,p)
+    JLoc->x = compute( coeffxd, coeffyp, 1, dual[0], 0, Jx2D, idxO[0], idxO[1] );
+    // Interpolation of Jy^(p,d)
+    JLoc->y = compute( coeffxp, coeffyd, 1, 0, dual[1], Jy2D, idxO[0], idxO[1] );
+    // Interpolation of Jz^(p,p)
+    JLoc->z = compute( coeffxp, coeffyp, 1, 0, 0, Jz2D, idxO[0], idxO[1] );
+    // Interpolation of Rho^(p,p)
+    ( *RhoLoc ) = compute( coeffxp, coeffyp, 1, 0, 0, Rho2D, idxO[0], idxO[1] );
+}
+
+// Interpolator on another field than the basic ones
+void Interpolator2D4OrderV::oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc )
+{
+    ERROR( "Single field 2D4O interpolator not available in vectorized mode" );
+}
+
+// Interpolator specific to tracked particles. A selection of particles may be provided
+void Interpolator2D4OrderV::fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, vector<unsigned int> *selection )
+{
+    if( selection ) {
+    
+        int nsel_tot = selection->size();
+        for( int isel=0 ; isel<nsel_tot; isel++ ) {
+            fields( EMfields, particles, ( *selection )[isel], offset, buffer+isel, buffer+isel+3*offset );
+        }
+        
+    } else {
+    
+        int npart_tot = particles.size();
+        for( int ipart=0 ; ipart<npart_tot; ipart++ ) {
+            fields( EMfields, particles, ipart, offset, buffer+ipart, buffer+ipart+3*offset );
+        }
+        
+    }
+}
+
+
+void Interpolator2D4OrderV::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    ERROR( "Projection and interpolation for the envelope model are implemented only for interpolation_order = 2" );
+}
+
+
+void Interpolator2D4OrderV::timeCenteredEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    ERROR( "Projection and interpolation for the envelope model are implemented only for interpolation_order = 2" );
+}
+
+// probes like diagnostic !
+void Interpolator2D4OrderV::envelopeAndSusceptibility( ElectroMagn *EMfields, Particles &particles, int ipart, double *Env_A_abs_Loc, double *Env_Chi_Loc, double *Env_E_abs_Loc )
+{
+    ERROR( "Projection and interpolation for the envelope model are implemented only for interpolation_order = 2" );
+}
@@ -0,0 +1,82 @@
+#ifndef INTERPOLATOR2D4ORDERV_H
+#define INTERPOLATOR2D4ORDERV_H
+
+
+#include "Interpolator2D.h"
+#include "Field2D.h"
+
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class for vectorized 4th order interpolator for 2Dcartesian simulations (particles sorted per cell)
+//  --------------------------------------------------------------------------------------------------------------------
+class Interpolator2D4OrderV : public Interpolator2D
+{
+
+public:
+    Interpolator2D4OrderV( Params &, Patch * );
+    ~Interpolator2D4OrderV() override final {};
+    
+    inline void fields( ElectroMagn *EMfields, Particles &particles, int ipart, int nparts, double *ELoc, double *BLoc );
+    void fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc ) override final ;
+    void fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
+    void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
+    void oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc ) override final;
+    
+    //! Interpolation of f at the particle position
+    //! coeffx/coeffy point to the central coefficient, stride is the distance between 2 coefficients of a particle
+    //! dualx/dualy (0 or 1) shift the stencil of the dual directions, idx/idy are the primal indices of the cell
+    inline double compute( double *coeffx, double *coeffy, int stride, int dualx, int dualy, Field2D *f, int idx, int idy )
+    {
+        double interp_res( 0. );
+        for( int iloc=-2 ; iloc<3 ; iloc++ ) {
+            for( int jloc=-2 ; jloc<3 ; jloc++ ) {
+                interp_res += *( coeffx+iloc*stride ) * *( coeffy+jloc*stride ) *
+                              ( ( double )( 1-dualy ) * ( ( double )( 1-dualx )*( *f )( idx+iloc, idy+jloc ) + ( double )dualx*( *f )( idx+1+iloc, idy+jloc ) )
+                                +   ( double )dualy  * ( ( double )( 1-dualx )*( *f )( idx+iloc, idy+1+jloc ) + ( double )dualx*( *f )( idx+1+iloc, idy+1+jloc ) ) );
+            }
+        }
+        return interp_res;
+    };
+    
+    void fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
+    void timeCenteredEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final;
+    void envelopeAndSusceptibility( ElectroMagn *EMfields, Particles &particles, int ipart, double *Env_A_abs_Loc, double *Env_Chi_Loc, double *Env_E_abs_Loc ) override final;
+    
+private:
+    //! Primal (coeff[.][0]) and dual (coeff[.][1]) coefficients of a single particle, dual index shifts and primal distances
+    inline void coeffs( double *xpn, int *idx, double coeff[2][2][5], int *dual, double *delta_p )
+    {
+        for( int i=0; i<2; i++ ) { // for X/Y
+            dual[i] = ( xpn[i] - ( double )idx[i] >=0. );
+            for( int j=0; j<2; j++ ) { // for dual
+                double delta  = xpn[i] - ( double )idx[i] + ( double )j*( 0.5-dual[i] );
+                double delta2 = delta*delta;
+                double delta3 = delta2*delta;
+                double delta4 = delta3*delta;
+                coeff[i][j][0] = dble_1_ov_384   - dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+                coeff[i][j][1] = dble_19_ov_96   - dble_11_ov_24 * delta  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+                coeff[i][j][2] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+                coeff[i][j][3] = dble_19_ov_96   + dble_11_ov_24 * delta  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+                coeff[i][j][4] = dble_1_ov_384   + dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+                if( j==0 ) {
+                    delta_p[i] = delta;
+                }
+            }
+        }
+    }
+    
+    static constexpr double dble_1_ov_384   = 1.0/384.0;
+    static constexpr double dble_1_ov_48    = 1.0/48.0;
+    static constexpr double dble_1_ov_16    = 1.0/16.0;
+    static constexpr double dble_1_ov_12    = 1.0/12.0;
+    static constexpr double dble_1_ov_24    = 1.0/24.0;
+    static constexpr double dble_19_ov_96   = 19.0/96.0;
+    static constexpr double dble_11_ov_24   = 11.0/24.0;
+    static constexpr double dble_1_ov_4     = 1.0/4.0;
+    static constexpr double dble_1_ov_6     = 1.0/6.0;
+    static constexpr double dble_115_ov_192 = 115.0/192.0;
+    static constexpr double dble_5_ov_8     = 5.0/8.0;
+    
+};//END class
+
+#endif
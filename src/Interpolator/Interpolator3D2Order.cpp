@@ -138,17 +138,17 @@ void Interpolator3D2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &part
     std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     
     //Loop on bin particles
-    int nparts( particles.size() );
+    int nparts( ( smpi->dynamics_invgf[ithread] ).size() );
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
         //Interpolation on current particle
-        fields( EMfields, particles, ipart, nparts, &( *Epart )[ipart], &( *Bpart )[ipart] );
+        fields( EMfields, particles, ipart, nparts, &( *Epart )[ipart-ipart_ref], &( *Bpart )[ipart-ipart_ref] );
         //Buffering of iol and delta
-        ( *iold )[ipart+0*nparts]  = ip_;
-        ( *iold )[ipart+1*nparts]  = jp_;
-        ( *iold )[ipart+2*nparts]  = kp_;
-        ( *delta )[ipart+0*nparts] = deltax;
-        ( *delta )[ipart+1*nparts] = deltay;
-        ( *delta )[ipart+2*nparts] = deltaz;
+        ( *iold )[ipart-ipart_ref+0*nparts]  = ip_;
+        ( *iold )[ipart-ipart_ref+1*nparts]  = jp_;
+        ( *iold )[ipart-ipart_ref+2*nparts]  = kp_;
+        ( *delta )[ipart-ipart_ref+0*nparts] = deltax;
+        ( *delta )[ipart-ipart_ref+1*nparts] = deltay;
+        ( *delta )[ipart-ipart_ref+2*nparts] = deltaz;
     }
     
 }
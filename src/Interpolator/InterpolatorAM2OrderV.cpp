@@ -0,0 +1,307 @@
+#include "InterpolatorAM2OrderV.h"
+
+#include <cmath>
+#include <iostream>
+#include <complex>
+
+#include "ElectroMagn.h"
+#include "ElectroMagnAM.h"
+#include "cField2D.h"
+#include "Particles.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Creator for InterpolatorAM2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+InterpolatorAM2OrderV::InterpolatorAM2OrderV( Params &params, Patch *patch ) : InterpolatorAM( params, patch )
+{
+
+    dl_inv_ = 1.0/params.cell_length[0];
+    dr_inv_ = 1.0/params.cell_length[1];
+    nmodes = params.nmodes;
+    dr =  params.cell_length[1];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 2nd Order Interpolation of the fields of all modes for the particles of a cell, by packs of 32 particles
+// ---------------------------------------------------------------------------------------------------------------------
+void InterpolatorAM2OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref )
+{
+    if( istart[0] == iend[0] ) {
+        return;    //Don't treat empty cells.
+    }
+    
+    int nparts( ( smpi->dynamics_invgf[ithread] ).size() );
+    
+    double *Epart[3], *Bpart[3];
+    
+    double *deltaO[2];
+    deltaO[0] = &( smpi->dynamics_deltaold[ithread][0] );
+    deltaO[1] = &( smpi->dynamics_deltaold[ithread][nparts] );
+    complex<double> *eitheta_old = &( smpi->dynamics_thetaold[ithread][0] );
+    
+    for( unsigned int k=0; k<3; k++ ) {
+        Epart[k]= &( smpi->dynamics_Epart[ithread][k*nparts] );
+        Bpart[k]= &( smpi->dynamics_Bpart[ithread][k*nparts] );
+    }
+    
+    ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
+    
+    double D_inv[2];
+    D_inv[0] = dl_inv_;
+    D_inv[1] = dr_inv_;
+    
+    int idx[2], idxO[2];
+    //Primal indices are constant over the all cell
+    double r0 = sqrt( particles.position( 1, *istart )*particles.position( 1, *istart ) + particles.position( 2, *istart )*particles.position( 2, *istart ) );
+    idx[0]  = round( particles.position( 0, *istart ) * D_inv[0] );
+    idxO[0] = idx[0] - i_domain_begin -1 ;
+    idx[1]  = round( r0 * D_inv[1] );
+    idxO[1] = idx[1] - j_domain_begin -1 ;
+    
+    double coeff[2][2][3][32];
+    int dual[2][32]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
+    
+    // exp(-i theta) and exp(-i m theta) of the particles (real and imaginary parts)
+    double exp_m_theta[2][32], exp_mm_theta[2][32];
+    // El, Er, Et, Bl, Br, Bt summed over the modes
+    double field_buffer[6][32];
+    
+    int vecSize = 32;
+    
+    int cell_nparts( ( int )iend[0]-( int )istart[0] );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+        
+            double yp = particles.position( 1, ipart+ivect+istart[0] );
+            double zp = particles.position( 2, ipart+ivect+istart[0] );
+            double rp = sqrt( yp*yp+zp*zp );
+            
+            double pos[2];
+            pos[0] = particles.position( 0, ipart+ivect+istart[0] );
+            pos[1] = rp;
+            
+            double delta0, delta;
+            double delta2;
+            
+            for( int i=0; i<2; i++ ) { // for L/R
+                delta0 = pos[i]*D_inv[i];
+                dual [i][ipart] = ( delta0 - ( double )idx[i] >=0. );
+                
+                for( int j=0; j<2; j++ ) { // for dual
+                
+                    delta   = delta0 - ( double )idx[i] + ( double )j*( 0.5-dual[i][ipart] );
+                    delta2  = delta*delta;
+                    
+                    coeff[i][j][0][ipart]    =  0.5 * ( delta2-delta+0.25 );
+                    coeff[i][j][1][ipart]    = ( 0.75 - delta2 );
+                    coeff[i][j][2][ipart]    =  0.5 * ( delta2+delta+0.25 );
+                    
+                    if( j==0 ) {
+                        deltaO[i][ipart-ipart_ref+ivect+istart[0]] = delta;
+                    }
+                }
+            }
+            
+            exp_m_theta[0][ipart] =  yp/rp;
+            exp_m_theta[1][ipart] = -zp/rp;
+            eitheta_old[ipart-ipart_ref+ivect+istart[0]] = complex<double>( exp_m_theta[0][ipart], exp_m_theta[1][ipart] );
+            exp_mm_theta[0][ipart] = 1.;
+            exp_mm_theta[1][ipart] = 0.;
+            
+            for( int k=0; k<6; k++ ) {
+                field_buffer[k][ipart] = 0.;
+            }
+        }
+        
+        for( unsigned int imode = 0; imode < nmodes ; imode++ ) {
+        
+            cField2D *El = emAM->El_[imode];
+            cField2D *Er = emAM->Er_[imode];
+            cField2D *Et = emAM->Et_[imode];
+            cField2D *Bl = emAM->Bl_m[imode];
+            cField2D *Br = emAM->Br_m[imode];
+            cField2D *Bt = emAM->Bt_m[imode];
+            
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            
+                // exp(-i m theta), mode 0 is real
+                if( imode > 0 ) {
+                    double tmp = exp_mm_theta[0][ipart]*exp_m_theta[0][ipart] - exp_mm_theta[1][ipart]*exp_m_theta[1][ipart];
+                    exp_mm_theta[1][ipart] = exp_mm_theta[0][ipart]*exp_m_theta[1][ipart] + exp_mm_theta[1][ipart]*exp_m_theta[0][ipart];
+                    exp_mm_theta[0][ipart] = tmp;
+                }
+                double c_re = exp_mm_theta[0][ipart];
+                double c_im = exp_mm_theta[1][ipart];
+                
+                double *coeffrp = &( coeff[1][0][1][ipart] );
+                double *coeffrd = &( coeff[1][1][1][ipart] );
+                double *coeffld = &( coeff[0][1][1][ipart] );
+                double *coefflp = &( coeff[0][0][1][ipart] );
+                
+                double interp_re, interp_im;
+                
+                //El(dual, primal)
+                compute( coeffld, coeffrp, 32, dual[0][ipart], 0, El, idxO[0], idxO[1], &interp_re, &interp_im );
+                field_buffer[0][ipart] += interp_re*c_re - interp_im*c_im;
+                //Er(primal, dual)
+                compute( coefflp, coeffrd, 32, 0, dual[1][ipart], Er, idxO[0], idxO[1], &interp_re, &interp_im );
+                field_buffer[1][ipart] += interp_re*c_re - interp_im*c_im;
+                //Et(primal, primal)
+                compute( coefflp, coeffrp, 32, 0, 0, Et, idxO[0], idxO[1], &interp_re, &interp_im );
+                field_buffer[2][ipart] += interp_re*c_re - interp_im*c_im;
+                //Bl(primal, dual)
+                compute( coefflp, coeffrd, 32, 0, dual[1][ipart], Bl, idxO[0], idxO[1], &interp_re, &interp_im );
+                field_buffer[3][ipart] += interp_re*c_re - interp_im*c_im;
+                //Br(dual, primal)
+                compute( coeffld, coeffrp, 32, dual[0][ipart], 0, Br, idxO[0], idxO[1], &interp_re, &interp_im );
+                field_buffer[4][ipart] += interp_re*c_re - interp_im*c_im;
+                //Bt(dual, dual)
+                compute( coeffld, coeffrd, 32, dual[0][ipart], dual[1][ipart], Bt, idxO[0], idxO[1], &interp_re, &interp_im );
+                field_buffer[5][ipart] += interp_re*c_re - interp_im*c_im;
+            }
+        }
+        
+        //Translate the fields into the cartesian y,z coordinates
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            double c = exp_m_theta[0][ipart];
+            double s = exp_m_theta[1][ipart];
+            Epart[0][ipart-ipart_ref+ivect+istart[0]] = field_buffer[0][ipart];
+            Epart[1][ipart-ipart_ref+ivect+istart[0]] =  c*field_buffer[1][ipart] + s*field_buffer[2][ipart];
+            Epart[2][ipart-ipart_ref+ivect+istart[0]] = -s*field_buffer[1][ipart] + c*field_buffer[2][ipart];
+            Bpart[0][ipart-ipart_ref+ivect+istart[0]] = field_buffer[3][ipart];
+            Bpart[1][ipart-ipart_ref+ivect+istart[0]] =  c*field_buffer[4][ipart] + s*field_buffer[5][ipart];
+            Bpart[2][ipart-ipart_ref+ivect+istart[0]] = -s*field_buffer[4][ipart] + c*field_buffer[5][ipart];
+        }
+    }
+
+} // END InterpolatorAM2OrderV
+
+
+void InterpolatorAM2OrderV::fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc )
+{
+    // iend not used for now
+    // probes are interpolated one by one for now
+    
+    int ipart = *istart;
+    int nparts( particles.size() );
+    
+    double *Epart[3], *Bpart[3];
+    
+    for( unsigned int k=0; k<3; k++ ) {
+        Epart[k]= &( smpi->dynamics_Epart[ithread][k*nparts] );
+        Bpart[k]= &( smpi->dynamics_Bpart[ithread][k*nparts] );
+    }
+    
+    ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
+    
+    double D_inv[2];
+    D_inv[0] = dl_inv_;
+    D_inv[1] = dr_inv_;
+    
+    double yp = particles.position( 1, ipart );
+    double zp = particles.position( 2, ipart );
+    double rp = sqrt( yp*yp+zp*zp );
+    double pos[2];
+    pos[0] = particles.position( 0, ipart );
+    pos[1] = rp;
+    
+    int idx[2], idxO[2];
+    double coeff[2][2][3];
+    int dual[2]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
+    
+    double delta0, delta;
+    double delta2;
+    
+    for( int i=0; i<2; i++ ) { // for L/R
+        delta0 = pos[i]*D_inv[i];
+        idx[i] = round( delta0 );
+        dual [i] = ( delta0 - ( double )idx[i] >=0. );
+        
+        for( int j=0; j<2; j++ ) { // for dual
+        
+            delta   = delta0 - ( double )idx[i] + ( double )j*( 0.5-dual[i] );
+            delta2  = delta*delta;
+            
+            coeff[i][j][0]    =  0.5 * ( delta2-delta+0.25 );
+            coeff[i][j][1]    = ( 0.75 - delta2 );
+            coeff[i][j][2]    =  0.5 * ( delta2+delta+0.25 );
+        }
+    }
+    idxO[0] = idx[0] - i_domain_begin -1 ;
+    idxO[1] = idx[1] - j_domain_begin -1 ;
+    
+    double *coeffrp = &( coeff[1][0][1] );
+    double *coeffrd = &( coeff[1][1][1] );
+    double *coeffld = &( coeff[0][1][1] );
+    double *coefflp = &( coeff[0][0][1] );
+    
+    // exp(-i theta) and exp(-i m theta)
+    complex<double> exp_m_theta( yp/rp, -zp/rp );
+    complex<double> exp_mm_theta = 1.;
+    
+    double field[10];
+    for( int k=0; k<10; k++ ) {
+        field[k] = 0.;
+    }
+    
+    for( unsigned int imode = 0; imode < nmodes ; imode++ ) {
+        if( imode > 0 ) {
+            exp_mm_theta *= exp_m_theta;
+        }
+        
+        // El, Er, Et, Bl, Br, Bt, Jl, Jr, Jt, Rho
+        cField2D *fields[10] = { emAM->El_[imode], emAM->Er_[imode], emAM->Et_[imode],
+                                 emAM->Bl_m[imode], emAM->Br_m[imode], emAM->Bt_m[imode],
+                                 emAM->Jl_[imode], emAM->Jr_[imode], emAM->Jt_[imode], emAM->rho_AM_[imode]
+                               };
+        double *coeffl[10] = { coeffld, coefflp, coefflp, coefflp, coeffld, coeffld, coeffld, coefflp, coefflp, coefflp };
+        double *coeffr[10] = { coeffrp, coeffrd, coeffrp, coeffrd, coeffrp, coeffrd, coeffrp, coeffrd, coeffrp, coeffrp };
+        int dualx[10] = { dual[0], 0, 0, 0, dual[0], dual[0], dual[0], 0, 0, 0 };
+        int dualr[10] = { 0, dual[1], 0, dual[1], 0, dual[1], 0, dual[1], 0, 0 };
+        
+        for( int k=0; k<10; k++ ) {
+            double interp_re, interp_im;
+            compute( coeffl[k], coeffr[k], 1, dualx[k], dualr[k], fields[k], idxO[0], idxO[1], &interp_re, &interp_im );
+            field[k] += interp_re*std::real( exp_mm_theta ) - interp_im*std::imag( exp_mm_theta );
+        }
+    }
+    
+    //Translate the vectors into the cartesian y,z coordinates
+    double c = std::real( exp_m_theta );
+    double s = std::imag( exp_m_theta );
+    Epart[0][ipart] = field[0];
+    Epart[1][ipart] =  c*field[1] + s*field[2];
+    Epart[2][ipart] = -s*field[1] + c*field[2];
+    Bpart[0][ipart] = field[3];
+    Bpart[1][ipart] =  c*field[4] + s*field[5];
+    Bpart[2][ipart] = -s*field[4] + c*field[5];
+    JLoc->x =  field[6];
+    JLoc->y =  c*field[7] + s*field[8];
+    JLoc->z = -s*field[7] + c*field[8];
+    ( *RhoLoc ) = field[9];
+
+}
+
+
+// Interpolator on another field than the basic ones
+void InterpolatorAM2OrderV::oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc )
+{
+    ERROR( "Single field AM2O interpolator not available in vectorized mode" );
+}
+
+
+// Interpolator specific to tracked particles. A selection of particles may be provided
+void InterpolatorAM2OrderV::fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, vector<unsigned int> *selection )
+{
+    ERROR( "To Do" );
+}
@@ -0,0 +1,49 @@
+#ifndef INTERPOLATORAM2ORDERV_H
+#define INTERPOLATORAM2ORDERV_H
+
+
+#include "InterpolatorAM.h"
+#include "cField2D.h"
+
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class for vectorized 2nd order interpolator for AM simulations (particles sorted per cell)
+//  --------------------------------------------------------------------------------------------------------------------
+class InterpolatorAM2OrderV : public InterpolatorAM
+{
+
+public:
+    InterpolatorAM2OrderV( Params &, Patch * );
+    ~InterpolatorAM2OrderV() override final {};
+    
+    void fieldsAndCurrents( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, LocalFields *JLoc, double *RhoLoc ) override final ;
+    void fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int ipart_ref = 0 ) override final ;
+    void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
+    void oneField( Field *field, Particles &particles, int *istart, int *iend, double *FieldLoc ) override final;
+    
+    //! Real and imaginary parts of one mode of f at the particle position
+    //! coeffx/coeffr point to the central coefficient, stride is the distance between 2 coefficients of a particle
+    //! dualx/dualr (0 or 1) shift the stencil of the dual directions, idx/idr are the primal indices of the cell minus 1
+    inline void compute( double *coeffx, double *coeffr, int stride, int dualx, int dualr, cField2D *f, int idx, int idr, double *interp_re, double *interp_im )
+    {
+        double re( 0. ), im( 0. );
+        for( int iloc=-1 ; iloc<2 ; iloc++ ) {
+            for( int jloc=-1 ; jloc<2 ; jloc++ ) {
+                double c = *( coeffx+iloc*stride ) * *( coeffr+jloc*stride );
+                std::complex<double> val = ( double )( 1-dualr ) * ( ( double )( 1-dualx )*( *f )( idx+1+iloc, idr+1+jloc ) + ( double )dualx*( *f )( idx+2+iloc, idr+1+jloc ) )
+                                           + ( double )dualr  * ( ( double )( 1-dualx )*( *f )( idx+1+iloc, idr+2+jloc ) + ( double )dualx*( *f )( idx+2+iloc, idr+2+jloc ) );
+                re += c * std::real( val );
+                im += c * std::imag( val );
+            }
+        }
+        *interp_re = re;
+        *interp_im = im;
+    };
+
+private:
+    //! Number of modes;
+    unsigned int nmodes;
+
+};//END class
+
+#endif
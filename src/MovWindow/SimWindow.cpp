@@ -72,6 +72,9 @@ SimWindow::SimWindow( Params &params )
 
 SimWindow::~SimWindow()
 {
+    for( unsigned int i=0; i<patch_pool_.size(); i++ ) {
+        delete patch_pool_[i];
+    }
 }
 
 bool SimWindow::isMoving( double time_dual )
@@ -79,6 +82,75 @@ bool SimWindow::isMoving( double time_dual )
     return active && ( ( time_dual - time_start )*velocity_x > x_moved );
 }
 
+void SimWindow::fillPatch( Patch *mypatch, Params &params, unsigned int itime )
+{
+    mypatch->rand_->setStream( mypatch->hindex, Random::creation, itime, 0 );
+    for( unsigned int ispec=0 ; ispec<mypatch->vecSpecies.size() ; ispec++ ) {
+        mypatch->vecSpecies[ispec]->createParticles( params.n_space, params, mypatch, 0 );
+                            /*#ifdef _VECTO
+                                                    // Classical vectorized mode
+                                                    if (params.vectorization_mode == "on")
+                                                    {
+                                                        if ( dynamic_cast<SpeciesV*>(mypatch->vecSpecies[ispec]) )
+                                                            dynamic_cast<SpeciesV*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
+                                                        mypatch->vecSpecies[ispec]->sort_part(params);
+                                                    }
+                                                    // First adaptive vectorization mode
+                                                    else if (params.vectorization_mode == "adaptive_mixed_sort")
+                                                    {
+                                                        if ( dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec]) )
+                                                        {
+                                                            dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec])->configuration(params, mypatch);
+                                                        }
+                                                    }
+                                                    // Second adaptive vectorization mode
+                                                    else if (params.vectorization_mode == "adaptive")
+                                                    {
+                                                        if ( dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec]) )
+                                                            dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
+                                                        mypatch->vecSpecies[ispec]->sort_part(params);
+                                                    }
+                                                }
+                            #endif
+                                                // We define the IDs of the new particles
+                                                for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ )
+                                                    if( DiagnosticTrack* track = dynamic_cast<DiagnosticTrack*>(vecPatches.localDiags[idiag]) )
+                                                        track->setIDs( mypatch );
+                            #ifdef _VECTO
+                                            }
+                                            // Patches that have received particles from another patch
+                                            // without the creation of new particles
+                                            else // (patch_particle_created[ithread][j] == false)
+                                            {
+                                                for (unsigned int ispec=0 ; ispec<nSpecies ; ispec++)
+                                                {
+                                                    // For the adaptive vectorization, we partially reconfigure the patch
+                                                    // We do not have to sort, but operators may have to be reconfigured
+                                                    // First adaptive vectorization mode:
+                                                    if (params.vectorization_mode == "adaptive_mixed_sort") {
+                                                        if ( dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec]) )
+                                                        {
+                                                            dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
+                                                            dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec])->reconfigure_operators(params, mypatch);
+                                                        }
+                                                    }
+                                                    // Second adaptive vectorization mode:
+                                                    else if (params.vectorization_mode == "adaptive")
+                                                    {
+                                                        if ( dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec]) )
+                                                        {
+                                                            dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
+                                                        }
+                                                    }
+                            #endif*/
+    }
+    
+    mypatch->EMfields->applyExternalFields( mypatch );
+    if( params.save_magnectic_fields_for_SM ) {
+        mypatch->EMfields->saveExternalFields( mypatch );
+    }
+}
+
 void SimWindow::operate( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params, unsigned int itime, double time_dual )
 {
     if( ! isMoving( time_dual ) ) {
@@ -189,13 +261,49 @@ void SimWindow::operate( VectorPatch &vecPatches, SmileiMPI *smpi, Params &param
         // At this point, all isends have been done and the list of patches to delete at the end is complete.
         // The lists of patches to create and patches to update is also complete.
         
+        // Probe points depend only on the position in the box: each patch which became its left neighbor
+        // takes over the points of this neighbor, and the patches leaving the box keep the remaining ones
+#ifndef _NO_MPI_TM
+        #pragma omp single
+#endif
+        if( vecPatches( 0 )->probes.size() > 0 ) {
+            std::vector<std::vector<ProbeParticles *> > old_probes( nPatches );
+            for( unsigned int ipatch = 0 ; ipatch < nPatches ; ipatch++ ) {
+                old_probes[ipatch].swap( vecPatches_old[ipatch]->probes );
+            }
+            for( unsigned int ipatch = 0 ; ipatch < nPatches ; ipatch++ ) {
+                mypatch = vecPatches_old[ipatch];
+                if( mypatch->MPI_neighbor_[0][0] == mypatch->MPI_me_ ) {
+                    mypatch->probes.swap( old_probes[mypatch->hindex - h0] );
+                }
+            }
+            unsigned int iold = 0;
+            for( unsigned int ipatch = 0 ; ipatch < nPatches ; ipatch++ ) {
+                mypatch = vecPatches_old[ipatch];
+                if( mypatch->MPI_neighbor_[0][0] != mypatch->MPI_me_ ) {
+                    while( old_probes[iold].empty() ) {
+                        iold++;
+                    }
+                    mypatch->probes.swap( old_probes[iold] );
+                }
+            }
+        }
+        
         //Creation of new Patches
         for( unsigned int j = 0; j < patch_to_be_created[my_thread].size();  j++ ) {
-            //create patch without particle.
+            //create patch without particle, recycling a patch which left the domain if possible
 #ifndef _NO_MPI_TM
             #pragma omp critical
 #endif
-            mypatch = PatchesFactory::clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved, false );
+            {
+                if( patch_pool_.size() > 0 ) {
+                    mypatch = patch_pool_.back();
+                    patch_pool_.pop_back();
+                    mypatch->recycle( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved );
+                } else {
+                    mypatch = PatchesFactory::clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, h0 + patch_to_be_created[my_thread][j], n_moved, false );
+                }
+            }
             
             // Do not receive Xmin condition
             if( mypatch->isXmin() && mypatch->EMfields->emBoundCond[0] ) {
@@ -248,6 +356,10 @@ void SimWindow::operate( VectorPatch &vecPatches, SmileiMPI *smpi, Params &param
                 mypatch->neighbor_[idim][0] = mypatch->tmp_neighbor_[idim][0];
                 mypatch->neighbor_[idim][1] = mypatch->tmp_neighbor_[idim][1];
             }
+            if( params.geometry != "AMcylindrical" ) {
+                mypatch->initAllNeighbors( params, vecPatches.domain_decomposition_ );
+                mypatch->updateMPIenv( smpi );
+            }
             
             mypatch->updateTagenv( smpi );
             if( mypatch->isXmin() ) {
@@ -296,86 +408,52 @@ void SimWindow::operate( VectorPatch &vecPatches, SmileiMPI *smpi, Params &param
         
         //Fill necessary patches with particles
 #ifndef _NO_MPI_TM
-        #pragma omp master
+        #pragma omp single
 #endif
         {
+            // Patches kept from the previous move and not recycled
+            for( unsigned int i=0; i<patch_pool_.size(); i++ ) {
+                delete patch_pool_[i];
+            }
+            patch_pool_.clear();
+            
+            patches_to_fill_.clear();
             for( int ithread=0; ithread < max_threads ; ithread++ ) {
                 for( unsigned int j=0; j< ( patch_to_be_created[ithread] ).size(); j++ ) {
-                
-                    // Current newly created patch
-                    mypatch = vecPatches.patches_[patch_to_be_created[ithread][j]];
-                    
                     // If new particles are required
                     if( patch_particle_created[ithread][j] ) {
-                        for( unsigned int ispec=0 ; ispec<nSpecies ; ispec++ ) {
-                            mypatch->vecSpecies[ispec]->createParticles( params.n_space, params, mypatch, 0 );
-                            /*#ifdef _VECTO
-                                                    // Classical vectorized mode
-                                                    if (params.vectorization_mode == "on")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesV*>(mypatch->vecSpecies[ispec]) )
-                                                            dynamic_cast<SpeciesV*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
-                                                        mypatch->vecSpecies[ispec]->sort_part(params);
-                                                    }
-                                                    // First adaptive vectorization mode
-                                                    else if (params.vectorization_mode == "adaptive_mixed_sort")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec]) )
-                                                        {
-                                                            dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec])->configuration(params, mypatch);
-                                                        }
-                                                    }
-                                                    // Second adaptive vectorization mode
-                                                    else if (params.vectorization_mode == "adaptive")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec]) )
-                                                            dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
-                                                        mypatch->vecSpecies[ispec]->sort_part(params);
-                                                    }
-                                                }
-                            #endif
-                                                // We define the IDs of the new particles
-                                                for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ )
-                                                    if( DiagnosticTrack* track = dynamic_cast<DiagnosticTrack*>(vecPatches.localDiags[idiag]) )
-                                                        track->setIDs( mypatch );
-                            #ifdef _VECTO
-                                            }
-                                            // Patches that have received particles from another patch
-                                            // without the creation of new particles
-                                            else // (patch_particle_created[ithread][j] == false)
-                                            {
-                                                for (unsigned int ispec=0 ; ispec<nSpecies ; ispec++)
-                                                {
-                                                    // For the adaptive vectorization, we partially reconfigure the patch
-                                                    // We do not have to sort, but operators may have to be reconfigured
-                                                    // First adaptive vectorization mode:
-                                                    if (params.vectorization_mode == "adaptive_mixed_sort") {
-                                                        if ( dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec]) )
-                                                        {
-                                                            dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
-                                                            dynamic_cast<SpeciesAdaptiveV*>(mypatch->vecSpecies[ispec])->reconfigure_operators(params, mypatch);
-                                                        }
-                                                    }
-                                                    // Second adaptive vectorization mode:
-                                                    else if (params.vectorization_mode == "adaptive")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec]) )
-                                                        {
-                                                            dynamic_cast<SpeciesAdaptiveV2*>(mypatch->vecSpecies[ispec])->compute_part_cell_keys(params);
-                                                        }
-                                                    }
-                            #endif*/
-                        }
-                        
-                        mypatch->EMfields->applyExternalFields( mypatch );
-                        if( params.save_magnectic_fields_for_SM ) {
-                            mypatch->EMfields->saveExternalFields( mypatch );
-                        }
-                        
-                    } // end test patch_particle_created[ithread][j]
-                } // end j loop
-            } // End ithread loop
-        } // End omp master region
+                        patches_to_fill_.push_back( vecPatches.patches_[patch_to_be_created[ithread][j]] );
+                    }
+                }
+            }
+            // Profiles evaluated by python can only be used by one thread
+            fill_with_python_ = false;
+            if( patches_to_fill_.size() > 0 ) {
+                mypatch = patches_to_fill_[0];
+                for( unsigned int ispec=0 ; ispec<nSpecies ; ispec++ ) {
+                    fill_with_python_ = fill_with_python_ || mypatch->vecSpecies[ispec]->profilesUsePython();
+                }
+                for( unsigned int i=0; i<mypatch->EMfields->extFields.size(); i++ ) {
+                    fill_with_python_ = fill_with_python_ || mypatch->EMfields->extFields[i].profile->usesPython();
+                }
+            }
+        }
+        
+        if( fill_with_python_ ) {
+#ifndef _NO_MPI_TM
+            #pragma omp master
+#endif
+            for( unsigned int i=0; i<patches_to_fill_.size(); i++ ) {
+                fillPatch( patches_to_fill_[i], params, itime );
+            }
+        } else {
+#ifndef _NO_MPI_TM
+            #pragma omp for schedule(dynamic)
+#endif
+            for( unsigned int i=0; i<patches_to_fill_.size(); i++ ) {
+                fillPatch( patches_to_fill_[i], params, itime );
+            }
+        }
 #ifndef _NO_MPI_TM
         #pragma omp barrier
 #endif
@@ -511,7 +589,7 @@ void SimWindow::operate( VectorPatch &vecPatches, SmileiMPI *smpi, Params &param
         poynting[0].resize( params.nDim_field, 0.0 );
         poynting[1].resize( params.nDim_field, 0.0 );
         
-        //Delete useless patches
+        //Keep useless patches, to be recycled at the next move
         for( unsigned int j=0; j < delete_patches_.size(); j++ ) {
             mypatch = delete_patches_[j];
             
@@ -527,7 +605,10 @@ void SimWindow::operate( VectorPatch &vecPatches, SmileiMPI *smpi, Params &param
                 }
                 
                 
-            delete  mypatch;
+#ifndef _NO_MPI_TM
+            #pragma omp critical
+#endif
+            patch_pool_.push_back( mypatch );
         }
         
         // SUM energy_field_lost, energy_part_lost and poynting / All threads
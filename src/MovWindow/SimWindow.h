@@ -39,6 +39,9 @@ public:
     //! call isMoving AFTER operate because the returned result might not be the expected one.
     bool isMoving( double time_dual );
     
+    //! Create the particles of a new patch, and apply the external fields
+    void fillPatch( Patch *mypatch, Params &params, unsigned int itime );
+    
     //! Return total length the window has moved
     double getXmoved()
     {
@@ -81,6 +84,13 @@ private:
     std::vector< std::vector<unsigned int>> patch_to_be_created;
     //! Keep track of patches that receive particles
     std::vector< std::vector<bool>> patch_particle_created;
+    //! Patches that need new particles (all threads)
+    std::vector<Patch *> patches_to_fill_;
+    //! Whether the new particles are created using python
+    bool fill_with_python_;
+    //! Patches which left the domain at the previous move (they are still being sent when the new patches are created),
+    //! recycled as new patches at the next move
+    std::vector<Patch *> patch_pool_;
     //! Max number of threads
     int max_threads;
     
@@ -74,7 +74,7 @@ void MultiphotonBreitWheeler::compute_thread_chiph( Particles &particles,
     double gamma;
     
     // Momentum shortcut
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -126,6 +126,7 @@ void MultiphotonBreitWheeler::compute_thread_chiph( Particles &particles,
 void MultiphotonBreitWheeler::operator()( Particles &particles,
         SmileiMPI *smpi,
         MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+        Random *rand,
         int istart,
         int iend,
         int ithread, int ipart_ref )
@@ -152,7 +153,7 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
     double event_time;
     
     // Momentum shortcut
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -216,7 +217,7 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
             if( tau[ipart] <= epsilon_tau_ ) {
                 // New final optical depth to reach for emision
                 while( tau[ipart] <= epsilon_tau_ ) {
-                    tau[ipart] = -log( 1.-Rand::uniform() );
+                    tau[ipart] = -log( 1.-rand->uniform() );
                 }
                 
             }
@@ -256,7 +257,7 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
                                                             particles,
                                                             ( *gamma )[ipart],
                                                             dt - event_time,
-                                                            MultiphotonBreitWheelerTables );
+                                                            MultiphotonBreitWheelerTables, rand );
                                                             
                                                             
                     // Optical depth becomes negative meaning
@@ -280,12 +281,14 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
 //! \param MultiphotonBreitWheelerTables    Cross-section data tables
 //!                       and useful functions
 //!                       for the multiphoton Breit-Wheeler process
+//! \param rand               Random number generator of the patch
 // -----------------------------------------------------------------------------
 void MultiphotonBreitWheeler::pair_emission( int ipart,
         Particles &particles,
         double &gammaph,
         double remaining_dt,
-        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables )
+        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+        Random *rand )
 {
 
     // _______________________________________________
@@ -305,7 +308,7 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     inv_chiph_gammaph = ( gammaph-2. )/particles.chi( ipart );
     
     // Get the pair quantum parameters to compute the energy
-    chi = MultiphotonBreitWheelerTables.compute_pair_chi( particles.chi( ipart ) );
+    chi = MultiphotonBreitWheelerTables.compute_pair_chi( particles.chi( ipart ), rand );
     
     // pair propagation direction // direction of the photon
     for( k = 0 ; k<3 ; k++ ) {
@@ -342,13 +345,6 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
 //               + new_pair[k].momentum(i,idNew)*remaining_dt*inv_gamma;
             }
             
-            // Old positions
-#ifdef  __DEBUG
-            for( i=0; i<n_dimensions_; i++ ) {
-                new_pair[k].position_old( i, idNew )=particles.position( i, ipart ) ;
-            }
-#endif
-            
             new_pair[k].weight( idNew )=particles.weight( ipart )*mBW_pair_creation_inv_sampling[k];
             new_pair[k].charge( idNew )= k*2-1;
             
@@ -41,6 +41,7 @@ public:
     void operator()( Particles &particles,
                      SmileiMPI *smpi,
                      MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                     Random *rand,
                      int istart,
                      int iend,
                      int ithread, int ipart_ref = 0 );
@@ -58,7 +59,7 @@ public:
     //! \param By y component of the particle magnetic field
     //! \param Bz z component of the particle magnetic field
     //#pragma omp declare simd
-    double inline compute_chiph( double &kx, double &ky, double &kz,
+    double inline compute_chiph( double kx, double ky, double kz,
                                  double &gamma,
                                  double &Ex, double &Ey, double &Ez,
                                  double &Bx, double &By, double &Bz )
@@ -97,7 +98,8 @@ public:
                         Particles &particles,
                         double &gammaph,
                         double remaining_dt,
-                        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables );
+                        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                        Random *rand );
                         
     //! Clean photons that decayed into pairs (weight <= 0)
     //! \param particles   particle object containing the particle
@@ -239,7 +239,7 @@ double MultiphotonBreitWheelerTables::compute_integration_Ritus_dTdchi( double p
 //
 //! \param photon_chi photon quantum parameter
 // -----------------------------------------------------------------------------
-double *MultiphotonBreitWheelerTables::compute_pair_chi( double photon_chi )
+double *MultiphotonBreitWheelerTables::compute_pair_chi( double photon_chi, Random *rand )
 {
     // Parameters
     double *chi = new double[2];
@@ -277,7 +277,7 @@ double *MultiphotonBreitWheelerTables::compute_pair_chi( double photon_chi )
     // ---------------------------------------
     
     // First, we compute a random xip in [0,1[
-    xip = Rand::uniform();
+    xip = rand->uniform();
     
     // The array uses the symmetric properties of the T fonction,
     // Cases xip > or <= 0.5 are treated seperatly
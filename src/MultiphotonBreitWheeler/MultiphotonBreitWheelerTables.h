@@ -20,6 +20,7 @@
 
 #include "Params.h"
 #include "H5.h"
+#include "Random.h"
 #include "userFunctions.h"
 
 //------------------------------------------------------------------------------
@@ -80,7 +81,7 @@ public:
     //! Computation of the electron and positron quantum parameters for
     //! the multiphoton Breit-Wheeler pair creation
     //! \param photon_chi photon quantum parameter
-    double *compute_pair_chi( double photon_chi );
+    double *compute_pair_chi( double photon_chi, Random *rand );
     
     // ---------------------------------------------------------------------
     // TABLE COMPUTATION
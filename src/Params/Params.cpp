@@ -2,6 +2,7 @@
 #include <cmath>
 #include <ctime>
 #include <iomanip>
+#include <random>
 
 #define SMILEI_IMPORT_ARRAY
 
@@ -19,35 +20,6 @@
 
 using namespace std;
 
-namespace Rand
-{
-std::random_device device;
-std::mt19937 gen( device() );
-
-std::uniform_real_distribution<double> uniform_distribution( 0., 1. );
-double uniform()
-{
-    return uniform_distribution( gen );
-}
-
-std::uniform_real_distribution<double> uniform_distribution1( 0., 1.-1e-11 );
-double uniform1()
-{
-    return uniform_distribution1( gen );
-}
-
-std::uniform_real_distribution<double> uniform_distribution2( -1., 1. );
-double uniform2()
-{
-    return uniform_distribution2( gen );
-}
-double normal( double stddev )
-{
-    std::normal_distribution<double> normal_distribution( 0., stddev );
-    return normal_distribution( gen );
-}
-}
-
 #define DO_EXPAND(VAL)  VAL ## 1
 #define EXPAND(VAL)     DO_EXPAND(VAL)
 #ifdef SMILEI_USE_NUMPY
@@ -197,13 +169,11 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         }
     }
     
-    // random seed
-    if( PyTools::extract( "random_seed", random_seed, "Main" ) ) {
-        // Init of the seed for the vectorized C++ random generator recommended by Intel
-        // See https://software.intel.com/en-us/articles/random-number-function-vectorization
-        srand48( random_seed );
-        // Init of the seed for the C++ random generator
-        Rand::gen = std::mt19937( random_seed );
+    // random seed (the same for all processes: the generators of the patches are keyed by their hindex)
+    if( ! PyTools::extract( "random_seed", random_seed, "Main" ) ) {
+        std::random_device device;
+        random_seed = device();
+        MPI_Bcast( &random_seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD );
     }
     
     // communication pattern initialized as partial B exchange
@@ -393,6 +363,13 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "solve_poisson", solve_poisson, "Main" );
     PyTools::extract( "poisson_max_iteration", poisson_max_iteration, "Main" );
     PyTools::extract( "poisson_max_error", poisson_max_error, "Main" );
+    PyTools::extract( "poisson_preconditioner", poisson_preconditioner, "Main" );
+    if( poisson_preconditioner != "none" && poisson_preconditioner != "multigrid" ) {
+        ERROR( "Main.poisson_preconditioner must be `none` or `multigrid`" );
+    }
+    if( poisson_preconditioner == "multigrid" && geometry == "AMcylindrical" ) {
+        ERROR( "Main.poisson_preconditioner = `multigrid` is not available in AMcylindrical geometry" );
+    }
     // Relativistic Poisson Solver
     PyTools::extract( "solve_relativistic_poisson", solve_relativistic_poisson, "Main" );
     PyTools::extract( "relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main" );
@@ -466,6 +443,12 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     // clrw
     PyTools::extract( "clrw", clrw, "Main" );
     
+    // Bound of the per-thread particle buffers
+    PyTools::extract( "particle_chunk_size", particle_chunk_size, "Main" );
+    if( particle_chunk_size < 0 ) {
+        ERROR( "Main.particle_chunk_size must be positive (or 0 to process whole patches)" );
+    }
+    
     
     
     // --------------------
@@ -511,6 +494,12 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         WARNING( "Use default distribution : " << patch_arrangement );
     }
     
+    PyTools::extract( "shared_memory_halos", shared_memory_halos, "Main" );
+    if( shared_memory_halos && geometry == "AMcylindrical" ) {
+        WARNING( "Main.shared_memory_halos is not available in AMcylindrical geometry: halos exchanged by MPI" );
+        shared_memory_halos = false;
+    }
+    
     
     int total_number_of_hilbert_patches = 1;
     if( patch_arrangement == "hilbertian" ) {
@@ -531,8 +520,15 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         PyTools::extract( "cell_load", cell_load, "LoadBalancing" );
         PyTools::extract( "frozen_particle_load", frozen_particle_load, "LoadBalancing" );
         PyTools::extract( "initial_balance", initial_balance, "LoadBalancing" );
+        PyTools::extract( "measured_load", measured_load, "LoadBalancing" );
+        PyTools::extract( "measured_load_smoothing", measured_load_smoothing, "LoadBalancing" );
+        if( measured_load_smoothing < 1 ) {
+            ERROR( "LoadBalancing.measured_load_smoothing must be at least 1" );
+        }
     } else {
         load_balancing_time_selection = new TimeSelection();
+        measured_load = false;
+        measured_load_smoothing = 1;
     }
     
     has_load_balancing = ( smpi->getSize()>1 )  && ( ! load_balancing_time_selection->isEmpty() );
@@ -626,6 +622,18 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         ERROR( "The parameter `Main.print_expected_disk_usage` must be True or False" );
     }
     
+    // Read the "async_diags" parameter
+    int ring_size = 0;
+    if( ! PyTools::extract( "async_diags", ring_size, "Main" ) || ring_size < 0 ) {
+        ERROR( "The parameter `Main.async_diags` must be a non-negative integer" );
+    }
+    async_diags = ring_size;
+    // The writer thread makes MPI calls (collective HDF5 writes)
+    if( async_diags > 0 && smpi->getThreadSupport() != MPI_THREAD_MULTIPLE ) {
+        WARNING( "`Main.async_diags` requires MPI_THREAD_MULTIPLE support: diagnostics will be written synchronously" );
+        async_diags = 0;
+    }
+    
     // -------------------------------------------------------
     // Checking species order
     // -------------------------------------------------------
@@ -912,12 +920,12 @@ void Params::check_consistency()
 {
     if( vectorization_mode != "off" ) {
     
-        if( ( geometry=="1Dcartesian" ) || ( geometry=="AMcylindrical" ) ) {
-            ERROR( "Vectorized algorithms not implemented for this geometry" );
+        if( ( geometry=="1Dcartesian" ) && ( interpolation_order==4 ) ) {
+            ERROR( "4th order vectorized algorithms not implemented in 1D" );
         }
         
-        if( ( geometry=="2Dcartesian" ) && ( interpolation_order==4 ) ) {
-            ERROR( "4th order vectorized algorithms not implemented in 2D" );
+        if( ( geometry=="AMcylindrical" ) && ( vectorization_mode != "on" ) ) {
+            ERROR( "Only the vectorization mode `on` is available in AMcylindrical geometry" );
         }
         
         
@@ -1005,10 +1013,16 @@ void Params::print_init()
         MESSAGE( 1, "Happens: " << load_balancing_time_selection->info() );
         MESSAGE( 1, "Cell load coefficient = " << cell_load );
         MESSAGE( 1, "Frozen particle load coefficient = " << frozen_particle_load );
+        if( measured_load ) {
+            MESSAGE( 1, "Particle load measured from patch timings, smoothed over " << measured_load_smoothing << " iterations" );
+        }
     }
     
     TITLE( "Vectorization: " );
     MESSAGE( 1, "Mode: " << vectorization_mode );
+    if( particle_chunk_size > 0 ) {
+        MESSAGE( 1, "Particles processed by chunks of at most " << particle_chunk_size << " particles" );
+    }
     if( vectorization_mode == "adaptive_mixed_sort" || vectorization_mode == "adaptive" ) {
         MESSAGE( 1, "Default mode: " << adaptive_default_mode );
         MESSAGE( 1, "Time selection: " << adaptive_vecto_time_selection->info() );
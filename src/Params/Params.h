@@ -26,30 +26,10 @@
 #include <ostream>
 #include <algorithm>
 #include <iterator>
-#include <random>
 
 class SmileiMPI;
 class Species;
 
-namespace Rand
-{
-extern std::random_device device;
-extern std::mt19937 gen;
-
-extern std::uniform_real_distribution<double> uniform_distribution;
-extern double uniform();
-
-extern std::uniform_real_distribution<double> uniform_distribution1;
-extern double uniform1();
-
-extern std::uniform_real_distribution<double> uniform_distribution2;
-extern double uniform2();
-
-extern std::normal_distribution<double> normal_distribution;
-extern double normal( double stddev );
-}
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 //! Params class: holds all the properties of the simulation that are read from the input file
 // ---------------------------------------------------------------------------------------------------------------------
@@ -145,6 +125,8 @@ public:
     unsigned int poisson_max_iteration;
     //! Maxium poisson error tolerated
     double poisson_max_error;
+    //! Preconditioner of the (relativistic) poisson solver: "none" or "multigrid"
+    std::string poisson_preconditioner;
     
     //"Relativistic" Poisson solver
     //! Do we solve "relativistic poisson problem" for relativistic species
@@ -175,6 +157,9 @@ public:
     //! Number of cells per cluster
     int n_cell_per_patch;
     
+    //! Maximum number of particles held in the per-thread dynamics buffers (0 = whole patch)
+    int particle_chunk_size;
+    
     //! initial number of particles
     unsigned int n_particles;
     
@@ -226,6 +211,8 @@ public:
     std::vector<unsigned int> number_of_patches;
     //! Domain decomposition
     std::string patch_arrangement;
+    //! Halos between MPI processes of the same node exchanged through a shared memory window
+    bool shared_memory_halos;
     
     //! Time selection for adaptive vectorization
     TimeSelection *adaptive_vecto_time_selection;
@@ -244,6 +231,10 @@ public:
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
     bool initial_balance;
+    //! Use the measured wall time of each patch instead of the particle count as load
+    bool measured_load;
+    //! Number of iterations over which the measured load is smoothed
+    unsigned int measured_load_smoothing;
     
     //! String containing the vectorization mode: off, on, adaptive, adaptive_mixed_sort
     std::string vectorization_mode;
@@ -294,6 +285,9 @@ public:
     //! Boolean for printing the expected disk usage or not
     bool print_expected_disk_usage;
     
+    //! Number of local diagnostics writes that can be staged for the background writer (0 for synchronous writes)
+    unsigned int async_diags;
+    
     //! Random seed
     unsigned int random_seed;
     
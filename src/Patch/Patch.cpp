@@ -22,8 +22,10 @@
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <complex>
 
 #include "Hilbert_functions.h"
+#include "DomainDecomposition.h"
 #include "PatchesFactory.h"
 #include "SpeciesFactory.h"
 #include "Particles.h"
@@ -31,6 +33,7 @@
 #include "ElectroMagnBC_Factory.h"
 #include "DiagnosticFactory.h"
 #include "CollisionsFactory.h"
+#include "BufferPool.h"
 
 using namespace std;
 
@@ -81,6 +84,10 @@ Patch::Patch( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition
 
 void Patch::initStep1( Params &params )
 {
+    // No load measured yet
+    load_timer_ = 0.;
+    measured_load_ = -1.;
+    
     // for nDim_fields = 1 : bug if Pcoordinates.size = 1 !!
     //Pcoordinates.resize(nDim_fields_);
     Pcoordinates.resize( 2 );
@@ -104,14 +111,9 @@ void Patch::initStep1( Params &params )
         oversize[iDim] = params.oversize[iDim];
     }
     
-    // Initialize the state of the random number generator
-    xorshift32_state = params.random_seed;
-    // Ensure that the random seed is different for each patch
-    xorshift32_state += rand();
-    // zero is not acceptable for xorshift
-    if( xorshift32_state==0 ) {
-        xorshift32_state = 1073741824;
-    }
+    // Random number generator, ready for the creation of the particles
+    rand_ = new Random( params.random_seed );
+    rand_->setStream( hindex, Random::creation, 0, 0 );
     
     // Obtain the cell_volume
     cell_volume = params.cell_volume;
@@ -132,7 +134,7 @@ void Patch::initStep3( Params &params, SmileiMPI *smpi, unsigned int n_moved )
     for( unsigned int i = 0 ; i<params.nDim_field ; i++ ) {
         min_local[i] = ( Pcoordinates[i] )*( params.n_space[i]*params.cell_length[i] );
         max_local[i] = ( ( Pcoordinates[i]+1 ) )*( params.n_space[i]*params.cell_length[i] );
-        cell_starting_global_index[i] += Pcoordinates[i]*params.n_space[i];
+        cell_starting_global_index[i] = Pcoordinates[i]*params.n_space[i];
         cell_starting_global_index[i] -= params.oversize[i];
         center[i] = ( min_local[i]+max_local[i] )*0.5;
         radius += pow( max_local[i] - center[i] + params.cell_length[i], 2 );
@@ -197,6 +199,73 @@ void Patch::finishCloning( Patch *patch, Params &params, SmileiMPI *smpi, unsign
     
 }
 
+// Move the arrays of part, emptied but with their capacity, into kept
+static void keepParticleBuffers( Particles &part, Particles &kept )
+{
+    part.clear();
+    // The cell keys of the old patch are meaningless in the new one (Particles::clear keeps them)
+    part.cell_keys.clear();
+    kept.initialize( 0, part );
+    kept.swap_buffers( part );
+}
+
+// Recycle a patch which left the domain (moving window) as a new clone of patch, at index ipatch.
+// The members depending on the position are rebuilt as in the cloning constructor, but in the memory of the previous
+// ones: the new fields take the arrays of the old fields, and the new species the particle arrays of the old species,
+// including their packets of exchanged particles.
+void Patch::recycle( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
+{
+    // Keep the (emptied) particle arrays of the old species
+    vector<Particles> particles( vecSpecies.size() );
+    vector<vector<Particles> > packets( vecSpecies.size() );
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++ ) {
+        keepParticleBuffers( *vecSpecies[ispec]->particles, particles[ispec] );
+        vector<Particles *> old_packets = vecSpecies[ispec]->MPIbuff.particlePackets();
+        packets[ispec].resize( old_packets.size() );
+        for( unsigned int k=0 ; k<old_packets.size() ; k++ ) {
+            keepParticleBuffers( *old_packets[k], packets[ispec][k] );
+        }
+    }
+    
+    BufferPool<double>::open();
+    BufferPool<complex<double> >::open();
+    
+    cleanType();
+    deleteMembers();
+    
+    // Same initialization as the cloning constructor
+    hindex = ipatch;
+    load_timer_ = 0.;
+    measured_load_ = -1.;
+    for( int iDim = 0 ; iDim < nDim_fields_ ; iDim++ ) {
+        neighbor_[iDim].assign( 2, MPI_PROC_NULL );
+        tmp_neighbor_[iDim].assign( 2, MPI_PROC_NULL );
+        MPI_neighbor_[iDim].assign( 2, MPI_PROC_NULL );
+        tmp_MPI_neighbor_[iDim].assign( 2, MPI_PROC_NULL );
+    }
+    rand_->setStream( hindex, Random::creation, 0, 0 );
+#ifdef  __DETAILED_TIMERS
+    patch_timers.assign( 14, 0. );
+#endif
+    
+    initStep2( params, domain_decomposition );
+    initStep3( params, smpi, n_moved );
+    finishCloning( patch, params, smpi, n_moved, false );
+    
+    BufferPool<double>::close();
+    BufferPool<complex<double> >::close();
+    
+    for( unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++ ) {
+        vecSpecies[ispec]->particles->swap_buffers( particles[ispec] );
+        vector<Particles *> new_packets = vecSpecies[ispec]->MPIbuff.particlePackets();
+        if( new_packets.size() == packets[ispec].size() ) {
+            for( unsigned int k=0 ; k<new_packets.size() ; k++ ) {
+                new_packets[k]->swap_buffers( packets[ispec][k] );
+            }
+        }
+    }
+}
+
 void Patch::finalizeMPIenvironment( Params &params )
 {
     int nb_comms( 9 ); // E, B, B_m : min number of comms
@@ -350,6 +419,19 @@ void Patch::set( Params &params, DomainDecomposition *domain_decomposition, Vect
 // Delete Patch members
 // ---------------------------------------------------------------------------------------------------------------------
 Patch::~Patch()
+{
+
+    deleteMembers();
+    
+    delete rand_;
+    
+} // END Patch::~Patch
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Delete the members built by finishCreation or finishCloning
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::deleteMembers()
 {
 
     delete probesInterp;
@@ -375,8 +457,37 @@ Patch::~Patch()
         delete vecSpecies[ispec];
     }
     vecSpecies.clear();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Compute the Ids of the 3^nDim patches around the current patch, applying periodicity
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::initAllNeighbors( Params &params, DomainDecomposition *domain_decomposition )
+{
+    unsigned int nneighbors = 1;
+    for( int iDim = 0 ; iDim < nDim_fields_ ; iDim++ ) {
+        nneighbors *= 3;
+    }
+    all_neighbor_.resize( nneighbors, MPI_PROC_NULL );
+    MPI_all_neighbor_.resize( nneighbors, MPI_PROC_NULL );
+    
+    std::vector<int> xcall( nDim_fields_, 0 );
+    for( unsigned int k = 0 ; k < nneighbors ; k++ ) {
+        unsigned int kdim = k;
+        for( int iDim = 0 ; iDim < nDim_fields_ ; iDim++ ) {
+            xcall[iDim] = ( int )Pcoordinates[iDim] + ( int )( kdim%3 ) - 1;
+            kdim /= 3;
+            if( params.EM_BCs[iDim][0]=="periodic" && xcall[iDim] < 0 ) {
+                xcall[iDim] += domain_decomposition->ndomain_[iDim];
+            } else if( params.EM_BCs[iDim][0]=="periodic" && xcall[iDim] >= ( int )domain_decomposition->ndomain_[iDim] ) {
+                xcall[iDim] -= domain_decomposition->ndomain_[iDim];
+            }
+        }
+        all_neighbor_[k] = domain_decomposition->getDomainId( xcall );
+    }
     
-} // END Patch::~Patch
+} // END initAllNeighbors
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -414,6 +525,10 @@ void Patch::updateMPIenv( SmileiMPI *smpi )
 //            }
         }
         
+    for( unsigned int k=0 ; k<all_neighbor_.size() ; k++ ) {
+        MPI_all_neighbor_[k] = smpi->hrank( all_neighbor_[k] );
+    }
+    
 } // END updateMPIenv
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -432,13 +547,20 @@ void Patch::cleanMPIBuffers( int ispec, Params &params )
             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
         }
     }
+    for( unsigned int k=0 ; k<all_neighbor_.size() ; k++ ) {
+        vecSpecies[ispec]->MPIbuff.neighbor_partRecv[k].clear();
+        vecSpecies[ispec]->MPIbuff.neighbor_partSend[k].clear();
+        vecSpecies[ispec]->MPIbuff.neighbor_part_index_send[k].clear();
+        vecSpecies[ispec]->MPIbuff.neighbor_recv_sz[k] = 0;
+    }
     vecSpecies[ispec]->indexes_of_particles_to_exchange.clear();
 } // cleanMPIBuffers
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Split particles Id to send in per direction and per patch neighbor dedicated buffers
-// Apply periodicity if necessary
+// Split particles Id to send in per patch neighbor dedicated buffers
+//   - cartesian geometries : directly to the destination patch, diagonal neighbors included
+//   - AMcylindrical : per direction, particles crossing a corner are forwarded by cornersParticles
 // ---------------------------------------------------------------------------------------------------------------------
 void Patch::initExchParticles( SmileiMPI *smpi, int ispec, Params &params )
 {
@@ -456,33 +578,37 @@ void Patch::initExchParticles( SmileiMPI *smpi, int ispec, Params &params )
             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
         }
     }
+    for( unsigned int k=0 ; k<all_neighbor_.size() ; k++ ) {
+        vecSpecies[ispec]->MPIbuff.neighbor_partRecv[k].clear();
+        vecSpecies[ispec]->MPIbuff.neighbor_partSend[k].clear();
+        vecSpecies[ispec]->MPIbuff.neighbor_part_index_send[k].resize( 0 );
+        vecSpecies[ispec]->MPIbuff.neighbor_recv_sz[k] = 0;
+    }
     
     int n_part_send = indexes_of_particles_to_exchange->size();
     
     int iPart;
     
     // Define where particles are going
-    //Put particles in the send buffer it belongs to. Priority to lower dimensions.
+    //Put particles in the send buffer of the patch they go to.
     if( params.geometry != "AMcylindrical" ) {
+        int center = all_neighbor_.size()/2;
         for( int i=0 ; i<n_part_send ; i++ ) {
             iPart = ( *indexes_of_particles_to_exchange )[i];
             check = 0;
-            idim = 0;
-            //Put indexes of particles in the first direction they will be exchanged and correct their position according to periodicity for the first exchange only.
-            while( check == 0 && idim<ndim ) {
-                if( cuParticles.position( idim, iPart ) < min_local[idim] ) {
-                    if( neighbor_[idim][0]!=MPI_PROC_NULL ) {
-                        vecSpecies[ispec]->MPIbuff.part_index_send[idim][0].push_back( iPart );
+            idim = 1;
+            for( int iDim=0 ; iDim<ndim ; iDim++ ) {
+                if( cuParticles.position( iDim, iPart ) >= min_local[iDim] ) {
+                    check += idim;
+                    if( cuParticles.position( iDim, iPart ) >= max_local[iDim] ) {
+                        check += idim;
                     }
-                    //If particle is outside of the global domain (has no neighbor), it will not be put in a send buffer and will simply be deleted.
-                    check = 1;
-                } else if( cuParticles.position( idim, iPart ) >= max_local[idim] ) {
-                    if( neighbor_[idim][1]!=MPI_PROC_NULL ) {
-                        vecSpecies[ispec]->MPIbuff.part_index_send[idim][1].push_back( iPart );
-                    }
-                    check = 1;
                 }
-                idim++;
+                idim *= 3;
+            }
+            //If particle is outside of the global domain (has no neighbor), it will not be put in a send buffer and will simply be deleted.
+            if( check != center && all_neighbor_[check]!=MPI_PROC_NULL ) {
+                vecSpecies[ispec]->MPIbuff.neighbor_part_index_send[check].push_back( iPart );
             }
         }
     } else { //if (geometry == "AMcylindrical")
@@ -713,6 +839,27 @@ void Patch::finalizeExchParticles( SmileiMPI *smpi, int ispec, Params &params, i
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// For direction iDim, test the communications over particles posted by exchParticles
+// Lets the MPI library progress them while computing, the requests are completed later by finalizeExchParticles
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::testExchParticles( int ispec, int iDim )
+{
+    int flag;
+    for( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
+        if( ( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL ) && ( vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].size()!=0 ) ) {
+            if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                MPI_Test( &( vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor] ), &flag, MPI_STATUS_IGNORE );
+            }
+        }
+        if( ( neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL ) && ( vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor]!=0 ) ) {
+            if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                MPI_Test( &( vecSpecies[ispec]->MPIbuff.rrequest[iDim][iNeighbor] ), &flag, MPI_STATUS_IGNORE );
+            }
+        }
+    }
+}
+
 void Patch::cornersParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim, VectorPatch *vecPatch )
 {
 
@@ -814,6 +961,208 @@ void Patch::cornersParticles( SmileiMPI *smpi, int ispec, Params &params, int iD
     } //loop i Neighbor
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Single-phase exchange of particles (cartesian geometries)
+// Each particle is sent directly to the patch it goes to, among the 3^nDim-1 neighbors (diagonal ones included)
+// The neighbor k is seen by the neighbor patch as its neighbor nneighbors-1-k, which identifies the messages
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::exchNbrOfParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch )
+{
+    int h0 = ( *vecPatch )( 0 )->hindex;
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        if( ( all_neighbor_[k]==MPI_PROC_NULL ) || ( k==nneighbors/2 ) ) {
+            continue;
+        }
+        MPIbuff.neighbor_send_sz[k] = MPIbuff.neighbor_part_index_send[k].size();
+        
+        if( MPI_all_neighbor_[k]!=MPI_me_ ) {
+            //If neighbour is MPI ==> I send him the number of particles I'll send later...
+            int local_hindex = hindex - vecPatch->refHindex_;
+            int tag = buildtag( local_hindex, k+10, 9 );
+            MPI_Isend( &( MPIbuff.neighbor_send_sz[k] ), 1, MPI_INT, MPI_all_neighbor_[k], tag, MPI_COMM_WORLD, &( MPIbuff.neighbor_srequest[k] ) );
+            //... and I receive the number of particles I'll receive later.
+            local_hindex = all_neighbor_[k] - smpi->patch_refHindexes[ MPI_all_neighbor_[k] ];
+            tag = buildtag( local_hindex, nneighbors-1-k+10, 9 );
+            MPI_Irecv( &( MPIbuff.neighbor_recv_sz[k] ), 1, MPI_INT, MPI_all_neighbor_[k], tag, MPI_COMM_WORLD, &( MPIbuff.neighbor_rrequest[k] ) );
+        } else {
+            //Else, I directly set the receive size to the correct value.
+            ( *vecPatch )( all_neighbor_[k]- h0 )->vecSpecies[ispec]->MPIbuff.neighbor_recv_sz[nneighbors-1-k] = MPIbuff.neighbor_send_sz[k];
+        }
+    }
+    
+} // exchNbrOfParticles
+
+
+void Patch::endNbrOfParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch )
+{
+    Particles &cuParticles = ( *vecSpecies[ispec]->particles );
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        if( ( all_neighbor_[k]!=MPI_PROC_NULL ) && ( k!=nneighbors/2 ) && ( MPI_all_neighbor_[k]!=MPI_me_ ) ) {
+            MPI_Wait( &( MPIbuff.neighbor_srequest[k] ), MPI_STATUS_IGNORE );
+            MPI_Wait( &( MPIbuff.neighbor_rrequest[k] ), MPI_STATUS_IGNORE );
+            if( MPIbuff.neighbor_recv_sz[k]!=0 ) {
+                //If I receive particles over MPI, I initialize my receive buffer with the appropriate size.
+                MPIbuff.neighbor_partRecv[k].initialize( MPIbuff.neighbor_recv_sz[k], cuParticles );
+            }
+        }
+    }
+    
+} // END endNbrOfParticles
+
+
+void Patch::prepareParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch )
+{
+    Particles &cuParticles = ( *vecSpecies[ispec]->particles );
+    int h0 = ( *vecPatch )( 0 )->hindex;
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        int n_part_send = MPIbuff.neighbor_part_index_send[k].size();
+        if( n_part_send==0 ) {
+            continue;
+        }
+        std::vector<int> &index_send = MPIbuff.neighbor_part_index_send[k];
+        
+        // Enabled periodicity, in all the directions crossed by the particles
+        int kdim = k;
+        for( int iDim=0 ; iDim<nDim_fields_ ; iDim++ ) {
+            int way = kdim%3;
+            kdim /= 3;
+            if( way==1 || smpi->periods_[iDim]!=1 ) {
+                continue;
+            }
+            double x_max = params.cell_length[iDim]*( params.n_space_global[iDim] );
+            for( int iPart=0 ; iPart<n_part_send ; iPart++ ) {
+                if( ( way==0 ) && ( Pcoordinates[iDim] == 0 ) && ( cuParticles.position( iDim, index_send[iPart] ) < 0. ) ) {
+                    cuParticles.position( iDim, index_send[iPart] ) += x_max;
+                } else if( ( way==2 ) && ( Pcoordinates[iDim] == params.number_of_patches[iDim]-1 ) && ( cuParticles.position( iDim, index_send[iPart] ) >= x_max ) ) {
+                    cuParticles.position( iDim, index_send[iPart] ) -= x_max;
+                }
+            }
+        }
+        
+        if( MPI_all_neighbor_[k]!=MPI_me_ ) {
+            // If MPI comm, first copy particles in the sendbuffer
+            for( int iPart=0 ; iPart<n_part_send ; iPart++ ) {
+                cuParticles.cp_particle( index_send[iPart], MPIbuff.neighbor_partSend[k] );
+            }
+        } else {
+            //If not MPI comm, copy particles directly in the receive buffer
+            Particles &partRecv = ( *vecPatch )( all_neighbor_[k]- h0 )->vecSpecies[ispec]->MPIbuff.neighbor_partRecv[nneighbors-1-k];
+            for( int iPart=0 ; iPart<n_part_send ; iPart++ ) {
+                cuParticles.cp_particle( index_send[iPart], partRecv );
+            }
+        }
+    }
+    
+} // END prepareParticles
+
+
+void Patch::exchParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch )
+{
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        if( ( all_neighbor_[k]==MPI_PROC_NULL ) || ( k==nneighbors/2 ) || ( MPI_all_neighbor_[k]==MPI_me_ ) ) {
+            continue;
+        }
+        if( MPIbuff.neighbor_send_sz[k]!=0 ) {
+            int local_hindex = hindex - vecPatch->refHindex_;
+            int tag = buildtag( local_hindex, k+10, 9 );
+            vecSpecies[ispec]->typePartSend[k] = smpi->createMPIparticles( &( MPIbuff.neighbor_partSend[k] ) );
+            MPI_Isend( &( MPIbuff.neighbor_partSend[k].position( 0, 0 ) ), 1, vecSpecies[ispec]->typePartSend[k], MPI_all_neighbor_[k], tag, MPI_COMM_WORLD, &( MPIbuff.neighbor_srequest[k] ) );
+        }
+        if( MPIbuff.neighbor_recv_sz[k]!=0 ) {
+            int local_hindex = all_neighbor_[k] - smpi->patch_refHindexes[ MPI_all_neighbor_[k] ];
+            int tag = buildtag( local_hindex, nneighbors-1-k+10, 9 );
+            vecSpecies[ispec]->typePartRecv[k] = smpi->createMPIparticles( &( MPIbuff.neighbor_partRecv[k] ) );
+            MPI_Irecv( &( MPIbuff.neighbor_partRecv[k].position( 0, 0 ) ), 1, vecSpecies[ispec]->typePartRecv[k], MPI_all_neighbor_[k], tag, MPI_COMM_WORLD, &( MPIbuff.neighbor_rrequest[k] ) );
+        }
+    }
+    
+} // END exchParticles
+
+
+void Patch::finalizeExchParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch )
+{
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        if( ( all_neighbor_[k]==MPI_PROC_NULL ) || ( k==nneighbors/2 ) || ( MPI_all_neighbor_[k]==MPI_me_ ) ) {
+            continue;
+        }
+        if( MPIbuff.neighbor_send_sz[k]!=0 ) {
+            MPI_Wait( &( MPIbuff.neighbor_srequest[k] ), MPI_STATUS_IGNORE );
+            MPI_Type_free( &( vecSpecies[ispec]->typePartSend[k] ) );
+        }
+        if( MPIbuff.neighbor_recv_sz[k]!=0 ) {
+            MPI_Wait( &( MPIbuff.neighbor_rrequest[k] ), MPI_STATUS_IGNORE );
+            MPI_Type_free( &( vecSpecies[ispec]->typePartRecv[k] ) );
+        }
+    }
+    
+} // END finalizeExchParticles
+
+
+void Patch::testExchParticles( int ispec )
+{
+    int flag;
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        if( ( all_neighbor_[k]==MPI_PROC_NULL ) || ( k==nneighbors/2 ) || ( MPI_all_neighbor_[k]==MPI_me_ ) ) {
+            continue;
+        }
+        if( MPIbuff.neighbor_send_sz[k]!=0 ) {
+            MPI_Test( &( MPIbuff.neighbor_srequest[k] ), &flag, MPI_STATUS_IGNORE );
+        }
+        if( MPIbuff.neighbor_recv_sz[k]!=0 ) {
+            MPI_Test( &( MPIbuff.neighbor_rrequest[k] ), &flag, MPI_STATUS_IGNORE );
+        }
+    }
+    
+} // END testExchParticles
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Gather the particles received from all neighbors in partRecv[iDim][iNeighbor], where iDim is the first direction
+// in which the neighbor is shifted : those coming from x neighbors arrive in the first or last bin, as expected
+// by Species::sort_part
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::dispatchParticles( int ispec, Params &params )
+{
+    int nneighbors = all_neighbor_.size();
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    
+    for( int k=0 ; k<nneighbors ; k++ ) {
+        unsigned int n_part_recv = MPIbuff.neighbor_recv_sz[k];
+        if( ( all_neighbor_[k]==MPI_PROC_NULL ) || ( k==nneighbors/2 ) || ( n_part_recv==0 ) ) {
+            continue;
+        }
+        int iDim = 0;
+        int kdim = k;
+        while( kdim%3 == 1 ) {
+            kdim /= 3;
+            iDim++;
+        }
+        int iNeighbor = kdim%3 / 2;
+        Particles &partRecv = MPIbuff.partRecv[iDim][iNeighbor];
+        MPIbuff.neighbor_partRecv[k].cp_particles( 0, n_part_recv, partRecv, partRecv.size() );
+        MPIbuff.part_index_recv_sz[iDim][iNeighbor] += n_part_recv;
+    }
+    
+} // END dispatchParticles
+
 void Patch::injectParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch )
 {
 
@@ -847,6 +1196,14 @@ void Patch::cleanParticlesOverhead( Params &params )
                 vector<int>( vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor] ).swap( vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor] );
             }
         }
+        for( unsigned int k=0 ; k<all_neighbor_.size() ; k++ ) {
+            vecSpecies[ispec]->MPIbuff.neighbor_partRecv[k].clear();
+            vecSpecies[ispec]->MPIbuff.neighbor_partRecv[k].shrink_to_fit( ndim );
+            vecSpecies[ispec]->MPIbuff.neighbor_partSend[k].clear();
+            vecSpecies[ispec]->MPIbuff.neighbor_partSend[k].shrink_to_fit( ndim );
+            vecSpecies[ispec]->MPIbuff.neighbor_part_index_send[k].clear();
+            vector<int>( vecSpecies[ispec]->MPIbuff.neighbor_part_index_send[k] ).swap( vecSpecies[ispec]->MPIbuff.neighbor_part_index_send[k] );
+        }
         
         cuParticles.shrink_to_fit( ndim );
     }
@@ -12,6 +12,7 @@
 #include "PartWall.h"
 #include "Interpolator.h"
 #include "Projector.h"
+#include "Random.h"
 
 class DomainDecomposition;
 class Collisions;
@@ -29,6 +30,7 @@ class Patch
     friend class SimWindow;
     friend class SyncVectorPatch;
     friend class AsyncMPIbuffers;
+    friend class PoissonMultigrid;
 public:
     //! Constructor for Patch
     Patch( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved );
@@ -45,6 +47,8 @@ public:
     void finishCreation( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition );
     //! Last cloning step
     void finishCloning( Patch *patch, Params &params, SmileiMPI *smpi, unsigned int n_moved, bool with_particles );
+    //! Reuse the patch, and the memory of its fields and particles, as a new clone of patch (without particles)
+    void recycle( Patch *patch, Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved );
     
     //! Finalize MPI environment : especially requests array for non blocking communications
     void finalizeMPIenvironment( Params &params );
@@ -53,6 +57,8 @@ public:
     
     //! Destructor for Patch
     virtual ~Patch();
+    //! Delete the members built by finishCreation or finishCloning
+    void deleteMembers();
     
     // Main PIC objects : data & operators
     // -----------------------------------
@@ -91,19 +97,26 @@ public:
     std::vector<double> patch_timers;
 #endif
     
-    //! Random number generator
-    inline uint32_t xorshift32()
+    // Measured load for the dynamic load balancing
+    // -----------------------
+    
+    //! Wall time spent in the particle operators of the patch during the current iteration
+    double load_timer_;
+    //! Smoothed wall time per iteration of the patch (negative when not measured yet)
+    double measured_load_;
+    //! Accumulate the wall time of the current iteration in the smoothed measured load
+    inline void updateMeasuredLoad( unsigned int smoothing )
     {
-        /* Algorithm "xor" from p. 4 of Marsaglia, "Xorshift RNGs" */
-        xorshift32_state ^= xorshift32_state << 13;
-        xorshift32_state ^= xorshift32_state >> 17;
-        xorshift32_state ^= xorshift32_state << 5;
-        return xorshift32_state;
+        if( measured_load_ < 0. ) {
+            measured_load_ = load_timer_;
+        } else {
+            measured_load_ += ( load_timer_ - measured_load_ ) / ( double )smoothing;
+        }
+        load_timer_ = 0.;
     }
-    //! State of the random number generator
-    uint32_t xorshift32_state;
-    //! Inverse of the maximum value of the random number generator
-    const double xorshift32_invmax = 1./4294967296.;
+    
+    //! Random number generator of the patch (see Random::setStream)
+    Random *rand_;
     
     // MPI exchange/sum methods for particles/fields
     //   - fields communication specified per geometry (pure virtual)
@@ -123,8 +136,27 @@ public:
     void exchParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim, VectorPatch *vecPatch );
     //! finalize exch / particles
     void finalizeExchParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim, VectorPatch *vecPatch );
-    //! Treat diagonalParticles
+    //! progress exch / particles without waiting (MPI_Test)
+    void testExchParticles( int ispec, int iDim );
+    //! Treat diagonalParticles (AMcylindrical geometry, see the single-phase exchange below otherwise)
     void cornersParticles( SmileiMPI *smpi, int ispec, Params &params, int iDim, VectorPatch *vecPatch );
+    
+    // Single-phase exchange of particles with all the neighbors, diagonal ones included (cartesian geometries)
+    //! init comm  nbr of particles
+    void exchNbrOfParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch );
+    //! finalize comm / nbr of particles
+    void endNbrOfParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch );
+    //! extract particles from main data structure to buffers
+    void prepareParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch );
+    //! effective exchange of particles
+    void exchParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch );
+    //! finalize exch / particles
+    void finalizeExchParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch );
+    //! progress exch / particles without waiting (MPI_Test)
+    void testExchParticles( int ispec );
+    //! gather the received particles in the per direction buffers expected by Species::sort_part
+    void dispatchParticles( int ispec, Params &params );
+    
     //! inject particles received in main data structure and particles sorting
     void injectParticles( SmileiMPI *smpi, int ispec, Params &params, VectorPatch *vecPatch );
     //! clean memory resizing particles structure
@@ -133,7 +165,8 @@ public:
     void cleanup_sent_particles( int ispec, std::vector<int> *indexes_of_particles_to_exchange );
     
     //! init comm / sum densities
-    virtual void initSumField( Field *field, int iDim, SmileiMPI *smpi ) = 0;
+    //!   - shared_halos: the halos of the processes of the same node are left to SyncVectorPatch (see SmileiMPI::sharedHalo)
+    virtual void initSumField( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos = false ) = 0;
     virtual void reallyinitSumField( Field *field, int iDim ) = 0;
     //! finalize comm / sum densities
     virtual void finalizeSumField( Field *field, int iDim ) = 0;
@@ -148,7 +181,7 @@ public:
     //! finalize comm / exchange complex fields
     virtual void finalizeExchangeComplex( Field *field ) = 0;
     //! init comm / exchange fields in direction iDim only
-    virtual void initExchange( Field *field, int iDim, SmileiMPI *smpi ) = 0;
+    virtual void initExchange( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos = false ) = 0;
     //! init comm / exchange complex fields in direction iDim only
     virtual void initExchangeComplex( Field *field, int iDim, SmileiMPI *smpi ) = 0;
     //! finalize comm / exchange fields
@@ -221,6 +254,9 @@ public:
         return false;
     }
     
+    //! Compute the Ids of all the neighbor patches, diagonal ones included (all_neighbor_)
+    void initAllNeighbors( Params &params, DomainDecomposition *domain_decomposition );
+    
     //! Compute MPI rank of neigbors patch regarding neigbors patch Ids
     void updateMPIenv( SmileiMPI *smpi );
     void updateTagenv( SmileiMPI *smpi );
@@ -363,6 +399,12 @@ protected:
     //! MPI rank of neighbors patch
     std::vector< std::vector<int> > MPI_neighbor_, tmp_MPI_neighbor_;
     
+    //! Hilbert index of the 3^nDim patches around, diagonal ones included (MPI_PROC_NULL if none, the patch itself
+    //! in the middle). The patch shifted by o[iDim] = -1, 0 or +1 is at sum over iDim of ( o[iDim]+1 )*3^iDim
+    std::vector<int> all_neighbor_;
+    //! MPI rank of the patches of all_neighbor_
+    std::vector<int> MPI_all_neighbor_;
+    
     //! "Real" min limit of local sub-subdomain (ghost data not concerned)
     //!     - "0." on rank 0
     std::vector<double> min_local;
@@ -76,6 +76,9 @@ void Patch1D::initStep2( Params &params, DomainDecomposition *domain_decompositi
     }
     neighbor_[0][1] = domain_decomposition->getDomainId( xcall );
     
+    // All neighbors, diagonal ones included, for the exchange of particles
+    initAllNeighbors( params, domain_decomposition );
+    
     for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
         ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
         ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
@@ -99,7 +102,7 @@ void Patch1D::reallyinitSumField( Field *field, int iDim )
 // Initialize current patch sum Fields communications through MPI for direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch1D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
+void Patch1D::initSumField( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.buf[0][0].size()==0 ) {
         field->MPIbuff.allocate( 1, field, oversize );
@@ -140,14 +143,20 @@ void Patch1D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
     
     for( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
     
-        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][iNeighbor] ) ) {
+            // Written in the shared memory window by SyncVectorPatch
+            field->MPIbuff.srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
             istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + ( 1-iNeighbor ) * ( 0 );
             ix = ( 1-iDim )*istart;
             int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
             MPI_Isend( &( f1D->data_[ix] ), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( f1D->MPIbuff.srequest[iDim][iNeighbor] ) );
         } // END of Send
         
-        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][( iNeighbor+1 )%2] ) ) {
+            // Read from the shared memory window by SyncVectorPatch
+            field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
             int tmp_elem = f1D->MPIbuff.buf[iDim][( iNeighbor+1 )%2].size();
             int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
             MPI_Irecv( &( f1D->MPIbuff.buf[iDim][( iNeighbor+1 )%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag, MPI_COMM_WORLD, &( f1D->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
@@ -243,7 +252,7 @@ void Patch1D::finalizeExchangeComplex( Field *field )
 // Initialize current patch exhange Fields communications through MPI for direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch1D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
+void Patch1D::initExchange( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.srequest.size()==0 ) {
         field->MPIbuff.allocate( 1 );
@@ -271,7 +280,10 @@ void Patch1D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
     MPI_Datatype ntype = ntype_[iDim][isDual[0]];
     for( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
     
-        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][iNeighbor] ) ) {
+            // Written in the shared memory window by SyncVectorPatch
+            field->MPIbuff.srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
         
             istart = iNeighbor * ( n_elem[iDim]- ( 2*oversize[iDim]+1+isDual[iDim] ) ) + ( 1-iNeighbor ) * ( oversize[iDim] + 1 + isDual[iDim] );
             ix = ( 1-iDim )*istart;
@@ -280,7 +292,10 @@ void Patch1D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
             
         } // END of Send
         
-        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][( iNeighbor+1 )%2] ) ) {
+            // Read from the shared memory window by SyncVectorPatch
+            field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
         
             istart = ( ( iNeighbor+1 )%2 ) * ( n_elem[iDim] - 1 - ( oversize[iDim]-1 ) ) + ( 1-( iNeighbor+1 )%2 ) * ( 0 )  ;
             ix = ( 1-iDim )*istart;
@@ -34,7 +34,7 @@ public:
     // --------------------------------------------------------------
     
     //! init comm / sum densities
-    void initSumField( Field *field, int iDim, SmileiMPI *smpi ) override final;
+    void initSumField( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos = false ) override final;
     void reallyinitSumField( Field *field, int iDim ) override final;
     //! finalize comm / sum densities
     void finalizeSumField( Field *field, int iDim ) override final;
@@ -49,7 +49,7 @@ public:
     //! finalize comm / exchange complex fields
     void finalizeExchangeComplex( Field *field ) override final;
     //! init comm / exchange fields in direction iDim only
-    void initExchange( Field *field, int iDim, SmileiMPI *smpi ) override final;
+    void initExchange( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos = false ) override final;
     //! init comm / exchange complex fields in direction iDim only
     void initExchangeComplex( Field *field, int iDim, SmileiMPI *smpi ) override final;
     //! finalize comm / exchange fields in direction iDim only
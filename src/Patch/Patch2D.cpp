@@ -99,6 +99,9 @@ void Patch2D::initStep2( Params &params, DomainDecomposition *domain_decompositi
     }
     neighbor_[1][1] = domain_decomposition->getDomainId( xcall );
     
+    // All neighbors, diagonal ones included, for the exchange of particles
+    initAllNeighbors( params, domain_decomposition );
+    
     for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
         for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
             ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
@@ -131,7 +134,7 @@ void Patch2D::reallyinitSumField( Field *field, int iDim )
 // Initialize current patch sum Fields communications through MPI in direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch2D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
+void Patch2D::initSumField( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.buf[0][0].size()==0 ) {
         field->MPIbuff.allocate( 2, field, oversize );
@@ -180,7 +183,10 @@ void Patch2D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
     
     for( int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++ ) {
     
-        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][iNeighbor] ) ) {
+            // Written in the shared memory window by SyncVectorPatch
+            field->MPIbuff.srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
             istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + ( 1-iNeighbor ) * ( 0 );
             ix = ( 1-iDim )*istart;
             iy =    iDim *istart;
@@ -189,7 +195,10 @@ void Patch2D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
             MPI_Isend( &( ( *f2D )( ix, iy ) ), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &( f2D->MPIbuff.srequest[iDim][iNeighbor] ) );
         } // END of Send
         
-        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][( iNeighbor+1 )%2] ) ) {
+            // Read from the shared memory window by SyncVectorPatch
+            field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
             int tmp_elem = f2D->MPIbuff.buf[iDim][( iNeighbor+1 )%2].size();
             int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
             //cout << hindex << " recv from " << neighbor_[iDim][(iNeighbor+1)%2] << " ; n_elements = " << tmp_elem << endl;
@@ -309,7 +318,7 @@ void Patch2D::finalizeExchangeComplex( Field *field )
 // Initialize current patch exhange Fields communications through MPI for direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch2D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
+void Patch2D::initExchange( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.srequest.size()==0 ) {
         field->MPIbuff.allocate( 2 );
@@ -350,7 +359,10 @@ void Patch2D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
     MPI_Datatype ntype = ntype_[iDim][isDual[0]][isDual[1]];
     for( int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++ ) {
     
-        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][iNeighbor] ) ) {
+            // Written in the shared memory window by SyncVectorPatch
+            field->MPIbuff.srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
         
             istart = iNeighbor * ( n_elem[iDim]- ( 2*oversize[iDim]+1+isDual[iDim] ) ) + ( 1-iNeighbor ) * ( oversize[iDim] + 1 + isDual[iDim] );
             ix = ( 1-iDim )*istart;
@@ -361,7 +373,10 @@ void Patch2D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
             
         } // END of Send
         
-        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][( iNeighbor+1 )%2] ) ) {
+            // Read from the shared memory window by SyncVectorPatch
+            field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
         
             istart = ( ( iNeighbor+1 )%2 ) * ( n_elem[iDim] - 1- ( oversize[iDim]-1 ) ) + ( 1-( iNeighbor+1 )%2 ) * ( 0 )  ;
             ix = ( 1-iDim )*istart;
@@ -125,6 +125,9 @@ void Patch3D::initStep2( Params &params, DomainDecomposition *domain_decompositi
     }
     neighbor_[2][1] =  domain_decomposition->getDomainId( xcall );
     
+    // All neighbors, diagonal ones included, for the exchange of particles
+    initAllNeighbors( params, domain_decomposition );
+    
     for( int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++ ) {
         for( int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++ ) {
             for( int iz_isPrim=0 ; iz_isPrim<2 ; iz_isPrim++ ) {
@@ -156,7 +159,7 @@ void Patch3D::reallyinitSumField( Field *field, int iDim )
 // Initialize current patch sum Fields communications through MPI in direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch3D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
+void Patch3D::initSumField( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.buf[0][0].size()==0 ) {
         field->MPIbuff.allocate( 3, field, oversize );
@@ -214,7 +217,10 @@ void Patch3D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
     
     for( int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++ ) {
     
-        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][iNeighbor] ) ) {
+            // Written in the shared memory window by SyncVectorPatch
+            field->MPIbuff.srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
             istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + ( 1-iNeighbor ) * ( 0 );
             ix = idx[0]*istart;
             iy = idx[1]*istart;
@@ -224,7 +230,10 @@ void Patch3D::initSumField( Field *field, int iDim, SmileiMPI *smpi )
                        MPI_COMM_WORLD, &( f3D->MPIbuff.srequest[iDim][iNeighbor] ) );
         } // END of Send
         
-        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][( iNeighbor+1 )%2] ) ) {
+            // Read from the shared memory window by SyncVectorPatch
+            field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
             int tmp_elem = f3D->MPIbuff.buf[iDim][( iNeighbor+1 )%2].size();
             int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
             MPI_Irecv( &( f3D->MPIbuff.buf[iDim][( iNeighbor+1 )%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
@@ -419,7 +428,7 @@ void Patch3D::finalizeExchangeComplex( Field *field )
 // Initialize current patch exhange Fields communications through MPI for direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch3D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
+void Patch3D::initExchange( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.srequest.size()==0 ) {
         field->MPIbuff.allocate( 3 );
@@ -453,7 +462,10 @@ void Patch3D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
     MPI_Datatype ntype = ntype_[iDim][isDual[0]][isDual[1]][isDual[2]];
     for( int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++ ) {
     
-        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][iNeighbor] ) ) {
+            // Written in the shared memory window by SyncVectorPatch
+            field->MPIbuff.srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
         
             istart = iNeighbor * ( n_elem[iDim]- ( 2*oversize[iDim]+1+isDual[iDim] ) ) + ( 1-iNeighbor ) * ( oversize[iDim] + 1 + isDual[iDim] );
             ix = idx[0]*istart;
@@ -465,7 +477,10 @@ void Patch3D::initExchange( Field *field, int iDim, SmileiMPI *smpi )
                        
         } // END of Send
         
-        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+        if( shared_halos && smpi->sharedHalo( MPI_neighbor_[iDim][( iNeighbor+1 )%2] ) ) {
+            // Read from the shared memory window by SyncVectorPatch
+            field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] = MPI_REQUEST_NULL;
+        } else if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
         
             istart = ( ( iNeighbor+1 )%2 ) * ( n_elem[iDim] - 1- ( oversize[iDim]-1 ) ) + ( 1-( iNeighbor+1 )%2 ) * ( 0 )  ;
             ix = idx[0]*istart;
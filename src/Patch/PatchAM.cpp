@@ -119,7 +119,7 @@ void PatchAM::reallyinitSumField( Field *field, int iDim )
 // Initialize current patch sum Fields communications through MPI in direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void PatchAM::initSumField( Field *field, int iDim, SmileiMPI *smpi )
+void PatchAM::initSumField( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     if( field->MPIbuff.ibuf[0][0].size()==0 ) {
         field->MPIbuff.iallocate( 2, field, oversize );
@@ -369,7 +369,7 @@ void PatchAM::finalizeExchangeComplex( Field *field )
 // Initialize current patch exhange Fields communications through MPI for direction iDim
 // Intra-MPI process communications managed by memcpy in SyncVectorPatch::sum()
 // ---------------------------------------------------------------------------------------------------------------------
-void PatchAM::initExchange( Field *field, int iDim, SmileiMPI *smpi )
+void PatchAM::initExchange( Field *field, int iDim, SmileiMPI *smpi, bool shared_halos )
 {
     ERROR( "Circ geometry initExchange not implemented" );
     
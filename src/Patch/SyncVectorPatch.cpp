@@ -2,6 +2,8 @@
 #include "SyncVectorPatch.h"
 
 #include <vector>
+#include <cstring>
+#include <algorithm>
 
 #include "VectorPatch.h"
 #include "Params.h"
@@ -22,34 +24,52 @@ void SyncVectorPatch::exchangeParticles( VectorPatch &vecPatches, int ispec, Par
         vecPatches( ipatch )->initExchParticles( smpi, ispec, params );
     }
     
-    // Init comm in direction 0
+    if( params.geometry != "AMcylindrical" ) {
+        // Init comm with all the neighbors
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(runtime)
+        #pragma omp for schedule(runtime)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-        vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, 0, &vecPatches );
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, &vecPatches );
+        }
+    } else {
+        // Init comm in direction 0
+#ifndef _NO_MPI_TM
+        #pragma omp for schedule(runtime)
+#else
+        #pragma omp single
+#endif
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, 0, &vecPatches );
+        }
     }
 }
 
 
+// The particles have been sent by sendParticles before solving Maxwell: to all the neighbors in cartesian geometries,
+// in direction 0 in AMcylindrical geometry, where the next directions are exchanged afterwards
 void SyncVectorPatch::finalize_and_sort_parts( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
 {
-    SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, 0, params, smpi, timers, itime );
-    
-    // Per direction
-    for( unsigned int iDim=1 ; iDim<params.nDim_field ; iDim++ ) {
+    if( params.geometry != "AMcylindrical" ) {
+        SyncVectorPatch::importParticles( vecPatches, ispec, params, smpi, timers, itime );
+    } else {
+        SyncVectorPatch::importParticles( vecPatches, ispec, 0, params, smpi, timers, itime );
+        
+        // Per direction
+        for( unsigned int iDim=1 ; iDim<params.nDim_field ; iDim++ ) {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(runtime)
+            #pragma omp for schedule(runtime)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-            vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, iDim, &vecPatches );
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                vecPatches( ipatch )->exchNbrOfParticles( smpi, ispec, params, iDim, &vecPatches );
+            }
+            
+            SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, iDim, params, smpi, timers, itime );
         }
-        
-        SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, iDim, params, smpi, timers, itime );
     }
     
     #pragma omp for schedule(runtime)
@@ -91,7 +111,8 @@ void SyncVectorPatch::finalize_and_sort_parts( VectorPatch &vecPatches, int ispe
 }
 
 
-void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
+// Complete the exchange of the number of particles in direction iDim, then post the exchange of particles
+void SyncVectorPatch::sendParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
 {
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(runtime)
@@ -115,7 +136,12 @@ void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int is
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
         vecPatches( ipatch )->exchParticles( smpi, ispec, params, iDim, &vecPatches );
     }
-    
+}
+
+
+// Wait for the particles of direction iDim, and prepare those which must go on in the next directions
+void SyncVectorPatch::importParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
+{
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(runtime)
 #else
@@ -132,6 +158,60 @@ void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int is
 }
 
 
+void SyncVectorPatch::finalizeExchangeParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
+{
+    SyncVectorPatch::sendParticles( vecPatches, ispec, iDim, params, smpi, timers, itime );
+    SyncVectorPatch::importParticles( vecPatches, ispec, iDim, params, smpi, timers, itime );
+}
+
+
+// Complete the exchange of the number of particles with all the neighbors, then post the exchange of particles
+void SyncVectorPatch::sendParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
+{
+#ifndef _NO_MPI_TM
+    #pragma omp for schedule(runtime)
+#else
+    #pragma omp single
+#endif
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->endNbrOfParticles( smpi, ispec, params, &vecPatches );
+    }
+    
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->prepareParticles( smpi, ispec, params, &vecPatches );
+    }
+    
+#ifndef _NO_MPI_TM
+    #pragma omp for schedule(runtime)
+#else
+    #pragma omp single
+#endif
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->exchParticles( smpi, ispec, params, &vecPatches );
+    }
+}
+
+
+// Wait for the particles of all the neighbors, and gather them per direction
+void SyncVectorPatch::importParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime )
+{
+#ifndef _NO_MPI_TM
+    #pragma omp for schedule(runtime)
+#else
+    #pragma omp single
+#endif
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->finalizeExchParticles( smpi, ispec, params, &vecPatches );
+    }
+    
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->dispatchParticles( ispec, params );
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // ----------------------------------------------       DENSITIES         ----------------------------------------------
@@ -227,6 +307,7 @@ void SyncVectorPatch::sum( std::vector<Field *> fields, VectorPatch &vecPatches,
     n_space[2] = vecPatches( 0 )->EMfields->n_space[2];
     
     unsigned int nComp = fields.size()/nPatches;
+    bool shared_halos = smpi->shared_halos_;
     
     // -----------------
     // Sum per direction :
@@ -239,7 +320,11 @@ void SyncVectorPatch::sum( std::vector<Field *> fields, VectorPatch &vecPatches,
 #endif
     for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
         unsigned int ipatch = ifield%nPatches;
-        vecPatches( ipatch )->initSumField( fields[ifield], 0, smpi );
+        vecPatches( ipatch )->initSumField( fields[ifield], 0, smpi, shared_halos );
+    }
+    
+    if( shared_halos ) {
+        exchange_shared_halos( fields, NULL, nComp, vecPatches, smpi, 0, 1, true );
     }
     
     // iDim = 0, local
@@ -296,7 +381,11 @@ void SyncVectorPatch::sum( std::vector<Field *> fields, VectorPatch &vecPatches,
 #endif
         for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
             unsigned int ipatch = ifield%nPatches;
-            vecPatches( ipatch )->initSumField( fields[ifield], 1, smpi );
+            vecPatches( ipatch )->initSumField( fields[ifield], 1, smpi, shared_halos );
+        }
+        
+        if( shared_halos ) {
+            exchange_shared_halos( fields, NULL, nComp, vecPatches, smpi, 1, 2, true );
         }
         
         // iDim = 1, local
@@ -357,7 +446,11 @@ void SyncVectorPatch::sum( std::vector<Field *> fields, VectorPatch &vecPatches,
 #endif
             for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
                 unsigned int ipatch = ifield%nPatches;
-                vecPatches( ipatch )->initSumField( fields[ifield], 2, smpi );
+                vecPatches( ipatch )->initSumField( fields[ifield], 2, smpi, shared_halos );
+            }
+            
+            if( shared_halos ) {
+                exchange_shared_halos( fields, NULL, nComp, vecPatches, smpi, 2, 3, true );
             }
             
             // iDim = 2 local
@@ -413,6 +506,79 @@ void SyncVectorPatch::sum( std::vector<Field *> fields, VectorPatch &vecPatches,
 }
 
 
+// fields : contains a single field component for all patches of vecPatches
+void SyncVectorPatch::sum_noomp( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    unsigned int nx_, ny_( 1 ), nz_( 1 ), h0, oversize[3], n_space[3], gsp[3];
+    double *pt1, *pt2;
+    h0 = vecPatches( 0 )->hindex;
+    
+    oversize[0] = vecPatches( 0 )->EMfields->oversize[0];
+    oversize[1] = vecPatches( 0 )->EMfields->oversize[1];
+    oversize[2] = vecPatches( 0 )->EMfields->oversize[2];
+    
+    n_space[0] = vecPatches( 0 )->EMfields->n_space[0];
+    n_space[1] = vecPatches( 0 )->EMfields->n_space[1];
+    n_space[2] = vecPatches( 0 )->EMfields->n_space[2];
+    
+    nx_ = fields[0]->dims_[0];
+    if( fields[0]->dims_.size()>1 ) {
+        ny_ = fields[0]->dims_[1];
+        if( fields[0]->dims_.size()>2 ) {
+            nz_ = fields[0]->dims_[2];
+        }
+    }
+    
+    for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+    
+        for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+            vecPatches( ipatch )->initSumField( fields[ipatch], iDim, smpi );
+        }
+        
+        gsp[iDim] = 1+2*oversize[iDim]+fields[0]->isDual_[iDim]; //Ghost size primal
+        for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+            if( vecPatches( ipatch )->MPI_me_ != vecPatches( ipatch )->MPI_neighbor_[iDim][0] ) {
+                continue;
+            }
+            // The neighbor patch in direction iDim belongs to the same MPI process than I
+            pt2 = &( *fields[ipatch] )( 0 );
+            if( iDim == 0 ) {
+                pt1 = &( *fields[vecPatches( ipatch )->neighbor_[0][0]-h0] )( n_space[0]*ny_*nz_ );
+                for( unsigned int i = 0; i < gsp[0]*ny_*nz_ ; i++ ) {
+                    pt1[i] += pt2[i];
+                }
+                memcpy( pt2, pt1, gsp[0]*ny_*nz_*sizeof( double ) );
+            } else if( iDim == 1 ) {
+                pt1 = &( *fields[vecPatches( ipatch )->neighbor_[1][0]-h0] )( n_space[1]*nz_ );
+                for( unsigned int j = 0; j < nx_ ; j++ ) {
+                    for( unsigned int i = 0; i < gsp[1]*nz_ ; i++ ) {
+                        pt1[i] += pt2[i];
+                    }
+                    memcpy( pt2, pt1, gsp[1]*nz_*sizeof( double ) );
+                    pt1 += ny_*nz_;
+                    pt2 += ny_*nz_;
+                }
+            } else {
+                pt1 = &( *fields[vecPatches( ipatch )->neighbor_[2][0]-h0] )( n_space[2] );
+                for( unsigned int j = 0; j < nx_*ny_ ; j++ ) {
+                    for( unsigned int i = 0; i < gsp[2] ; i++ ) {
+                        pt1[i] += pt2[i];
+                        pt2[i] =  pt1[i];
+                    }
+                    pt1 += nz_;
+                    pt2 += nz_;
+                }
+            }
+        }
+        
+        for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+            vecPatches( ipatch )->finalizeSumField( fields[ipatch], iDim );
+        }
+    }
+    
+}
+
+
 void SyncVectorPatch::sumComplex( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime )
 {
     unsigned int nx_, ny_, nz_, h0, oversize[3], n_space[3], gsp[3];
@@ -662,9 +828,13 @@ void SyncVectorPatch::sum_all_components( std::vector<Field *> &fields, VectorPa
 #endif
     for( unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
-        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
-        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi, smpi->shared_halos_ ); // Jx
+        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi, smpi->shared_halos_ ); // Jy
+        vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi, smpi->shared_halos_ ); // Jz
+    }
+    
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( vecPatches.densitiesMPIx, &vecPatches.MPIxIdx, 3, vecPatches, smpi, 0, 1, true );
     }
     // iDim = 0, local
     int nFieldLocalx = vecPatches.densitiesLocalx.size()/3;
@@ -731,9 +901,13 @@ void SyncVectorPatch::sum_all_components( std::vector<Field *> &fields, VectorPa
 #endif
         for( unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield++ ) {
             unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
-            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
-            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi, smpi->shared_halos_ ); // Jx
+            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi, smpi->shared_halos_ ); // Jy
+            vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi, smpi->shared_halos_ ); // Jz
+        }
+        
+        if( smpi->shared_halos_ ) {
+            exchange_shared_halos( vecPatches.densitiesMPIy, &vecPatches.MPIyIdx, 3, vecPatches, smpi, 1, 2, true );
         }
         
         // iDim = 1,
@@ -805,9 +979,13 @@ void SyncVectorPatch::sum_all_components( std::vector<Field *> &fields, VectorPa
 #endif
             for( unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield++ ) {
                 unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
-                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
-                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi, smpi->shared_halos_ ); // Jx
+                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi, smpi->shared_halos_ ); // Jy
+                vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi, smpi->shared_halos_ ); // Jz
+            }
+            
+            if( smpi->shared_halos_ ) {
+                exchange_shared_halos( vecPatches.densitiesMPIz, &vecPatches.MPIzIdx, 3, vecPatches, smpi, 2, 3, true );
             }
             
             // iDim = 2 local
@@ -1099,10 +1277,13 @@ void SyncVectorPatch::exchange_along_all_directions( std::vector<Field *> fields
         #pragma omp single
 #endif
         for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
-            vecPatches( ipatch )->initExchange( fields[ipatch], iDim, smpi );
+            vecPatches( ipatch )->initExchange( fields[ipatch], iDim, smpi, smpi->shared_halos_ );
         }
     } // End for iDim
     
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( fields, NULL, 1, vecPatches, smpi, 0, fields[0]->dims_.size(), false );
+    }
     
     unsigned int nx_, ny_( 1 ), nz_( 1 ), h0, oversize[3], n_space[3], gsp[3];
     double *pt1, *pt2;
@@ -1187,6 +1368,107 @@ void SyncVectorPatch::finalize_exchange_along_all_directions( std::vector<Field
     
 }
 
+// Copy the cells [istart, istart+width[ along iDim of a field to (or from) a contiguous buffer
+static void copy_halo( Field *field, unsigned int iDim, unsigned int istart, unsigned int width, double *buffer, bool to_buffer )
+{
+    unsigned int nouter = 1, ninner = 1;
+    for( unsigned int d=0 ; d<iDim ; d++ ) {
+        nouter *= field->dims_[d];
+    }
+    for( unsigned int d=iDim+1 ; d<field->dims_.size() ; d++ ) {
+        ninner *= field->dims_[d];
+    }
+    unsigned int n = field->dims_[iDim];
+    for( unsigned int i=0 ; i<nouter ; i++ ) {
+        double *pt = &( *field )( ( i*n + istart )*ninner );
+        double *buf = buffer + i*width*ninner;
+        if( to_buffer ) {
+            memcpy( buf, pt, width*ninner*sizeof( double ) );
+        } else {
+            memcpy( pt, buf, width*ninner*sizeof( double ) );
+        }
+    }
+}
+
+// fields : contains nComp field components, for all patches of vecPatches or for the patches listed in patchIdx
+//     - the field ifield of component icomp is fields[icomp*nField+ifield], owned by vecPatches( patchIdx[ifield] )
+// The halos are those that Patch::initExchange / initSumField send through MPI, in the same layout
+void SyncVectorPatch::exchange_shared_halos( std::vector<Field *> &fields, std::vector<int> *patchIdx, unsigned int nComp, VectorPatch &vecPatches, SmileiMPI *smpi, unsigned int iDim0, unsigned int iDim1, bool sum )
+{
+    unsigned int nDim = vecPatches( 0 )->EMfields->Ex_->dims_.size();
+    unsigned int oversize[3], n_space[3];
+    for( unsigned int iDim=0 ; iDim<3 ; iDim++ ) {
+        oversize[iDim] = vecPatches( 0 )->EMfields->oversize[iDim];
+        n_space[iDim] = vecPatches( 0 )->EMfields->n_space[iDim];
+    }
+    unsigned int nField = patchIdx ? patchIdx->size() : vecPatches.size();
+    
+    // Slots large enough for the halos of all fields (primal or dual) in all directions
+    #pragma omp single
+    {
+        unsigned int slot_size = 0;
+        for( unsigned int iDim=0 ; iDim<nDim ; iDim++ ) {
+            unsigned int size = 2*oversize[iDim]+2;
+            for( unsigned int d=0 ; d<nDim ; d++ ) {
+                if( d != iDim ) {
+                    size *= n_space[d]+2*oversize[d]+2;
+                }
+            }
+            slot_size = max( slot_size, size );
+        }
+        smpi->reserveSharedHalos( slot_size, nDim, nComp );
+    }
+    
+    // Write the halos sent
+    #pragma omp for schedule(static)
+    for( unsigned int ifield=0 ; ifield<nComp*nField ; ifield++ ) {
+        unsigned int icomp = ifield/nField;
+        Patch *patch = vecPatches( patchIdx ? ( *patchIdx )[ifield%nField] : ifield%nField );
+        Field *field = fields[ifield];
+        for( unsigned int iDim=iDim0 ; iDim<iDim1 ; iDim++ ) {
+            unsigned int n = field->dims_[iDim];
+            unsigned int ghost = 2*oversize[iDim]+1+field->isDual_[iDim];
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( smpi->sharedHalo( patch->MPI_neighbor_[iDim][iNeighbor] ) ) {
+                    double *halo = smpi->sharedHaloSend( patch->hindex, icomp, iDim, iNeighbor );
+                    if( sum ) {
+                        copy_halo( field, iDim, iNeighbor*( n-ghost ), ghost, halo, true );
+                    } else {
+                        copy_halo( field, iDim, iNeighbor ? n-ghost : ghost-oversize[iDim], oversize[iDim], halo, true );
+                    }
+                }
+            }
+        }
+    }
+    
+    #pragma omp single
+    smpi->syncSharedHalos();
+    
+    // Read the halos received
+    #pragma omp for schedule(static)
+    for( unsigned int ifield=0 ; ifield<nComp*nField ; ifield++ ) {
+        unsigned int icomp = ifield/nField;
+        Patch *patch = vecPatches( patchIdx ? ( *patchIdx )[ifield%nField] : ifield%nField );
+        Field *field = fields[ifield];
+        for( unsigned int iDim=iDim0 ; iDim<iDim1 ; iDim++ ) {
+            unsigned int n = field->dims_[iDim];
+            for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                int rank = patch->MPI_neighbor_[iDim][iNeighbor];
+                if( smpi->sharedHalo( rank ) ) {
+                    double *halo = smpi->sharedHaloRecv( rank, patch->neighbor_[iDim][iNeighbor], icomp, iDim, 1-iNeighbor );
+                    if( sum ) {
+                        std::vector<double> &buf = field->MPIbuff.buf[iDim][iNeighbor];
+                        memcpy( &buf[0], halo, buf.size()*sizeof( double ) );
+                    } else {
+                        copy_halo( field, iDim, iNeighbor*( n-oversize[iDim] ), oversize[iDim], halo, false );
+                    }
+                }
+            }
+        }
+    }
+
+}
+
 void SyncVectorPatch::exchangeComplex( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi )
 {
     for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
@@ -1413,7 +1695,11 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field *>
         #pragma omp single
 #endif
         for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
-            vecPatches( ipatch )->initExchange( fields[ipatch], 2, smpi );
+            vecPatches( ipatch )->initExchange( fields[ipatch], 2, smpi, smpi->shared_halos_ );
+        }
+        
+        if( smpi->shared_halos_ ) {
+            exchange_shared_halos( fields, NULL, 1, vecPatches, smpi, 2, 3, false );
         }
         
 #ifndef _NO_MPI_TM
@@ -1456,7 +1742,11 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field *>
     #pragma omp single
 #endif
     for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
-        vecPatches( ipatch )->initExchange( fields[ipatch], 1, smpi );
+        vecPatches( ipatch )->initExchange( fields[ipatch], 1, smpi, smpi->shared_halos_ );
+    }
+    
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( fields, NULL, 1, vecPatches, smpi, 1, 2, false );
     }
     
 #ifndef _NO_MPI_TM
@@ -1495,7 +1785,11 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field *>
     #pragma omp single
 #endif
     for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
-        vecPatches( ipatch )->initExchange( fields[ipatch], 0, smpi );
+        vecPatches( ipatch )->initExchange( fields[ipatch], 0, smpi, smpi->shared_halos_ );
+    }
+    
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( fields, NULL, 1, vecPatches, smpi, 0, 1, false );
     }
     
 #ifndef _NO_MPI_TM
@@ -1543,8 +1837,12 @@ void SyncVectorPatch::exchange_all_components_along_X( std::vector<Field *> &fie
 #endif
     for( unsigned int ifield=0 ; ifield<nMPIx ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
-        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi, smpi->shared_halos_ ); // By
+        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi, smpi->shared_halos_ ); // Bz
+    }
+    
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( vecPatches.B_MPIx, &vecPatches.MPIxIdx, 2, vecPatches, smpi, 0, 1, false );
     }
     
     
@@ -1627,8 +1925,12 @@ void SyncVectorPatch::exchange_all_components_along_Y( std::vector<Field *> &fie
 #endif
     for( unsigned int ifield=0 ; ifield<nMPIy ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi ); // Bx
-        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi, smpi->shared_halos_ ); // Bx
+        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi, smpi->shared_halos_ ); // Bz
+    }
+    
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( vecPatches.B1_MPIy, &vecPatches.MPIyIdx, 2, vecPatches, smpi, 1, 2, false );
     }
     
     unsigned int h0, oversize, n_space;
@@ -1715,8 +2017,12 @@ void SyncVectorPatch::exchange_all_components_along_Z( std::vector<Field *> fiel
 #endif
     for( unsigned int ifield=0 ; ifield<nMPIz ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
-        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi, smpi->shared_halos_ ); // Bx
+        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi, smpi->shared_halos_ ); // By
+    }
+    
+    if( smpi->shared_halos_ ) {
+        exchange_shared_halos( vecPatches.B2_MPIz, &vecPatches.MPIzIdx, 2, vecPatches, smpi, 2, 3, false );
     }
     
     unsigned int h0, oversize, n_space;
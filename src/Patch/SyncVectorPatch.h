@@ -17,6 +17,10 @@ public :
     //! Particles synchronization
     static void exchangeParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
     static void finalize_and_sort_parts( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
+    static void sendParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
+    static void importParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
+    static void sendParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
+    static void importParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
     static void finalizeExchangeParticles( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi, Timers &timers, int itime );
     
     //! Densities synchronization
@@ -32,6 +36,8 @@ public :
     static void sumEnvChis( Params &params, VectorPatch &vecPatches, int ispec, SmileiMPI *smp, Timers &timers, int itime );
     
     static void sum( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
+    //! Sum of a single field component, without OpenMP worksharing (may be called by a single thread)
+    static void sum_noomp( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void sumComplex( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
     static void sum_all_components( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
     
@@ -56,6 +62,10 @@ public :
     static void exchangeEnvChi( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
     
     static void exchange_along_all_directions( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
+    //! Halos of the directions [iDim0,iDim1[ exchanged with the processes of the same node (see Main.shared_memory_halos)
+    //!   - fields: nComp components of the fields of all patches (patchIdx = NULL) or of the patches listed in patchIdx
+    //!   - sum = false: copied in the ghost cells, sum = true: copied in MPIbuff.buf, then summed by Patch::finalizeSumField
+    static void exchange_shared_halos( std::vector<Field *> &fields, std::vector<int> *patchIdx, unsigned int nComp, VectorPatch &vecPatches, SmileiMPI *smpi, unsigned int iDim0, unsigned int iDim1, bool sum );
     static void finalize_exchange_along_all_directions( std::vector<Field *> fields, VectorPatch &vecPatches );
     
     static void exchangeComplex( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
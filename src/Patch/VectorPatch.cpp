@@ -17,9 +17,11 @@
 #include "SimWindow.h"
 #include "SolverFactory.h"
 #include "DiagnosticFactory.h"
+#include "DiagnosticParticleBinning.h"
 #include "LaserEnvelope.h"
 
 #include "SyncVectorPatch.h"
+#include "PoissonMultigrid.h"
 #include "interface.h"
 #include "Timers.h"
 
@@ -87,6 +89,7 @@ void VectorPatch::createDiags( Params &params, SmileiMPI *smpi, OpenPMDparams &o
 {
     globalDiags = DiagnosticFactory::createGlobalDiagnostics( params, smpi, *this );
     localDiags  = DiagnosticFactory::createLocalDiagnostics( params, smpi, *this, openPMD );
+    diagWriter.start( params.async_diags );
     
     // Delete all unused fields
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
@@ -295,12 +298,15 @@ void VectorPatch::dynamics( Params &params,
     
     timers.particles.restart();
     ostringstream t;
+    bool measure_load = params.has_load_balancing && params.measured_load;
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        double load_timer = measure_load ? MPI_Wtime() : 0.;
         ( *this )( ipatch )->EMfields->restartRhoJ();
         //MESSAGE("restart rhoj");
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
+                ( *this )( ipatch )->rand_->setStream( ( *this )( ipatch )->hindex, Random::dynamics, itime, ispec );
                 // Dynamics with vectorized operators
                 if( ( ( *this )( ipatch )->vecSpecies[ispec]->vectorized_operators )&&( !( *this )( ipatch )->vecSpecies[ispec]->ponderomotive_dynamics ) ) {
                     species( ipatch, ispec )->dynamics( time_dual, ispec,
@@ -334,6 +340,10 @@ void VectorPatch::dynamics( Params &params,
             } // end if condition on species
         } // end loop on species
         //MESSAGE("species dynamics");
+        if( measure_load ) {
+            ( *this )( ipatch )->load_timer_ += MPI_Wtime() - load_timer;
+            ( *this )( ipatch )->updateMeasuredLoad( params.measured_load_smoothing );
+        }
     } // end loop on patches
     
     
@@ -410,6 +420,28 @@ void VectorPatch::projection_for_diags( Params &params,
     
 } // END projection for diags
 
+// ---------------------------------------------------------------------------------------------------------------------
+// For all species, complete the exchange of the number of particles started in dynamics and post the exchange of
+// particles (with all the neighbors, or only along x in AMcylindrical geometry). Their communication progresses while
+// solving Maxwell, and finalize_and_sort_parts waits for them.
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::sendParticles( Params &params, SmileiMPI *smpi, SimWindow *simWindow,
+                                 double time_dual, Timers &timers, int itime )
+{
+    timers.syncPart.restart();
+    for( unsigned int ispec=0 ; ispec<( *this )( 0 )->vecSpecies.size(); ispec++ ) {
+        if( ( *this )( 0 )->vecSpecies[ispec]->isProj( time_dual, simWindow ) ) {
+            if( params.geometry != "AMcylindrical" ) {
+                SyncVectorPatch::sendParticles( ( *this ), ispec, params, smpi, timers, itime );
+            } else {
+                SyncVectorPatch::sendParticles( ( *this ), ispec, 0, params, smpi, timers, itime );
+            }
+        }
+    }
+    timers.syncPart.update( params.printNow( itime ) );
+    
+} // END sendParticles
+
 void VectorPatch::finalize_and_sort_parts( Params &params, SmileiMPI *smpi, SimWindow *simWindow,
         double time_dual, Timers &timers, int itime )
 {
@@ -647,6 +679,18 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         //for (unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++) {
         ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
         //MESSAGE("SOLVE MAXWELL FARADAY");
+#ifndef _NO_MPI_TM
+        // Progress the exchange of particles posted by sendParticles
+        for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
+            if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) ) {
+                if( params.geometry != "AMcylindrical" ) {
+                    ( *this )( ipatch )->testExchParticles( ispec );
+                } else {
+                    ( *this )( ipatch )->testExchParticles( ispec, 0 );
+                }
+            }
+        }
+#endif
     }
     //Synchronize B fields between patches.
     timers.maxwell.update( params.printNow( itime ) );
@@ -812,10 +856,8 @@ void VectorPatch::initAllDiags( Params &params, SmileiMPI *smpi )
     // Global diags: scalars + particles
     for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
         globalDiags[idiag]->init( params, smpi, *this );
-        // MPI master creates the file
-        if( smpi->isMaster() ) {
-            globalDiags[idiag]->openFile( params, smpi, true );
-        }
+        // MPI master creates the file (all MPI in case of parallel writes)
+        globalDiags[idiag]->openFile( params, smpi, true );
     }
     
     // Local diags : fields, probes, tracks
@@ -828,12 +870,14 @@ void VectorPatch::initAllDiags( Params &params, SmileiMPI *smpi )
 
 void VectorPatch::closeAllDiags( SmileiMPI *smpi )
 {
-    // MPI master closes all global diags
-    if( smpi->isMaster() )
-        for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
-            globalDiags[idiag]->closeFile();
-        }
-        
+    // Finish the writes of the local diags
+    diagWriter.wait();
+    
+    // MPI master closes all global diags (all MPI in case of parallel writes)
+    for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+        globalDiags[idiag]->closeFile();
+    }
+    
     // All MPI close local diags
     for( unsigned int idiag = 0 ; idiag < localDiags.size() ; idiag++ ) {
         localDiags[idiag]->closeFile();
@@ -843,12 +887,11 @@ void VectorPatch::closeAllDiags( SmileiMPI *smpi )
 
 void VectorPatch::openAllDiags( Params &params, SmileiMPI *smpi )
 {
-    // MPI master opens all global diags
-    if( smpi->isMaster() )
-        for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
-            globalDiags[idiag]->openFile( params, smpi, false );
-        }
-        
+    // MPI master opens all global diags (all MPI in case of parallel writes)
+    for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+        globalDiags[idiag]->openFile( params, smpi, false );
+    }
+    
     // All MPI open local diags
     for( unsigned int idiag = 0 ; idiag < localDiags.size() ; idiag++ ) {
         localDiags[idiag]->openFile( params, smpi, false );
@@ -865,29 +908,66 @@ void VectorPatch::runAllDiags( Params &params, SmileiMPI *smpi, unsigned int iti
 {
     // Global diags: scalars + particles
     timers.diags.restart();
+    #pragma omp single
+    {
+        binningDiags.resize( 0 );
+        for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+            globalDiags[idiag]->theTimeIsNow = globalDiags[idiag]->prepare( itime );
+            // Particle binning diags that must run now are grouped
+            DiagnosticParticleBinning *binning = dynamic_cast<DiagnosticParticleBinning *>( globalDiags[idiag] );
+            if( binning && binning->theTimeIsNow ) {
+                binningDiags.push_back( binning );
+            }
+        }
+    }
+    #pragma omp barrier
     for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
         diag_timers[idiag]->restart();
         
-        #pragma omp single
-        globalDiags[idiag]->theTimeIsNow = globalDiags[idiag]->prepare( itime );
-        #pragma omp barrier
         if( globalDiags[idiag]->theTimeIsNow ) {
-            // All patches run
-            #pragma omp for schedule(runtime)
-            for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
-                globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+            if( !binningDiags.empty() && globalDiags[idiag] == binningDiags[0] ) {
+                // All patches run all the particle binning diags, with a single sweep over the particles
+                #pragma omp for schedule(runtime)
+                for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+                    DiagnosticParticleBinning::runFused( binningDiags, ( *this )( ipatch ), itime, simWindow );
+                }
+            } else if( !dynamic_cast<DiagnosticParticleBinning *>( globalDiags[idiag] ) ) {
+                // All patches run
+                #pragma omp for schedule(runtime)
+                for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+                    globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+                }
             }
-            // MPI procs gather the data and compute
-            #pragma omp single
-            smpi->computeGlobalDiags( globalDiags[idiag], itime );
-            // MPI master writes
-            #pragma omp single
-            globalDiags[idiag]->write( itime, smpi );
         }
         
         diag_timers[idiag]->update();
     }
     
+    // MPI procs gather the data of all the diags at once and compute
+    #pragma omp single
+    {
+        smpi->computeGlobalDiags( globalDiags, itime );
+        // Scalars excepted, the diags use HDF5 so the local diags writes must be finished before writing.
+        // The reductions proceed meanwhile.
+        for( unsigned int idiag = 1 ; idiag < globalDiags.size() ; idiag++ ) {
+            if( globalDiags[idiag]->theTimeIsNow ) {
+                diagWriter.wait();
+                break;
+            }
+        }
+        smpi->completeGlobalDiags( globalDiags, itime );
+    }
+    
+    // MPI master writes
+    for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+        if( globalDiags[idiag]->theTimeIsNow ) {
+            diag_timers[idiag]->restart();
+            #pragma omp single
+            globalDiags[idiag]->write( itime, smpi );
+            diag_timers[idiag]->update();
+        }
+    }
+    
     // Local diags : fields, probes, tracks
     for( unsigned int idiag = 0 ; idiag < localDiags.size() ; idiag++ ) {
         diag_timers[globalDiags.size()+idiag]->restart();
@@ -959,6 +1039,15 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     }
     MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
     
+    // With a preconditioner, the first direction is p = z = M^-1 r
+    PoissonMultigrid *preconditioner = NULL;
+    double rnew_dot_znew = rnew_dot_rnew;
+    if( params.poisson_preconditioner == "multigrid" ) {
+        preconditioner = new PoissonMultigrid( params, *this, smpi );
+        preconditioner->apply( *this, smpi, rnew_dot_rnew, rnew_dot_znew );
+        preconditioner->update_p( *this, 0. );
+    }
+    
     std::vector<Field *> Ex_;
     std::vector<Field *> Ap_;
     
@@ -990,8 +1079,9 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
             DEBUG( "iteration " << iteration << " started with control parameter ctrl = " << ctrl*1.e14 << " x 1e-14" );
         }
         
-        // scalar product of the residual
+        // scalar product of the residual (preconditioned)
         double r_dot_r = rnew_dot_rnew;
+        double r_dot_z = rnew_dot_znew;
         
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
             ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
@@ -1012,25 +1102,32 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
         
         // compute new potential and residual
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_z, p_dot_Ap );
         }
         
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+        if( preconditioner ) {
+            // preconditioned residual, residual norm and new direction
+            preconditioner->apply( *this, smpi, rnew_dot_rnew, rnew_dot_znew );
+            preconditioner->update_p( *this, rnew_dot_znew/r_dot_z );
+        } else {
+            // compute new residual norm
+            rnew_dot_rnew       = 0.0;
+            rnew_dot_rnew_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            }
+            MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            rnew_dot_znew = rnew_dot_rnew;
+            
+            // compute new directio
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
         }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
         if( smpi->isMaster() ) {
             DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
         }
         
-        // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
-        }
-        
         // compute control parameter
         ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
         if( smpi->isMaster() ) {
@@ -1039,6 +1136,8 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
         
     }//End of the iterative loop
     
+    delete preconditioner;
+    
     
     // --------------------------------
     // Status of the solver convergence
@@ -1265,6 +1364,15 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     //cout << std::scientific << "rnew_dot_rnew_local = " << rnew_dot_rnew_local << endl;
     MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
     
+    // With a preconditioner, the first direction is p = z = M^-1 r
+    PoissonMultigrid *preconditioner = NULL;
+    double rnew_dot_znew = rnew_dot_rnew;
+    if( params.poisson_preconditioner == "multigrid" ) {
+        preconditioner = new PoissonMultigrid( params, *this, smpi, gamma_mean );
+        preconditioner->apply( *this, smpi, rnew_dot_rnew, rnew_dot_znew );
+        preconditioner->update_p( *this, 0. );
+    }
+    
     std::vector<Field *> Ex_;
     std::vector<Field *> Ey_;
     std::vector<Field *> Ez_;
@@ -1347,8 +1455,9 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
             MESSAGE( "iteration " << iteration << " started with control parameter ctrl = " << 1.0e22*ctrl << " x 1.e-22" );
         }
         
-        // scalar product of the residual
+        // scalar product of the residual (preconditioned)
         double r_dot_r = rnew_dot_rnew;
+        double r_dot_z = rnew_dot_znew;
         
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
             ( *this )( ipatch )->EMfields->compute_Ap_relativistic_Poisson( ( *this )( ipatch ), gamma_mean );
@@ -1370,25 +1479,32 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
         
         // compute new potential and residual
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_z, p_dot_Ap );
         }
         
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+        if( preconditioner ) {
+            // preconditioned residual, residual norm and new direction
+            preconditioner->apply( *this, smpi, rnew_dot_rnew, rnew_dot_znew );
+            preconditioner->update_p( *this, rnew_dot_znew/r_dot_z );
+        } else {
+            // compute new residual norm
+            rnew_dot_rnew       = 0.0;
+            rnew_dot_rnew_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            }
+            MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            rnew_dot_znew = rnew_dot_rnew;
+            
+            // compute new directio
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
         }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
         if( smpi->isMaster() ) {
             DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
         }
         
-        // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
-        }
-        
         // compute control parameter
         //ctrl = rnew_dot_rnew / (double)(nx_p2_global);
         ctrl = sqrt( rnew_dot_rnew )/norm2_source_term;
@@ -1398,6 +1514,8 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
         
     }//End of the iterative loop
     
+    delete preconditioner;
+    
     
     // --------------------------------
     // Status of the solver convergence
@@ -2402,13 +2520,20 @@ void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
         }
         
     unsigned int ncoll = patches_[0]->vecCollisions.size();
+    bool measure_load = params.has_load_balancing && params.measured_load && ncoll > 0;
     
     #pragma omp for schedule(runtime)
-    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ )
+    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        double load_timer = measure_load ? MPI_Wtime() : 0.;
         for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+            patches_[ipatch]->rand_->setStream( patches_[ipatch]->hindex, Random::collisions, itime, icoll );
             patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
         }
-        
+        if( measure_load ) {
+            patches_[ipatch]->load_timer_ += MPI_Wtime() - load_timer;
+        }
+    }
+    
     #pragma omp single
     for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
         Collisions::debug( params, itime, icoll, *this );
@@ -2634,7 +2759,8 @@ void VectorPatch::check_expected_disk_usage( SmileiMPI *smpi, Params &params, Ch
                 Particles *p = s->particles;
                 //     * Calculate the size of particles' individual parameters
                 uint64_t one_particle_size = 0;
-                one_particle_size += ( p->Position.size() + p->Momentum.size() + 1 ) * sizeof( double );
+                one_particle_size += ( p->Position.size() + 1 ) * sizeof( double );
+                one_particle_size += p->Momentum.size() * sizeof( momentum_t );
                 one_particle_size += 1 * sizeof( short );
                 if( p->tracked ) {
                     one_particle_size += 1 * sizeof( uint64_t );
@@ -2691,6 +2817,7 @@ void VectorPatch::ponderomotive_update_susceptibility_and_momentum( Params &para
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
                 if( species( ipatch, ispec )->ponderomotive_dynamics ) {
+                    ( *this )( ipatch )->rand_->setStream( ( *this )( ipatch )->hindex, Random::dynamics, itime, ispec );
                     if( ( *this )( ipatch )->vecSpecies[ispec]->vectorized_operators )
                         species( ipatch, ispec )->ponderomotive_update_susceptibility_and_momentum( time_dual, ispec,
                                 emfields( ipatch ),
@@ -2743,6 +2870,7 @@ void VectorPatch::ponderomotive_update_position_and_currents( Params &params,
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
                 if( species( ipatch, ispec )->ponderomotive_dynamics ) {
+                    ( *this )( ipatch )->rand_->setStream( ( *this )( ipatch )->hindex, Random::boundaries, itime, ispec );
                     if( ( *this )( ipatch )->vecSpecies[ispec]->vectorized_operators )
                         species( ipatch, ispec )->ponderomotive_update_position_and_currents( time_dual, ispec,
                                 emfields( ipatch ),
@@ -12,6 +12,7 @@
 #include "ProjectorFactory.h"
 
 #include "DiagnosticScalar.h"
+#include "DiagnosticWriter.h"
 
 #include "Checkpoint.h"
 #include "OpenPMDparams.h"
@@ -24,6 +25,7 @@ class Field;
 class Timer;
 class SimWindow;
 class DomainDecomposition;
+class DiagnosticParticleBinning;
 
 //! Class Patch : sub MPI domain
 //!     Collection of patch = MPI domain
@@ -47,8 +49,12 @@ public :
     
     //! Vector of global diagnostics (diagnostics which cannot be computed locally)
     std::vector<Diagnostic *> globalDiags;
+    //! Particle binning diagnostics running at the current timestep
+    std::vector<DiagnosticParticleBinning *> binningDiags;
     //! Vector of local diagnostics (diagnostics which can partly be computed locally)
     std::vector<Diagnostic *> localDiags;
+    //! Background writer of the local diagnostics
+    DiagnosticWriter diagWriter;
     
     //! Some vector operations extended to VectorPatch
     inline void resize( int npatches )
@@ -119,6 +125,10 @@ public :
                    double time_dual,
                    Timers &timers, int itime );
                    
+    //! Post the exchange of particles along x, so that it progresses while solving Maxwell
+    void sendParticles( Params &params, SmileiMPI *smpi, SimWindow *simWindow,
+                        double time_dual, Timers &timers, int itime );
+                        
     void finalize_and_sort_parts( Params &params, SmileiMPI *smpi, SimWindow *simWindow,
                                   double time_dual,
                                   Timers &timers, int itime );
@@ -77,6 +77,377 @@ PyArrayObject *Function_Python3D::valueAt( std::vector<PyArrayObject *> x )
 #endif
 
 
+// Native expressions
+namespace
+{
+struct OperationName {
+    const char *name;
+    int operation;
+    unsigned int arity;
+};
+}
+
+Function_Expression *Function_Expression::translate( PyObject *py_profile, unsigned int nvariables )
+{
+    Function_Expression *f = NULL;
+    PyObject *native_expression = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_native_expression" );
+    if( native_expression ) {
+        PyObject *translation = PyObject_CallFunction( native_expression, const_cast<char *>( "(Oi)" ), py_profile, nvariables );
+        PyTools::checkPyError( false, false );
+        if( translation && translation != Py_None ) {
+            f = new Function_Expression( nvariables );
+            if( ! f->parse( translation ) ) {
+                delete f;
+                f = NULL;
+                // Tell python that the profile must still be evaluated by python
+                PyObject_SetAttrString( py_profile, "_smilei_native", Py_None );
+            }
+        }
+        Py_XDECREF( translation );
+        Py_DECREF( native_expression );
+    }
+    PyErr_Clear();
+    return f;
+}
+
+bool Function_Expression::parse( PyObject *translation )
+{
+    static const OperationName operations[] = {
+        {"x", op_variable, 0}, {"c", op_constant, 0},
+        {"+", op_add, 2}, {"-", op_sub, 2}, {"*", op_mul, 2}, {"/", op_div, 2}, {"**", op_pow, 2},
+        {"atan2", op_atan2, 2}, {"max", op_max, 2}, {"min", op_min, 2},
+        {"<", op_lt, 2}, {"<=", op_le, 2}, {">", op_gt, 2}, {">=", op_ge, 2}, {"==", op_eq, 2}, {"!=", op_ne, 2},
+        {"and", op_and, 2}, {"or", op_or, 2},
+        {"neg", op_neg, 1}, {"not", op_not, 1}, {"abs", op_abs, 1}, {"exp", op_exp, 1}, {"log", op_log, 1},
+        {"log10", op_log10, 1}, {"sqrt", op_sqrt, 1}, {"sin", op_sin, 1}, {"cos", op_cos, 1}, {"tan", op_tan, 1},
+        {"asin", op_asin, 1}, {"acos", op_acos, 1}, {"atan", op_atan, 1}, {"sinh", op_sinh, 1}, {"cosh", op_cosh, 1},
+        {"tanh", op_tanh, 1}, {"floor", op_floor, 1}, {"ceil", op_ceil, 1}
+    };
+    const unsigned int noperations = sizeof( operations )/sizeof( operations[0] );
+    
+    std::vector<PyObject *> parts, py_samples;
+    std::vector<std::string> names;
+    std::vector<double> values;
+    if( !PyTools::convert( translation, parts ) || parts.size() != 3
+            || !PyTools::convert( parts[0], names ) || !PyTools::convert( parts[1], values )
+            || !PyTools::convert( parts[2], py_samples ) || names.size() != values.size() ) {
+        return false;
+    }
+    
+    // Read the code, and verify that the stack holds a single value in the end
+    unsigned int stack_size = 0;
+    code_.resize( names.size() );
+    for( unsigned int i=0; i<names.size(); i++ ) {
+        unsigned int iop = 0;
+        while( iop<noperations && names[i] != operations[iop].name ) {
+            iop++;
+        }
+        if( iop == noperations || stack_size < operations[iop].arity ) {
+            return false;
+        }
+        code_[i].operation = ( Operation ) operations[iop].operation;
+        code_[i].index = 0;
+        code_[i].value = values[i];
+        if( code_[i].operation == op_variable ) {
+            code_[i].index = ( unsigned int ) values[i];
+            if( code_[i].index >= nvariables_ ) {
+                return false;
+            }
+        }
+        stack_size += 1 - operations[iop].arity;
+        if( stack_size > max_stack ) {
+            return false;
+        }
+    }
+    if( stack_size != 1 ) {
+        return false;
+    }
+    
+    // Compare with the values given by python
+    for( unsigned int i=0; i<py_samples.size(); i++ ) {
+        std::vector<double> sample;
+        if( !PyTools::convert( py_samples[i], sample ) || sample.size() != nvariables_+1 ) {
+            return false;
+        }
+        double expected = sample[nvariables_];
+        double value = evaluate( &sample[0] );
+        if( value != expected
+                && !( std::isnan( value ) && std::isnan( expected ) )
+                && !( std::abs( value - expected ) <= 1e-12 * std::abs( expected ) ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double Function_Expression::evaluate( const double *v )
+{
+    double stack[max_stack];
+    unsigned int s = 0;
+    for( unsigned int i=0; i<code_.size(); i++ ) {
+        Operation operation = code_[i].operation;
+        if( operation == op_variable ) {
+            stack[s++] = v[code_[i].index];
+        } else if( operation == op_constant ) {
+            stack[s++] = code_[i].value;
+        } else if( operation < op_neg ) {
+            apply( operation, &stack[s-2], &stack[s-1], 1 );
+            s--;
+        } else {
+            apply( operation, &stack[s-1], NULL, 1 );
+        }
+    }
+    return stack[0];
+}
+
+void Function_Expression::valuesAt( std::vector<double *> &x, double *ret, unsigned int n )
+{
+    double stack[max_stack][block_size];
+    for( unsigned int i0=0; i0<n; i0+=block_size ) {
+        unsigned int m = n-i0 < block_size ? n-i0 : block_size;
+        unsigned int s = 0;
+        for( unsigned int i=0; i<code_.size(); i++ ) {
+            Operation operation = code_[i].operation;
+            if( operation == op_variable ) {
+                double *xi = x[code_[i].index] + i0;
+                for( unsigned int j=0; j<m; j++ ) {
+                    stack[s][j] = xi[j];
+                }
+                s++;
+            } else if( operation == op_constant ) {
+                double value = code_[i].value;
+                for( unsigned int j=0; j<m; j++ ) {
+                    stack[s][j] = value;
+                }
+                s++;
+            } else if( operation < op_neg ) {
+                apply( operation, stack[s-2], stack[s-1], m );
+                s--;
+            } else {
+                apply( operation, stack[s-1], NULL, m );
+            }
+        }
+        for( unsigned int j=0; j<m; j++ ) {
+            ret[i0+j] = stack[0][j];
+        }
+    }
+}
+
+void Function_Expression::apply( Operation operation, double *a, const double *b, unsigned int n )
+{
+    switch( operation ) {
+        case op_add:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] += b[i];
+            }
+            break;
+        case op_sub:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] -= b[i];
+            }
+            break;
+        case op_mul:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] *= b[i];
+            }
+            break;
+        case op_div:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] /= b[i];
+            }
+            break;
+        case op_pow:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = pow( a[i], b[i] );
+            }
+            break;
+        case op_atan2:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = atan2( a[i], b[i] );
+            }
+            break;
+        case op_max: // propagates nan, as numpy.maximum
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = ( a[i] != a[i] || a[i] > b[i] ) ? a[i] : b[i];
+            }
+            break;
+        case op_min:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = ( a[i] != a[i] || a[i] < b[i] ) ? a[i] : b[i];
+            }
+            break;
+        case op_lt:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] < b[i] ? 1. : 0.;
+            }
+            break;
+        case op_le:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] <= b[i] ? 1. : 0.;
+            }
+            break;
+        case op_gt:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] > b[i] ? 1. : 0.;
+            }
+            break;
+        case op_ge:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] >= b[i] ? 1. : 0.;
+            }
+            break;
+        case op_eq:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] == b[i] ? 1. : 0.;
+            }
+            break;
+        case op_ne:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] != b[i] ? 1. : 0.;
+            }
+            break;
+        case op_and:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = ( a[i] != 0. && b[i] != 0. ) ? 1. : 0.;
+            }
+            break;
+        case op_or:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = ( a[i] != 0. || b[i] != 0. ) ? 1. : 0.;
+            }
+            break;
+        case op_neg:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = -a[i];
+            }
+            break;
+        case op_not:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = a[i] == 0. ? 1. : 0.;
+            }
+            break;
+        case op_abs:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = std::abs( a[i] );
+            }
+            break;
+        case op_sqrt:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = sqrt( a[i] );
+            }
+            break;
+        case op_exp:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = exp( a[i] );
+            }
+            break;
+        case op_log:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = log( a[i] );
+            }
+            break;
+        case op_log10:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = log10( a[i] );
+            }
+            break;
+        case op_sin:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = sin( a[i] );
+            }
+            break;
+        case op_cos:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = cos( a[i] );
+            }
+            break;
+        case op_tan:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = tan( a[i] );
+            }
+            break;
+        case op_asin:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = asin( a[i] );
+            }
+            break;
+        case op_acos:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = acos( a[i] );
+            }
+            break;
+        case op_atan:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = atan( a[i] );
+            }
+            break;
+        case op_sinh:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = sinh( a[i] );
+            }
+            break;
+        case op_cosh:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = cosh( a[i] );
+            }
+            break;
+        case op_tanh:
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = tanh( a[i] );
+            }
+            break;
+        case op_floor:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = floor( a[i] );
+            }
+            break;
+        case op_ceil:
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                a[i] = ceil( a[i] );
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+double Function_Expression::valueAt( double time )
+{
+    return evaluate( &time );
+}
+double Function_Expression::valueAt( vector<double> x_cell, double time )
+{
+    double v[4];
+    for( unsigned int i=0; i+1<nvariables_; i++ ) {
+        v[i] = x_cell[i];
+    }
+    v[nvariables_-1] = time;
+    return evaluate( v );
+}
+double Function_Expression::valueAt( vector<double> x_cell )
+{
+    return evaluate( &x_cell[0] );
+}
+
+
 // Constant profiles
 double Function_Constant1D::valueAt( vector<double> x_cell )
 {
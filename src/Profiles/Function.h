@@ -142,6 +142,50 @@ private:
 
 
 
+// Child class for python functions translated into native expressions (see _native_expression in pycontrol.py)
+
+class Function_Expression : public Function
+{
+public:
+    //! Translates a python function of nvariables variables (returns NULL if not possible)
+    static Function_Expression *translate( PyObject *py_profile, unsigned int nvariables );
+    Function_Expression( Function_Expression *f ) : code_( f->code_ ), nvariables_( f->nvariables_ ) {};
+    double valueAt( double ); // time
+    double valueAt( std::vector<double>, double ); // space + time
+    double valueAt( std::vector<double> ); // space
+    //! Values at n points, given by the arrays of their coordinates (evaluated by blocks of points)
+    void valuesAt( std::vector<double *> &x, double *ret, unsigned int n );
+private:
+    enum Operation {
+        op_variable, op_constant,
+        op_add, op_sub, op_mul, op_div, op_pow, op_atan2, op_max, op_min,
+        op_lt, op_le, op_gt, op_ge, op_eq, op_ne, op_and, op_or,
+        op_neg, op_not, op_abs, op_exp, op_log, op_log10, op_sqrt, op_sin, op_cos, op_tan,
+        op_asin, op_acos, op_atan, op_sinh, op_cosh, op_tanh, op_floor, op_ceil
+    };
+    struct Instruction {
+        Operation operation;
+        unsigned int index; // variable index (op_variable)
+        double value; // constant value (op_constant)
+    };
+    Function_Expression( unsigned int nvariables ) : nvariables_( nvariables ) {};
+    //! Reads the postfix code and checks it against the samples of the python function
+    bool parse( PyObject *translation );
+    //! Value at one point
+    double evaluate( const double *v );
+    //! Applies an operation to n values of a (and b for binary operations), the result is stored in a
+    static void apply( Operation operation, double *a, const double *b, unsigned int n );
+    
+    //! Postfix code
+    std::vector<Instruction> code_;
+    unsigned int nvariables_;
+    //! Maximum number of values in the stack
+    static const unsigned int max_stack = 32;
+    //! Number of points evaluated together
+    static const unsigned int block_size = 64;
+};
+
+
 // Children classes for hard-coded functions
 
 class Function_Constant1D : public Function
@@ -12,7 +12,8 @@ using namespace std;
 Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bool try_numpy ) :
     profileName( "" ),
     nvariables_( nvariables ),
-    uses_numpy( false )
+    uses_numpy( false ),
+    uses_expression( false )
 {
     ostringstream info_( "" );
     info_ << nvariables_ << "D";
@@ -218,9 +219,15 @@ Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bo
         }
         
         
+        // If possible, translate the profile into a native expression, evaluated without python
+        if( try_numpy ) {
+            function = Function_Expression::translate( py_profile, nvariables_ );
+            uses_expression = ( function != NULL );
+        }
+        
         // Verify that the profile transforms a float in a float
 #ifdef SMILEI_USE_NUMPY
-        if( try_numpy ) {
+        if( try_numpy && !uses_expression ) {
             // If numpy available, verify that the profile accepts numpy arguments
             double test_value[2] = {0., 0.};
             npy_intp dims[1] = {2};
@@ -274,17 +281,20 @@ Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bo
         }
         
         // Assign the evaluating function, which depends on the number of arguments
-        if( nvariables_ == 1 ) {
-            function = new Function_Python1D( py_profile );
-        } else if( nvariables_ == 2 ) {
-            function = new Function_Python2D( py_profile );
-        } else if( nvariables_ == 3 ) {
-            function = new Function_Python3D( py_profile );
-        } else if( nvariables_ == 4 ) {
-            function = new Function_Python4D( py_profile );
+        if( uses_expression ) {
+            info_ << " user-defined function (native expression)";
+        } else {
+            if( nvariables_ == 1 ) {
+                function = new Function_Python1D( py_profile );
+            } else if( nvariables_ == 2 ) {
+                function = new Function_Python2D( py_profile );
+            } else if( nvariables_ == 3 ) {
+                function = new Function_Python3D( py_profile );
+            } else if( nvariables_ == 4 ) {
+                function = new Function_Python4D( py_profile );
+            }
+            info_ << " user-defined function";
         }
-        
-        info_ << " user-defined function";
     }
     
     info = info_.str();
@@ -298,7 +308,10 @@ Profile::Profile( Profile *p )
     nvariables_  = p->nvariables_ ;
     info        = p->info       ;
     uses_numpy  = p->uses_numpy ;
-    if( profileName != "" ) {
+    uses_expression = p->uses_expression;
+    if( uses_expression ) {
+        function = new Function_Expression( static_cast<Function_Expression *>( p->function ) );
+    } else if( profileName != "" ) {
         if( profileName == "constant" ) {
             if( nvariables_ == 1 ) {
                 function = new Function_Constant1D( static_cast<Function_Constant1D *>( p->function ) );
@@ -47,6 +47,14 @@ public:
     {
         unsigned int ndim = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // If the profile was translated into a native expression, evaluate it without python
+        if( uses_expression ) {
+            std::vector<double *> x( ndim );
+            for( unsigned int idim=0; idim<ndim; idim++ ) {
+                x[idim] = coordinates[idim]->data();
+            }
+            static_cast<Function_Expression *>( function )->valuesAt( x, ret.data(), size );
+        } else
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -81,6 +89,12 @@ public:
         }
     };
     
+    //! Whether the profile is evaluated by python (then, only one thread may evaluate it at a time)
+    inline bool usesPython()
+    {
+        return profileName == "" && !uses_expression;
+    };
+    
     //! Get info on the loaded profile, to be printed later
     inline std::string getInfo()
     {
@@ -103,6 +117,9 @@ private:
     //! Whether the profile is using numpy
     bool uses_numpy;
     
+    //! Whether the profile is a python function translated into a native expression
+    bool uses_expression;
+    
 };//END class Profile
 
 
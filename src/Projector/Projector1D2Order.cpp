@@ -327,11 +327,11 @@ void Projector1D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
     if( !diag_flag ) {
         if( !is_spectral ) {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
-                currents( Jx_, Jy_, Jz_, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                currents( Jx_, Jy_, Jz_, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref] );
             }
         } else {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
-                currentsAndDensity( Jx_, Jy_, Jz_, rho_, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                currentsAndDensity( Jx_, Jy_, Jz_, rho_, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref] );
             }
         }
         // Otherwise, the projection may apply to the species-specific arrays
@@ -341,7 +341,7 @@ void Projector1D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
         double *b_Jzs  = EMfields->Jz_s [ispec] ? &( *EMfields->Jz_s [ispec] )( 0 ) : &( *EMfields->Jz_ )( 0 ) ;
         double *b_rhos = EMfields->rho_s[ispec] ? &( *EMfields->rho_s[ispec] )( 0 ) : &( *EMfields->rho_ )( 0 ) ;
         for( int ipart=istart ; ipart<iend; ipart++ ) {
-            currentsAndDensity( b_Jxs, b_Jys, b_Jzs, b_rhos, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+            currentsAndDensity( b_Jxs, b_Jys, b_Jzs, b_rhos, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref] );
         }
     }
 }
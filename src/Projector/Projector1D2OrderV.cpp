@@ -0,0 +1,345 @@
+#include "Projector1D2OrderV.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "ElectroMagn.h"
+#include "Field1D.h"
+#include "Particles.h"
+#include "Tools.h"
+#include "Patch.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructor for Projector1D2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+Projector1D2OrderV::Projector1D2OrderV( Params &params, Patch *patch ) : Projector1D( params, patch )
+{
+    dx_inv_  = 1.0/params.cell_length[0];
+    dx_ov_dt = params.cell_length[0] / params.timestep;
+    
+    index_domain_begin = patch->getCellStartingGlobalIndex( 0 );
+    
+    oversize = params.oversize[0];
+    
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Destructor for Projector1D2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+Projector1D2OrderV::~Projector1D2OrderV()
+{
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities : main projector vectorized
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector1D2OrderV::currents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int ipart_ref )
+{
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+    
+    int ipo = iold[0];
+    int ipom2 = ipo-2;
+    
+    int vecSize = 8;
+    int bsize = 5*vecSize;
+    
+    double bJx[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJy[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJz[bsize] __attribute__( ( aligned( 64 ) ) );
+    
+    double S0[40] __attribute__( ( aligned( 64 ) ) );
+    double S1[40] __attribute__( ( aligned( 64 ) ) );
+    
+    #pragma omp simd
+    for( int j=0; j<bsize; j++ ) {
+        bJx[j] = 0.;
+        bJy[j] = 0.;
+        bJz[j] = 0.;
+    }
+    
+    int cell_nparts( ( int )iend-( int )istart );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        int istart0 = ( int )istart + ivect;
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            compute_distances( particles, ipart, istart0, ipart_ref, deltaold, ipo, S0, S1 );
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            double charge_weight = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            double crx_p = charge_weight*dx_ov_dt;
+            double cry_p = charge_weight*particles.momentum( 1, istart0+ipart )*invgf[istart0-ipart_ref+ipart];
+            double crz_p = charge_weight*particles.momentum( 2, istart0+ipart )*invgf[istart0-ipart_ref+ipart];
+            
+            // Jx is obtained from the cumulated longitudinal weights once summed over the particles
+            for( int i=0; i<5; i++ ) {
+                double Wt = 0.5 * ( S0[i*vecSize+ipart] + S1[i*vecSize+ipart] );
+                bJx[i*vecSize+ipart] += crx_p * ( S0[i*vecSize+ipart] - S1[i*vecSize+ipart] );
+                bJy[i*vecSize+ipart] += cry_p * Wt;
+                bJz[i*vecSize+ipart] += crz_p * Wt;
+            }
+        }
+    }
+    
+    double tmpJx( 0. );
+    for( int i=0 ; i<5 ; i++ ) {
+        double tmpJy( 0. ), tmpJz( 0. );
+        if( i > 0 ) {
+            for( int ipart=0 ; ipart<8; ipart++ ) {
+                tmpJx += bJx[( i-1 )*vecSize+ipart];
+            }
+        }
+        for( int ipart=0 ; ipart<8; ipart++ ) {
+            tmpJy += bJy[i*vecSize+ipart];
+            tmpJz += bJz[i*vecSize+ipart];
+        }
+        Jx[ipom2+i] += tmpJx;
+        Jy[ipom2+i] += tmpJy;
+        Jz[ipom2+i] += tmpJz;
+    }
+    
+} // END Project vectorized
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//!  Project current densities & charge : diagFields timstep
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector1D2OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz, double *rho, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int ipart_ref )
+{
+    currents( Jx, Jy, Jz, particles, istart, iend, invgf, iold, deltaold, ipart_ref );
+    
+    int ipo = iold[0];
+    int ipom2 = ipo-2;
+    
+    int vecSize = 8;
+    int bsize = 5*vecSize;
+    
+    double brho[bsize] __attribute__( ( aligned( 64 ) ) );
+    
+    double S0[40] __attribute__( ( aligned( 64 ) ) );
+    double S1[40] __attribute__( ( aligned( 64 ) ) );
+    
+    #pragma omp simd
+    for( int j=0; j<bsize; j++ ) {
+        brho[j] = 0.;
+    }
+    
+    int cell_nparts( ( int )iend-( int )istart );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        int istart0 = ( int )istart + ivect;
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            compute_distances( particles, ipart, istart0, ipart_ref, deltaold, ipo, S0, S1 );
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            double charge_weight = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            for( int i=0; i<5; i++ ) {
+                brho[i*vecSize+ipart] += charge_weight * S1[i*vecSize+ipart];
+            }
+        }
+    }
+    
+    for( int i=0 ; i<5 ; i++ ) {
+        double tmpRho( 0. );
+        for( int ipart=0 ; ipart<8; ipart++ ) {
+            tmpRho += brho[i*vecSize+ipart];
+        }
+        rho[ipom2+i] += tmpRho;
+    }
+    
+} // END Project local current densities (sort)
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project charge : frozen & diagFields timstep (not vectorized)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector1D2OrderV::densityFrozen( double *rhoj, Particles &particles, unsigned int ipart, unsigned int type )
+{
+
+    //Warning : this function is used for frozen species or initialization only and doesn't use the standard scheme.
+    //rho type = 0
+    //Jx type = 1
+    //Jy type = 2
+    //Jz type = 3
+    
+    // Declare local variables
+    int ip;
+    double xjn, xj_m_xip, xj_m_xip2;
+    double S1[5];            // arrays used for the Esirkepov projection method
+    
+    double charge_weight = inv_cell_volume * ( double )( particles.charge( ipart ) )*particles.weight( ipart );
+    if( type > 0 ) {
+        charge_weight *= 1./sqrt( 1.0 + particles.momentum( 0, ipart )*particles.momentum( 0, ipart )
+                                  + particles.momentum( 1, ipart )*particles.momentum( 1, ipart )
+                                  + particles.momentum( 2, ipart )*particles.momentum( 2, ipart ) );
+                                  
+        if( type == 1 ) {
+            charge_weight *= particles.momentum( 0, ipart );
+        } else if( type == 2 ) {
+            charge_weight *= particles.momentum( 1, ipart );
+        } else {
+            charge_weight *= particles.momentum( 2, ipart );
+        }
+    }
+    
+    // Initialize variables
+    for( unsigned int i=0; i<5; i++ ) {
+        S1[i]=0.;
+    }//i
+    
+    // Locate particle new position on the primal grid
+    xjn       = particles.position( 0, ipart ) * dx_inv_;
+    ip        = round( xjn + 0.5 * ( type==1 ) );                       // index of the central node
+    xj_m_xip  = xjn - ( double )ip;                   // normalized distance to the nearest grid point
+    xj_m_xip2 = xj_m_xip*xj_m_xip;                    // square of the normalized distance to the nearest grid point
+    
+    // coefficients 2nd order interpolation on 3 nodes
+    S1[1] = 0.5 * ( xj_m_xip2-xj_m_xip+0.25 );
+    S1[2] = ( 0.75-xj_m_xip2 );
+    S1[3] = 0.5 * ( xj_m_xip2+xj_m_xip+0.25 );
+    
+    ip -= index_domain_begin + 2;
+    
+    // 2nd order projection for charge density
+    // At the 2nd order, oversize = 2.
+    for( unsigned int i=0; i<5; i++ ) {
+        rhoj[i + ip ] += charge_weight * S1[i];
+    }//i
+    
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project global current densities : ionization (not vectorized)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector1D2OrderV::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion )
+{
+    Field1D *Jx1D  = static_cast<Field1D *>( Jx );
+    Field1D *Jy1D  = static_cast<Field1D *>( Jy );
+    Field1D *Jz1D  = static_cast<Field1D *>( Jz );
+    
+    
+    //Declaration of local variables
+    int i, im1, ip1;
+    double xjn, xjmxi, xjmxi2;
+    double cim1, ci, cip1;
+    
+    // weighted currents
+    double weight = inv_cell_volume * particles.weight( ipart );
+    double Jx_ion = Jion.x * weight;
+    double Jy_ion = Jion.y * weight;
+    double Jz_ion = Jion.z * weight;
+    
+    //Locate particle on the grid
+    xjn    = particles.position( 0, ipart ) * dx_inv_; // normalized distance to the first node
+    
+    
+    // Compute Jx_ion on the dual grid
+    // -------------------------------
+    
+    i      = round( xjn+0.5 );             // index of the central node
+    xjmxi  = xjn - ( double )i + 0.5;      // normalized distance to the nearest grid point
+    xjmxi2 = xjmxi*xjmxi;                  // square of the normalized distance to the nearest grid point
+    
+    i  -= index_domain_begin;
+    im1 = i-1;
+    ip1 = i+1;
+    
+    cim1 = 0.5 * ( xjmxi2-xjmxi+0.25 );
+    ci   = ( 0.75-xjmxi2 );
+    cip1 = 0.5 * ( xjmxi2+xjmxi+0.25 );
+    
+    // Jx
+    ( *Jx1D )( im1 )  += cim1 * Jx_ion;
+    ( *Jx1D )( i )  += ci   * Jx_ion;
+    ( *Jx1D )( ip1 )  += cip1 * Jx_ion;
+    
+    
+    // Compute Jy_ion & Jz_ion on the primal grid
+    // ------------------------------------------
+    
+    i      = round( xjn );                 // index of the central node
+    xjmxi  = xjn - ( double )i;            // normalized distance to the nearest grid point
+    xjmxi2 = xjmxi*xjmxi;                  // square of the normalized distance to the nearest grid point
+    
+    i  -= index_domain_begin;
+    im1 = i-1;
+    ip1 = i+1;
+    
+    cim1 = 0.5 * ( xjmxi2-xjmxi+0.25 );
+    ci   = ( 0.75-xjmxi2 );
+    cip1 = 0.5 * ( xjmxi2+xjmxi+0.25 );
+    
+    // Jy
+    ( *Jy1D )( im1 )  += cim1 * Jy_ion;
+    ( *Jy1D )( i )  += ci   * Jy_ion;
+    ( *Jy1D )( ip1 )  += cip1 * Jy_ion;
+    
+    // Jz
+    ( *Jz1D )( im1 )  += cim1 * Jz_ion;
+    ( *Jz1D )( i )  += ci   * Jz_ion;
+    ( *Jz1D )( ip1 )  += cip1 * Jz_ion;
+    
+} // END Project global current densities (ionize)
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Wrapper for projection
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector1D2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int scell, int ipart_ref )
+{
+    if( istart == iend ) {
+        return;    //Don't treat empty cells.
+    }
+    
+    double *delta = &( smpi->dynamics_deltaold[ithread][0] );
+    double *invgf = &( smpi->dynamics_invgf[ithread][0] );
+    
+    int iold[1];
+    iold[0] = scell+oversize;
+    
+    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    if( !diag_flag ) {
+        double *b_Jx =  &( *EMfields->Jx_ )( 0 );
+        double *b_Jy =  &( *EMfields->Jy_ )( 0 );
+        double *b_Jz =  &( *EMfields->Jz_ )( 0 );
+        if( !is_spectral ) {
+            currents( b_Jx, b_Jy, b_Jz, particles, istart, iend, invgf, iold, delta, ipart_ref );
+        } else {
+            double *b_rho = &( *EMfields->rho_ )( 0 );
+            currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles, istart, iend, invgf, iold, delta, ipart_ref );
+        }
+        
+        // Otherwise, the projection may apply to the species-specific arrays
+    } else {
+        double *b_Jx  = EMfields->Jx_s [ispec] ? &( *EMfields->Jx_s [ispec] )( 0 ) : &( *EMfields->Jx_ )( 0 ) ;
+        double *b_Jy  = EMfields->Jy_s [ispec] ? &( *EMfields->Jy_s [ispec] )( 0 ) : &( *EMfields->Jy_ )( 0 ) ;
+        double *b_Jz  = EMfields->Jz_s [ispec] ? &( *EMfields->Jz_s [ispec] )( 0 ) : &( *EMfields->Jz_ )( 0 ) ;
+        double *b_rho = EMfields->rho_s[ispec] ? &( *EMfields->rho_s[ispec] )( 0 ) : &( *EMfields->rho_ )( 0 ) ;
+        currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles, istart, iend, invgf, iold, delta, ipart_ref );
+    }
+}
+
+// Project susceptibility
+void Projector1D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &particles, double species_mass, SmileiMPI *smpi, int istart, int iend,  int ithread, int ibin, int ipart_ref )
+{
+    ERROR( "Vectorized projection of the susceptibility for the envelope model is not implemented for 1D geometry" );
+}
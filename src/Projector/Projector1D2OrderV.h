@@ -0,0 +1,67 @@
+#ifndef PROJECTOR1D2ORDERV_H
+#define PROJECTOR1D2ORDERV_H
+
+#include "Projector1D.h"
+
+
+class Projector1D2OrderV : public Projector1D
+{
+public:
+    Projector1D2OrderV( Params &, Patch *patch );
+    ~Projector1D2OrderV();
+    
+    //! Project global current densities (EMfields->Jx_/Jy_/Jz_)
+    inline void currents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int ipart_ref = 0 );
+    //! Project global current densities (EMfields->Jx_/Jy_/Jz_/rho), diagFields timestep
+    inline void currentsAndDensity( double *Jx, double *Jy, double *Jz, double *rho, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int ipart_ref = 0 );
+    
+    //! Project global current charge (EMfields->rho_ , J), for initialization and diags
+    void densityFrozen( double *rhoj, Particles &particles, unsigned int ipart, unsigned int type ) override final;
+    
+    //! Project global current densities if Ionization in Species::dynamics,
+    void ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion ) override final;
+    
+    //!Wrapper
+    void currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int icell = 0, int ipart_ref = 0 ) override final;
+    
+    // Project susceptibility
+    void susceptibility( ElectroMagn *EMfields, Particles &particles, double species_mass, SmileiMPI *smpi, int istart, int iend,  int ithread, int ibin, int ipart_ref = 0 ) override final;
+    
+private:
+    //! Shape factors of the particle istart+ipart at former (S0) and current (S1) time-steps
+    //! S1 is expressed on the stencil of the cell iold, coefficients are stored by 8 particles
+    inline void compute_distances( Particles &particles, int ipart, int istart, int ipart_ref, double *deltaold, int ipo, double *S0, double *S1 )
+    {
+        int vecSize = 8;
+        
+        double delta = deltaold[istart-ipart_ref+ipart];
+        double delta2 = delta*delta;
+        S0[          ipart] = 0.;
+        S0[  vecSize+ipart] = 0.5 * ( delta2-delta+0.25 );
+        S0[2*vecSize+ipart] = 0.75-delta2;
+        S0[3*vecSize+ipart] = 0.5 * ( delta2+delta+0.25 );
+        S0[4*vecSize+ipart] = 0.;
+        
+        double pos = particles.position( 0, istart+ipart ) * dx_inv_;
+        int cell = round( pos );
+        int cell_shift = cell-ipo-index_domain_begin;
+        delta  = pos - ( double )cell;
+        delta2 = delta*delta;
+        double deltam =  0.5 * ( delta2-delta+0.25 );
+        double deltap =  0.5 * ( delta2+delta+0.25 );
+        delta2 = 0.75 - delta2;
+        double m1 = ( cell_shift == -1 );
+        double c0 = ( cell_shift ==  0 );
+        double p1 = ( cell_shift ==  1 );
+        S1[          ipart] = m1 * deltam                             ;
+        S1[  vecSize+ipart] = c0 * deltam + m1 * delta2               ;
+        S1[2*vecSize+ipart] = p1 * deltam + c0 * delta2 + m1* deltap  ;
+        S1[3*vecSize+ipart] =               p1 * delta2 + c0* deltap  ;
+        S1[4*vecSize+ipart] =                             p1* deltap  ;
+    }
+    
+    double dx_ov_dt;
+    int oversize;
+};
+
+#endif
@@ -291,11 +291,11 @@ void Projector1D4Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
     if( !diag_flag ) {
         if( !is_spectral ) {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
-                currents( Jx_, Jy_, Jz_, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                currents( Jx_, Jy_, Jz_, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref] );
             }
         } else {
             for( int ipart=istart ; ipart<iend; ipart++ ) {
-                currentsAndDensity( Jx_, Jy_, Jz_, rho_, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                currentsAndDensity( Jx_, Jy_, Jz_, rho_, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref] );
             }
         }
         // Otherwise, the projection may apply to the species-specific arrays
@@ -305,7 +305,7 @@ void Projector1D4Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
         double *b_Jz  = EMfields->Jz_s [ispec] ? &( *EMfields->Jz_s [ispec] )( 0 ) : &( *EMfields->Jz_ )( 0 ) ;
         double *b_rho = EMfields->rho_s[ispec] ? &( *EMfields->rho_s[ispec] )( 0 ) : &( *EMfields->rho_ )( 0 ) ;
         for( int ipart=istart ; ipart<iend; ipart++ ) {
-            currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+            currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref] );
         }
     }
     
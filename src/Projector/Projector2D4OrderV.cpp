@@ -0,0 +1,370 @@
+#include "Projector2D4OrderV.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "ElectroMagn.h"
+#include "Field2D.h"
+#include "Particles.h"
+#include "Tools.h"
+#include "Patch.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructor for Projector2D4OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+Projector2D4OrderV::Projector2D4OrderV( Params &params, Patch *patch ) : Projector2D( params, patch )
+{
+    dx_inv_   = 1.0/params.cell_length[0];
+    dx_ov_dt  = params.cell_length[0] / params.timestep;
+    dy_inv_   = 1.0/params.cell_length[1];
+    dy_ov_dt  = params.cell_length[1] / params.timestep;
+    
+    i_domain_begin = patch->getCellStartingGlobalIndex( 0 );
+    j_domain_begin = patch->getCellStartingGlobalIndex( 1 );
+    
+    nscelly = params.n_space[1] + 1;
+    oversize[0] = params.oversize[0];
+    oversize[1] = params.oversize[1];
+    nprimy = nscelly + 2*oversize[1];
+    dq_inv[0] = dx_inv_;
+    dq_inv[1] = dy_inv_;
+    
+    
+    DEBUG( "cell_length "<< params.cell_length[0] );
+    
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Destructor for Projector2D4OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+Projector2D4OrderV::~Projector2D4OrderV()
+{
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities : main projector vectorized
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D4OrderV::currents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int npart_total, int ipart_ref )
+{
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+    
+    int ipo = iold[0];
+    int jpo = iold[1];
+    int ipom3 = ipo-3;
+    int jpom3 = jpo-3;
+    
+    int vecSize = 8;
+    int bsize = 7*7*vecSize;
+    
+    double bJx[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJy[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bJz[bsize] __attribute__( ( aligned( 64 ) ) );
+    
+    double Sx0[56] __attribute__( ( aligned( 64 ) ) );
+    double Sy0[56] __attribute__( ( aligned( 64 ) ) );
+    double Sx1[56] __attribute__( ( aligned( 64 ) ) );
+    double Sy1[56] __attribute__( ( aligned( 64 ) ) );
+    
+    #pragma omp simd
+    for( int j=0; j<bsize; j++ ) {
+        bJx[j] = 0.;
+        bJy[j] = 0.;
+        bJz[j] = 0.;
+    }
+    
+    int cell_nparts( ( int )iend-( int )istart );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        int istart0 = ( int )istart + ivect;
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sx0, Sy0, Sx1, Sy1 );
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            double charge_weight = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            double crx_p = charge_weight*dx_ov_dt;
+            double cry_p = charge_weight*dy_ov_dt;
+            double crz_p = charge_weight*one_third*particles.momentum( 2, istart0+ipart )*invgf[istart0-ipart_ref+ipart];
+            
+            double sumx[7], sumy[7];
+            sumx[0] = 0.;
+            sumy[0] = 0.;
+            for( int k=1 ; k<7 ; k++ ) {
+                sumx[k] = sumx[k-1] - ( Sx1[( k-1 )*vecSize+ipart] - Sx0[( k-1 )*vecSize+ipart] );
+                sumy[k] = sumy[k-1] - ( Sy1[( k-1 )*vecSize+ipart] - Sy0[( k-1 )*vecSize+ipart] );
+            }
+            
+            for( int i=0 ; i<7 ; i++ ) {
+                double sx0 = Sx0[i*vecSize+ipart];
+                double sx1 = Sx1[i*vecSize+ipart];
+                double tmpy  = cry_p * 0.5 * ( sx0 + sx1 );
+                double tmpz0 = crz_p * ( 0.5*sx1 + sx0 );
+                double tmpz1 = crz_p * ( 0.5*sx0 + sx1 );
+                for( int j=0 ; j<7 ; j++ ) {
+                    double sy0 = Sy0[j*vecSize+ipart];
+                    double sy1 = Sy1[j*vecSize+ipart];
+                    int index( ( i*7+j )*vecSize+ipart );
+                    // Jx^(d,p)
+                    bJx[index] += crx_p * sumx[i] * 0.5 * ( sy0 + sy1 );
+                    // Jy^(p,d)
+                    bJy[index] += sumy[j] * tmpy;
+                    // Jz^(p,p)
+                    bJz[index] += sy0*tmpz0 + sy1*tmpz1;
+                }
+            }
+        }
+    }
+    
+    int iloc0 = ipom3*nprimy+jpom3;
+    int iloc  = iloc0;
+    for( int i=0 ; i<7 ; i++ ) {
+        #pragma omp simd
+        for( int j=0 ; j<7 ; j++ ) {
+            double tmpJx( 0. ), tmpJz( 0. );
+            int ilocal = ( i*7+j )*vecSize;
+            for( int ipart=0 ; ipart<8; ipart++ ) {
+                tmpJx += bJx[ilocal+ipart];
+                tmpJz += bJz[ilocal+ipart];
+            }
+            Jx[iloc+j] += tmpJx;
+            Jz[iloc+j] += tmpJz;
+        }
+        iloc += nprimy;
+    }
+    
+    iloc = iloc0 + ipom3;
+    for( int i=0 ; i<7 ; i++ ) {
+        #pragma omp simd
+        for( int j=0 ; j<7 ; j++ ) {
+            double tmpJy( 0. );
+            int ilocal = ( i*7+j )*vecSize;
+            for( int ipart=0 ; ipart<8; ipart++ ) {
+                tmpJy += bJy[ilocal+ipart];
+            }
+            Jy[iloc+j] += tmpJy;
+        }
+        iloc += nprimy+1;
+    }
+    
+} // END Project vectorized
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//!  Project current densities & charge : diagFields timstep
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D4OrderV::currentsAndDensity( double *Jx, double *Jy, double *Jz, double *rho, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int npart_total, int ipart_ref )
+{
+    currents( Jx, Jy, Jz, particles, istart, iend, invgf, iold, deltaold, npart_total, ipart_ref );
+    
+    int ipom3 = iold[0]-3;
+    int jpom3 = iold[1]-3;
+    
+    int vecSize = 8;
+    int bsize = 7*7*vecSize;
+    
+    double brho[bsize] __attribute__( ( aligned( 64 ) ) );
+    
+    double Sx0[56] __attribute__( ( aligned( 64 ) ) );
+    double Sy0[56] __attribute__( ( aligned( 64 ) ) );
+    double Sx1[56] __attribute__( ( aligned( 64 ) ) );
+    double Sy1[56] __attribute__( ( aligned( 64 ) ) );
+    
+    #pragma omp simd
+    for( int j=0; j<bsize; j++ ) {
+        brho[j] = 0.;
+    }
+    
+    int cell_nparts( ( int )iend-( int )istart );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        int istart0 = ( int )istart + ivect;
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sx0, Sy0, Sx1, Sy1 );
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            double charge_weight = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+            for( int i=0 ; i<7 ; i++ ) {
+                double tmp = charge_weight * Sx1[i*vecSize+ipart];
+                for( int j=0 ; j<7 ; j++ ) {
+                    brho[( i*7+j )*vecSize+ipart] += tmp * Sy1[j*vecSize+ipart];
+                }
+            }
+        }
+    }
+    
+    int iloc = ipom3*nprimy+jpom3;
+    for( int i=0 ; i<7 ; i++ ) {
+        #pragma omp simd
+        for( int j=0 ; j<7 ; j++ ) {
+            double tmpRho( 0. );
+            int ilocal = ( i*7+j )*vecSize;
+            for( int ipart=0 ; ipart<8; ipart++ ) {
+                tmpRho += brho[ilocal+ipart];
+            }
+            rho[iloc+j] += tmpRho;
+        }
+        iloc += nprimy;
+    }
+    
+} // END Project local current densities at diag timestep.
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project charge : frozen & diagFields timstep (not vectorized)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D4OrderV::densityFrozen( double *rhoj, Particles &particles, unsigned int ipart, unsigned int type )
+{
+    //Warning : this function is used for frozen species or initialization only and doesn't use the standard scheme.
+    //rho type = 0
+    //Jx type = 1
+    //Jy type = 2
+    //Jz type = 3
+    
+    int iloc;
+    int ny( nprimy );
+    // (x,y,z) components of the current density for the macro-particle
+    double charge_weight = inv_cell_volume * ( double )( particles.charge( ipart ) )*particles.weight( ipart );
+    
+    if( type > 0 ) {
+        charge_weight *= 1./sqrt( 1.0 + particles.momentum( 0, ipart )*particles.momentum( 0, ipart )
+                                  + particles.momentum( 1, ipart )*particles.momentum( 1, ipart )
+                                  + particles.momentum( 2, ipart )*particles.momentum( 2, ipart ) );
+                                  
+        if( type == 1 ) {
+            charge_weight *= particles.momentum( 0, ipart );
+        } else if( type == 2 ) {
+            charge_weight *= particles.momentum( 1, ipart );
+            ny ++;
+        } else {
+            charge_weight *= particles.momentum( 2, ipart );
+        }
+    }
+    
+    // variable declaration
+    double xpn, ypn;
+    double delta, delta2, delta3, delta4;
+    // arrays used for the Esirkepov projection method
+    double  Sx1[7], Sy1[7];
+    
+    for( unsigned int i=0; i<7; i++ ) {
+        Sx1[i] = 0.;
+        Sy1[i] = 0.;
+    }
+    
+    // --------------------------------------------------------
+    // Locate particles & Calculate Esirkepov coef. S, DS and W
+    // --------------------------------------------------------
+    // locate the particle on the primal grid at current time-step & calculate coeff. S1
+    xpn = particles.position( 0, ipart ) * dx_inv_;
+    int ip        = round( xpn + 0.5 * ( type==1 ) );                       // index of the central node
+    delta  = xpn - ( double )ip;
+    delta2 = delta*delta;
+    delta3 = delta2*delta;
+    delta4 = delta3*delta;
+    
+    Sx1[1] = dble_1_ov_384   - dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+    Sx1[2] = dble_19_ov_96   - dble_11_ov_24 * delta  + dble_1_ov_4  * delta2 + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+    Sx1[3] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4  * delta4;
+    Sx1[4] = dble_19_ov_96   + dble_11_ov_24 * delta  + dble_1_ov_4  * delta2 - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+    Sx1[5] = dble_1_ov_384   + dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+    
+    ypn = particles.position( 1, ipart ) * dy_inv_;
+    int jp = round( ypn + 0.5*( type==2 ) );
+    delta  = ypn - ( double )jp;
+    delta2 = delta*delta;
+    delta3 = delta2*delta;
+    delta4 = delta3*delta;
+    
+    Sy1[1] = dble_1_ov_384   - dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+    Sy1[2] = dble_19_ov_96   - dble_11_ov_24 * delta  + dble_1_ov_4  * delta2 + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+    Sy1[3] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4  * delta4;
+    Sy1[4] = dble_19_ov_96   + dble_11_ov_24 * delta  + dble_1_ov_4  * delta2 - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+    Sy1[5] = dble_1_ov_384   + dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+    
+    // ---------------------------
+    // Calculate the total current
+    // ---------------------------
+    ip -= i_domain_begin + 3;
+    jp -= j_domain_begin + 3;
+    
+    for( unsigned int i=0 ; i<7 ; i++ ) {
+        iloc = ( i+ip )*ny+jp;
+        for( unsigned int j=0 ; j<7 ; j++ ) {
+            rhoj[iloc+j] += charge_weight * Sx1[i]*Sy1[j];
+        }
+    }//i
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project global current densities : ionization
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D4OrderV::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion )
+{
+    ERROR( "Projection of ionization current not yet defined for 2D 4th order" );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Wrapper for projection
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D4OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int scell, int ipart_ref )
+{
+    if( istart == iend ) {
+        return;    //Don't treat empty cells.
+    }
+    
+    double *delta = &( smpi->dynamics_deltaold[ithread][0] );
+    double *invgf = &( smpi->dynamics_invgf[ithread][0] );
+    int npart_total = smpi->dynamics_invgf[ithread].size();
+    
+    int iold[2];
+    iold[0] = scell/nscelly+oversize[0];
+    iold[1] = ( scell%nscelly )+oversize[1];
+    
+    
+    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    if( !diag_flag ) {
+        double *b_Jx =  &( *EMfields->Jx_ )( 0 );
+        double *b_Jy =  &( *EMfields->Jy_ )( 0 );
+        double *b_Jz =  &( *EMfields->Jz_ )( 0 );
+        if( !is_spectral ) {
+            currents( b_Jx, b_Jy, b_Jz, particles, istart, iend, invgf, iold, delta, npart_total, ipart_ref );
+        } else {
+            double *b_rho = &( *EMfields->rho_ )( 0 );
+            currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles, istart, iend, invgf, iold, delta, npart_total, ipart_ref );
+        }
+        
+        // Otherwise, the projection may apply to the species-specific arrays
+    } else {
+        double *b_Jx  = EMfields->Jx_s [ispec] ? &( *EMfields->Jx_s [ispec] )( 0 ) : &( *EMfields->Jx_ )( 0 ) ;
+        double *b_Jy  = EMfields->Jy_s [ispec] ? &( *EMfields->Jy_s [ispec] )( 0 ) : &( *EMfields->Jy_ )( 0 ) ;
+        double *b_Jz  = EMfields->Jz_s [ispec] ? &( *EMfields->Jz_s [ispec] )( 0 ) : &( *EMfields->Jz_ )( 0 ) ;
+        double *b_rho = EMfields->rho_s[ispec] ? &( *EMfields->rho_s[ispec] )( 0 ) : &( *EMfields->rho_ )( 0 ) ;
+        currentsAndDensity( b_Jx, b_Jy, b_Jz, b_rho, particles, istart, iend, invgf, iold, delta, npart_total, ipart_ref );
+    }
+}
+
+// Projector for susceptibility used as source term in envelope equation
+void Projector2D4OrderV::susceptibility( ElectroMagn *EMfields, Particles &particles, double species_mass, SmileiMPI *smpi, int istart, int iend,  int ithread, int ibin, int ipart_ref )
+{
+    ERROR( "Projection and interpolation for the envelope model are implemented only for interpolation_order = 2" );
+}
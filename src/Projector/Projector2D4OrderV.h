@@ -0,0 +1,85 @@
+#ifndef PROJECTOR2D4ORDERV_H
+#define PROJECTOR2D4ORDERV_H
+
+#include "Projector2D.h"
+
+
+class Projector2D4OrderV : public Projector2D
+{
+public:
+    Projector2D4OrderV( Params &, Patch *patch );
+    ~Projector2D4OrderV();
+    
+    //! Project global current densities (EMfields->Jx_/Jy_/Jz_)
+    inline void currents( double *Jx, double *Jy, double *Jz, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int npart_total, int ipart_ref = 0 );
+    //! Project global current densities (EMfields->Jx_/Jy_/Jz_/rho), diagFields timestep
+    inline void currentsAndDensity( double *Jx, double *Jy, double *Jz, double *rho, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, int npart_total, int ipart_ref = 0 );
+    
+    //! Project global current charge (EMfields->rho_), frozen & diagFields timestep
+    void densityFrozen( double *rhoj, Particles &particles, unsigned int ipart, unsigned int type ) override final;
+    
+    //! Project global current densities if Ionization in Species::dynamics,
+    void ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Particles &particles, int ipart, LocalFields Jion ) override final;
+    
+    //!Wrapper
+    void currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int icell = 0, int ipart_ref = 0 ) override final;
+    
+    // Project susceptibility
+    void susceptibility( ElectroMagn *EMfields, Particles &particles, double species_mass, SmileiMPI *smpi, int istart, int iend,  int ithread, int ibin, int ipart_ref = 0 ) override final;
+    
+private:
+    //! Shape factors of the particle istart+ipart at former (S0) and current (S1) time-steps
+    //! S1 is expressed on the 7 points stencil of the cell iold, coefficients are stored by 8 particles
+    inline void compute_distances( Particles &particles, int npart_total, int ipart, int istart, int ipart_ref, double *deltaold, int *iold, double *Sx0, double *Sy0, double *Sx1, double *Sy1 )
+    {
+        shape( deltaold[istart-ipart_ref+ipart            ], 0, ipart, Sx0 );
+        shape( deltaold[istart-ipart_ref+ipart+npart_total], 0, ipart, Sy0 );
+        
+        double pos = particles.position( 0, istart+ipart ) * dx_inv_;
+        int cell = round( pos );
+        shape( pos - ( double )cell, cell-iold[0]-i_domain_begin, ipart, Sx1 );
+        
+        pos = particles.position( 1, istart+ipart ) * dy_inv_;
+        cell = round( pos );
+        shape( pos - ( double )cell, cell-iold[1]-j_domain_begin, ipart, Sy1 );
+    }
+    
+    //! 4th order shape factor of a particle at distance delta of the node cell_shift (-1, 0 or 1) relatively to the central node of the stencil
+    inline void shape( double delta, int cell_shift, int ipart, double *S )
+    {
+        int vecSize = 8;
+        
+        double delta2 = delta*delta;
+        double delta3 = delta2*delta;
+        double delta4 = delta3*delta;
+        double S0 = dble_1_ov_384   - dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        double S1 = dble_19_ov_96   - dble_11_ov_24 * delta  + dble_1_ov_4  * delta2 + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        double S2 = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4  * delta4;
+        double S3 = dble_19_ov_96   + dble_11_ov_24 * delta  + dble_1_ov_4  * delta2 - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        double S4 = dble_1_ov_384   + dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        double m1 = ( cell_shift == -1 );
+        double c0 = ( cell_shift ==  0 );
+        double p1 = ( cell_shift ==  1 );
+        S [          ipart] = m1 * S0                                        ;
+        S [  vecSize+ipart] = c0 * S0 + m1 * S1                              ;
+        S [2*vecSize+ipart] = p1 * S0 + c0 * S1 + m1* S2                     ;
+        S [3*vecSize+ipart] =           p1 * S1 + c0* S2 + m1 * S3           ;
+        S [4*vecSize+ipart] =                     p1* S2 + c0 * S3 + m1 * S4 ;
+        S [5*vecSize+ipart] =                              p1 * S3 + c0 * S4 ;
+        S [6*vecSize+ipart] =                                        p1 * S4 ;
+    }
+    
+    static constexpr double dble_1_ov_384   = 1.0/384.0;
+    static constexpr double dble_1_ov_48    = 1.0/48.0;
+    static constexpr double dble_1_ov_16    = 1.0/16.0;
+    static constexpr double dble_1_ov_12    = 1.0/12.0;
+    static constexpr double dble_1_ov_24    = 1.0/24.0;
+    static constexpr double dble_19_ov_96   = 19.0/96.0;
+    static constexpr double dble_11_ov_24   = 11.0/24.0;
+    static constexpr double dble_1_ov_4     = 1.0/4.0;
+    static constexpr double dble_1_ov_6     = 1.0/6.0;
+    static constexpr double dble_115_ov_192 = 115.0/192.0;
+    static constexpr double dble_5_ov_8     = 5.0/8.0;
+};
+
+#endif
@@ -61,9 +61,8 @@ ProjectorAM2Order::~ProjectorAM2Order()
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local currents for mode=0
 // ---------------------------------------------------------------------------------------------------------------------
-void ProjectorAM2Order::currents_mode0( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold )
+void ProjectorAM2Order::currents_mode0( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, int nparts )
 {
-    int nparts= particles.size();
     // -------------------------------------
     // Variable declaration & initialization
     // -------------------------------------   int iloc,
@@ -240,12 +239,11 @@ void ProjectorAM2Order::currents_mode0( complex<double> *Jl, complex<double> *Jr
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local currents for m>0
 // ---------------------------------------------------------------------------------------------------------------------
-void ProjectorAM2Order::currents( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, complex<double> *exp_m_theta_old, int imode )
+void ProjectorAM2Order::currents( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, complex<double> *exp_m_theta_old, int imode, int nparts )
 {
     // -------------------------------------
     // Variable declaration & initialization
     // -------------------------------------   int iloc,
-    int nparts= particles.size();
     // (x,y,z) components of the current density for the macro-particle
     double charge_weight = inv_cell_volume * ( double )( particles.charge( ipart ) )*particles.weight( ipart );
     double crl_p = charge_weight*dl_ov_dt;
@@ -449,12 +447,11 @@ void ProjectorAM2Order::currents( complex<double> *Jl, complex<double> *Jr, comp
 //! Project local currents with diag for mode=0
 // ---------------------------------------------------------------------------------------------------------------------
 
-void ProjectorAM2Order::currentsAndDensity_mode0( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold )
+void ProjectorAM2Order::currentsAndDensity_mode0( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, int nparts )
 {
     // -------------------------------------
     // Variable declaration & initialization
     // -------------------------------------
-    int nparts= particles.size();
     // (x,y,z) components of the current density for the macro-particle
     double charge_weight = inv_cell_volume * ( double )( particles.charge( ipart ) )*particles.weight( ipart );
     double crl_p = charge_weight*dl_ov_dt;
@@ -643,12 +640,11 @@ void ProjectorAM2Order::currentsAndDensity_mode0( complex<double> *Jl, complex<d
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local currents with diag for m>0
 // ---------------------------------------------------------------------------------------------------------------------
-void ProjectorAM2Order::currentsAndDensity( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, complex<double> *exp_m_theta_old,  int imode )
+void ProjectorAM2Order::currentsAndDensity( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, complex<double> *exp_m_theta_old,  int imode, int nparts )
 {
     // -------------------------------------
     // Variable declaration & initialization
     // -------------------------------------
-    int nparts= particles.size();
     // (x,y,z) components of the current density for the macro-particle
     double charge_weight = inv_cell_volume * ( double )( particles.charge( ipart ) )*particles.weight( ipart );
     double crl_p = charge_weight*dl_ov_dt;
@@ -1045,6 +1041,7 @@ void ProjectorAM2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
     std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
     std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    int nparts = invgf->size();
     std::vector<std::complex<double>> *exp_m_theta_old = &( smpi->dynamics_thetaold[ithread] );
     
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
@@ -1060,11 +1057,11 @@ void ProjectorAM2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
             
             if( imode==0 ) {
                 for( int ipart=istart ; ipart<iend; ipart++ ) {
-                    currents_mode0( b_Jl, b_Jr, b_Jt, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                    currents_mode0( b_Jl, b_Jr, b_Jt, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref], nparts );
                 }
             } else {
                 for( int ipart=istart ; ipart<iend; ipart++ ) {
-                    currents( b_Jl, b_Jr, b_Jt, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart], &( *exp_m_theta_old )[ipart], imode );
+                    currents( b_Jl, b_Jr, b_Jt, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref], &( *exp_m_theta_old )[ipart-ipart_ref], imode, nparts );
                 }
             }
         }       // Otherwise, the projection may apply to the species-specific arrays
@@ -1082,11 +1079,11 @@ void ProjectorAM2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
             complex<double> *b_rho = emAM->rho_AM_s[ifield] ? &( * ( emAM->rho_AM_s[ifield] ) )( 0 ) : &( *emAM->rho_AM_[imode] )( 0 ) ;
             if( imode==0 ) {
                 for( int ipart=istart ; ipart<iend; ipart++ ) {
-                    currentsAndDensity_mode0( b_Jl, b_Jr, b_Jt, b_rho, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart] );
+                    currentsAndDensity_mode0( b_Jl, b_Jr, b_Jt, b_rho, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref], nparts );
                 }
             } else {
                 for( int ipart=istart ; ipart<iend; ipart++ ) {
-                    currentsAndDensity( b_Jl, b_Jr, b_Jt, b_rho, particles,  ipart, ( *invgf )[ipart], &( *iold )[ipart], &( *delta )[ipart], &( *exp_m_theta_old )[ipart], imode );
+                    currentsAndDensity( b_Jl, b_Jr, b_Jt, b_rho, particles,  ipart, ( *invgf )[ipart-ipart_ref], &( *iold )[ipart-ipart_ref], &( *delta )[ipart-ipart_ref], &( *exp_m_theta_old )[ipart-ipart_ref], imode, nparts );
                 }
             }
             
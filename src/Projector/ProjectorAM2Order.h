@@ -13,12 +13,12 @@ public:
     ~ProjectorAM2Order();
     
     //! Project global current densities for m=0 (EMfields->Jl_/Jr_/Jt_)
-    inline void currents_mode0( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold );
-    inline void currents( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, std::complex<double> *exp_m_theta_old, int imode );
+    inline void currents_mode0( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, int nparts );
+    inline void currents( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, std::complex<double> *exp_m_theta_old, int imode, int nparts );
     //! Project global current densities (EMfields->Jl_/Jr_/Jt_/rho), diagFields timestep
-    inline void currentsAndDensity_mode0( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, std::complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold );
+    inline void currentsAndDensity_mode0( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, std::complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, int nparts );
     //! Project global current densities (EMfields->Jl_/Jr_/Jt_/rho), diagFields timestep
-    inline void currentsAndDensity( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, std::complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, std::complex<double> *exp_m_theta_old,  int imode );
+    inline void currentsAndDensity( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, std::complex<double> *rho, Particles &particles, unsigned int ipart, double invgf, int *iold, double *deltaold, std::complex<double> *exp_m_theta_old,  int imode, int nparts );
     
     //! Project global current charge (EMfields->rho_), frozen & diagFields timestep
     void densityFrozenComplex( std::complex<double> *rhoj, Particles &particles, unsigned int ipart, unsigned int type, int imode ) override final;
@@ -0,0 +1,521 @@
+#include "ProjectorAM2OrderV.h"
+
+#include <cmath>
+#include <iostream>
+#include <complex>
+#include "dcomplex.h"
+#include "ElectroMagnAM.h"
+#include "cField2D.h"
+#include "Particles.h"
+#include "Tools.h"
+#include "Patch.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructor for ProjectorAM2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+ProjectorAM2OrderV::ProjectorAM2OrderV( Params &params, Patch *patch ) : ProjectorAM( params, patch )
+{
+    dt = params.timestep;
+    dr = params.cell_length[1];
+    dl_inv_   = 1.0/params.cell_length[0];
+    dl_ov_dt  = params.cell_length[0] / params.timestep;
+    dr_inv_   = 1.0 / dr;
+    one_ov_dt  = 1.0 / params.timestep;
+    Nmode=params.nmodes;
+    i_domain_begin = patch->getCellStartingGlobalIndex( 0 );
+    j_domain_begin = patch->getCellStartingGlobalIndex( 1 );
+    n_species = patch->vecSpecies.size();
+    
+    nscellr = params.n_space[1] + 1;
+    oversize[0] = params.oversize[0];
+    oversize[1] = params.oversize[1];
+    nprimr = nscellr + 2*oversize[1];
+    
+    rprim.resize( nprimr );
+    invV.resize( nprimr );
+    invVd.resize( nprimr+1 );
+    
+    for( int j = 0; j< nprimr; j++ ) {
+        rprim[j] = abs( ( j_domain_begin+j )*dr );
+        if( j_domain_begin+j == 0 ) {
+            invV[j] = 8./dr;   // No correction.
+        } else {
+            invV[j] = 1./rprim[j];
+        }
+    }
+    for( int j = 0; j< nprimr+1; j++ ) {
+        invVd[j] = 1./abs( j_domain_begin+j-0.5 );
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Destructor for ProjectorAM2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+ProjectorAM2OrderV::~ProjectorAM2OrderV()
+{
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities of the mode imode for all particles of the cell iold (vectorized)
+//! The Esirkepov weights of the particles, multiplied by their complex coefficients, are summed over the cell
+//! before the folding on axis and the integration along l and r, which are linear and shared by all particles
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::currents( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, complex<double> *eitheta_old, int npart_total, int imode, int ipart_ref, bool jt_rp )
+{
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+    
+    int ipo = iold[0];
+    int jpo = iold[1];
+    
+    int vecSize = 8;
+    unsigned int bsize = 5*5*vecSize;
+    
+    // Real and imaginary parts of the weights of each particle of the pack
+    double bWl_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bWl_im[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bWr_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bWr_im[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bWt_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double bWt_im[bsize] __attribute__( ( aligned( 64 ) ) );
+    
+    double Sl0[40] __attribute__( ( aligned( 64 ) ) );
+    double Sr0[40] __attribute__( ( aligned( 64 ) ) );
+    double Sl1[40] __attribute__( ( aligned( 64 ) ) );
+    double Sr1[40] __attribute__( ( aligned( 64 ) ) );
+    double e_delta[16] __attribute__( ( aligned( 64 ) ) );
+    double e_bar[16] __attribute__( ( aligned( 64 ) ) );
+    double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
+    double crt_p[8] __attribute__( ( aligned( 64 ) ) );
+    
+    #pragma omp simd
+    for( unsigned int j=0; j<bsize; j++ ) {
+        bWl_re[j] = 0.;
+        bWl_im[j] = 0.;
+        bWr_re[j] = 0.;
+        bWr_im[j] = 0.;
+        bWt_re[j] = 0.;
+        bWt_im[j] = 0.;
+    }
+    
+    int cell_nparts( ( int )iend-( int )istart );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        int istart0 = ( int )istart + ivect;
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sl0, Sr0, Sl1, Sr1 );
+            charge_weight[ipart] = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+        }
+        
+        if( imode == 0 ) {
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+                double yp = particles.position( 1, istart0+ipart );
+                double zp = particles.position( 2, istart0+ipart );
+                crt_p[ipart] = charge_weight[ipart]*( particles.momentum( 2, istart0+ipart )*yp-particles.momentum( 1, istart0+ipart )*zp )
+                               / sqrt( yp*yp + zp*zp )*invgf[istart0-ipart_ref+ipart];
+            }
+            
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+                double crl_p = charge_weight[ipart]*dl_ov_dt;
+                double crr_p = charge_weight[ipart]*one_ov_dt;
+                for( unsigned int i=0 ; i<5 ; i++ ) {
+                    double sl0 = Sl0[i*vecSize+ipart];
+                    double sl1 = Sl1[i*vecSize+ipart];
+                    double dsl = sl1 - sl0;
+                    for( unsigned int j=0 ; j<5 ; j++ ) {
+                        double sr0 = Sr0[j*vecSize+ipart];
+                        double sr1 = Sr1[j*vecSize+ipart];
+                        double dsr = sr1 - sr0;
+                        int ilocal = ( i*5+j )*vecSize+ipart;
+                        bWl_re[ilocal] += crl_p * dsl * ( sr0 + 0.5*dsr );
+                        bWr_re[ilocal] += crr_p * dsr * ( sl0 + 0.5*dsl );
+                        bWt_re[ilocal] += crt_p[ipart] * 0.5 * ( sl0*sr0 + sl1*sr1 );
+                    }
+                }
+            }
+        } else {
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+                compute_exponentials( particles, ipart, istart0, ipart_ref, eitheta_old, imode, e_delta, e_bar );
+            }
+            
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+                // C_m = 2 exp(i m theta_bar) multiplies Jl and Jr, crt_p = 2 i exp(i m theta_bar) charge_weight / (m dt)
+                double cm_re = 2.*e_bar[ipart];
+                double cm_im = 2.*e_bar[vecSize+ipart];
+                double crl_p = charge_weight[ipart]*dl_ov_dt;
+                double crr_p = charge_weight[ipart]*one_ov_dt;
+                double crt_re = -charge_weight[ipart]*cm_im / ( dt*( double )imode );
+                double crt_im =  charge_weight[ipart]*cm_re / ( dt*( double )imode );
+                if( jt_rp ) {
+                    double yp = particles.position( 1, istart0+ipart );
+                    double zp = particles.position( 2, istart0+ipart );
+                    double rp = sqrt( yp*yp + zp*zp );
+                    crt_re *= rp;
+                    crt_im *= rp;
+                }
+                double ed_re = e_delta[ipart];
+                double ed_im = e_delta[vecSize+ipart];
+                for( unsigned int i=0 ; i<5 ; i++ ) {
+                    double sl0 = Sl0[i*vecSize+ipart];
+                    double sl1 = Sl1[i*vecSize+ipart];
+                    double dsl = sl1 - sl0;
+                    for( unsigned int j=0 ; j<5 ; j++ ) {
+                        double sr0 = Sr0[j*vecSize+ipart];
+                        double sr1 = Sr1[j*vecSize+ipart];
+                        double dsr = sr1 - sr0;
+                        int ilocal = ( i*5+j )*vecSize+ipart;
+                        double wl = crl_p * dsl * ( sr0 + 0.5*dsr );
+                        double wr = crr_p * dsr * ( sl0 + 0.5*dsl );
+                        // Wt = S1 ( exp(-i m dtheta)-1 ) - S0 ( exp(i m dtheta)-1 )
+                        double s1 = sl1*sr1;
+                        double s0 = sl0*sr0;
+                        double wt_re = ( s1 - s0 ) * ( ed_re - 1. );
+                        double wt_im = -( s1 + s0 ) * ed_im;
+                        bWl_re[ilocal] += cm_re * wl;
+                        bWl_im[ilocal] += cm_im * wl;
+                        bWr_re[ilocal] += cm_re * wr;
+                        bWr_im[ilocal] += cm_im * wr;
+                        bWt_re[ilocal] += crt_re * wt_re - crt_im * wt_im;
+                        bWt_im[ilocal] += crt_re * wt_im + crt_im * wt_re;
+                    }
+                }
+            }
+        }
+        
+    } // END ivect
+    
+    // Sum the weights over the particles of the cell
+    complex<double> Wl[5][5], Wr[5][5], Wt[5][5];
+    for( unsigned int i=0 ; i<5 ; i++ ) {
+        for( unsigned int j=0 ; j<5 ; j++ ) {
+            double tmpWl_re( 0. ), tmpWl_im( 0. ), tmpWr_re( 0. ), tmpWr_im( 0. ), tmpWt_re( 0. ), tmpWt_im( 0. );
+            int ilocal = ( i*5+j )*vecSize;
+            #pragma omp simd reduction(+:tmpWl_re,tmpWl_im,tmpWr_re,tmpWr_im,tmpWt_re,tmpWt_im)
+            for( int ipart=0 ; ipart<8; ipart++ ) {
+                tmpWl_re += bWl_re[ilocal+ipart];
+                tmpWl_im += bWl_im[ilocal+ipart];
+                tmpWr_re += bWr_re[ilocal+ipart];
+                tmpWr_im += bWr_im[ilocal+ipart];
+                tmpWt_re += bWt_re[ilocal+ipart];
+                tmpWt_im += bWt_im[ilocal+ipart];
+            }
+            Wl[i][j] = complex<double>( tmpWl_re, tmpWl_im );
+            Wr[i][j] = complex<double>( tmpWr_re, tmpWr_im );
+            Wt[i][j] = complex<double>( tmpWt_re, tmpWt_im );
+        }
+    }
+    
+    //Fold W if the particles project anything below axis
+    unsigned int nfold = max( 2-jpo, 0 ); // Number of cells touched below axis
+    if( nfold > 0 ) {
+        // Cancel contribution on axis for mode > 0
+        if( imode > 0 ) {
+            for( unsigned int i=0 ; i<5 ; i++ ) {
+                Wl[i][nfold] = 0.;
+                Wr[i][nfold] = 0.;
+                Wt[i][nfold] = 0.;
+            }
+        }
+        for( unsigned int i=0 ; i<5 ; i++ ) {
+            for( unsigned int j = 0 ; j < nfold ; j++ ) {
+                Wl[i][2*nfold-j] += Wl[i][j];
+                Wr[i][2*nfold-j] += Wr[i][j];
+                Wt[i][2*nfold-j] += Wt[i][j];
+            }
+        }
+    }
+    
+    ipo -= 2;   //This minus 2 come from the order 2 scheme, based on a 5 points stencil from -2 to +2.
+    jpo -= 2;
+    
+    int iloc, jloc;
+    
+    // Jl^(d,p)
+    for( unsigned int j=0 ; j<5 ; j++ ) {
+        jloc = j+jpo;
+        complex<double> Jl_p = 0.;
+        for( unsigned int i=1 ; i<5 ; i++ ) {
+            Jl_p -= Wl[i-1][j];
+            Jl[( i+ipo )*nprimr+jloc] += Jl_p * invV[jloc];
+        }
+    }
+    
+    // Jr^(p,d)
+    for( unsigned int i=0 ; i<5 ; i++ ) {
+        iloc = ( i+ipo )*( nprimr+1 );
+        complex<double> Jr_p = 0.;
+        for( int j=3 ; j>=0 ; j-- ) {
+            jloc = j+jpo+1;
+            double Vd = abs( jloc + j_domain_begin + 0.5 ) ;
+            Jr_p = ( Jr_p * Vd + Wr[i][j+1] ) * invVd[jloc];
+            Jr[iloc+jloc] += Jr_p;
+        }
+    }
+    
+    // Jt^(p,p)
+    for( unsigned int i=0 ; i<5 ; i++ ) {
+        iloc = ( i+ipo )*nprimr;
+        for( unsigned int j=0 ; j<5 ; j++ ) {
+            jloc = j+jpo;
+            if( ( imode == 0 ) || jt_rp ) {
+                Jt[iloc+jloc] += Wt[i][j] * invV[jloc];
+            } else {
+                Jt[iloc+jloc] += Wt[i][j] * invV[jloc] * rprim[jloc];
+            }
+        }
+    }
+
+} // END Project vectorized
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities and charge of the mode imode for all particles of the cell iold (vectorized)
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::currentsAndDensity( complex<double> *Jl, complex<double> *Jr, complex<double> *Jt, complex<double> *rho, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, complex<double> *eitheta_old, int npart_total, int imode, int ipart_ref )
+{
+    currents( Jl, Jr, Jt, particles, istart, iend, invgf, iold, deltaold, eitheta_old, npart_total, imode, ipart_ref, true );
+    
+    int vecSize = 8;
+    unsigned int bsize = 5*5*vecSize;
+    
+    double brho_re[bsize] __attribute__( ( aligned( 64 ) ) );
+    double brho_im[bsize] __attribute__( ( aligned( 64 ) ) );
+    
+    double Sl0[40] __attribute__( ( aligned( 64 ) ) );
+    double Sr0[40] __attribute__( ( aligned( 64 ) ) );
+    double Sl1[40] __attribute__( ( aligned( 64 ) ) );
+    double Sr1[40] __attribute__( ( aligned( 64 ) ) );
+    double e_delta[16] __attribute__( ( aligned( 64 ) ) );
+    double e_bar[16] __attribute__( ( aligned( 64 ) ) );
+    double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
+    
+    #pragma omp simd
+    for( unsigned int j=0; j<bsize; j++ ) {
+        brho_re[j] = 0.;
+        brho_im[j] = 0.;
+    }
+    
+    int cell_nparts( ( int )iend-( int )istart );
+    
+    for( int ivect=0 ; ivect < cell_nparts; ivect += vecSize ) {
+    
+        int np_computed( min( cell_nparts-ivect, vecSize ) );
+        int istart0 = ( int )istart + ivect;
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            compute_distances( particles, npart_total, ipart, istart0, ipart_ref, deltaold, iold, Sl0, Sr0, Sl1, Sr1 );
+            charge_weight[ipart] = inv_cell_volume * ( double )( particles.charge( istart0+ipart ) )*particles.weight( istart0+ipart );
+        }
+        
+        if( imode == 0 ) {
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+                e_bar[ipart]         = 1.;
+                e_bar[vecSize+ipart] = 0.;
+            }
+        } else {
+            #pragma omp simd
+            for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+                compute_exponentials( particles, ipart, istart0, ipart_ref, eitheta_old, imode, e_delta, e_bar );
+                e_bar[ipart]         *= 2.;
+                e_bar[vecSize+ipart] *= 2.;
+            }
+        }
+        
+        #pragma omp simd
+        for( int ipart=0 ; ipart<np_computed; ipart++ ) {
+            double crho_re = charge_weight[ipart]*e_bar[ipart];
+            double crho_im = charge_weight[ipart]*e_bar[vecSize+ipart];
+            for( unsigned int i=0 ; i<5 ; i++ ) {
+                for( unsigned int j=0 ; j<5 ; j++ ) {
+                    int ilocal = ( i*5+j )*vecSize+ipart;
+                    double s1 = Sl1[i*vecSize+ipart]*Sr1[j*vecSize+ipart];
+                    brho_re[ilocal] += crho_re * s1;
+                    brho_im[ilocal] += crho_im * s1;
+                }
+            }
+        }
+    } // END ivect
+    
+    int ipo = iold[0] - 2;
+    int jpo = iold[1] - 2;
+    
+    for( unsigned int i=0 ; i<5 ; i++ ) {
+        int iloc = ( i+ipo )*nprimr;
+        for( unsigned int j=0 ; j<5 ; j++ ) {
+            double tmprho_re( 0. ), tmprho_im( 0. );
+            int ilocal = ( i*5+j )*vecSize;
+            #pragma omp simd reduction(+:tmprho_re,tmprho_im)
+            for( int ipart=0 ; ipart<8; ipart++ ) {
+                tmprho_re += brho_re[ilocal+ipart];
+                tmprho_im += brho_im[ilocal+ipart];
+            }
+            int jloc = j+jpo;
+            rho[iloc+jloc] += complex<double>( tmprho_re, tmprho_im ) * invV[jloc];
+        }
+    }
+
+} // END Project vectorized
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project for diags and frozen species - mode >= 0
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::densityFrozenComplex( complex<double> *rhoj, Particles &particles, unsigned int ipart, unsigned int type, int imode )
+{
+    //Warning : this function is not charge conserving.
+    
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+    
+    int iloc, nr( nprimr );
+    double charge_weight = inv_cell_volume * ( double )( particles.charge( ipart ) )*particles.weight( ipart );
+    double r = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) );
+    
+    if( type > 0 ) { //if current density
+        charge_weight *= 1./sqrt( 1.0 + particles.momentum( 0, ipart )*particles.momentum( 0, ipart )
+                                  + particles.momentum( 1, ipart )*particles.momentum( 1, ipart )
+                                  + particles.momentum( 2, ipart )*particles.momentum( 2, ipart ) );
+        if( type == 1 ) { //if Jl
+            charge_weight *= particles.momentum( 0, ipart );
+        } else if( type == 2 ) { //if Jr
+            charge_weight *= ( particles.momentum( 1, ipart )*particles.position( 1, ipart ) + particles.momentum( 2, ipart )*particles.position( 2, ipart ) )*dr_inv_ / r ;
+            nr++;
+        } else { //if Jt
+            charge_weight *= ( -particles.momentum( 1, ipart )*particles.position( 2, ipart ) + particles.momentum( 2, ipart )*particles.position( 1, ipart ) ) / r ;
+        }
+    }
+    
+    complex<double> e_theta = ( particles.position( 1, ipart ) + Icpx*particles.position( 2, ipart ) )/r;
+    complex<double> C_m = 1.;
+    if( imode > 0 ) {
+        C_m = 2.;
+    }
+    for( unsigned int i=0; i<( unsigned int )imode; i++ ) {
+        C_m *= e_theta;
+    }
+    
+    double xpn, ypn;
+    double delta, delta2;
+    double Sl1[5], Sr1[5];
+    
+    // --------------------------------------------------------
+    // Locate particles & Calculate Esirkepov coef. S, DS and W
+    // --------------------------------------------------------
+    
+    // locate the particle on the primal grid at current time-step & calculate coeff. S1
+    xpn = particles.position( 0, ipart ) * dl_inv_;
+    int ip = round( xpn + 0.5 * ( type==1 ) );
+    delta  = xpn - ( double )ip;
+    delta2 = delta*delta;
+    Sl1[1] = 0.5 * ( delta2-delta+0.25 );
+    Sl1[2] = 0.75-delta2;
+    Sl1[3] = 0.5 * ( delta2+delta+0.25 );
+    ypn = r * dr_inv_ ;
+    int jp = round( ypn + 0.5*( type==2 ) );
+    delta  = ypn - ( double )jp;
+    delta2 = delta*delta;
+    Sr1[1] = 0.5 * ( delta2-delta+0.25 );
+    Sr1[2] = 0.75-delta2;
+    Sr1[3] = 0.5 * ( delta2+delta+0.25 );
+    
+    // ---------------------------
+    // Calculate the total charge
+    // ---------------------------
+    ip -= i_domain_begin + 2;
+    jp -= j_domain_begin + 2;
+    
+    if( type != 2 ) {
+        for( unsigned int i=1 ; i<4 ; i++ ) {
+            iloc = ( i+ip )*nr+jp;
+            for( unsigned int j=1 ; j<4 ; j++ ) {
+                rhoj [iloc+j] += C_m*charge_weight* Sl1[i]*Sr1[j] * invV[j+jp];
+            }
+        }//i
+    } else {
+        for( unsigned int i=1 ; i<4 ; i++ ) {
+            iloc = ( i+ip )*nr+jp;
+            for( unsigned int j=1 ; j<4 ; j++ ) {
+                rhoj [iloc+j] += C_m*charge_weight* Sl1[i]*Sr1[j] * invVd[j+jp];
+            }
+        }//i
+    }
+} // END Project for diags local current densities
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project global current densities : ionization
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::ionizationCurrents( Field *Jl, Field *Jr, Field *Jt, Particles &particles, int ipart, LocalFields Jion )
+{
+    ERROR( "Vectorized projection of the ionization current not implemented in AM geometry" );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Wrapper for projection
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int scell, int ipart_ref )
+{
+    if( istart == iend ) {
+        return;    //Don't treat empty cells.
+    }
+    
+    if( is_spectral ) {
+        ERROR( "Not implemented" );
+    }
+    
+    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    std::vector<std::complex<double>> *eitheta_old = &( smpi->dynamics_thetaold[ithread] );
+    int npart_total = invgf->size();
+    
+    int iold[2];
+    iold[0] = scell/nscellr+oversize[0];
+    iold[1] = ( scell%nscellr )+oversize[1];
+    
+    ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
+    
+    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    if( !diag_flag ) {
+    
+        for( unsigned int imode = 0; imode<Nmode; imode++ ) {
+            complex<double> *b_Jl =  &( *emAM->Jl_[imode] )( 0 );
+            complex<double> *b_Jr =  &( *emAM->Jr_[imode] )( 0 );
+            complex<double> *b_Jt =  &( *emAM->Jt_[imode] )( 0 );
+            currents( b_Jl, b_Jr, b_Jt, particles, istart, iend, &( *invgf )[0], iold, &( *delta )[0], &( *eitheta_old )[0], npart_total, imode, ipart_ref );
+        }
+        
+        // Otherwise, the projection may apply to the species-specific arrays
+    } else {
+    
+        for( unsigned int imode = 0; imode<Nmode; imode++ ) {
+        
+            // Fix for n_species which is not know in constructors : now the projector is inside each species
+            n_species = emAM->Jl_.size() / Nmode;
+            
+            int ifield = imode*n_species+ispec;
+            complex<double> *b_Jl  = emAM->Jl_s    [ifield] ? &( * ( emAM->Jl_s    [ifield] ) )( 0 ) : &( *emAM->Jl_    [imode] )( 0 ) ;
+            complex<double> *b_Jr  = emAM->Jr_s    [ifield] ? &( * ( emAM->Jr_s    [ifield] ) )( 0 ) : &( *emAM->Jr_    [imode] )( 0 ) ;
+            complex<double> *b_Jt  = emAM->Jt_s    [ifield] ? &( * ( emAM->Jt_s    [ifield] ) )( 0 ) : &( *emAM->Jt_    [imode] )( 0 ) ;
+            complex<double> *b_rho = emAM->rho_AM_s[ifield] ? &( * ( emAM->rho_AM_s[ifield] ) )( 0 ) : &( *emAM->rho_AM_[imode] )( 0 ) ;
+            currentsAndDensity( b_Jl, b_Jr, b_Jt, b_rho, particles, istart, iend, &( *invgf )[0], iold, &( *delta )[0], &( *eitheta_old )[0], npart_total, imode, ipart_ref );
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#ifndef PROJECTORAM2ORDERV_H
+#define PROJECTORAM2ORDERV_H
+
+#include <complex>
+
+#include "ProjectorAM.h"
+
+
+class ProjectorAM2OrderV : public ProjectorAM
+{
+public:
+    ProjectorAM2OrderV( Params &, Patch *patch );
+    ~ProjectorAM2OrderV();
+    
+    //! Project global current densities of the mode imode (EMfields->Jl_/Jr_/Jt_)
+    //! jt_rp : Jt of the modes > 0 weighted by the particle radius rather than by the node radius (diagFields timestep)
+    inline void currents( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, std::complex<double> *eitheta_old, int npart_total, int imode, int ipart_ref = 0, bool jt_rp = false );
+    //! Project global current densities of the mode imode (EMfields->Jl_/Jr_/Jt_/rho), diagFields timestep
+    inline void currentsAndDensity( std::complex<double> *Jl, std::complex<double> *Jr, std::complex<double> *Jt, std::complex<double> *rho, Particles &particles, unsigned int istart, unsigned int iend, double *invgf, int *iold, double *deltaold, std::complex<double> *eitheta_old, int npart_total, int imode, int ipart_ref = 0 );
+    
+    //! Project global current charge (EMfields->rho_), frozen & diagFields timestep
+    void densityFrozenComplex( std::complex<double> *rhoj, Particles &particles, unsigned int ipart, unsigned int type, int imode ) override final;
+    
+    //! Project global current densities if Ionization in Species::dynamics,
+    void ionizationCurrents( Field *Jl, Field *Jr, Field *Jt, Particles &particles, int ipart, LocalFields Jion ) override final;
+    
+    //!Wrapper
+    void currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int icell = 0, int ipart_ref = 0 ) override final;
+
+private:
+    //! Shape factors of the particle istart+ipart at former (S0) and current (S1) time-steps
+    //! S1 is expressed on the stencil of the cell iold, coefficients are stored by 8 particles
+    inline void compute_distances( Particles &particles, int npart_total, int ipart, int istart, int ipart_ref, double *deltaold, int *iold, double *Sl0, double *Sr0, double *Sl1, double *Sr1 )
+    {
+        int vecSize = 8;
+        
+        double delta = deltaold[istart-ipart_ref+ipart];
+        double delta2 = delta*delta;
+        Sl0[          ipart] = 0.;
+        Sl0[  vecSize+ipart] = 0.5 * ( delta2-delta+0.25 );
+        Sl0[2*vecSize+ipart] = 0.75-delta2;
+        Sl0[3*vecSize+ipart] = 0.5 * ( delta2+delta+0.25 );
+        Sl0[4*vecSize+ipart] = 0.;
+        
+        delta = deltaold[istart-ipart_ref+ipart+npart_total];
+        delta2 = delta*delta;
+        Sr0[          ipart] = 0.;
+        Sr0[  vecSize+ipart] = 0.5 * ( delta2-delta+0.25 );
+        Sr0[2*vecSize+ipart] = 0.75-delta2;
+        Sr0[3*vecSize+ipart] = 0.5 * ( delta2+delta+0.25 );
+        Sr0[4*vecSize+ipart] = 0.;
+        
+        //                            L                                 //
+        double pos = particles.position( 0, istart+ipart ) * dl_inv_;
+        int cell = round( pos );
+        int cell_shift = cell-iold[0]-i_domain_begin;
+        delta  = pos - ( double )cell;
+        delta2 = delta*delta;
+        double deltam =  0.5 * ( delta2-delta+0.25 );
+        double deltap =  0.5 * ( delta2+delta+0.25 );
+        delta2 = 0.75 - delta2;
+        double m1 = ( cell_shift == -1 );
+        double c0 = ( cell_shift ==  0 );
+        double p1 = ( cell_shift ==  1 );
+        Sl1[          ipart] = m1 * deltam                             ;
+        Sl1[  vecSize+ipart] = c0 * deltam + m1 * delta2               ;
+        Sl1[2*vecSize+ipart] = p1 * deltam + c0 * delta2 + m1* deltap  ;
+        Sl1[3*vecSize+ipart] =               p1 * delta2 + c0* deltap  ;
+        Sl1[4*vecSize+ipart] =                             p1* deltap  ;
+        //                            R                                 //
+        double yp = particles.position( 1, istart+ipart );
+        double zp = particles.position( 2, istart+ipart );
+        pos = sqrt( yp*yp + zp*zp ) * dr_inv_;
+        cell = round( pos );
+        cell_shift = cell-iold[1]-j_domain_begin;
+        delta  = pos - ( double )cell;
+        delta2 = delta*delta;
+        deltam =  0.5 * ( delta2-delta+0.25 );
+        deltap =  0.5 * ( delta2+delta+0.25 );
+        delta2 = 0.75 - delta2;
+        m1 = ( cell_shift == -1 );
+        c0 = ( cell_shift ==  0 );
+        p1 = ( cell_shift ==  1 );
+        Sr1[          ipart] = m1 * deltam                             ;
+        Sr1[  vecSize+ipart] = c0 * deltam + m1 * delta2               ;
+        Sr1[2*vecSize+ipart] = p1 * deltam + c0 * delta2 + m1* deltap  ;
+        Sr1[3*vecSize+ipart] =               p1 * delta2 + c0* deltap  ;
+        Sr1[4*vecSize+ipart] =                             p1* deltap  ;
+    }
+    
+    //! exp(i imode dtheta) and exp(i imode theta_bar) of the particle istart+ipart, theta_bar = theta_old+dtheta being the mid-step angle
+    //! exp(i dtheta) is the principal square root of exp(i theta)*exp(-i theta_old), no atan2 is required
+    inline void compute_exponentials( Particles &particles, int ipart, int istart, int ipart_ref, std::complex<double> *eitheta_old, int imode, double *e_delta, double *e_bar )
+    {
+        int vecSize = 8;
+        
+        double yp = particles.position( 1, istart+ipart );
+        double zp = particles.position( 2, istart+ipart );
+        double inv_rp = 1./sqrt( yp*yp + zp*zp );
+        // exp(i theta_old)
+        double eold_re =  std::real( eitheta_old[istart-ipart_ref+ipart] );
+        double eold_im = -std::imag( eitheta_old[istart-ipart_ref+ipart] );
+        // exp(i (theta-theta_old))
+        double w_re = ( yp*eold_re + zp*eold_im ) * inv_rp;
+        double w_im = ( zp*eold_re - yp*eold_im ) * inv_rp;
+        // exp(i dtheta), dtheta in [-pi/2, pi/2]
+        double ed_m1_re = sqrt( std::max( 0.5*( 1.+w_re ), 0. ) );
+        double ed_m1_im = std::copysign( sqrt( std::max( 0.5*( 1.-w_re ), 0. ) ), w_im );
+        // exp(i theta_bar)
+        double eb_m1_re = eold_re*ed_m1_re - eold_im*ed_m1_im;
+        double eb_m1_im = eold_re*ed_m1_im + eold_im*ed_m1_re;
+        
+        double ed_re = 1., ed_im = 0., eb_re = 1., eb_im = 0., tmp;
+        for( int i=0; i<imode; i++ ) {
+            tmp   = ed_re*ed_m1_re - ed_im*ed_m1_im;
+            ed_im = ed_re*ed_m1_im + ed_im*ed_m1_re;
+            ed_re = tmp;
+            tmp   = eb_re*eb_m1_re - eb_im*eb_m1_im;
+            eb_im = eb_re*eb_m1_im + eb_im*eb_m1_re;
+            eb_re = tmp;
+        }
+        e_delta[ipart]         = ed_re;
+        e_delta[vecSize+ipart] = ed_im;
+        e_bar  [ipart]         = eb_re;
+        e_bar  [vecSize+ipart] = eb_im;
+    }
+    
+    //! Number of cells along r in the cell sorting
+    int nscellr;
+    int oversize[2];
+};
+
+#endif
+
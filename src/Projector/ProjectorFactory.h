@@ -11,9 +11,12 @@
 #include "ProjectorAM2Order.h"
 
 #ifdef _VECTO
+#include "Projector1D2OrderV.h"
 #include "Projector2D2OrderV.h"
+#include "Projector2D4OrderV.h"
 #include "Projector3D2OrderV.h"
 #include "Projector3D4OrderV.h"
+#include "ProjectorAM2OrderV.h"
 #endif
 
 #include "Params.h"
@@ -31,7 +34,14 @@ public:
         // 1Dcartesian simulation
         // ---------------
         if( ( params.geometry == "1Dcartesian" ) && ( params.interpolation_order == ( unsigned int )2 ) ) {
-            Proj = new Projector1D2Order( params, patch );
+            if( !vectorization ) {
+                Proj = new Projector1D2Order( params, patch );
+            }
+#ifdef _VECTO
+            else {
+                Proj = new Projector1D2OrderV( params, patch );
+            }
+#endif
         } else if( ( params.geometry == "1Dcartesian" ) && ( params.interpolation_order == ( unsigned int )4 ) ) {
             Proj = new Projector1D4Order( params, patch );
         }
@@ -48,7 +58,14 @@ public:
             }
 #endif
         } else if( ( params.geometry == "2Dcartesian" ) && ( params.interpolation_order == ( unsigned int )4 ) ) {
-            Proj = new Projector2D4Order( params, patch );
+            if( !vectorization ) {
+                Proj = new Projector2D4Order( params, patch );
+            }
+#ifdef _VECTO
+            else {
+                Proj = new Projector2D4OrderV( params, patch );
+            }
+#endif
         }
         // ---------------
         // 3Dcartesian simulation
@@ -77,7 +94,14 @@ public:
         // AM simulation
         // ---------------
         else if( params.geometry == "AMcylindrical" ) {
-            Proj = new ProjectorAM2Order( params, patch );
+            if( !vectorization ) {
+                Proj = new ProjectorAM2Order( params, patch );
+            }
+#ifdef _VECTO
+            else {
+                Proj = new ProjectorAM2OrderV( params, patch );
+            }
+#endif
         } else {
             ERROR( "Unknwon parameters : " << params.geometry << ", Order : " << params.interpolation_order );
         }
@@ -35,7 +35,7 @@ void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart,
     double pxsm, pysm, pzsm;
     double local_invgf;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -43,15 +43,9 @@ void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart,
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     short *charge = &( particles.charge( 0 ) );
     
-    int nparts = particles.size();
+    int nparts = Epart->size()/3;
     double *Ex = &( ( *Epart )[0*nparts] );
     double *Ey = &( ( *Epart )[1*nparts] );
     double *Ez = &( ( *Epart )[2*nparts] );
@@ -64,9 +58,9 @@ void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart,
         charge_over_mass_dts2 = ( double )( charge[ipart] )*one_over_mass_*dts2;
         
         // init Half-acceleration in the electric field
-        pxsm = charge_over_mass_dts2*( *( Ex+ipart ) );
-        pysm = charge_over_mass_dts2*( *( Ey+ipart ) );
-        pzsm = charge_over_mass_dts2*( *( Ez+ipart ) );
+        pxsm = charge_over_mass_dts2*( *( Ex+ipart-ipart_ref ) );
+        pysm = charge_over_mass_dts2*( *( Ey+ipart-ipart_ref ) );
+        pzsm = charge_over_mass_dts2*( *( Ez+ipart-ipart_ref ) );
         
         //(*this)(particles, ipart, (*Epart)[ipart], (*Bpart)[ipart] , (*invgf)[ipart]);
         umx = momentum[0][ipart] + pxsm;
@@ -76,9 +70,9 @@ void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart,
         
         // Rotation in the magnetic field
         alpha = charge_over_mass_dts2*local_invgf;
-        Tx    = alpha * ( *( Bx+ipart ) );
-        Ty    = alpha * ( *( By+ipart ) );
-        Tz    = alpha * ( *( Bz+ipart ) );
+        Tx    = alpha * ( *( Bx+ipart-ipart_ref ) );
+        Ty    = alpha * ( *( By+ipart-ipart_ref ) );
+        Tz    = alpha * ( *( Bz+ipart-ipart_ref ) );
         Tx2   = Tx*Tx;
         Ty2   = Ty*Ty;
         Tz2   = Tz*Tz;
@@ -95,20 +89,15 @@ void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart,
         pxsm += upx;
         pysm += upy;
         pzsm += upz;
-        ( *invgf )[ipart] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
+        ( *invgf )[ipart-ipart_ref] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
         
         momentum[0][ipart] = pxsm;
         momentum[1][ipart] = pysm;
         momentum[2][ipart] = pzsm;
         
         // Move the particle
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         for( int i = 0 ; i<nDim_ ; i++ ) {
-            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart];
+            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart-ipart_ref];
         }
         
     }
@@ -35,7 +35,7 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     
     //int* cell_keys;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -43,12 +43,6 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     short *charge = &( particles.charge( 0 ) );
     
     int nparts = Epart->size()/3;
@@ -65,14 +59,14 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
     double dcharge[nparts];
     #pragma omp simd
     for( int ipart=istart ; ipart<iend; ipart++ ) {
-        dcharge[ipart] = ( double )( charge[ipart] );
+        dcharge[ipart-ipart_ref] = ( double )( charge[ipart] );
     }
     
     #pragma omp simd
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         double psm[3], um[3];
         
-        charge_over_mass_dts2 = dcharge[ipart]*one_over_mass_*dts2;
+        charge_over_mass_dts2 = dcharge[ipart-ipart_ref]*one_over_mass_*dts2;
         
         // init Half-acceleration in the electric field
         psm[0] = charge_over_mass_dts2*( *( Ex+ipart-ipart_ref ) );
@@ -104,11 +98,6 @@ void PusherBorisV::operator()( Particles &particles, SmileiMPI *smpi, int istart
         momentum[2][ipart] = psm[2];
         
         // Move the particle
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         local_invgf *= dt;
         for( int i = 0 ; i<nDim_ ; i++ ) {
             position[i][ipart]     += psm[i]*local_invgf;
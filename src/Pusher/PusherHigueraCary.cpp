@@ -35,7 +35,7 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
     std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
     
-    int nparts = particles.size();
+    int nparts = Epart->size()/3;
     double *Ex = &( ( *Epart )[0*nparts] );
     double *Ey = &( ( *Epart )[1*nparts] );
     double *Ez = &( ( *Epart )[2*nparts] );
@@ -52,7 +52,7 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
     double pxsm, pysm, pzsm;
     double local_invgf;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -60,12 +60,6 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     short *charge = &( particles.charge( 0 ) );
     
     #pragma omp simd
@@ -73,9 +67,9 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
         charge_over_mass_dts2 = ( double )( charge[ipart] )*one_over_mass_*dts2;
         
         // init Half-acceleration in the electric field
-        pxsm = charge_over_mass_dts2*( *( Ex+ipart ) );
-        pysm = charge_over_mass_dts2*( *( Ey+ipart ) );
-        pzsm = charge_over_mass_dts2*( *( Ez+ipart ) );
+        pxsm = charge_over_mass_dts2*( *( Ex+ipart-ipart_ref ) );
+        pysm = charge_over_mass_dts2*( *( Ey+ipart-ipart_ref ) );
+        pzsm = charge_over_mass_dts2*( *( Ez+ipart-ipart_ref ) );
         
         //(*this)(particles, ipart, (*Epart)[ipart], (*Bpart)[ipart] , (*invgf)[ipart]);
         umx = momentum[0][ipart] + pxsm;
@@ -87,9 +81,9 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
         gfm2 = ( 1.0 + umx*umx + umy*umy + umz*umz );
         
         // Equivalent of betax,betay,betaz in the paper
-        Tx    = charge_over_mass_dts2 * ( *( Bx+ipart ) );
-        Ty    = charge_over_mass_dts2 * ( *( By+ipart ) );
-        Tz    = charge_over_mass_dts2 * ( *( Bz+ipart ) );
+        Tx    = charge_over_mass_dts2 * ( *( Bx+ipart-ipart_ref ) );
+        Ty    = charge_over_mass_dts2 * ( *( By+ipart-ipart_ref ) );
+        Tz    = charge_over_mass_dts2 * ( *( Bz+ipart-ipart_ref ) );
         
         // beta**2
         beta2 = Tx*Tx + Ty*Ty + Tz*Tz;
@@ -120,20 +114,15 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
         pzsm += upz;
         
         // final gamma factor
-        ( *invgf )[ipart] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
+        ( *invgf )[ipart-ipart_ref] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
         
         momentum[0][ipart] = pxsm;
         momentum[1][ipart] = pysm;
         momentum[2][ipart] = pzsm;
         
         // Move the particle
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         for( int i = 0 ; i<nDim_ ; i++ ) {
-            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart];
+            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart-ipart_ref];
         }
         
     }
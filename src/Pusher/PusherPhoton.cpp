@@ -35,7 +35,7 @@ void PusherPhoton::operator()( Particles &particles, SmileiMPI *smpi,
     // Inverse normalized energy
     std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -43,28 +43,17 @@ void PusherPhoton::operator()( Particles &particles, SmileiMPI *smpi,
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     
     #pragma omp simd
     for( int ipart=istart ; ipart<iend; ipart++ ) {
     
-        ( *invgf )[ipart] = 1. / sqrt( momentum[0][ipart]*momentum[0][ipart] +
-                                       momentum[1][ipart]*momentum[1][ipart] +
-                                       momentum[2][ipart]*momentum[2][ipart] );
+        ( *invgf )[ipart-ipart_ref] = 1. / sqrt( momentum[0][ipart]*momentum[0][ipart] +
+                                                 momentum[1][ipart]*momentum[1][ipart] +
+                                                 momentum[2][ipart]*momentum[2][ipart] );
                                        
         // Move the photons
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         for( int i = 0 ; i<nDim_ ; i++ ) {
-            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart];
+            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart-ipart_ref];
         }
         
     }
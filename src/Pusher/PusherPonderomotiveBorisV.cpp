@@ -35,7 +35,7 @@ void PusherPonderomotiveBorisV::operator()( Particles &particles, SmileiMPI *smp
     double TxTy, TyTz, TzTx;
     double one_ov_gamma_ponderomotive;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -57,14 +57,14 @@ void PusherPonderomotiveBorisV::operator()( Particles &particles, SmileiMPI *smp
     double dcharge[nparts];
     #pragma omp simd
     for( int ipart=istart ; ipart<iend; ipart++ ) {
-        dcharge[ipart] = ( double )( charge[ipart] );
+        dcharge[ipart-ipart_ref] = ( double )( charge[ipart] );
     }
     
     #pragma omp simd
     for( int ipart=istart ; ipart<iend; ipart++ ) {
         double psm[3], um[3];
         
-        charge_over_mass_dts2 = dcharge[ipart]*one_over_mass_*dts2;
+        charge_over_mass_dts2 = dcharge[ipart-ipart_ref]*one_over_mass_*dts2;
         // ! ponderomotive force is proportional to charge squared and the field is divided by 4 instead of 2
         charge_sq_over_mass_sq_dts4 = ( double )( charge[ipart] )*( double )( charge[ipart] )*one_over_mass_*one_over_mass_*dts4;
         
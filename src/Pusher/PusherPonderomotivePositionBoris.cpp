@@ -34,7 +34,7 @@ void PusherPonderomotivePositionBoris::operator()( Particles &particles, SmileiM
     double gamma0, gamma0_sq, gamma_ponderomotive;
     double pxsm, pysm, pzsm;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -42,12 +42,6 @@ void PusherPonderomotivePositionBoris::operator()( Particles &particles, SmileiM
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     
     short *charge = &( particles.charge( 0 ) );
     
@@ -79,11 +73,6 @@ void PusherPonderomotivePositionBoris::operator()( Particles &particles, SmileiM
         ( *invgf )[ipart] = 1. / gamma_ponderomotive;
         
         // Move the particle
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         for( int i = 0 ; i<nDim_ ; i++ ) {
             position[i][ipart]     += dt*momentum[i][ipart]/gamma_ponderomotive;
         }
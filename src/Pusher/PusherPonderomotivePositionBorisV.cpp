@@ -35,7 +35,7 @@ void PusherPonderomotivePositionBorisV::operator()( Particles &particles, Smilei
     
     //int* cell_keys;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -43,12 +43,6 @@ void PusherPonderomotivePositionBorisV::operator()( Particles &particles, Smilei
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     
     short *charge = &( particles.charge( 0 ) );
     
@@ -84,11 +78,6 @@ void PusherPonderomotivePositionBorisV::operator()( Particles &particles, Smilei
         gamma_ponderomotive = gamma0 + ( pxsm*momentum[0][ipart]+pysm*momentum[1][ipart]+pzsm*momentum[2][ipart] ) ;
         
         // Move the particle
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         for( int i = 0 ; i<nDim_ ; i++ ) {
             position[i][ipart]     += dt*momentum[i][ipart]/gamma_ponderomotive;
         }
@@ -46,7 +46,7 @@ void PusherVay::operator()( Particles &particles, SmileiMPI *smpi, int istart, i
     //double Tx2, Ty2, Tz2;
     //double TxTy, TyTz, TzTx;
     
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -54,15 +54,9 @@ void PusherVay::operator()( Particles &particles, SmileiMPI *smpi, int istart, i
     for( int i = 0 ; i<nDim_ ; i++ ) {
         position[i] =  &( particles.position( i, 0 ) );
     }
-#ifdef  __DEBUG
-    double *position_old[3];
-    for( int i = 0 ; i<nDim_ ; i++ ) {
-        position_old[i] =  &( particles.position_old( i, 0 ) );
-    }
-#endif
     short *charge = &( particles.charge( 0 ) );
     
-    int nparts = particles.size();
+    int nparts = Epart->size()/3;
     double *Ex = &( ( *Epart )[0*nparts] );
     double *Ey = &( ( *Epart )[1*nparts] );
     double *Ez = &( ( *Epart )[2*nparts] );
@@ -78,23 +72,23 @@ void PusherVay::operator()( Particles &particles, SmileiMPI *smpi, int istart, i
         // Part I: Computation of uprime
         
         // For unknown reason, this has to be computed again
-        ( *invgf )[ipart] = 1./sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
-                                     + momentum[1][ipart]*momentum[1][ipart]
-                                     + momentum[2][ipart]*momentum[2][ipart] );
+        ( *invgf )[ipart-ipart_ref] = 1./sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
+                                               + momentum[1][ipart]*momentum[1][ipart]
+                                               + momentum[2][ipart]*momentum[2][ipart] );
                                      
         // Add Electric field
-        upx = momentum[0][ipart] + 2.*charge_over_mass_dts2*( *( Ex+ipart ) );
-        upy = momentum[1][ipart] + 2.*charge_over_mass_dts2*( *( Ey+ipart ) );
-        upz = momentum[2][ipart] + 2.*charge_over_mass_dts2*( *( Ez+ipart ) );
+        upx = momentum[0][ipart] + 2.*charge_over_mass_dts2*( *( Ex+ipart-ipart_ref ) );
+        upy = momentum[1][ipart] + 2.*charge_over_mass_dts2*( *( Ey+ipart-ipart_ref ) );
+        upz = momentum[2][ipart] + 2.*charge_over_mass_dts2*( *( Ez+ipart-ipart_ref ) );
         
         // Add magnetic field
-        Tx  = charge_over_mass_dts2* ( *( Bx+ipart ) );
-        Ty  = charge_over_mass_dts2* ( *( By+ipart ) );
-        Tz  = charge_over_mass_dts2* ( *( Bz+ipart ) );
+        Tx  = charge_over_mass_dts2* ( *( Bx+ipart-ipart_ref ) );
+        Ty  = charge_over_mass_dts2* ( *( By+ipart-ipart_ref ) );
+        Tz  = charge_over_mass_dts2* ( *( Bz+ipart-ipart_ref ) );
         
-        upx += ( *invgf )[ipart]*( momentum[1][ipart]*Tz - momentum[2][ipart]*Ty );
-        upy += ( *invgf )[ipart]*( momentum[2][ipart]*Tx - momentum[0][ipart]*Tz );
-        upz += ( *invgf )[ipart]*( momentum[0][ipart]*Ty - momentum[1][ipart]*Tx );
+        upx += ( *invgf )[ipart-ipart_ref]*( momentum[1][ipart]*Tz - momentum[2][ipart]*Ty );
+        upy += ( *invgf )[ipart-ipart_ref]*( momentum[2][ipart]*Tx - momentum[0][ipart]*Tz );
+        upz += ( *invgf )[ipart-ipart_ref]*( momentum[0][ipart]*Ty - momentum[1][ipart]*Tx );
         
         // alpha is gamma^2
         alpha = 1.0 + upx*upx + upy*upy + upz*upz;
@@ -135,31 +129,27 @@ void PusherVay::operator()( Particles &particles, SmileiMPI *smpi, int istart, i
         //pzsm = ((TzTx+Ty)* upx  + (TyTz-Tx)* upy + (1.0+Tz2)* upz)*s;
         
         // Inverse Gamma factor
-        ( *invgf )[ipart] = 1.0 / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
+        ( *invgf )[ipart-ipart_ref] = 1.0 / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
         
         momentum[0][ipart] = pxsm;
         momentum[1][ipart] = pysm;
         momentum[2][ipart] = pzsm;
         
         // Move the particle
-#ifdef  __DEBUG
-        for( int i = 0 ; i<nDim_ ; i++ ) {
-            position_old[i][ipart] = position[i][ipart];
-        }
-#endif
         for( int i = 0 ; i<nDim_ ; i++ ) {
-            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart];
+            position[i][ipart]     += dt*momentum[i][ipart]*( *invgf )[ipart-ipart_ref];
         }
         
     }
     
     if( vecto ) {
         int *cell_keys;
+        int npart_tot = particles.size();
         
-        particles.cell_keys.resize( nparts );
+        particles.cell_keys.resize( npart_tot );
         cell_keys = &( particles.cell_keys[0] );
         #pragma omp simd
-        for( int ipart=0 ; ipart<nparts; ipart++ ) {
+        for( int ipart=0 ; ipart<npart_tot; ipart++ ) {
         
             for( int i = 0 ; i<nDim_ ; i++ ) {
                 cell_keys[ipart] *= nspace[i];
@@ -6,7 +6,7 @@
 
 gc.collect()
 import math
-import glob, re
+import glob, re, numbers
 
 def _mkdir(role, path):
     if not os.path.exists(path):
@@ -104,6 +104,120 @@ def _smilei_check():
         l.space_envelope  = [ toSpaceProfile(p) for p in l.space_envelope ]
         l.phase           = [ toSpaceProfile(p) for p in l.phase          ]
     
+# Translation of profiles into native expressions, evaluated without python (see Function_Expression)
+class _Expression(object):
+    """Records the operations applied to the variables of a profile, as a postfix code"""
+    __array_priority__ = 1000
+    __hash__ = None
+    def __init__(self, code):
+        self.code = code
+    @staticmethod
+    def _code(a):
+        if isinstance(a, _Expression):
+            return a.code
+        if isinstance(a, numbers.Real):
+            return [("c", float(a))]
+        raise TypeError("cannot translate "+type(a).__name__)
+    def _op(self, name, *args):
+        code = list(self.code)
+        for a in args:
+            code += _Expression._code(a)
+        return _Expression(code + [(name, 0.)])
+    def _rop(self, name, a):
+        return _Expression(_Expression._code(a) + self.code + [(name, 0.)])
+    def __add__     (self, a): return self._op ("+" , a)
+    def __radd__    (self, a): return self._rop("+" , a)
+    def __sub__     (self, a): return self._op ("-" , a)
+    def __rsub__    (self, a): return self._rop("-" , a)
+    def __mul__     (self, a): return self._op ("*" , a)
+    def __rmul__    (self, a): return self._rop("*" , a)
+    def __truediv__ (self, a): return self._op ("/" , a)
+    def __rtruediv__(self, a): return self._rop("/" , a)
+    __div__, __rdiv__ = __truediv__, __rtruediv__
+    def __pow__     (self, a): return self._op ("**", a)
+    def __rpow__    (self, a): return self._rop("**", a)
+    def __lt__      (self, a): return self._op ("<" , a)
+    def __le__      (self, a): return self._op ("<=", a)
+    def __gt__      (self, a): return self._op (">" , a)
+    def __ge__      (self, a): return self._op (">=", a)
+    def __eq__      (self, a): return self._op ("==", a)
+    def __ne__      (self, a): return self._op ("!=", a)
+    def __neg__     (self   ): return self._op ("neg")
+    def __pos__     (self   ): return self
+    def __abs__     (self   ): return self._op ("abs")
+    def __bool__(self):
+        raise TypeError("cannot translate a condition")
+    __nonzero__ = __bool__
+    def __float__(self):
+        raise TypeError("cannot translate a conversion to float")
+    _ufuncs = {"add":"+", "subtract":"-", "multiply":"*", "divide":"/", "true_divide":"/", "power":"**",
+        "less":"<", "less_equal":"<=", "greater":">", "greater_equal":">=", "equal":"==", "not_equal":"!=",
+        "logical_and":"and", "logical_or":"or", "logical_not":"not", "negative":"neg", "absolute":"abs", "fabs":"abs",
+        "exp":"exp", "log":"log", "log10":"log10", "sqrt":"sqrt", "sin":"sin", "cos":"cos", "tan":"tan",
+        "arcsin":"asin", "arccos":"acos", "arctan":"atan", "arctan2":"atan2", "sinh":"sinh", "cosh":"cosh",
+        "tanh":"tanh", "floor":"floor", "ceil":"ceil", "maximum":"max", "minimum":"min"}
+    def __array_ufunc__(self, ufunc, method, *inputs, **kwargs):
+        if method != "__call__" or kwargs:
+            return NotImplemented
+        if ufunc.__name__ == "square":
+            return _Expression(self.code + self.code + [("*", 0.)])
+        if ufunc.__name__ not in _Expression._ufuncs:
+            return NotImplemented
+        return _Expression(sum([_Expression._code(a) for a in inputs], []) + [(_Expression._ufuncs[ufunc.__name__], 0.)])
+
+_math_operations = {"exp":"exp", "log":"log", "log10":"log10", "sqrt":"sqrt", "sin":"sin", "cos":"cos", "tan":"tan",
+    "asin":"asin", "acos":"acos", "atan":"atan", "atan2":"atan2", "sinh":"sinh", "cosh":"cosh", "tanh":"tanh",
+    "floor":"floor", "ceil":"ceil", "fabs":"abs", "pow":"**"}
+
+def _math_wrapper(original, operation):
+    def f(*args):
+        if not any([isinstance(a, _Expression) for a in args]):
+            return original(*args)
+        return _Expression(sum([_Expression._code(a) for a in args], []) + [(operation, 0.)])
+    return f
+
+def _native_expression(profile, nvariables):
+    """Translates a profile into a postfix code (lists of operations and of their values),
+    with samples of the profile values to verify the translation. Returns None if not possible"""
+    try:
+        return profile._smilei_native
+    except:
+        pass
+    result = None
+    # Replace the math functions by versions that record their operation on variables
+    namespaces = [math.__dict__, getattr(profile, "__globals__", {})]
+    replaced = []
+    for name, operation in _math_operations.items():
+        original = getattr(math, name)
+        wrapper = _math_wrapper(original, operation)
+        for namespace in namespaces:
+            for key in [k for k,v in namespace.items() if v is original]:
+                replaced += [(namespace, key, original)]
+                namespace[key] = wrapper
+    try:
+        code = _Expression._code( profile(*[_Expression([("x", float(i))]) for i in range(nvariables)]) )
+    except:
+        code = None
+    finally:
+        for namespace, key, original in replaced:
+            namespace[key] = original
+    # Values of the profile at a few points
+    if code is not None:
+        samples = []
+        for t in [0.3, 1.1, 2.9, 7.3, 19.7, 53.1]:
+            point = [t*(1.+0.37*i) for i in range(nvariables)]
+            try:
+                samples += [point + [float(profile(*point))]]
+            except:
+                pass
+        if len(samples) > 0:
+            result = [[c[0] for c in code], [c[1] for c in code], samples]
+    try:
+        profile._smilei_native = result
+    except:
+        pass
+    return result
+
 # this function will be called after initialising the simulation, just before entering the time loop
 # if it returns false, the code will call a Py_Finalize();
 def _keep_python_running():
@@ -117,12 +231,15 @@ def _keep_python_running():
         if hasattr(las, "_extra_envelope"):
             profiles += [las._extra_envelope]
     profiles += [ant.time_profile for ant in Antenna]
-    if len(MovingWindow)>0 or len(LoadBalancing)>0:
-        for s in Species:
-            profiles += [s.number_density, s.charge_density, s.particles_per_cell, s.charge] + s.mean_velocity + s.temperature
     for prof in profiles:
         if callable(prof) and not hasattr(prof,"profileName"):
             return True
+    # Species profiles translated into native expressions do not need python
+    if len(MovingWindow)>0 or len(LoadBalancing)>0:
+        for s in Species:
+            for prof in [s.number_density, s.charge_density, s.particles_per_cell, s.charge] + s.mean_velocity + s.temperature:
+                if callable(prof) and not hasattr(prof,"profileName") and getattr(prof,"_smilei_native",None) is None:
+                    return True
     # Verify the tracked species that require a particle selection
     for d in DiagTrackParticles:
         if d.filter is not None:
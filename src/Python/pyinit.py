@@ -178,7 +178,9 @@ class Main(SmileiSingleton):
     interpolation_order = 2
     number_of_patches = None
     patch_arrangement = "hilbertian"
+    shared_memory_halos = False
     clrw = -1
+    particle_chunk_size = 0
     every_clean_particles_overhead = 100
     timestep = None
     number_of_AM = 2
@@ -194,6 +196,7 @@ class Main(SmileiSingleton):
     solve_poisson = True
     poisson_max_iteration = 50000
     poisson_max_error = 1.e-14
+    poisson_preconditioner = "none"
 
     # Relativistic Poisson tuning
     solve_relativistic_poisson = False
@@ -213,6 +216,7 @@ class Main(SmileiSingleton):
     print_every = None
     random_seed = None
     print_expected_disk_usage = True
+    async_diags = 0
 
     def __init__(self, **kwargs):
         # Load all arguments to Main()
@@ -291,6 +295,8 @@ class LoadBalancing(SmileiSingleton):
     initial_balance      = True
     cell_load            = 1.0
     frozen_particle_load = 0.1
+    measured_load        = False
+    measured_load_smoothing = 10
 
 # Radiation reaction configuration (continuous and MC algorithms)
 class Vectorization(SmileiSingleton):
@@ -318,7 +324,11 @@ class Checkpoints(SmileiSingleton):
     dump_minutes = 0.
     keep_n_dumps = 2
     dump_deflate = 0
+    dump_compression = "none"
     exit_after_dump = True
+    async_dump = False
+    async_dump_max_memory = 1024.
+    incremental_dumps = 0
     file_grouping = None
     restart_files = []
 
@@ -419,6 +429,7 @@ class DiagParticleBinning(SmileiComponent):
     axes = []
     every = None
     flush_every = 1
+    parallel_write = False
 
 class DiagScreen(SmileiComponent):
     """Screen diagnostic"""
@@ -453,6 +464,7 @@ class DiagTrackParticles(SmileiComponent):
     every = 0
     flush_every = 1
     filter = None
+    ordered = False
     attributes = ["x", "y", "z", "px", "py", "pz"]
 
 class DiagPerformances(SmileiSingleton):
@@ -668,38 +668,25 @@ def LaserEnvelopeGaussian3D( a0=1., omega=1., focus=None, waist=3., time_envelop
         Envelope_boundary_conditions = Envelope_boundary_conditions,
     )
 # Define the tools for the propagation of a laser profile
-try:
-    import numpy as np
+_N_LaserOffset = 0
+
+def LaserOffset(box_side="xmin", space_time_profile=[], offset=0., extra_envelope=lambda *a:1., keep_n_strongest_modes=100, angle=0.):
+    global _N_LaserOffset
+    
+    file = 'LaserOffset'+str(_N_LaserOffset)+'.h5'
     
-    _N_LaserOffset = 0
+    L = Laser(
+        box_side = "xmin",
+        file = file,
+    )
     
-    def LaserOffset(box_side="xmin", space_time_profile=[], offset=0., extra_envelope=lambda *a:1., keep_n_strongest_modes=100, angle=0.):
-        global _N_LaserOffset
-        
-        file = 'LaserOffset'+str(_N_LaserOffset)+'.h5'
-        
-        L = Laser(
-            box_side = "xmin",
-            file = file,
-        )
-        
-        L._offset = offset
-        L._extra_envelope = extra_envelope
-        L._profiles = space_time_profile
-        L._keep_n_strongest_modes = keep_n_strongest_modes
-        L._angle = angle
-        
-        _N_LaserOffset += 1
-
-except:
+    L._offset = offset
+    L._extra_envelope = extra_envelope
+    L._profiles = space_time_profile
+    L._keep_n_strongest_modes = keep_n_strongest_modes
+    L._angle = angle
     
-    def LaserOffset(box_side="xmin", space_time_profile=[], offset=0., time_envelope=1.):
-        L = Laser(
-            box_side = "xmin",
-            file = "none",
-            time_envelope = time_envelope
-        )
-        print("WARNING: LaserOffset unavailable because numpy was not found")
+    _N_LaserOffset += 1
 
 """
 -----------------------------------------------------------------------
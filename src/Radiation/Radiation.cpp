@@ -81,7 +81,7 @@ void Radiation::computeParticlesChi( Particles &particles,
     double gamma;
     
     // Momentum shortcut
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -18,6 +18,7 @@
 #include "Particles.h"
 #include "Species.h"
 #include "RadiationTables.h"
+#include "Random.h"
 
 //  ----------------------------------------------------------------------------
 //! Class Radiation
@@ -38,12 +39,14 @@ public:
     //                     for nonlinear inverse Compton scattering
     //! \param istart      Index of the first particle
     //! \param iend        Index of the last particle
+    //! \param rand        Random number generator of the patch
     //! \param ithread     Thread index
     virtual void operator()(
         Particles &particles,
         Species *photon_species,
         SmileiMPI *smpi,
         RadiationTables &RadiationTables,
+        Random *rand,
         int istart,
         int iend,
         int ithread, int ipart_ref = 0 ) = 0;
@@ -63,7 +66,7 @@ public:
     //! \param Bz z component of the particle magnetic field
     //#pragma omp declare simd
     double inline computeParticleChi( double &charge_over_mass2,
-                                      double &px, double &py, double &pz,
+                                      double px, double py, double pz,
                                       double &gamma,
                                       double &Ex, double &Ey, double &Ez,
                                       double &Bx, double &By, double &Bz )
@@ -47,6 +47,7 @@ void RadiationLandauLifshitz::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -82,7 +83,7 @@ void RadiationLandauLifshitz::operator()(
     double temp;
     
     // Momentum shortcut
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
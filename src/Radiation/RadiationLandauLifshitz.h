@@ -53,6 +53,7 @@ public:
         Species *photon_species,
         SmileiMPI *smpi,
         RadiationTables &RadiationTables,
+        Random *rand,
         int istart,
         int iend,
         int ithread, int ipart_ref = 0 );
@@ -53,6 +53,7 @@ void RadiationMonteCarlo::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -99,7 +100,7 @@ void RadiationMonteCarlo::operator()(
     int mc_it_nb;
     
     // Momentum shortcut
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -163,7 +164,7 @@ void RadiationMonteCarlo::operator()(
                     && ( tau[ipart] <= epsilon_tau_ ) ) {
                 // New final optical depth to reach for emision
                 while( tau[ipart] <= epsilon_tau_ ) {
-                    tau[ipart] = -log( 1.-Rand::uniform() );
+                    tau[ipart] = -log( 1.-rand->uniform() );
                 }
                 
             }
@@ -193,7 +194,7 @@ void RadiationMonteCarlo::operator()(
                                                          momentum,
                                                          weight,
                                                          photon_species,
-                                                         RadiationTables );
+                                                         RadiationTables, rand );
                                                          
                     // Optical depth becomes negative meaning
                     // that a new drawing is possible
@@ -267,10 +268,11 @@ void RadiationMonteCarlo::photonEmission( int ipart,
         double &particle_chi,
         double &particle_gamma,
         double *position[3],
-        double *momentum[3],
+        momentum_t *momentum[3],
         double *weight,
         Species *photon_species,
-        RadiationTables &RadiationTables )
+        RadiationTables &RadiationTables,
+        Random *rand )
 {
     // ____________________________________________________
     // Parameters
@@ -280,7 +282,7 @@ void RadiationMonteCarlo::photonEmission( int ipart,
     //double new_norm_p;
     
     // Get the photon quantum parameter from the table xip
-    photon_chi = RadiationTables.computeRandomPhotonChi( particle_chi );
+    photon_chi = RadiationTables.computeRandomPhotonChi( particle_chi, rand );
     
     // compute the photon gamma factor
     gammaph = photon_chi/particle_chi*( particle_gamma-1.0 );
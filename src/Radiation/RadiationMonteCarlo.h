@@ -49,6 +49,7 @@ public:
         Species *photon_species,
         SmileiMPI *smpi,
         RadiationTables &RadiationTables,
+        Random *rand,
         int istart,
         int iend,
         int ithread, int ipart_ref = 0 );
@@ -68,10 +69,11 @@ public:
                          double &particle_chi,
                          double &particle_gamma,
                          double *position[3],
-                         double *momentum[3],
+                         momentum_t *momentum[3],
                          double *weight,
                          Species *photon_species,
-                         RadiationTables &RadiationTables );
+                         RadiationTables &RadiationTables,
+                         Random *rand );
                          
 protected:
 
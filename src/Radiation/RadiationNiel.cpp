@@ -50,6 +50,7 @@ void RadiationNiel::operator()(
     Species *photon_species,
     SmileiMPI *smpi,
     RadiationTables &RadiationTables,
+    Random *rand,
     int istart,
     int iend,
     int ithread, int ipart_ref )
@@ -99,7 +100,7 @@ void RadiationNiel::operator()(
     double random_numbers[nbparticles];
     
     // Momentum shortcut
-    double *momentum[3];
+    momentum_t *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, istart ) );
     }
@@ -161,17 +162,11 @@ void RadiationNiel::operator()(
     }*/
     
     // Vectorized computation of the random number in a uniform distribution
+    // (drawn for all particles, so that the stream does not depend on particle_chi)
+    rand->uniform( &random_numbers[0], nbparticles );
     #pragma omp simd
     for( ipart=0 ; ipart < nbparticles; ipart++ ) {
-    
-        // Below particle_chi = minimum_chi_continuous_, radiation losses are negligible
-        if( particle_chi[ipart] > minimum_chi_continuous_ ) {
-        
-            // Pick a random number in the normal distribution of standard
-            // deviation sqrt(dt_) (variance dt_)
-            //random_numbers[ipart] = 2.*Rand::uniform() -1.;
-            random_numbers[ipart] = 2.*drand48() -1.;
-        }
+        random_numbers[ipart] = 2.*random_numbers[ipart] -1.;
     }
     
     // Vectorized computation of the random number in a normal distribution
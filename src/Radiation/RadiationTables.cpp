@@ -1104,7 +1104,7 @@ void RadiationTables::output_tables( SmileiMPI *smpi )
 //
 //! \param particle_chi particle quantum parameter
 // -----------------------------------------------------------------------------
-double RadiationTables::computeRandomPhotonChi( double particle_chi )
+double RadiationTables::computeRandomPhotonChi( double particle_chi, Random *rand )
 {
     // Log10 of particle_chi
     double logchipa;
@@ -1141,7 +1141,7 @@ double RadiationTables::computeRandomPhotonChi( double particle_chi )
     // ---------------------------------------
     
     // First, we compute a random xip in [0,1[
-    xip = Rand::uniform();
+    xip = rand->uniform();
     
     // If the randomly computed xip if below the first one of the row,
     // we take the first one which corresponds to the minimal photon photon_chi
@@ -1437,7 +1437,8 @@ double RadiationTables::getHNielFromTable( double particle_chi )
 // -----------------------------------------------------------------------------
 double RadiationTables::getNielStochasticTerm( double gamma,
         double particle_chi,
-        double sqrtdt )
+        double sqrtdt,
+        Random *rand )
 {
     // Get the value of h for the corresponding particle_chi
     double h, r;
@@ -1446,7 +1447,7 @@ double RadiationTables::getNielStochasticTerm( double gamma,
     
     // Pick a random number in the normal distribution of standard
     // deviation sqrt(dt) (variance dt)
-    r = Rand::normal( sqrtdt );
+    r = rand->normal( sqrtdt );
     
     /*std::random_device device;
     std::mt19937 gen(device());
@@ -19,6 +19,7 @@
 
 #include "Params.h"
 #include "H5.h"
+#include "Random.h"
 
 //------------------------------------------------------------------------------
 //! RadiationTables class: holds parameters, tables and functions to compute
@@ -76,7 +77,7 @@ public:
     //! from a particle chi value (particle_chi) and
     //! using the tables xip and chiphmin
     //! \param particle_chi particle quantum parameter
-    double computeRandomPhotonChi( double particle_chi );
+    double computeRandomPhotonChi( double particle_chi, Random *rand );
     
     //! Return the value of the function h(particle_chi) of Niel et al.
     //! Use an integration of Gauss-Legendre
@@ -98,7 +99,8 @@ public:
     //! \param dt time step
     double getNielStochasticTerm( double gamma,
                                   double particle_chi,
-                                  double dt );
+                                  double dt,
+                                  Random *rand );
                                   
     //! Computation of the corrected continuous quantum radiated energy
     //! during dt from the quantum parameter particle_chi using the Ridgers
@@ -370,6 +370,9 @@ int main( int argc, char *argv[] )
             // apply currents from antennas
             vecPatches.applyAntennas( time_dual );
             
+            // start sending particles, while solving Maxwell's equations
+            vecPatches.sendParticles( params, &smpi, simWindow, time_dual, timers, itime );
+            
             // solve Maxwell's equations
 #ifndef _PICSAR
             // Force temporary usage of double grids, even if global_factor = 1
@@ -439,6 +442,7 @@ int main( int argc, char *argv[] )
         
     } //End omp parallel region
     
+    checkpoint.waitDump();
     smpi.barrier();
     
     // ------------------------------------------------------------------
@@ -201,5 +201,33 @@ void SpeciesMPIbuffers::allocate( unsigned int ndims )
         part_index_recv_sz[i].resize( 2 );
     }
     
+    unsigned int nneighbors = 1;
+    for( unsigned int i=0 ; i<ndims ; i++ ) {
+        nneighbors *= 3;
+    }
+    neighbor_partSend.resize( nneighbors );
+    neighbor_partRecv.resize( nneighbors );
+    neighbor_part_index_send.resize( nneighbors );
+    neighbor_send_sz.resize( nneighbors, 0 );
+    neighbor_recv_sz.resize( nneighbors, 0 );
+    neighbor_srequest.resize( nneighbors, MPI_REQUEST_NULL );
+    neighbor_rrequest.resize( nneighbors, MPI_REQUEST_NULL );
+    
 }
 
+
+std::vector<Particles *> SpeciesMPIbuffers::particlePackets()
+{
+    std::vector<Particles *> packets;
+    for( unsigned int i=0 ; i<partSend.size() ; i++ ) {
+        for( unsigned int j=0 ; j<partSend[i].size() ; j++ ) {
+            packets.push_back( &partSend[i][j] );
+            packets.push_back( &partRecv[i][j] );
+        }
+    }
+    for( unsigned int k=0 ; k<neighbor_partSend.size() ; k++ ) {
+        packets.push_back( &neighbor_partSend[k] );
+        packets.push_back( &neighbor_partRecv[k] );
+    }
+    return packets;
+}
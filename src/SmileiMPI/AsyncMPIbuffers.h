@@ -56,6 +56,19 @@ public:
     //! ndim vectors of 2 numbers of particles to receive (1 per direction)
     std::vector< std::vector< unsigned int > > part_index_recv_sz;
     
+    //! Single-phase exchange with the 3^ndim patches around (see Patch::all_neighbor_)
+    //!   - packets of particles sent to / received from each of them
+    std::vector<Particles> neighbor_partSend, neighbor_partRecv;
+    //!   - indexes of the particles to send to each of them
+    std::vector< std::vector<int> > neighbor_part_index_send;
+    //!   - numbers of particles to send / to receive
+    std::vector<unsigned int> neighbor_send_sz, neighbor_recv_sz;
+    //!   - sent / received requests
+    std::vector<MPI_Request> neighbor_srequest, neighbor_rrequest;
+    
+    //! All the packets of particles above, in a fixed order (used to keep their memory, see Patch::recycle)
+    std::vector<Particles *> particlePackets();
+    
 };
 
 #endif
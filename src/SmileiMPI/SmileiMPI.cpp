@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <algorithm>
 
 #include <iostream>
 #include <sstream>
@@ -39,9 +40,6 @@ SmileiMPI::SmileiMPI( int *argc, char ***argv )
 {
     test_mode = false;
     
-    // Send information on current simulation
-    int mpi_provided;
-    
 #ifdef _OPENMP
     MPI_Init_thread( argc, argv, MPI_THREAD_MULTIPLE, &mpi_provided );
 #ifndef _NO_MPI_TM
@@ -52,6 +50,7 @@ SmileiMPI::SmileiMPI( int *argc, char ***argv )
     smilei_omp_max_threads = omp_get_max_threads();
 #else
     MPI_Init( argc, argv );
+    MPI_Query_thread( &mpi_provided );
     smilei_omp_max_threads = 1;
 #endif
     
@@ -70,6 +69,8 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
     
+    cleanSharedHalos();
+    
     MPI_Finalize();
     
 } // END SmileiMPI::~SmileiMPI
@@ -178,9 +179,131 @@ void SmileiMPI::init( Params &params, DomainDecomposition *domain_decomposition
             MESSAGE( 1, "applied topology for periodic BCs in "<<"xyz"[i]<<"-direction" );
         }
     }
+    
+    initSharedHalos( params );
+    
 } // END init
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Find the processes of the node, whose halos may be exchanged through a shared memory window
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::initSharedHalos( Params &params )
+{
+    if( !params.shared_memory_halos ) {
+        return;
+    }
+    
+    MPI_Comm_split_type( SMILEI_COMM_WORLD, MPI_COMM_TYPE_SHARED, smilei_rk, MPI_INFO_NULL, &node_comm_ );
+    int node_sz;
+    MPI_Comm_size( node_comm_, &node_sz );
+    
+    // Rank in the node of each process
+    MPI_Group world_group, node_group;
+    MPI_Comm_group( SMILEI_COMM_WORLD, &world_group );
+    MPI_Comm_group( node_comm_, &node_group );
+    vector<int> world_ranks( smilei_sz );
+    for( int rk=0 ; rk<smilei_sz ; rk++ ) {
+        world_ranks[rk] = rk;
+    }
+    node_rank_.resize( smilei_sz );
+    MPI_Group_translate_ranks( world_group, smilei_sz, &world_ranks[0], node_group, &node_rank_[0] );
+    MPI_Group_free( &world_group );
+    MPI_Group_free( &node_group );
+    
+    halo_base_.resize( node_sz, NULL );
+    shared_halos_ = true;
+    
+    int max_node_sz;
+    MPI_Allreduce( &node_sz, &max_node_sz, 1, MPI_INT, MPI_MAX, SMILEI_COMM_WORLD );
+    MESSAGE( 1, "Halos exchanged through shared memory between the processes of a node (up to "<<max_node_sz<<" per node)" );
+    
+} // END initSharedHalos
+
+
+void SmileiMPI::cleanSharedHalos()
+{
+    if( halo_win_ != MPI_WIN_NULL ) {
+        MPI_Win_unlock_all( halo_win_ );
+        MPI_Win_free( &halo_win_ );
+    }
+    if( node_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &node_comm_ );
+    }
+    shared_halos_ = false;
+    
+} // END cleanSharedHalos
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// The window holds, for each process, 2 sets of nComp x nDim x 2 slots for as many patches as the most loaded process
+// of the node, so that the slots of a patch can be found from its hindex only.
+// All the processes of the node see the same patch_count, hence take the same decision.
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::reserveSharedHalos( unsigned int slot_size, unsigned int nDim, unsigned int nComp )
+{
+    unsigned int capacity = 0;
+    for( int rk=0 ; rk<smilei_sz ; rk++ ) {
+        if( node_rank_[rk] != MPI_UNDEFINED ) {
+            capacity = max( capacity, ( unsigned int )patch_count[rk] );
+        }
+    }
+    if( capacity <= halo_capacity_ && slot_size <= halo_slot_size_ && nDim == halo_ndim_ && nComp <= halo_ncomp_ ) {
+        return;
+    }
+    
+    if( halo_win_ != MPI_WIN_NULL ) {
+        MPI_Win_unlock_all( halo_win_ );
+        MPI_Win_free( &halo_win_ );
+    }
+    halo_capacity_  = max( capacity, halo_capacity_ );
+    halo_slot_size_ = max( slot_size, halo_slot_size_ );
+    halo_ndim_      = nDim;
+    halo_ncomp_     = max( nComp, halo_ncomp_ );
+    
+    MPI_Aint size = ( MPI_Aint )2 * halo_capacity_ * halo_ncomp_ * halo_ndim_ * 2 * halo_slot_size_ * sizeof( double );
+    double *base;
+    MPI_Win_allocate_shared( size, sizeof( double ), MPI_INFO_NULL, node_comm_, &base, &halo_win_ );
+    for( unsigned int irk=0 ; irk<halo_base_.size() ; irk++ ) {
+        MPI_Aint rk_size;
+        int disp_unit;
+        MPI_Win_shared_query( halo_win_, irk, &rk_size, &disp_unit, &halo_base_[irk] );
+    }
+    MPI_Win_lock_all( MPI_MODE_NOCHECK, halo_win_ );
+    
+} // END reserveSharedHalos
+
+
+double *SmileiMPI::sharedHaloSend( unsigned int hindex, unsigned int icomp, int iDim, int iNeighbor )
+{
+    unsigned int ipatch = ( halo_sync_count_%2 )*halo_capacity_ + hindex - patch_refHindexes[smilei_rk];
+    unsigned int islot = ( ( ipatch*halo_ncomp_ + icomp )*halo_ndim_ + iDim )*2 + iNeighbor;
+    return halo_base_[node_rank_[smilei_rk]] + ( size_t )islot * halo_slot_size_;
+}
+
+
+double *SmileiMPI::sharedHaloRecv( int rank, unsigned int hindex, unsigned int icomp, int iDim, int iNeighbor )
+{
+    unsigned int ipatch = ( ( halo_sync_count_+1 )%2 )*halo_capacity_ + hindex - patch_refHindexes[rank];
+    unsigned int islot = ( ( ipatch*halo_ncomp_ + icomp )*halo_ndim_ + iDim )*2 + iNeighbor;
+    return halo_base_[node_rank_[rank]] + ( size_t )islot * halo_slot_size_;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// After this barrier, the halos written are read by the neighbors while the other set of slots is written.
+// A set is written again only after the next barrier, which the readers reach once done with it.
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::syncSharedHalos()
+{
+    MPI_Win_sync( halo_win_ );
+    MPI_Barrier( node_comm_ );
+    MPI_Win_sync( halo_win_ );
+    halo_sync_count_++;
+    
+} // END syncSharedHalos
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 //  Initialize patch distribution
 // ---------------------------------------------------------------------------------------------------------------------
@@ -387,7 +510,7 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
     bool recompute_tload = true;
     //Load of a cell = cell_load*load of a particle.
     //Load of a frozen particle = frozen_particle_load*load of a particle.
-    std::vector<double> Lp, Lp_left, Lp_right;
+    std::vector<double> Lp, Lp_left, Lp_right, Lp_particles;
     ofstream fout;
     
     if( isMaster() ) {
@@ -413,21 +536,42 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         Lp_right.resize( patch_count[smilei_rk+1] );
     }
     
+    //Compute particle contribution to Local Loads of each Patch
+    Lp_particles.resize( patch_count[smilei_rk], 0. );
+    for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+        for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
+            Lp_particles[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen ) ) ;
+        }
+    }
     
+    //With measured loads, the particle contribution is replaced by the measured wall time of the patch,
+    //converted in units of the load of a particle using the global time per particle.
+    //Patches not measured yet (just received or created) keep the particle count estimate.
+    if( params.measured_load ) {
+        double measure[2] = {0., 0.}, global_measure[2];
+        for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+            if( vecpatches( ipatch )->measured_load_ >= 0. ) {
+                measure[0] += vecpatches( ipatch )->measured_load_;
+                measure[1] += Lp_particles[ipatch];
+            }
+        }
+        MPI_Allreduce( measure, global_measure, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        if( global_measure[0] > 0. && global_measure[1] > 0. ) {
+            double particles_per_second = global_measure[1] / global_measure[0];
+            for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+                if( vecpatches( ipatch )->measured_load_ >= 0. ) {
+                    Lp_particles[ipatch] = vecpatches( ipatch )->measured_load_ * particles_per_second;
+                }
+            }
+        }
+    }
     
     while( recompute_tload ) {
     
         Tload_loc = 0.;
         Ncur = 0; // Variation of the number of patches assigned to current rank r.
         for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            Lp[ipatch] =  cells_load ;
-        }
-        
-        //Compute particle contribution to Local Loads of each Patch (Lp)
-        for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
-                Lp[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen ) ) ;
-            }
+            Lp[ipatch] =  cells_load + Lp_particles[ipatch];
             Tload_loc += Lp[ipatch];
         }
         
@@ -572,17 +716,21 @@ int SmileiMPI::hrank( int h )
 // ----------------------------------------------------------------------
 MPI_Datatype SmileiMPI::createMPIparticles( Particles *particles )
 {
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
+    int nbrOfProp = particles->double_prop.size() + particles->float_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
     
     MPI_Aint address[nbrOfProp];
+    unsigned int iaddress = 0;
     for( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->double_prop[iprop] ) )[0] ), &( address[iprop] ) );
+        MPI_Get_address( &( ( *( particles->double_prop[iprop] ) )[0] ), &( address[iaddress++] ) );
+    }
+    for( unsigned int iprop=0 ; iprop<particles->float_prop.size() ; iprop++ ) {
+        MPI_Get_address( &( ( *( particles->float_prop[iprop] ) )[0] ), &( address[iaddress++] ) );
     }
     for( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->short_prop[iprop] ) )[0] ), &( address[particles->double_prop.size()+iprop] ) );
+        MPI_Get_address( &( ( *( particles->short_prop[iprop] ) )[0] ), &( address[iaddress++] ) );
     }
     for( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ ) {
-        MPI_Get_address( &( ( *( particles->uint64_prop[iprop] ) )[0] ), &( address[particles->double_prop.size()+particles->short_prop.size()+iprop] ) );
+        MPI_Get_address( &( ( *( particles->uint64_prop[iprop] ) )[0] ), &( address[iaddress++] ) );
     }
     
     int nbr_parts[nbrOfProp];
@@ -600,14 +748,18 @@ MPI_Datatype SmileiMPI::createMPIparticles( Particles *particles )
     
     MPI_Datatype partDataType[nbrOfProp];
     // define MPI type of each property, default is DOUBLE
+    unsigned int itype = 0;
     for( unsigned int i=0 ; i<particles->double_prop.size() ; i++ ) {
-        partDataType[i] = MPI_DOUBLE;
+        partDataType[itype++] = MPI_DOUBLE;
+    }
+    for( unsigned int iprop=0 ; iprop<particles->float_prop.size() ; iprop++ ) {
+        partDataType[itype++] = MPI_FLOAT;
     }
     for( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ ) {
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
+        partDataType[itype++] = MPI_SHORT;
     }
     for( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ ) {
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED_LONG_LONG;
+        partDataType[itype++] = MPI_UNSIGNED_LONG_LONG;
     }
     
     MPI_Datatype typeParticlesMPI;
@@ -1574,15 +1726,55 @@ void SmileiMPI::recv( int *integer, int from, int tag, unsigned int nDim_particl
 //   - concerns    : scalars, phasespace, particles
 //   - not concern : probes, fields, track particles (each patch write its own data)
 //   - called in VectorPatch::runAllDiags(...)
+// The sums of all the diags due now are packed and reduced by a single non-blocking MPI_Ireduce,
+// completed by completeGlobalDiags before the diags are written
 // ---------------------------------------------------------------------------------------------------------------------
-void SmileiMPI::computeGlobalDiags( Diagnostic *diag, int timestep )
+void SmileiMPI::computeGlobalDiags( vector<Diagnostic *> &diags, int timestep )
 {
-    if( DiagnosticScalar *scalar = dynamic_cast<DiagnosticScalar *>( diag ) ) {
-        computeGlobalDiags( scalar, timestep );
-    } else if( DiagnosticParticleBinning *particles = dynamic_cast<DiagnosticParticleBinning *>( diag ) ) {
-        computeGlobalDiags( particles, timestep );
-    } else if( DiagnosticScreen *screen = dynamic_cast<DiagnosticScreen *>( diag ) ) {
-        computeGlobalDiags( screen, timestep );
+    diags_sum_.resize( 0 );
+    diags_requests_.resize( 0 );
+    
+    // Each diag packs its sums, or starts its own reductions
+    for( unsigned int idiag = 0 ; idiag < diags.size() ; idiag++ ) {
+        if( !diags[idiag]->theTimeIsNow ) {
+            continue;
+        }
+        if( DiagnosticScalar *scalar = dynamic_cast<DiagnosticScalar *>( diags[idiag] ) ) {
+            computeGlobalDiags( scalar, timestep );
+        } else if( DiagnosticParticleBinning *particles = dynamic_cast<DiagnosticParticleBinning *>( diags[idiag] ) ) {
+            computeGlobalDiags( particles, timestep );
+        } else if( DiagnosticScreen *screen = dynamic_cast<DiagnosticScreen *>( diags[idiag] ) ) {
+            computeGlobalDiags( screen, timestep );
+        }
+    }
+    
+    // Reduce all the packed sums at once
+    if( diags_sum_.size() > 0 ) {
+        diags_requests_.push_back( MPI_REQUEST_NULL );
+        MPI_Ireduce( isMaster()?MPI_IN_PLACE:&diags_sum_[0], &diags_sum_[0], diags_sum_.size(), MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD, &diags_requests_.back() );
+    }
+}
+
+void SmileiMPI::completeGlobalDiags( vector<Diagnostic *> &diags, int timestep )
+{
+    if( diags_requests_.size() > 0 ) {
+        MPI_Waitall( diags_requests_.size(), &diags_requests_[0], MPI_STATUSES_IGNORE );
+        diags_requests_.resize( 0 );
+    }
+    
+    // Each diag gets its sums back, in the order they were packed
+    diags_sum_offset_ = 0;
+    for( unsigned int idiag = 0 ; idiag < diags.size() ; idiag++ ) {
+        if( !diags[idiag]->theTimeIsNow ) {
+            continue;
+        }
+        if( DiagnosticScalar *scalar = dynamic_cast<DiagnosticScalar *>( diags[idiag] ) ) {
+            completeGlobalDiags( scalar, timestep );
+        } else if( DiagnosticParticleBinning *particles = dynamic_cast<DiagnosticParticleBinning *>( diags[idiag] ) ) {
+            completeGlobalDiags( particles, timestep );
+        } else if( DiagnosticScreen *screen = dynamic_cast<DiagnosticScreen *>( diags[idiag] ) ) {
+            completeGlobalDiags( screen, timestep );
+        }
     }
 }
 
@@ -1597,22 +1789,37 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScalar *scalars, int timestep )
         return;
     }
     
-    // Reduce all scalars that should be summed
-    int n_sum = scalars->values_SUM.size();
-    double *d_sum = &scalars->values_SUM[0];
-    MPI_Reduce( isMaster()?MPI_IN_PLACE:d_sum, d_sum, n_sum, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+    // Pack all scalars that should be summed
+    diags_sum_.insert( diags_sum_.end(), scalars->values_SUM.begin(), scalars->values_SUM.end() );
     
     if( scalars->necessary_fieldMinMax_any ) {
         // Reduce all scalars that are a "min" and its location
         int n_min = scalars->values_MINLOC.size();
         val_index *d_min = &scalars->values_MINLOC[0];
-        MPI_Reduce( isMaster()?MPI_IN_PLACE:d_min, d_min, n_min, MPI_DOUBLE_INT, MPI_MINLOC, 0, MPI_COMM_WORLD );
+        diags_requests_.push_back( MPI_REQUEST_NULL );
+        MPI_Ireduce( isMaster()?MPI_IN_PLACE:d_min, d_min, n_min, MPI_DOUBLE_INT, MPI_MINLOC, 0, MPI_COMM_WORLD, &diags_requests_.back() );
         
         // Reduce all scalars that are a "max" and its location
         int n_max = scalars->values_MAXLOC.size();
         val_index *d_max = &scalars->values_MAXLOC[0];
-        MPI_Reduce( isMaster()?MPI_IN_PLACE:d_max, d_max, n_max, MPI_DOUBLE_INT, MPI_MAXLOC, 0, MPI_COMM_WORLD );
+        diags_requests_.push_back( MPI_REQUEST_NULL );
+        MPI_Ireduce( isMaster()?MPI_IN_PLACE:d_max, d_max, n_max, MPI_DOUBLE_INT, MPI_MAXLOC, 0, MPI_COMM_WORLD, &diags_requests_.back() );
+    }
+}
+
+void SmileiMPI::completeGlobalDiags( DiagnosticScalar *scalars, int timestep )
+{
+
+    if( !scalars->timeSelection->theTimeIsNow( timestep ) ) {
+        return;
+    }
+    
+    // Unpack the summed scalars
+    unsigned int n_sum = scalars->values_SUM.size();
+    if( isMaster() ) {
+        copy( diags_sum_.begin()+diags_sum_offset_, diags_sum_.begin()+diags_sum_offset_+n_sum, scalars->values_SUM.begin() );
     }
+    diags_sum_offset_ += n_sum;
     
     // Complete the computation of the scalars after all reductions
     if( isMaster() ) {
@@ -1673,7 +1880,7 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScalar *scalars, int timestep )
         }
         
     }
-} // END computeGlobalDiags(DiagnosticScalar& scalars ...)
+} // END completeGlobalDiags(DiagnosticScalar& scalars ...)
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1681,25 +1888,58 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScalar *scalars, int timestep )
 // ---------------------------------------------------------------------------------------------------------------------
 void SmileiMPI::computeGlobalDiags( DiagnosticParticleBinning *diagParticles, int timestep )
 {
-    if( timestep - diagParticles->timeSelection->previousTime() == diagParticles->time_average-1 ) {
-        MPI_Reduce( diagParticles->filename.size()?MPI_IN_PLACE:&diagParticles->data_sum[0], &diagParticles->data_sum[0], diagParticles->output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
-        
-        if( !isMaster() ) {
-            diagParticles->clear();
-        }
+    if( timestep - diagParticles->timeSelection->previousTime() != diagParticles->time_average-1 ) {
+        return;
+    }
+    
+    if( diagParticles->parallel_write ) {
+        // Each process gets the sum of its own slice of the histogram
+        diagParticles->data_slice.resize( diagParticles->slice_sizes[smilei_rk] );
+        diags_requests_.push_back( MPI_REQUEST_NULL );
+        MPI_Ireduce_scatter( &diagParticles->data_sum[0], diagParticles->data_slice.data(), &diagParticles->slice_sizes[0], MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &diags_requests_.back() );
+    } else {
+        diags_sum_.insert( diags_sum_.end(), diagParticles->data_sum.begin(), diagParticles->data_sum.end() );
     }
 } // END computeGlobalDiags(DiagnosticParticleBinning* diagParticles ...)
 
+void SmileiMPI::completeGlobalDiags( DiagnosticParticleBinning *diagParticles, int timestep )
+{
+    if( timestep - diagParticles->timeSelection->previousTime() != diagParticles->time_average-1 ) {
+        return;
+    }
+    
+    if( diagParticles->parallel_write ) {
+        diagParticles->data_sum.swap( diagParticles->data_slice );
+        vector<double>().swap( diagParticles->data_slice );
+        return;
+    }
+    
+    if( isMaster() ) {
+        copy( diags_sum_.begin()+diags_sum_offset_, diags_sum_.begin()+diags_sum_offset_+diagParticles->output_size, diagParticles->data_sum.begin() );
+    } else {
+        diagParticles->clear();
+    }
+    diags_sum_offset_ += diagParticles->output_size;
+} // END completeGlobalDiags(DiagnosticParticleBinning* diagParticles ...)
+
 // ---------------------------------------------------------------------------------------------------------------------
 // MPI synchronization of diags screen
 // ---------------------------------------------------------------------------------------------------------------------
 void SmileiMPI::computeGlobalDiags( DiagnosticScreen *diagScreen, int timestep )
 {
     if( diagScreen->timeSelection->theTimeIsNow( timestep ) ) {
-        MPI_Reduce( diagScreen->filename.size()?MPI_IN_PLACE:&diagScreen->data_sum[0], &diagScreen->data_sum[0], diagScreen->output_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
-        
-        if( !isMaster() ) {
+        diags_sum_.insert( diags_sum_.end(), diagScreen->data_sum.begin(), diagScreen->data_sum.end() );
+    }
+} // END computeGlobalDiags(DiagnosticScreen* diagScreen ...)
+
+void SmileiMPI::completeGlobalDiags( DiagnosticScreen *diagScreen, int timestep )
+{
+    if( diagScreen->timeSelection->theTimeIsNow( timestep ) ) {
+        if( isMaster() ) {
+            copy( diags_sum_.begin()+diags_sum_offset_, diags_sum_.begin()+diags_sum_offset_+diagScreen->output_size, diagScreen->data_sum.begin() );
+        } else {
             diagScreen->clear();
         }
+        diags_sum_offset_ += diagScreen->output_size;
     }
-} // END computeGlobalDiags(DiagnosticScreen* diagScreen ...)
+} // END completeGlobalDiags(DiagnosticScreen* diagScreen ...)
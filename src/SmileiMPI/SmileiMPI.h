@@ -103,14 +103,20 @@ public:
     // DIAGS MPI SYNC
     // --------------
     
-    // Wrapper of MPI synchronization of all computing diags
-    void computeGlobalDiags( Diagnostic                *diag, int timestep );
+    // Wrapper of MPI synchronization of all computing diags: starts the reductions of the diags due now,
+    // their sums being packed in a single non-blocking reduction
+    void computeGlobalDiags( std::vector<Diagnostic *> &diags, int timestep );
+    // Waits for the reductions started by computeGlobalDiags and completes the diags
+    void completeGlobalDiags( std::vector<Diagnostic *> &diags, int timestep );
     // MPI synchronization of scalars diags
     void computeGlobalDiags( DiagnosticScalar          *diag, int timestep );
+    void completeGlobalDiags( DiagnosticScalar          *diag, int timestep );
     // MPI synchronization of diags particles
     void computeGlobalDiags( DiagnosticParticleBinning *diag, int timestep );
+    void completeGlobalDiags( DiagnosticParticleBinning *diag, int timestep );
     // MPI synchronization of screen diags
     void computeGlobalDiags( DiagnosticScreen          *diag, int timestep );
+    void completeGlobalDiags( DiagnosticScreen          *diag, int timestep );
     
     // MPI basic methods
     // -----------------
@@ -148,6 +154,12 @@ public:
         return smilei_omp_max_threads;
     }
     
+    //! Return the thread support level provided by the MPI library
+    inline int getThreadSupport()
+    {
+        return mpi_provided;
+    }
+    
     
     // Global buffers for vectorization of Species::dynamics
     // -----------------------------------------------------
@@ -210,6 +222,27 @@ public:
     
     bool test_mode;
     
+    //! Halos between processes of the same node exchanged through a shared memory window (Main.shared_memory_halos)
+    //!   - the processes of the node are found with MPI_Comm_split_type
+    void initSharedHalos( Params &params );
+    void cleanSharedHalos();
+    //!   - true if the halos of the patches of process rank go through the shared window
+    inline bool sharedHalo( int rank )
+    {
+        return shared_halos_ && ( rank!=MPI_PROC_NULL ) && ( rank!=smilei_rk ) && ( node_rank_[rank]!=MPI_UNDEFINED );
+    }
+    //!   - (re)allocate the window for nComp field components, in slots of slot_size doubles, if needed (collective
+    //!     in the node)
+    void reserveSharedHalos( unsigned int slot_size, unsigned int nDim, unsigned int nComp );
+    //!   - slot where the patch hindex of this process writes the halo of component icomp sent to its neighbor
+    //!     (iDim,iNeighbor)
+    double *sharedHaloSend( unsigned int hindex, unsigned int icomp, int iDim, int iNeighbor );
+    //!   - slot written by the patch hindex of process rank for its neighbor (iDim,iNeighbor), at the last syncSharedHalos
+    double *sharedHaloRecv( int rank, unsigned int hindex, unsigned int icomp, int iDim, int iNeighbor );
+    //!   - make the halos written visible to the other processes of the node (collective in the node)
+    void syncSharedHalos();
+    bool shared_halos_ = false;
+    
 protected:
     //! Global MPI Communicator
     MPI_Comm SMILEI_COMM_WORLD;
@@ -220,6 +253,8 @@ protected:
     int smilei_rk;
     //! OMP max number of threads in one MPI
     int smilei_omp_max_threads;
+    //! Thread support level provided by the MPI library
+    int mpi_provided;
     
     // Store periodicity (0/1) per direction
     // Should move in Params : last parameters of this type in this class
@@ -229,6 +264,24 @@ protected:
     //Number of patches owned by each mpi process.
     std::vector<int>  patch_count, capabilities, patch_refHindexes;
     int Tcapabilities; //Default = smilei_sz (1 per MPI rank)
+    
+    //! Communicator of the processes of the node, and rank in it of each process (MPI_UNDEFINED if on another node)
+    MPI_Comm node_comm_ = MPI_COMM_NULL;
+    std::vector<int> node_rank_;
+    //! Shared window of the halos: 2 sets (alternately written) of nComp x nDim x 2 slots per patch
+    MPI_Win halo_win_ = MPI_WIN_NULL;
+    //! Address of the part of the window of each process of the node
+    std::vector<double *> halo_base_;
+    unsigned int halo_slot_size_ = 0, halo_capacity_ = 0, halo_ndim_ = 0, halo_ncomp_ = 0;
+    //! Number of syncSharedHalos so far (its parity selects the set of slots written)
+    unsigned int halo_sync_count_ = 0;
+    
+    //! Sums of the global diags, packed to be reduced together
+    std::vector<double> diags_sum_;
+    //! Position of the next diag data in diags_sum_
+    unsigned int diags_sum_offset_ = 0;
+    //! Pending non-blocking reductions of the global diags
+    std::vector<MPI_Request> diags_requests_;
 };
 
 
@@ -53,7 +53,6 @@ SmileiMPI_test::SmileiMPI_test( int *argc, char ***argv )
     }
     // Return a test-mode SmileiMPI
     
-    int mpi_provided;
 #ifdef _OPENMP
     MPI_Init_thread( argc, argv, MPI_THREAD_MULTIPLE, &mpi_provided );
 #ifndef _NO_MPI_TM
@@ -64,6 +63,7 @@ SmileiMPI_test::SmileiMPI_test( int *argc, char ***argv )
     omp_set_num_threads( 1 );
 #else
     MPI_Init( argc, argv );
+    MPI_Query_thread( &mpi_provided );
 #endif
     
     SMILEI_COMM_WORLD = MPI_COMM_WORLD;
@@ -12,18 +12,19 @@
 
 #include "Particles.h"
 #include "Params.h"
+#include "Random.h"
 #include "tabulatedFunctions.h"
 #include "userFunctions.h"
 
 //!
-//! int function( Particles &particles, int ipart, int direction, double limit_pos )
+//! int function( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand )
 //!     returns :
 //!         0 if particle ipart have to be deleted from current process (MPI or BC)
 //!         1 otherwise
 //!
 
 inline int reflect_particle( Particles &particles, int ipart, int direction, double limit_pos, Species *species,
-                             double &nrj_iPart )
+                             double &nrj_iPart, Random *rand )
 {
     nrj_iPart = 0.;     // no energy loss during reflection
     particles.position( direction, ipart ) = limit_pos - particles.position( direction, ipart );
@@ -33,7 +34,7 @@ inline int reflect_particle( Particles &particles, int ipart, int direction, dou
 
 // direction not used below, direction is "r"
 inline int refl_particle_AM( Particles &particles, int ipart, int direction, double limit_pos, Species *species,
-                             double &nrj_iPart )
+                             double &nrj_iPart, Random *rand )
 {
     nrj_iPart = 0.;     // no energy loss during reflection
     
@@ -69,7 +70,7 @@ inline int refl_particle_AM( Particles &particles, int ipart, int direction, dou
 }
 
 inline int remove_particle( Particles &particles, int ipart, int direction, double limit_pos, Species *species,
-                            double &nrj_iPart )
+                            double &nrj_iPart, Random *rand )
 {
     nrj_iPart = particles.weight( ipart )*( particles.lor_fac( ipart )-1.0 ); // energy lost
     particles.charge( ipart ) = 0;
@@ -78,7 +79,7 @@ inline int remove_particle( Particles &particles, int ipart, int direction, doub
 
 //! Delete photon (mass==0) at the boundary and keep the energy for diagnostics
 inline int remove_photon( Particles &particles, int ipart, int direction, double limit_pos, Species *species,
-                          double &nrj_iPart )
+                          double &nrj_iPart, Random *rand )
 {
     nrj_iPart = particles.weight( ipart )*( particles.momentum_norm( ipart ) ); // energy lost
     particles.charge( ipart ) = 0;
@@ -86,7 +87,7 @@ inline int remove_photon( Particles &particles, int ipart, int direction, double
 }
 
 inline int stop_particle( Particles &particles, int ipart, int direction, double limit_pos, Species *species,
-                          double &nrj_iPart )
+                          double &nrj_iPart, Random *rand )
 {
     nrj_iPart = particles.weight( ipart )*( particles.lor_fac( ipart )-1.0 ); // energy lost
     particles.position( direction, ipart ) = limit_pos - particles.position( direction, ipart );
@@ -97,7 +98,7 @@ inline int stop_particle( Particles &particles, int ipart, int direction, double
 }
 
 inline int stop_particle_AM( Particles &particles, int ipart, int direction, double limit_pos, Species *species,
-                             double &nrj_iPart )
+                             double &nrj_iPart, Random *rand )
 {
     nrj_iPart = particles.weight( ipart )*( particles.lor_fac( ipart )-1.0 ); // energy lost
     double distance_to_axis = sqrt( particles.distance2_to_axis( ipart ) );
@@ -121,7 +122,7 @@ inline int stop_particle_AM( Particles &particles, int ipart, int direction, dou
 //!\todo (MG) at the moment the particle is thermalize whether or not there is a plasma initially at the boundary.
 // ATTENTION: here the thermalization assumes a Maxwellian distribution, maybe we should add some checks on thermal_boundary_temperature (MG)!
 inline int thermalize_particle( Particles &particles, int ipart, int direction, double limit_pos,
-                                Species *species, double &nrj_iPart )
+                                Species *species, double &nrj_iPart, Random *rand )
 {
 
     // checking the particle's velocity compared to the thermal one
@@ -146,14 +147,14 @@ inline int thermalize_particle( Particles &particles, int ipart, int direction,
                 // change of velocity in the direction normal to the reflection plane
                 double sign_vel = -particles.momentum( i, ipart )/std::abs( particles.momentum( i, ipart ) );
                 particles.momentum( i, ipart ) = sign_vel * species->thermalMomentum[i]
-                                                 *                             std::sqrt( -std::log( 1.0-Rand::uniform1() ) );
+                                                 *                             std::sqrt( -std::log( 1.0-rand->uniform1() ) );
                                                  
             } else {
                 // change of momentum in the direction(s) along the reflection plane
-                double sign_rnd = Rand::uniform() - 0.5;
+                double sign_rnd = rand->uniform() - 0.5;
                 sign_rnd = ( sign_rnd )/std::abs( sign_rnd );
                 particles.momentum( i, ipart ) = sign_rnd * species->thermalMomentum[i]
-                                                 *                             userFunctions::erfinv( Rand::uniform1() );
+                                                 *                             userFunctions::erfinv( rand->uniform1() );
             }//if
             
         }//i
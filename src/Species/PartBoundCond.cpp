@@ -89,7 +89,7 @@ PartBoundCond::PartBoundCond( Params &params, Species *species, Patch *patch ) :
     // Define the kind of applied boundary conditions
     // ----------------------------------------------
     
-    int ( *remove )( Particles &, int, int, double, Species *, double & );
+    int ( *remove )( Particles &, int, int, double, Species *, double &, Random * );
     if( species->mass == 0 ) {
         remove = &remove_photon;
     } else {
@@ -21,17 +21,17 @@ public:
     
     //! Xmin particles boundary conditions pointers (same prototypes for all conditions)
     //! @see BoundaryConditionType.h for functions that this pointers will target
-    int ( *bc_xmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_xmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand );
     //! Xmax particles boundary conditions pointers
-    int ( *bc_xmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_xmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand );
     //! Ymin particles boundary conditions pointers
-    int ( *bc_ymin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_ymin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand );
     //! Ymax particles boundary conditions pointers
-    int ( *bc_ymax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_ymax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand );
     //! Zmin particles boundary conditions pointers
-    int ( *bc_zmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_zmin )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand );
     //! Zmax particles boundary conditions pointers
-    int ( *bc_zmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart );
+    int ( *bc_zmax )( Particles &particles, int ipart, int direction, double limit_pos, Species *species, double &nrj_iPart, Random *rand );
     
     //! Method which applies particles boundary conditions.
     //! If the MPI process is not a border process, particles will be flagged as an exchange particle returning 0
@@ -39,7 +39,7 @@ public:
     //! The decision whether the particle is added or not on the Exchange Particle List is defined by the final
     //! value of keep_part.
     //! Be careful, once an a BC along a given dimension set keep_part to 0, it will remain to 0.
-    inline int apply( Particles &particles, int ipart, Species *species, double &nrj_iPart )  //, bool &contribute ) {
+    inline int apply( Particles &particles, int ipart, Species *species, double &nrj_iPart, Random *rand )  //, bool &contribute ) {
     {
     
         /*if ((particles.position(0, ipart) > x_max)
@@ -61,13 +61,13 @@ public:
             if( bc_xmin==NULL ) {
                 keep_part = 0;
             } else {
-                keep_part = ( *bc_xmin )( particles, ipart, 0, 2.*x_min, species, nrj_iPart );
+                keep_part = ( *bc_xmin )( particles, ipart, 0, 2.*x_min, species, nrj_iPart, rand );
             }
         } else if( particles.position( 0, ipart ) >= x_max ) {
             if( bc_xmax==NULL ) {
                 keep_part = 0;
             } else {
-                keep_part = ( *bc_xmax )( particles, ipart, 0, 2.*x_max, species, nrj_iPart );
+                keep_part = ( *bc_xmax )( particles, ipart, 0, 2.*x_max, species, nrj_iPart, rand );
             }
         }
         
@@ -79,13 +79,13 @@ public:
                     if( bc_ymin==NULL ) {
                         keep_part = 0;
                     } else {
-                        keep_part *= ( *bc_ymin )( particles, ipart, 1, 2.*y_min, species, nrj_iPart );
+                        keep_part *= ( *bc_ymin )( particles, ipart, 1, 2.*y_min, species, nrj_iPart, rand );
                     }
                 } else if( particles.position( 1, ipart ) >= y_max ) {
                     if( bc_ymax==NULL ) {
                         keep_part = 0;
                     } else {
-                        keep_part *= ( *bc_ymax )( particles, ipart, 1, 2.*y_max, species, nrj_iPart );
+                        keep_part *= ( *bc_ymax )( particles, ipart, 1, 2.*y_max, species, nrj_iPart, rand );
                     }
                 }
                 // iDim = 2
@@ -95,13 +95,13 @@ public:
                         if( bc_zmin==NULL ) {
                             keep_part = 0;
                         } else {
-                            keep_part *= ( *bc_zmin )( particles, ipart, 2, 2.*z_min, species, nrj_iPart );
+                            keep_part *= ( *bc_zmin )( particles, ipart, 2, 2.*z_min, species, nrj_iPart, rand );
                         }
                     } else if( particles.position( 2, ipart ) >= z_max ) {
                         if( bc_zmax==NULL ) {
                             keep_part = 0;
                         } else {
-                            keep_part *= ( *bc_zmax )( particles, ipart, 2, 2.*z_max, species, nrj_iPart );
+                            keep_part *= ( *bc_zmax )( particles, ipart, 2, 2.*z_max, species, nrj_iPart, rand );
                         }
                     }
                 } // end if (nDim_particle == 3)
@@ -113,7 +113,7 @@ public:
                 if( bc_ymax==NULL ) {
                     keep_part = 0;
                 } else {
-                    keep_part *= ( *bc_ymax )( particles, ipart, -1, 2.*y_max, species, nrj_iPart );
+                    keep_part *= ( *bc_ymax )( particles, ipart, -1, 2.*y_max, species, nrj_iPart, rand );
                 }
             }
             if( particles.distance2_to_axis( ipart ) < y_min2 ) {
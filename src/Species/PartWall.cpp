@@ -33,13 +33,13 @@ PartWall::PartWall( double pos, unsigned short dir, string kind ) :
 }
 
 // Applies the wall's boundary condition to one particle
-int PartWall::apply( Particles &particles, int ipart, Species *species, double dtgf, double &nrj_iPart )
+int PartWall::apply( Particles &particles, int ipart, Species *species, double dtgf, double &nrj_iPart, Random *rand )
 {
     // The particle previous position needs to be computed
     double particle_position     = particles.position( direction, ipart );
     double particle_position_old = particle_position - dtgf*particles.momentum( direction, ipart );
     if( ( position-particle_position_old )*( position-particle_position )<0. ) {
-        return ( *wall )( particles, ipart, direction, 2.*position, species, nrj_iPart );
+        return ( *wall )( particles, ipart, direction, 2.*position, species, nrj_iPart, rand );
     } else {
         return 1;
     }
@@ -20,8 +20,6 @@ public:
 private:
     //! array containing the particle position
     std::vector<double> Position;
-    //! array containing the particle former (old) positions
-    std::vector<double> Position_old;
     //! array containing the particle moments
     std::vector<double>  Momentum;
     //! containing the particle weight: equivalent to a charge density
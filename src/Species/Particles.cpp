@@ -20,13 +20,13 @@ Particles::Particles():
     tracked( false )
 {
     Position.resize( 0 );
-    Position_old.resize( 0 );
     Momentum.resize( 0 );
     is_test = false;
     isQuantumParameter = false;
     isMonteCarlo = false;
     
     double_prop.resize( 0 );
+    float_prop.resize( 0 );
     short_prop.resize( 0 );
     uint64_prop.resize( 0 );
 }
@@ -57,18 +57,15 @@ void Particles::initialize( unsigned int nParticles, unsigned int nDim )
         }
         
         for( unsigned int i=0 ; i< 3 ; i++ ) {
+#ifdef __SINGLE_PRECISION_MOMENTUM
+            float_prop.push_back( &( Momentum[i] ) );
+#else
             double_prop.push_back( &( Momentum[i] ) );
+#endif
         }
         
         double_prop.push_back( &Weight );
         
-#ifdef  __DEBUG
-        Position_old.resize( nDim );
-        for( unsigned int i=0 ; i< nDim ; i++ ) {
-            double_prop.push_back( &( Position_old[i] ) );
-        }
-#endif
-        
         short_prop.push_back( &Charge );
         if( tracked ) {
             uint64_prop.push_back( &Id );
@@ -118,10 +115,8 @@ void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
     return;
     
     Position.resize( nDim );
-    Position_old.resize( nDim );
     for( unsigned int i=0 ; i< nDim ; i++ ) {
         Position[i].reserve( n_part_max );
-        Position_old[i].reserve( n_part_max );
     }
     Momentum.resize( 3 );
     for( unsigned int i=0 ; i< 3 ; i++ ) {
@@ -150,12 +145,6 @@ void Particles::resize( unsigned int nParticles, unsigned int nDim )
     for( unsigned int i=0 ; i<nDim ; i++ ) {
         Position[i].resize( nParticles, 0. );
     }
-#ifdef  __DEBUG
-    Position_old.resize( nDim );
-    for( unsigned int i=0 ; i<nDim ; i++ ) {
-        Position_old[i].resize( nParticles, 0. );
-    }
-#endif
     
     Momentum.resize( 3 );
     for( unsigned int i=0 ; i< 3 ; i++ ) {
@@ -186,6 +175,10 @@ void Particles::shrink_to_fit( unsigned int nDim )
         std::vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        std::vector<float>( *float_prop[iprop] ).swap( *float_prop[iprop] );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         std::vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
     }
@@ -205,6 +198,10 @@ void Particles::clear()
         double_prop[iprop]->clear();
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        float_prop[iprop]->clear();
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         short_prop[iprop]->clear();
     }
@@ -215,12 +212,48 @@ void Particles::clear()
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Exchange of Particles vectors (used to keep the memory of the particles of recycled patches)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::swap_buffers( Particles &part )
+{
+    if( double_prop.size() != part.double_prop.size()
+            || float_prop.size() != part.float_prop.size()
+            || short_prop.size() != part.short_prop.size()
+            || uint64_prop.size() != part.uint64_prop.size() ) {
+        ERROR( "Cannot swap the buffers of particles with different properties" );
+    }
+    
+    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        double_prop[iprop]->swap( *part.double_prop[iprop] );
+    }
+    
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        float_prop[iprop]->swap( *part.float_prop[iprop] );
+    }
+    
+    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        short_prop[iprop]->swap( *part.short_prop[iprop] );
+    }
+    
+    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        uint64_prop[iprop]->swap( *part.uint64_prop[iprop] );
+    }
+    
+    cell_keys.swap( part.cell_keys );
+}
+
+
 void Particles::cp_particle( unsigned int ipart )
 {
     for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
         double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        float_prop[iprop]->push_back( ( *float_prop[iprop] )[ipart] );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
     }
@@ -240,6 +273,10 @@ void Particles::cp_particle( unsigned int ipart, Particles &dest_parts )
         dest_parts.double_prop[iprop]->push_back( ( *double_prop[iprop] )[ipart] );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        dest_parts.float_prop[iprop]->push_back( ( *float_prop[iprop] )[ipart] );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         dest_parts.short_prop[iprop]->push_back( ( *short_prop[iprop] )[ipart] );
     }
@@ -258,6 +295,10 @@ void Particles::cp_particle( unsigned int ipart, Particles &dest_parts, int dest
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, ( *double_prop[iprop] )[ipart] );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        dest_parts.float_prop[iprop]->insert( dest_parts.float_prop[iprop]->begin() + dest_id, ( *float_prop[iprop] )[ipart] );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, ( *short_prop[iprop] )[ipart] );
     }
@@ -277,6 +318,10 @@ void Particles::cp_particles( unsigned int iPart, unsigned int nPart, Particles
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, double_prop[iprop]->begin()+iPart, double_prop[iprop]->begin()+iPart+nPart );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        dest_parts.float_prop[iprop]->insert( dest_parts.float_prop[iprop]->begin() + dest_id, float_prop[iprop]->begin()+iPart, float_prop[iprop]->begin()+iPart+nPart );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, short_prop[iprop]->begin()+iPart, short_prop[iprop]->begin()+iPart+nPart );
     }
@@ -287,6 +332,48 @@ void Particles::cp_particles( unsigned int iPart, unsigned int nPart, Particles
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert particles src_ids in dest_parts at the final slots dest_ids (ascending)
+// All property arrays are grown once, instead of one insertion (and one shift) per particle
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::cp_particles( vector<unsigned int> &src_ids, Particles &dest_parts, vector<unsigned int> &dest_ids )
+{
+    unsigned int nPart = src_ids.size();
+    
+    vector<double> double_buffer( nPart );
+    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        for( unsigned int k=0 ; k<nPart ; k++ ) {
+            double_buffer[k] = ( *double_prop[iprop] )[src_ids[k]];
+        }
+        insert_at_slots( *dest_parts.double_prop[iprop], dest_ids, double_buffer );
+    }
+    
+    vector<float> float_buffer( nPart );
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        for( unsigned int k=0 ; k<nPart ; k++ ) {
+            float_buffer[k] = ( *float_prop[iprop] )[src_ids[k]];
+        }
+        insert_at_slots( *dest_parts.float_prop[iprop], dest_ids, float_buffer );
+    }
+    
+    vector<short> short_buffer( nPart );
+    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        for( unsigned int k=0 ; k<nPart ; k++ ) {
+            short_buffer[k] = ( *short_prop[iprop] )[src_ids[k]];
+        }
+        insert_at_slots( *dest_parts.short_prop[iprop], dest_ids, short_buffer );
+    }
+    
+    vector<uint64_t> uint64_buffer( nPart );
+    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        for( unsigned int k=0 ; k<nPart ; k++ ) {
+            uint64_buffer[k] = ( *uint64_prop[iprop] )[src_ids[k]];
+        }
+        insert_at_slots( *dest_parts.uint64_prop[iprop], dest_ids, uint64_buffer );
+    }
+    
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Suppress particle iPart
 // ---------------------------------------------------------------------------------------------------------------------
@@ -296,6 +383,10 @@ void Particles::erase_particle( unsigned int ipart )
         ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *float_prop[iprop] ).erase( ( *float_prop[iprop] ).begin()+ipart );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart );
     }
@@ -315,6 +406,10 @@ void Particles::erase_particle_trail( unsigned int ipart )
         ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart, ( *double_prop[iprop] ).end() );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *float_prop[iprop] ).erase( ( *float_prop[iprop] ).begin()+ipart, ( *float_prop[iprop] ).end() );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart, ( *short_prop[iprop] ).end() );
     }
@@ -333,6 +428,10 @@ void Particles::erase_particle( unsigned int ipart, unsigned int npart )
         ( *double_prop[iprop] ).erase( ( *double_prop[iprop] ).begin()+ipart, ( *double_prop[iprop] ).begin()+ipart+npart );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *float_prop[iprop] ).erase( ( *float_prop[iprop] ).begin()+ipart, ( *float_prop[iprop] ).begin()+ipart+npart );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *short_prop[iprop] ).erase( ( *short_prop[iprop] ).begin()+ipart, ( *short_prop[iprop] ).begin()+ipart+npart );
     }
@@ -350,7 +449,6 @@ void Particles::print( unsigned int iPart )
 {
     for( unsigned int i=0; i<Position.size(); i++ ) {
         cout << Position[i][iPart] << " ";
-        //cout << Position_old[i][iPart] << " ";
     }
     for( unsigned int i=0; i<3; i++ ) {
         cout << Momentum[i][iPart] << " ";
@@ -381,7 +479,6 @@ ostream &operator << ( ostream &out, const Particles &particles )
     
         for( unsigned int i=0; i<particles.Position.size(); i++ ) {
             out << particles.Position[i][iPart] << " ";
-            //out << particles.Position_old[i][iPart] << " ";
         }
         for( unsigned int i=0; i<3; i++ ) {
             out << particles.Momentum[i][iPart] << " ";
@@ -415,6 +512,10 @@ void Particles::swap_part( unsigned int part1, unsigned int part2 )
         std::swap( ( *double_prop[iprop] )[part1], ( *double_prop[iprop] )[part2] );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        std::swap( ( *float_prop[iprop] )[part1], ( *float_prop[iprop] )[part2] );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         std::swap( ( *short_prop[iprop] )[part1], ( *short_prop[iprop] )[part2] );
     }
@@ -436,6 +537,14 @@ void Particles::swap_part3( unsigned int part1, unsigned int part2, unsigned int
         ( *double_prop[iprop] )[part2] = temp;
     }
     
+    float ftemp;
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ftemp = ( *float_prop[iprop] )[part1];
+        ( *float_prop[iprop] )[part1] = ( *float_prop[iprop] )[part3];
+        ( *float_prop[iprop] )[part3] = ( *float_prop[iprop] )[part2];
+        ( *float_prop[iprop] )[part2] = ftemp;
+    }
+    
     short stemp;
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         stemp = ( *short_prop[iprop] )[part1];
@@ -467,6 +576,15 @@ void Particles::swap_part4( unsigned int part1, unsigned int part2, unsigned int
         ( *double_prop[iprop] )[part2] = temp;
     }
     
+    float ftemp;
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ftemp = ( *float_prop[iprop] )[part1];
+        ( *float_prop[iprop] )[part1] = ( *float_prop[iprop] )[part4];
+        ( *float_prop[iprop] )[part4] = ( *float_prop[iprop] )[part3];
+        ( *float_prop[iprop] )[part3] = ( *float_prop[iprop] )[part2];
+        ( *float_prop[iprop] )[part2] = ftemp;
+    }
+    
     short stemp;
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         stemp = ( *short_prop[iprop] )[part1];
@@ -520,6 +638,10 @@ void Particles::overwrite_part( unsigned int part1, unsigned int part2 )
         ( *double_prop[iprop] )[part2] = ( *double_prop[iprop] )[part1];
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *float_prop[iprop] )[part2] = ( *float_prop[iprop] )[part1];
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *short_prop[iprop] )[part2] = ( *short_prop[iprop] )[part1];
     }
@@ -536,6 +658,7 @@ void Particles::overwrite_part( unsigned int part1, unsigned int part2 )
 void Particles::overwrite_part( unsigned int part1, unsigned int part2, unsigned int N )
 {
     unsigned int sizepart = N*sizeof( Position[0][0] );
+    unsigned int sizefloat = N*sizeof( float );
     unsigned int sizecharge = N*sizeof( Charge[0] );
     unsigned int sizeid = N*sizeof( Id[0] );
     
@@ -543,6 +666,10 @@ void Particles::overwrite_part( unsigned int part1, unsigned int part2, unsigned
         memcpy( & ( *double_prop[iprop] )[part2],  &( *double_prop[iprop] )[part1], sizepart );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        memcpy( & ( *float_prop[iprop] )[part2],  &( *float_prop[iprop] )[part1], sizefloat );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         memcpy( & ( *short_prop[iprop] )[part2],  &( *short_prop[iprop] )[part1], sizecharge );
     }
@@ -561,6 +688,10 @@ void Particles::overwrite_part( unsigned int part1, Particles &dest_parts, unsig
         ( *dest_parts.double_prop[iprop] )[part2] = ( *double_prop[iprop] )[part1];
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *dest_parts.float_prop[iprop] )[part2] = ( *float_prop[iprop] )[part1];
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *dest_parts.short_prop[iprop] )[part2] = ( *short_prop[iprop] )[part1];
     }
@@ -576,6 +707,7 @@ void Particles::overwrite_part( unsigned int part1, Particles &dest_parts, unsig
 void Particles::overwrite_part( unsigned int part1, Particles &dest_parts, unsigned int part2, unsigned int N )
 {
     unsigned int sizepart = N*sizeof( Position[0][0] );
+    unsigned int sizefloat = N*sizeof( float );
     unsigned int sizecharge = N*sizeof( Charge[0] );
     unsigned int sizeid = N*sizeof( Id[0] );
     
@@ -583,6 +715,10 @@ void Particles::overwrite_part( unsigned int part1, Particles &dest_parts, unsig
         memcpy( & ( *dest_parts.double_prop[iprop] )[part2],  &( *double_prop[iprop] )[part1], sizepart );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        memcpy( & ( *dest_parts.float_prop[iprop] )[part2],  &( *float_prop[iprop] )[part1], sizefloat );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         memcpy( & ( *dest_parts.short_prop[iprop] )[part2],  &( *short_prop[iprop] )[part1], sizecharge );
     }
@@ -602,6 +738,7 @@ void Particles::swap_part( unsigned int part1, unsigned int part2, unsigned int
     double *buffer[N];
     
     unsigned int sizepart = N*sizeof( Position[0][0] );
+    unsigned int sizefloat = N*sizeof( float );
     unsigned int sizecharge = N*sizeof( Charge[0] );
     unsigned int sizeid = N*sizeof( Id[0] );
     
@@ -611,6 +748,12 @@ void Particles::swap_part( unsigned int part1, unsigned int part2, unsigned int
         memcpy( &( ( *double_prop[iprop] )[part2] ), buffer, sizepart );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        memcpy( buffer, &( ( *float_prop[iprop] )[part1] ), sizefloat );
+        memcpy( &( ( *float_prop[iprop] )[part1] ), &( ( *float_prop[iprop] )[part2] ), sizefloat );
+        memcpy( &( ( *float_prop[iprop] )[part2] ), buffer, sizefloat );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         memcpy( buffer, &( ( *short_prop[iprop] )[part1] ), sizecharge );
         memcpy( &( ( *short_prop[iprop] )[part1] ), &( ( *short_prop[iprop] )[part2] ), sizecharge );
@@ -642,6 +785,10 @@ void Particles::create_particle()
         ( *double_prop[iprop] ).push_back( 0. );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *float_prop[iprop] ).push_back( 0. );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *short_prop[iprop] ).push_back( 0 );
     }
@@ -662,6 +809,10 @@ void Particles::create_particles( int nAdditionalParticles )
         ( *double_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0. );
     }
     
+    for( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ( *float_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0. );
+    }
+    
     for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         ( *short_prop[iprop] ).resize( nParticles+nAdditionalParticles, 0 );
     }
@@ -681,7 +832,6 @@ void Particles::create_particles( int nAdditionalParticles )
 //    int nParticles = size();
 //    for (unsigned int i=0; i<Position.size(); i++) {
 //        Position[i].resize(nParticles+nAdditionalParticles,0.);
-//        Position_old[i].resize(nParticles+nAdditionalParticles,0.);
 //    }
 //
 //    for (unsigned int i=0; i<3; i++) {
@@ -744,7 +894,7 @@ bool Particles::test_move( int iPartStart, int iPartEnd, Params &params )
     for( int iDim = 0 ; iDim < Position.size() ; iDim++ ) {
         double dx2 = params.cell_length[iDim];//*params.cell_length[iDim];
         for( int iPart = iPartStart ; iPart < iPartEnd ; iPart++ ) {
-            if( dist( iPart, iDim ) > dx2 ) {
+            if( dist( iPart, iDim, params.timestep ) > dx2 ) {
                 ERROR( "Too large displacment for particle : " << iPart << "\t: " << ( *this )( iPart ) );
                 return false;
             }
@@ -15,6 +15,13 @@ class Particle;
 class Params;
 class Patch;
 
+//! Type of the stored momenta: single precision when compiled with config=single_momentum (the pushers, interpolators
+//! and projectors still compute in double precision, only the storage is reduced)
+#ifdef __SINGLE_PRECISION_MOMENTUM
+typedef float momentum_t;
+#else
+typedef double momentum_t;
+#endif
 
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -48,6 +55,9 @@ public:
     //! Reset Particles vectors
     void clear();
     
+    //! Exchange the arrays of two Particles with the same properties (their capacity included)
+    void swap_buffers( Particles &part );
+    
     //! Get number of particules
     inline unsigned int size() const
     {
@@ -76,6 +86,29 @@ public:
     void cp_particles( unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id );
     //! Insert particle iPart at dest_id in dest_parts
     void cp_particle( unsigned int ipart, Particles &dest_parts, int dest_id );
+    //! Insert particles src_ids[k] in dest_parts so that they end up at dest_ids[k] (ascending) in the resulting arrays
+    void cp_particles( std::vector<unsigned int> &src_ids, Particles &dest_parts, std::vector<unsigned int> &dest_ids );
+    
+    //! Grow v once and merge values[k] at the final slot dest_ids[k] (ascending), shifting the existing elements
+    template<typename T>
+    static void insert_at_slots( std::vector<T> &v, std::vector<unsigned int> &dest_ids, std::vector<T> &values )
+    {
+        int nnew = dest_ids.size();
+        if( nnew == 0 ) {
+            return;
+        }
+        int iold = v.size();
+        v.resize( iold + nnew );
+        // Fill from the end: each slot receives either a new value or the last unmoved old element
+        int k = nnew-1;
+        for( int islot = v.size()-1 ; k >= 0 ; islot-- ) {
+            if( islot == ( int )dest_ids[k] ) {
+                v[islot] = values[k--];
+            } else {
+                v[islot] = v[--iold];
+            }
+        }
+    }
     
     //! Suppress particle iPart
     void erase_particle( unsigned int iPart );
@@ -142,17 +175,6 @@ public:
         return Position[1][ipart] * Position[1][ipart] + Position[2][ipart] * Position[2][ipart];
     }
     
-    //! Method used to get the Particle position
-    inline double  position_old( unsigned int idim, unsigned int ipart ) const
-    {
-        return Position_old[idim][ipart];
-    }
-    //! Method used to set a new value to the Particle former position
-    inline double &position_old( unsigned int idim, unsigned int ipart )
-    {
-        return Position_old[idim][ipart];
-    }
-    
     //! Method used to get the list of Particle position
     inline std::vector<double>  position( unsigned int idim ) const
     {
@@ -160,17 +182,17 @@ public:
     }
     
     //! Method used to get the Particle momentum
-    inline double  momentum( unsigned int idim, unsigned int ipart ) const
+    inline momentum_t  momentum( unsigned int idim, unsigned int ipart ) const
     {
         return Momentum[idim][ipart];
     }
     //! Method used to set a new value to the Particle momentum
-    inline double &momentum( unsigned int idim, unsigned int ipart )
+    inline momentum_t &momentum( unsigned int idim, unsigned int ipart )
     {
         return Momentum[idim][ipart];
     }
     //! Method used to get the Particle momentum
-    inline std::vector<double>  momentum( unsigned int idim ) const
+    inline std::vector<momentum_t>  momentum( unsigned int idim ) const
     {
         return Momentum[idim];
     }
@@ -226,16 +248,13 @@ public:
         return sqrt( pow( momentum( 0, ipart ), 2 )+pow( momentum( 1, ipart ), 2 )+pow( momentum( 2, ipart ), 2 ) );
     }
     
-    //! Partiles properties, respect type order : all double, all short, all unsigned int
+    //! Partiles properties, respect type order : all double, all float, all short, all unsigned int
     
     //! array containing the particle position
     std::vector< std::vector<double> > Position;
     
-    //! array containing the particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
-    
     //! array containing the particle moments
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< std::vector<momentum_t> >  Momentum;
     
     //! containing the particle weight: equivalent to a charge density
     std::vector<double> Weight;
@@ -334,6 +353,7 @@ public:
     
     
     std::vector< std::vector<double  >*> double_prop;
+    std::vector< std::vector<float   >*> float_prop;
     std::vector< std::vector<short   >*> short_prop;
     std::vector< std::vector<uint64_t>*> uint64_prop;
     
@@ -341,25 +361,16 @@ public:
 #ifdef __DEBUG
     bool test_move( int iPartStart, int iPartEnd, Params &params );
     
-    inline double dist2( unsigned int iPart )
+    //! Displacement along iDim during the last timestep dt, recomputed from the momentum (former positions are not stored)
+    inline double dist( unsigned int iPart, unsigned int iDim, double dt )
     {
-        double dist( 0. );
-        for( unsigned int iDim = 0 ; iDim < Position.size() ; iDim++ ) {
-            double delta = position( iDim, iPart )-position_old( iDim, iPart );
-            dist += delta*delta;
-        }
-        return dist;
-    }
-    inline double dist( unsigned int iPart, unsigned int iDim )
-    {
-        double delta = std::abs( position( iDim, iPart )-position_old( iDim, iPart ) );
-        return delta;
+        return dt * std::abs( momentum( iDim, iPart ) ) * inv_lor_fac( iPart );
     }
 #endif
     
     Particle operator()( unsigned int iPart );
     
-    //! Methods to obtain any property, given its index in the arrays double_prop, uint64_prop, or short_prop
+    //! Methods to obtain any property, given its index in the arrays double_prop, float_prop, uint64_prop, or short_prop
     void getProperty( unsigned int iprop, std::vector<uint64_t> *&prop )
     {
         prop = uint64_prop[iprop];
@@ -372,6 +383,10 @@ public:
     {
         prop = double_prop[iprop];
     }
+    void getProperty( unsigned int iprop, std::vector<float> *&prop )
+    {
+        prop = float_prop[iprop];
+    }
     
 private:
 
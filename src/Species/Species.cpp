@@ -220,8 +220,13 @@ void Species::initOperators( Params &params, Patch *patch )
             MPIbuff.part_index_send_sz[iDim][iNeighbor] = 0;
         }
     }
-    typePartSend.resize( nDim_particle*2, MPI_DATATYPE_NULL );
-    typePartRecv.resize( nDim_particle*2, MPI_DATATYPE_NULL );
+    for( unsigned int k=0 ; k<MPIbuff.neighbor_partRecv.size() ; k++ ) {
+        MPIbuff.neighbor_partRecv[k].initialize( 0, ( *particles ) );
+        MPIbuff.neighbor_partSend[k].initialize( 0, ( *particles ) );
+    }
+    // Per direction and neighbor, or per neighbor for the single-phase exchange
+    typePartSend.resize( max( nDim_particle*2, ( unsigned int )MPIbuff.neighbor_partRecv.size() ), MPI_DATATYPE_NULL );
+    typePartRecv.resize( max( nDim_particle*2, ( unsigned int )MPIbuff.neighbor_partRecv.size() ), MPI_DATATYPE_NULL );
     exchangePatch = MPI_DATATYPE_NULL;
     
 }
@@ -325,7 +330,7 @@ void Species::initCharge( unsigned int nPart, unsigned int iPart, double q )
 //   - either using regular distribution in the mesh (position_initialization = regular)
 //   - or using uniform random distribution (position_initialization = random)
 // ---------------------------------------------------------------------------------------------------------------------
-void Species::initPosition( unsigned int nPart, unsigned int iPart, double *indexes, Params &params )
+void Species::initPosition( unsigned int nPart, unsigned int iPart, double *indexes, Params &params, Random *rand )
 {
     double particles_r, particles_theta;
     if( position_initialization == "regular" ) {
@@ -364,9 +369,9 @@ void Species::initPosition( unsigned int nPart, unsigned int iPart, double *inde
     } else if( position_initialization == "random" ) {
         if( params.geometry=="AMcylindrical" ) {
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
-                particles->position( 0, p )=indexes[0]+Rand::uniform()*cell_length[0];
-                particles_r=sqrt( indexes[1]*indexes[1]+ 2.*Rand::uniform()*( indexes[1]+cell_length[1]*0.5 )*cell_length[1] );
-                particles_theta=Rand::uniform()*2.*M_PI;
+                particles->position( 0, p )=indexes[0]+rand->uniform()*cell_length[0];
+                particles_r=sqrt( indexes[1]*indexes[1]+ 2.*rand->uniform()*( indexes[1]+cell_length[1]*0.5 )*cell_length[1] );
+                particles_theta=rand->uniform()*2.*M_PI;
                 particles->position( 2, p )=particles_r*sin( particles_theta );
                 //if (particles_theta >= M_PI/2. || particles_theta <= 3./2.*M_PI)
                 particles->position( 1, p )= particles_r*cos( particles_theta );
@@ -378,7 +383,7 @@ void Species::initPosition( unsigned int nPart, unsigned int iPart, double *inde
         } else {
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
                 for( unsigned int i=0; i<nDim_particle ; i++ ) {
-                    particles->position( i, p )=indexes[i]+Rand::uniform()*cell_length[i];
+                    particles->position( i, p )=indexes[i]+rand->uniform()*cell_length[i];
                 }
             }
         }
@@ -403,7 +408,7 @@ void Species::initPosition( unsigned int nPart, unsigned int iPart, double *inde
 //   - at zero (init_momentum_type = cold)
 //   - using random distribution (init_momentum_type = maxwell-juettner)
 // ---------------------------------------------------------------------------------------------------------------------
-void Species::initMomentum( unsigned int nPart, unsigned int iPart, double *temp, double *vel )
+void Species::initMomentum( unsigned int nPart, unsigned int iPart, double *temp, double *vel, Random *rand )
 {
 
     // -------------------------------------------------------------------------
@@ -424,12 +429,12 @@ void Species::initMomentum( unsigned int nPart, unsigned int iPart, double *temp
         } else if( momentum_initialization == "maxwell-juettner" ) {
         
             // Sample the energies in the MJ distribution
-            vector<double> energies = maxwellJuttner( nPart, temp[0]/mass );
+            vector<double> energies = maxwellJuttner( nPart, temp[0]/mass, rand );
             
             // Sample angles randomly and calculate the momentum
             for( unsigned int p=iPart; p<iPart+nPart; p++ ) {
-                double phi   = acos( -Rand::uniform2() );
-                double theta = 2.0*M_PI*Rand::uniform();
+                double phi   = acos( -rand->uniform2() );
+                double theta = 2.0*M_PI*rand->uniform();
                 double psm = sqrt( pow( 1.0+energies[p-iPart], 2 )-1.0 );
                 
                 particles->momentum( 0, p ) = psm*cos( theta )*sin( phi );
@@ -451,9 +456,9 @@ void Species::initMomentum( unsigned int nPart, unsigned int iPart, double *temp
         
             double t0 = sqrt( temp[0]/mass ), t1 = sqrt( temp[1]/mass ), t2 = sqrt( temp[2]/mass );
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
-                particles->momentum( 0, p ) = Rand::uniform2() * t0;
-                particles->momentum( 1, p ) = Rand::uniform2() * t1;
-                particles->momentum( 2, p ) = Rand::uniform2() * t2;
+                particles->momentum( 0, p ) = rand->uniform2() * t0;
+                particles->momentum( 1, p ) = rand->uniform2() * t1;
+                particles->momentum( 2, p ) = rand->uniform2() * t2;
             }
         }
         
@@ -491,7 +496,7 @@ void Species::initMomentum( unsigned int nPart, unsigned int iPart, double *temp
                            + pow( particles->momentum( 2, p ), 2 ) );
                            
                 CheckVelocity = ( vx*particles->momentum( 0, p ) + vy*particles->momentum( 1, p ) + vz*particles->momentum( 2, p ) ) / gp;
-                Volume_Acc = Rand::uniform();
+                Volume_Acc = rand->uniform();
                 if( CheckVelocity > Volume_Acc ) {
                 
                     double Phi, Theta, vfl, vflx, vfly, vflz, vpx, vpy, vpz ;
@@ -546,9 +551,9 @@ void Species::initMomentum( unsigned int nPart, unsigned int iPart, double *temp
         
             //double gamma =sqrt(temp[0]*temp[0] + temp[1]*temp[1] + temp[2]*temp[2]);
             for( unsigned int p= iPart; p<iPart+nPart; p++ ) {
-                particles->momentum( 0, p ) = Rand::uniform2()*temp[0];
-                particles->momentum( 1, p ) = Rand::uniform2()*temp[1];
-                particles->momentum( 2, p ) = Rand::uniform2()*temp[2];
+                particles->momentum( 0, p ) = rand->uniform2()*temp[0];
+                particles->momentum( 1, p ) = rand->uniform2()*temp[1];
+                particles->momentum( 2, p ) = rand->uniform2()*temp[2];
             }
             
         }
@@ -603,177 +608,193 @@ void Species::dynamics( double time_dual, unsigned int ispec,
     // -------------------------------
     if( time_dual>time_frozen ) { // moving particle
     
-        smpi->dynamics_resize( ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical" );
+        // Thread buffers are bounded to particle_chunk_size particles: each bin is processed
+        // by chunks and the buffers are indexed relatively to the chunk start (ipart_ref).
+        // Radiation and pair generation still index the buffers by absolute particle index.
+        bool chunked = ( params.particle_chunk_size > 0 ) && ( !Radiate ) && ( !Multiphoton_Breit_Wheeler_process );
+        int buffer_size = last_index.back();
+        if( chunked ) {
+            buffer_size = min( buffer_size, params.particle_chunk_size );
+        }
+        smpi->dynamics_resize( ithread, nDim_field, buffer_size, params.geometry=="AMcylindrical" );
         //Point to local thread dedicated buffers
         //Still needed for ionization
         vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
         
         for( unsigned int ibin = 0 ; ibin < first_index.size() ; ibin++ ) {
         
-#ifdef  __DETAILED_TIMERS
-            timer = MPI_Wtime();
-#endif
-            
-            // Interpolate the fields at the particle position
-            Interp->fieldsWrapper( EMfields, *particles, smpi, &( first_index[ibin] ), &( last_index[ibin] ), ithread );
+            for( int istart = first_index[ibin] ; istart < last_index[ibin] ; istart += buffer_size ) {
             
+                int iend = min( istart + buffer_size, last_index[ibin] );
+                int ipart_ref = chunked ? istart : 0;
+                
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[0] += MPI_Wtime() - timer;
+                timer = MPI_Wtime();
 #endif
-            
-            // Ionization
-            if( Ionize ) {
-            
+                
+                // Interpolate the fields at the particle position
+                Interp->fieldsWrapper( EMfields, *particles, smpi, &istart, &iend, ithread, ipart_ref );
+                
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                patch->patch_timers[0] += MPI_Wtime() - timer;
 #endif
                 
-                ( *Ionize )( particles, first_index[ibin], last_index[ibin], Epart, patch, Proj );
+                // Ionization
+                if( Ionize ) {
                 
 #ifdef  __DETAILED_TIMERS
-                patch->patch_timers[4] += MPI_Wtime() - timer;
+                    timer = MPI_Wtime();
 #endif
-            }
-            
-            // Radiation losses
-            if( Radiate ) {
-            
+                    
+                    ( *Ionize )( particles, istart, iend, Epart, patch, Proj, ipart_ref );
+                    
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                    patch->patch_timers[4] += MPI_Wtime() - timer;
 #endif
+                }
                 
-                // Radiation process
-                ( *Radiate )( *particles, this->photon_species, smpi,
-                              RadiationTables,
-                              first_index[ibin], last_index[ibin], ithread );
-                              
-                // Update scalar variable for diagnostics
-                nrj_radiation += Radiate->getRadiatedEnergy();
+                // Radiation losses
+                if( Radiate ) {
                 
-                // Update the quantum parameter chi
-                Radiate->computeParticlesChi( *particles,
-                                              smpi,
-                                              first_index[ibin],
-                                              last_index[ibin],
-                                              ithread );
 #ifdef  __DETAILED_TIMERS
-                patch->patch_timers[5] += MPI_Wtime() - timer;
+                    timer = MPI_Wtime();
 #endif
-                
-            }
-            
-            
-            // Multiphoton Breit-Wheeler
-            if( Multiphoton_Breit_Wheeler_process ) {
-            
+                    
+                    // Radiation process
+                    ( *Radiate )( *particles, this->photon_species, smpi,
+                                  RadiationTables, patch->rand_,
+                                  istart, iend, ithread );
+                                  
+                    // Update scalar variable for diagnostics
+                    nrj_radiation += Radiate->getRadiatedEnergy();
+                    
+                    // Update the quantum parameter chi
+                    Radiate->computeParticlesChi( *particles,
+                                                  smpi,
+                                                  istart,
+                                                  iend,
+                                                  ithread );
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                    patch->patch_timers[5] += MPI_Wtime() - timer;
 #endif
+                    
+                }
                 
-                // Pair generation process
-                ( *Multiphoton_Breit_Wheeler_process )( *particles,
-                                                        smpi,
-                                                        MultiphotonBreitWheelerTables,
-                                                        first_index[ibin], last_index[ibin], ithread );
-                                                        
-                // Update scalar variable for diagnostics
-                // We reuse nrj_radiation for the pairs
-                nrj_radiation += Multiphoton_Breit_Wheeler_process->getPairEnergy();
                 
-                // Update the photon quantum parameter chi of all photons
-                Multiphoton_Breit_Wheeler_process->compute_thread_chiph( *particles,
-                        smpi,
-                        first_index[ibin],
-                        last_index[ibin],
-                        ithread );
-                        
-                // Suppression of the decayed photons into pairs
-                Multiphoton_Breit_Wheeler_process->decayed_photon_cleaning(
-                    *particles, ibin, first_index.size(), &first_index[0], &last_index[0] );
+                // Multiphoton Breit-Wheeler
+                if( Multiphoton_Breit_Wheeler_process ) {
+                
+#ifdef  __DETAILED_TIMERS
+                    timer = MPI_Wtime();
+#endif
                     
+                    // Pair generation process
+                    ( *Multiphoton_Breit_Wheeler_process )( *particles,
+                                                            smpi,
+                                                            MultiphotonBreitWheelerTables, patch->rand_,
+                                                            istart, iend, ithread );
+                                                            
+                    // Update scalar variable for diagnostics
+                    // We reuse nrj_radiation for the pairs
+                    nrj_radiation += Multiphoton_Breit_Wheeler_process->getPairEnergy();
+                    
+                    // Update the photon quantum parameter chi of all photons
+                    Multiphoton_Breit_Wheeler_process->compute_thread_chiph( *particles,
+                            smpi,
+                            istart,
+                            iend,
+                            ithread );
+                            
+                    // Suppression of the decayed photons into pairs
+                    Multiphoton_Breit_Wheeler_process->decayed_photon_cleaning(
+                        *particles, ibin, first_index.size(), &first_index[0], &last_index[0] );
+                    iend = last_index[ibin];
+                        
 #ifdef  __DETAILED_TIMERS
-                patch->patch_timers[6] += MPI_Wtime() - timer;
+                    patch->patch_timers[6] += MPI_Wtime() - timer;
 #endif
+                    
+                }
                 
-            }
-            
 #ifdef  __DETAILED_TIMERS
-            timer = MPI_Wtime();
+                timer = MPI_Wtime();
 #endif
-            
-            // Push the particles and the photons
-            ( *Push )( *particles, smpi, first_index[ibin], last_index[ibin], ithread );
-            //particles->test_move( first_index[ibin], last_index[ibin], params );
-            
+                
+                // Push the particles and the photons
+                ( *Push )( *particles, smpi, istart, iend, ithread, ipart_ref );
+                //particles->test_move( istart, iend, params );
+                
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[1] += MPI_Wtime() - timer;
-            timer = MPI_Wtime();
+                patch->patch_timers[1] += MPI_Wtime() - timer;
+                timer = MPI_Wtime();
 #endif
-            
-            // Apply wall and boundary conditions
-            if( mass>0 ) {
-                for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
-                    for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                        double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                
+                // Apply wall and boundary conditions
+                if( mass>0 ) {
+                    for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
+                        for( iPart=istart ; ( int )iPart<iend; iPart++ ) {
+                            double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart-ipart_ref];
+                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
+                                nrj_lost_per_thd[tid] += mass * ener_iPart;
+                            }
+                        }
+                    }
+                    // Boundary Condition may be physical or due to domain decomposition
+                    // apply returns 0 if iPart is not in the local domain anymore
+                    //        if omp, create a list per thread
+                    for( iPart=istart ; ( int )iPart<iend; iPart++ ) {
+                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
+                            addPartInExchList( iPart );
                             nrj_lost_per_thd[tid] += mass * ener_iPart;
+                            //}
+                            //else if ( partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
+                            //std::cout<<"removed particle position"<< particles->position(0,iPart)<<" , "<<particles->position(1,iPart)<<" ,"<<particles->position(2,iPart)<<std::endl;
                         }
                     }
-                }
-                // Boundary Condition may be physical or due to domain decomposition
-                // apply returns 0 if iPart is not in the local domain anymore
-                //        if omp, create a list per thread
-                for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                        addPartInExchList( iPart );
-                        nrj_lost_per_thd[tid] += mass * ener_iPart;
-                        //}
-                        //else if ( partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                        //std::cout<<"removed particle position"<< particles->position(0,iPart)<<" , "<<particles->position(1,iPart)<<" ,"<<particles->position(2,iPart)<<std::endl;
+                    
+                } else if( mass==0 ) {
+                    for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
+                        for( iPart=istart ; ( int )iPart<iend; iPart++ ) {
+                            double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart-ipart_ref];
+                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
+                                nrj_lost_per_thd[tid] += ener_iPart;
+                            }
+                        }
                     }
-                }
-                
-            } else if( mass==0 ) {
-                for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
-                    for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                        double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                    
+                    // Boundary Condition may be physical or due to domain decomposition
+                    // apply returns 0 if iPart is not in the local domain anymore
+                    //        if omp, create a list per thread
+                    for( iPart=istart ; ( int )iPart<iend; iPart++ ) {
+                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
+                            addPartInExchList( iPart );
                             nrj_lost_per_thd[tid] += ener_iPart;
                         }
                     }
+                    
                 }
                 
-                // Boundary Condition may be physical or due to domain decomposition
-                // apply returns 0 if iPart is not in the local domain anymore
-                //        if omp, create a list per thread
-                for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                        addPartInExchList( iPart );
-                        nrj_lost_per_thd[tid] += ener_iPart;
-                    }
-                }
-                
-            }
-            
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[3] += MPI_Wtime() - timer;
+                patch->patch_timers[3] += MPI_Wtime() - timer;
 #endif
-            
-            //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
-            
+                
+                //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
+                
 #ifdef  __DETAILED_TIMERS
-            timer = MPI_Wtime();
+                timer = MPI_Wtime();
 #endif
-            
-            // Project currents if not a Test species and charges as well if a diag is needed.
-            // Do not project if a photon
-            if( ( !particles->is_test ) && ( mass > 0 ) ) {
-                Proj->currentsAndDensityWrapper( EMfields, *particles, smpi, first_index[ibin], last_index[ibin], ithread, diag_flag, params.is_spectral, ispec );
-            }
-            
+                
+                // Project currents if not a Test species and charges as well if a diag is needed.
+                // Do not project if a photon
+                if( ( !particles->is_test ) && ( mass > 0 ) ) {
+                    Proj->currentsAndDensityWrapper( EMfields, *particles, smpi, istart, iend, ithread, diag_flag, params.is_spectral, ispec, ibin, ipart_ref );
+                }
+                
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[2] += MPI_Wtime() - timer;
+                patch->patch_timers[2] += MPI_Wtime() - timer;
 #endif
+                
+            }// chunk
             
         }// ibin
         
@@ -1483,9 +1504,9 @@ int Species::createParticles( vector<unsigned int> n_space_to_create, Params &pa
                             }
                         }
                         if( position_initialization_on_species==false ) {
-                            initPosition( nPart, iPart, indexes, params );
+                            initPosition( nPart, iPart, indexes, params, patch->rand_ );
                         }
-                        initMomentum( nPart, iPart, temp, vel );
+                        initMomentum( nPart, iPart, temp, vel, patch->rand_ );
                         initWeight( nPart, iPart, density( i, j, k ) );
                         initCharge( nPart, iPart, charge( i, j, k ) );
                         
@@ -1548,7 +1569,7 @@ int Species::createParticles( vector<unsigned int> n_space_to_create, Params &pa
                 temp[0] = temperature[0]( int_ijk[0], int_ijk[1], int_ijk[2] );
                 temp[1] = temperature[1]( int_ijk[0], int_ijk[1], int_ijk[2] );
                 temp[2] = temperature[2]( int_ijk[0], int_ijk[1], int_ijk[2] );
-                initMomentum( 1, ip, temp, vel );
+                initMomentum( 1, ip, temp, vel, patch->rand_ );
             } else {
                 for( unsigned int idim=0; idim < 3; idim++ ) {
                     particles->momentum( idim, ip ) = momentum[idim][ippy] ;
@@ -1599,6 +1620,22 @@ int Species::createParticles( vector<unsigned int> n_space_to_create, Params &pa
 } // End createParticles
 
 
+bool Species::profilesUsePython()
+{
+    vector<Profile *> profiles( 1, chargeProfile );
+    profiles.push_back( densityProfile );
+    profiles.push_back( ppcProfile );
+    profiles.insert( profiles.end(), velocityProfile.begin(), velocityProfile.end() );
+    profiles.insert( profiles.end(), temperatureProfile.begin(), temperatureProfile.end() );
+    for( unsigned int i=0; i<profiles.size(); i++ ) {
+        if( profiles[i] && profiles[i]->usesPython() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 // Move all particles from another species to this one
 void Species::importParticles( Params &params, Patch *patch, Particles &source_particles, vector<Diagnostic *> &localDiags )
 {
@@ -1619,20 +1656,38 @@ void Species::importParticles( Params &params, Patch *patch, Particles &source_p
         dynamic_cast<DiagnosticTrack *>( localDiags[tracking_diagnostic] )->setIDs( source_particles );
     }
     
-    // Move particles
+    // Find the bin of each particle and count the particles per bin
+    vector<unsigned int> part_bin( npart ), bin_count( nbin, 0 );
     for( unsigned int i=0; i<npart; i++ ) {
-        // Copy particle to the correct bin
         ibin = source_particles.position( 0, i )*inv_cell_length - ( patch->getCellStartingGlobalIndex( 0 ) + params.oversize[0] );
-        
         ibin /= params.clrw;
-        source_particles.cp_particle( i, *particles, first_index[ibin] );
-        
-        // Update the bin counts
-        last_index[ibin]++;
-        for( ii=ibin+1; ii<nbin; ii++ ) {
-            first_index[ii]++;
-            last_index[ii]++;
-        }
+        part_bin[i] = ibin;
+        bin_count[ibin]++;
+    }
+    
+    // Number of particles imported in the bins before each bin
+    vector<unsigned int> bin_offset( nbin, 0 );
+    for( ii=1; ii<nbin; ii++ ) {
+        bin_offset[ii] = bin_offset[ii-1] + bin_count[ii-1];
+    }
+    
+    // Final slots: the particles are placed at the start of their bin,
+    // the last imported first (same order as successive insertions at first_index)
+    vector<unsigned int> src_ids( npart ), dest_ids( npart ), bin_fill( nbin, 0 );
+    for( int i=npart-1; i>=0; i-- ) {
+        ibin = part_bin[i];
+        ii = bin_offset[ibin] + bin_fill[ibin]++;
+        src_ids [ii] = i;
+        dest_ids[ii] = first_index[ibin] + ii;
+    }
+    
+    // Move particles
+    source_particles.cp_particles( src_ids, *particles, dest_ids );
+    
+    // Update the bin counts
+    for( ibin=0; ibin<nbin; ibin++ ) {
+        first_index[ibin] += bin_offset[ibin];
+        last_index [ibin] += bin_offset[ibin] + bin_count[ibin];
     }
     
     source_particles.clear();
@@ -1687,7 +1742,7 @@ void Species::setXminBoundaryCondition()
 }
 
 // Provides a Maxwell-Juttner distribution of energies
-vector<double> Species::maxwellJuttner( unsigned int npoints, double temperature )
+vector<double> Species::maxwellJuttner( unsigned int npoints, double temperature, Random *rand )
 {
     if( temperature==0. ) {
         ERROR( "The species " << speciesNumber << " is initializing its momentum with the following temperature : " << temperature );
@@ -1702,7 +1757,7 @@ vector<double> Species::maxwellJuttner( unsigned int npoints, double temperature
         // For each particle
         for( unsigned int i=0; i<npoints; i++ ) {
             // Pick a random number
-            U = Rand::uniform();
+            U = rand->uniform();
             // Calculate the inverse of F
             lnlnU = log( -log( U ) );
             if( lnlnU>2. ) {
@@ -1731,7 +1786,7 @@ vector<double> Species::maxwellJuttner( unsigned int npoints, double temperature
         for( unsigned int i=0; i<npoints; i++ ) {
             do {
                 // Pick a random number
-                U = Rand::uniform();
+                U = rand->uniform();
                 // Calculate the inverse of H at the point log(1.-U) + H0
                 lnU = log( -log( 1.-U ) - H0 );
                 if( lnU<-26. ) {
@@ -1747,7 +1802,7 @@ vector<double> Species::maxwellJuttner( unsigned int npoints, double temperature
                 // Make a first guess for the value of gamma
                 gamma = temperature * invH;
                 // We use the rejection method, so we pick another random number
-                U = Rand::uniform();
+                U = rand->uniform();
                 // And we are done only if U < beta, otherwise we try again
             } while( U >= sqrt( 1.-1./( gamma*gamma ) ) );
             // Store that value of the energy
@@ -1947,7 +2002,7 @@ void Species::ponderomotive_update_position_and_currents( double time_dual, unsi
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
                             nrj_lost_per_thd[tid] += mass * ener_iPart;
                         }
                     }
@@ -1957,7 +2012,7 @@ void Species::ponderomotive_update_position_and_currents( double time_dual, unsi
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[ibin] ; ( int )iPart<last_index[ibin]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass * ener_iPart;
                     }
@@ -1978,7 +2033,7 @@ void Species::ponderomotive_update_position_and_currents( double time_dual, unsi
                 // // apply returns 0 if iPart is not in the local domain anymore
                 // //        if omp, create a list per thread
                 // for (iPart=first_index[ibin] ; (int)iPart<last_index[ibin]; iPart++ ) {
-                //     if ( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                //     if ( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
                 //         addPartInExchList( iPart );
                 //         nrj_lost_per_thd[tid] += ener_iPart;
                 //     }
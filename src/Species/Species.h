@@ -7,6 +7,7 @@
 
 #include "Particles.h"
 #include "Params.h"
+#include "Random.h"
 //#include "PartBoundCond.h"
 
 #include "Pusher.h"
@@ -361,10 +362,10 @@ public:
     virtual void computeCharge( unsigned int ispec, ElectroMagn *EMfields );
     
     //! Method used to initialize the Particle position in a given cell
-    void initPosition( unsigned int, unsigned int, double *, Params & );
+    void initPosition( unsigned int, unsigned int, double *, Params &, Random *rand );
     
     //! Method used to initialize the Particle 3d momentum in a given cell
-    void initMomentum( unsigned int, unsigned int, double *, double * );
+    void initMomentum( unsigned int, unsigned int, double *, double *, Random *rand );
     
     //! Method used to initialize the Particle weight (equivalent to a charge density) in a given cell
     void initWeight( unsigned int,  unsigned int, double );
@@ -490,6 +491,7 @@ public:
         //speciesSize *= getNbrOfParticles();
         int speciesSize( 0 );
         speciesSize += particles->double_prop.size()*sizeof( double );
+        speciesSize += particles->float_prop.size()*sizeof( float );
         speciesSize += particles->short_prop.size()*sizeof( short );
         speciesSize += particles->uint64_prop.size()*sizeof( uint64_t );
         speciesSize *= getParticlesCapacity();
@@ -499,6 +501,9 @@ public:
     //! Method to create new particles.
     int  createParticles( std::vector<unsigned int> n_space_to_create, Params &params, Patch *patch, int new_bin_idx );
     
+    //! Whether createParticles evaluates profiles with python (then, only one thread may create particles at a time)
+    bool profilesUsePython();
+    
     //! Method to import particles in this species while conserving the sorting among bins
     virtual void importParticles( Params &, Patch *, Particles &, std::vector<Diagnostic *> & );
     
@@ -548,7 +553,7 @@ private:
     double min_loc;
     
     //! Samples npoints values of energies in a Maxwell-Juttner distribution
-    std::vector<double> maxwellJuttner( unsigned int npoints, double temperature );
+    std::vector<double> maxwellJuttner( unsigned int npoints, double temperature, Random *rand );
     //! Array used in the Maxwell-Juttner sampling (see doc)
     static const double lnInvF[1000];
     //! Array used in the Maxwell-Juttner sampling (see doc)
@@ -142,7 +142,7 @@ void SpeciesAdaptiveV2::scalar_dynamics( double time_dual, unsigned int ispec,
 #endif
                 // Radiation process
                 ( *Radiate )( *particles, this->photon_species, smpi,
-                              RadiationTables,
+                              RadiationTables, patch->rand_,
                               first_index[scell], last_index[scell], ithread );
                               
                 // Update scalar variable for diagnostics
@@ -167,7 +167,7 @@ void SpeciesAdaptiveV2::scalar_dynamics( double time_dual, unsigned int ispec,
                 // Pair generation process
                 ( *Multiphoton_Breit_Wheeler_process )( *particles,
                                                         smpi,
-                                                        MultiphotonBreitWheelerTables,
+                                                        MultiphotonBreitWheelerTables, patch->rand_,
                                                         first_index[scell], last_index[scell], ithread );
                                                         
                 // Update scalar variable for diagnostics
@@ -209,14 +209,14 @@ void SpeciesAdaptiveV2::scalar_dynamics( double time_dual, unsigned int ispec,
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
                             nrj_lost_per_thd[tid] += mass * ener_iPart;
                         }
                     }
                 }
                 
                 for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass * ener_iPart;
                         particles->cell_keys[iPart] = -1;
@@ -235,7 +235,7 @@ void SpeciesAdaptiveV2::scalar_dynamics( double time_dual, unsigned int ispec,
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
                             nrj_lost_per_thd[tid] += ener_iPart;
                         }
                     }
@@ -245,7 +245,7 @@ void SpeciesAdaptiveV2::scalar_dynamics( double time_dual, unsigned int ispec,
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += ener_iPart;
                         particles->cell_keys[iPart] = -1;
@@ -612,7 +612,7 @@ void SpeciesAdaptiveV2::scalar_ponderomotive_update_position_and_currents( doubl
                 for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                     for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                         double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                        if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
                             nrj_lost_per_thd[tid] += mass * ener_iPart;
                         }
                     }
@@ -622,7 +622,7 @@ void SpeciesAdaptiveV2::scalar_ponderomotive_update_position_and_currents( doubl
                 // apply returns 0 if iPart is not in the local domain anymore
                 //        if omp, create a list per thread
                 for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                    if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
                         addPartInExchList( iPart );
                         nrj_lost_per_thd[tid] += mass * ener_iPart;
                         particles->cell_keys[iPart] = -1;
@@ -18,6 +18,7 @@
 #include "BoundaryConditionType.h"
 
 #include "ElectroMagn.h"
+#include "ElectroMagnAM.h"
 #include "Interpolator.h"
 #include "InterpolatorFactory.h"
 #include "Profile.h"
@@ -64,7 +65,7 @@ SpeciesV::~SpeciesV()
 void SpeciesV::initCluster( Params &params )
 {
     int ncells = 1;
-    for( unsigned int iDim=0 ; iDim<nDim_particle ; iDim++ ) {
+    for( unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++ ) {
         ncells *= ( params.n_space[iDim]+1 );
     }
     last_index.resize( ncells, 0 );
@@ -79,18 +80,19 @@ void SpeciesV::initCluster( Params &params )
     f_dim1 =  params.n_space[1] + 2 * oversize[1] +1;
     f_dim2 =  params.n_space[2] + 2 * oversize[2] +1;
     
+    // Cells are sorted in the field dimensions (x, r in AM geometry)
     b_dim.resize( params.nDim_field, 1 );
-    if( nDim_particle == 1 ) {
+    if( params.nDim_field == 1 ) {
         b_dim[0] = ( 1 + clrw ) + 2 * oversize[0];
         f_dim1 = 1;
         f_dim2 = 1;
     }
-    if( nDim_particle == 2 ) {
+    if( params.nDim_field == 2 ) {
         b_dim[0] = ( 1 + clrw ) + 2 * oversize[0]; // There is a primal number of bins.
         b_dim[1] =  f_dim1;
         f_dim2 = 1;
     }
-    if( nDim_particle == 3 ) {
+    if( params.nDim_field == 3 ) {
         b_dim[0] = ( 1 + clrw ) + 2 * oversize[0]; // There is a primal number of bins.
         b_dim[1] = f_dim1;
         b_dim[2] = f_dim2;
@@ -135,7 +137,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
         //else
         //    npack_ *= (f_dim0-2*oversize[0]);
         
-        if( nDim_particle == 3 ) {
+        if( nDim_field == 3 ) {
             packsize_ *= ( f_dim2-2*oversize[2] );
         }
     }
@@ -154,7 +156,13 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
     // -------------------------------
     if( time_dual>time_frozen ) { // moving particle
     
-        smpi->dynamics_resize( ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical" );
+        // Thread buffers are bounded to particle_chunk_size particles: consecutive cells are
+        // gathered in chunks and the buffers are indexed relatively to the chunk start (ipart_ref).
+        // Radiation and pair generation still index the buffers by absolute particle index.
+        bool chunked = ( params.particle_chunk_size > 0 ) && ( !Radiate ) && ( !Multiphoton_Breit_Wheeler_process );
+        if( !chunked ) {
+            smpi->dynamics_resize( ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical" );
+        }
         
         //Point to local thread dedicated buffers
         //Still needed for ionization
@@ -167,200 +175,209 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
         
         for( unsigned int ipack = 0 ; ipack < npack_ ; ipack++ ) {
         
-            int nparts_in_pack = last_index[( ipack+1 ) * packsize_-1 ];
-            smpi->dynamics_resize( ithread, nDim_particle, nparts_in_pack );
+            unsigned int cell_start = ipack*packsize_;
+            unsigned int pack_end   = ( ipack+1 )*packsize_;
             
-#ifdef  __DETAILED_TIMERS
-            timer = MPI_Wtime();
-#endif
+            while( cell_start < pack_end ) {
             
-            // Interpolate the fields at the particle position
-            for( unsigned int scell = 0 ; scell < packsize_ ; scell++ )
-                Interp->fieldsWrapper( EMfields, *particles, smpi, &( first_index[ipack*packsize_+scell] ),
-                                       &( last_index[ipack*packsize_+scell] ),
-                                       ithread, first_index[ipack*packsize_] );
-                                       
+                unsigned int cell_end = pack_end;
+                int ipart_ref = first_index[cell_start];
+                if( chunked ) {
+                    // A chunk holds at least one cell
+                    cell_end = cell_start+1;
+                    while( ( cell_end < pack_end ) && ( last_index[cell_end]-ipart_ref <= params.particle_chunk_size ) ) {
+                        cell_end++;
+                    }
+                    smpi->dynamics_resize( ithread, nDim_field, last_index[cell_end-1]-ipart_ref, params.geometry=="AMcylindrical" );
+                } else {
+                    int nparts_in_pack = last_index[pack_end-1];
+                    smpi->dynamics_resize( ithread, nDim_field, nparts_in_pack, params.geometry=="AMcylindrical" );
+                }
+                
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[0] += MPI_Wtime() - timer;
+                timer = MPI_Wtime();
 #endif
-            
-            // Ionization
-            if( Ionize ) {
+                
+                // Interpolate the fields at the particle position
+                for( unsigned int scell = cell_start ; scell < cell_end ; scell++ )
+                    Interp->fieldsWrapper( EMfields, *particles, smpi, &( first_index[scell] ),
+                                           &( last_index[scell] ),
+                                           ithread, ipart_ref );
+                                           
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                patch->patch_timers[0] += MPI_Wtime() - timer;
 #endif
-                for( unsigned int scell = 0 ; scell < first_index.size() ; scell++ ) {
-                    ( *Ionize )( particles, first_index[scell], last_index[scell], Epart, patch, Proj );
-                }
+                
+                // Ionization
+                if( Ionize ) {
 #ifdef  __DETAILED_TIMERS
-                patch->patch_timers[4] += MPI_Wtime() - timer;
+                    timer = MPI_Wtime();
 #endif
-            }
-            
-            // Radiation losses
-            if( Radiate ) {
+                    for( unsigned int scell = cell_start ; scell < cell_end ; scell++ ) {
+                        ( *Ionize )( particles, first_index[scell], last_index[scell], Epart, patch, Proj, ipart_ref );
+                    }
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                    patch->patch_timers[4] += MPI_Wtime() - timer;
 #endif
-                for( unsigned int scell = 0 ; scell < first_index.size() ; scell++ ) {
-                    // Radiation process
-                    ( *Radiate )( *particles, this->photon_species, smpi,
-                                  RadiationTables,
-                                  first_index[scell], last_index[scell], ithread );
-                                  
-                    // Update scalar variable for diagnostics
-                    nrj_radiation += Radiate->getRadiatedEnergy();
-                    
-                    // Update the quantum parameter chi
-                    Radiate->computeParticlesChi( *particles,
-                                                  smpi,
-                                                  first_index[scell],
-                                                  last_index[scell],
-                                                  ithread );
                 }
+                
+                // Radiation losses
+                if( Radiate ) {
+#ifdef  __DETAILED_TIMERS
+                    timer = MPI_Wtime();
+#endif
+                    for( unsigned int scell = 0 ; scell < first_index.size() ; scell++ ) {
+                        // Radiation process
+                        ( *Radiate )( *particles, this->photon_species, smpi,
+                                      RadiationTables, patch->rand_,
+                                      first_index[scell], last_index[scell], ithread );
+                                      
+                        // Update scalar variable for diagnostics
+                        nrj_radiation += Radiate->getRadiatedEnergy();
+                        
+                        // Update the quantum parameter chi
+                        Radiate->computeParticlesChi( *particles,
+                                                      smpi,
+                                                      first_index[scell],
+                                                      last_index[scell],
+                                                      ithread );
+                    }
 #ifdef  __DETAILED_TIMERS
-                patch->patch_timers[5] += MPI_Wtime() - timer;
+                    patch->patch_timers[5] += MPI_Wtime() - timer;
 #endif
-            }
-            
-            // Multiphoton Breit-Wheeler
-            if( Multiphoton_Breit_Wheeler_process ) {
+                }
+                
+                // Multiphoton Breit-Wheeler
+                if( Multiphoton_Breit_Wheeler_process ) {
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                    timer = MPI_Wtime();
 #endif
-                for( unsigned int scell = 0 ; scell < first_index.size() ; scell++ ) {
-                
-                    // Pair generation process
-                    ( *Multiphoton_Breit_Wheeler_process )( *particles,
-                                                            smpi,
-                                                            MultiphotonBreitWheelerTables,
-                                                            first_index[scell], last_index[scell], ithread );
-                                                            
-                    // Update scalar variable for diagnostics
-                    // We reuse nrj_radiation for the pairs
-                    nrj_radiation += Multiphoton_Breit_Wheeler_process->getPairEnergy();
+                    for( unsigned int scell = 0 ; scell < first_index.size() ; scell++ ) {
                     
-                    // Update the photon quantum parameter chi of all photons
-                    Multiphoton_Breit_Wheeler_process->compute_thread_chiph( *particles,
-                            smpi,
-                            first_index[scell],
-                            last_index[scell],
-                            ithread );
-                            
-                    // Suppression of the decayed photons into pairs
-                    Multiphoton_Breit_Wheeler_process->decayed_photon_cleaning(
-                        *particles, scell, first_index.size(), &first_index[0], &last_index[0] );
+                        // Pair generation process
+                        ( *Multiphoton_Breit_Wheeler_process )( *particles,
+                                                                smpi,
+                                                                MultiphotonBreitWheelerTables, patch->rand_,
+                                                                first_index[scell], last_index[scell], ithread );
+                                                                
+                        // Update scalar variable for diagnostics
+                        // We reuse nrj_radiation for the pairs
+                        nrj_radiation += Multiphoton_Breit_Wheeler_process->getPairEnergy();
                         
-                }
+                        // Update the photon quantum parameter chi of all photons
+                        Multiphoton_Breit_Wheeler_process->compute_thread_chiph( *particles,
+                                smpi,
+                                first_index[scell],
+                                last_index[scell],
+                                ithread );
+                                
+                        // Suppression of the decayed photons into pairs
+                        Multiphoton_Breit_Wheeler_process->decayed_photon_cleaning(
+                            *particles, scell, first_index.size(), &first_index[0], &last_index[0] );
+                            
+                    }
 #ifdef  __DETAILED_TIMERS
-                patch->patch_timers[6] += MPI_Wtime() - timer;
+                    patch->patch_timers[6] += MPI_Wtime() - timer;
 #endif
-            }
-            
+                }
+                
 #ifdef  __DETAILED_TIMERS
-            timer = MPI_Wtime();
+                timer = MPI_Wtime();
 #endif
-            
-            // Push the particles and the photons
-            ( *Push )( *particles, smpi, first_index[ipack*packsize_],
-                       last_index[ipack*packsize_+packsize_-1],
-                       ithread, first_index[ipack*packsize_] );
-                       
+                
+                // Push the particles and the photons
+                ( *Push )( *particles, smpi, first_index[cell_start],
+                           last_index[cell_end-1],
+                           ithread, ipart_ref );
+                           
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[1] += MPI_Wtime() - timer;
-            timer = MPI_Wtime();
+                patch->patch_timers[1] += MPI_Wtime() - timer;
+                timer = MPI_Wtime();
 #endif
-            
-            unsigned int length[3];
-            length[0]=0;
-            length[1]=params.n_space[1]+1;
-            length[2]=params.n_space[2]+1;
-            
-            for( unsigned int scell = 0 ; scell < packsize_ ; scell++ ) {
-                // Apply wall and boundary conditions
-                if( mass>0 ) {
-                    for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
+                
+                for( unsigned int scell = cell_start ; scell < cell_end ; scell++ ) {
+                    // Apply wall and boundary conditions
+                    if( mass>0 ) {
+                        for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
+                            for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
+                                double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart-ipart_ref];
+                                if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
+                                    nrj_lost_per_thd[tid] += mass * ener_iPart;
+                                }
+                            }
+                        }
+                        
+                        // Boundary Condition may be physical or due to domain decomposition
+                        // apply returns 0 if iPart is not in the local domain anymore
+                        
                         for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                            double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                            if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
+                                addPartInExchList( iPart );
                                 nrj_lost_per_thd[tid] += mass * ener_iPart;
+                                particles->cell_keys[iPart] = -1;
+                            } else {
+                                //Compute cell_keys of remaining particles
+                                particles->cell_keys[iPart] = compute_cell_key( *particles, iPart );
+                                //First reduction of the count sort algorithm. Lost particles are not included.
+                                count[particles->cell_keys[iPart]] ++;
                             }
                         }
-                    }
-                    
-                    // Boundary Condition may be physical or due to domain decomposition
-                    // apply returns 0 if iPart is not in the local domain anymore
-                    
-                    for( iPart=first_index[ipack*packsize_+scell] ; ( int )iPart<last_index[ipack*packsize_+scell]; iPart++ ) {
-                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                            addPartInExchList( iPart );
-                            nrj_lost_per_thd[tid] += mass * ener_iPart;
-                            particles->cell_keys[iPart] = -1;
-                        } else {
-                            //Compute cell_keys of remaining particles
-                            for( unsigned int i = 0 ; i<nDim_particle; i++ ) {
-                                particles->cell_keys[iPart] *= this->length_[i];
-                                particles->cell_keys[iPart] += round( ( particles->position( i, iPart )-min_loc_vec[i] ) * dx_inv_[i] );
+                        
+                    } else if( mass==0 ) {
+                        for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
+                            for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
+                                double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart-ipart_ref];
+                                if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
+                                    nrj_lost_per_thd[tid] += ener_iPart;
+                                }
                             }
-                            //First reduction of the count sort algorithm. Lost particles are not included.
-                            count[particles->cell_keys[iPart]] ++;
                         }
-                    }
-                    
-                } else if( mass==0 ) {
-                    for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
+                        
+                        // Boundary Condition may be physical or due to domain decomposition
+                        // apply returns 0 if iPart is not in the local domain anymore
                         for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                            double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                            if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
+                                addPartInExchList( iPart );
                                 nrj_lost_per_thd[tid] += ener_iPart;
+                                particles->cell_keys[iPart] = -1;
+                            } else {
+                                //Compute cell_keys of remaining particles
+                                particles->cell_keys[iPart] = compute_cell_key( *particles, iPart );
+                                //First reduction of the count sort algorithm. Lost particles are not included.
+                                count[particles->cell_keys[iPart]] ++;
                             }
                         }
                     }
-                    
-                    // Boundary Condition may be physical or due to domain decomposition
-                    // apply returns 0 if iPart is not in the local domain anymore
-                    for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
-                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                            addPartInExchList( iPart );
-                            nrj_lost_per_thd[tid] += ener_iPart;
-                            particles->cell_keys[iPart] = -1;
-                        } else {
-                            //Compute cell_keys of remaining particles
-                            for( unsigned int i = 0 ; i<nDim_particle; i++ ) {
-                                particles->cell_keys[iPart] *= length[i];
-                                particles->cell_keys[iPart] += round( ( particles->position( i, iPart )-min_loc_vec[i] ) * dx_inv_[i] );
-                            }
-                            //First reduction of the count sort algorithm. Lost particles are not included.
-                            count[particles->cell_keys[iPart]] ++;
-                        }
-                    }
                 }
-            }
-            //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
-            
+                //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
+                
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[3] += MPI_Wtime() - timer;
+                patch->patch_timers[3] += MPI_Wtime() - timer;
 #endif
-            
-            // Project currents if not a Test species and charges as well if a diag is needed.
-            // Do not project if a photon
-            if( ( !particles->is_test ) && ( mass > 0 ) )
+                
+                // Project currents if not a Test species and charges as well if a diag is needed.
+                // Do not project if a photon
+                if( ( !particles->is_test ) && ( mass > 0 ) )
 #ifdef  __DETAILED_TIMERS
-                timer = MPI_Wtime();
+                    timer = MPI_Wtime();
 #endif
-                
-            for( unsigned int scell = 0 ; scell < packsize_ ; scell++ )
-                Proj->currentsAndDensityWrapper(
-                    EMfields, *particles, smpi, first_index[ipack*packsize_+scell],
-                    last_index[ipack*packsize_+scell],
-                    ithread,
-                    diag_flag, params.is_spectral,
-                    ispec, ipack*packsize_+scell, first_index[ipack*packsize_]
-                );
-                
+                    
+                for( unsigned int scell = cell_start ; scell < cell_end ; scell++ )
+                    Proj->currentsAndDensityWrapper(
+                        EMfields, *particles, smpi, first_index[scell],
+                        last_index[scell],
+                        ithread,
+                        diag_flag, params.is_spectral,
+                        ispec, scell, ipart_ref
+                    );
+                    
 #ifdef  __DETAILED_TIMERS
-            patch->patch_timers[2] += MPI_Wtime() - timer;
+                patch->patch_timers[2] += MPI_Wtime() - timer;
 #endif
+                
+                
+                cell_start = cell_end;
+            }
             
             for( unsigned int ithd=0 ; ithd<nrj_lost_per_thd.size() ; ithd++ ) {
                 nrj_bc_lost += nrj_lost_per_thd[tid];
@@ -398,10 +415,21 @@ void SpeciesV::computeCharge( unsigned int ispec, ElectroMagn *EMfields )
     // calculate the particle charge
     // -------------------------------
     if( ( !particles->is_test ) ) {
-        double *b_rho=&( *EMfields->rho_ )( 0 );
-        
-        for( unsigned int iPart=first_index[0] ; ( int )iPart<last_index[last_index.size()-1]; iPart++ ) {
-            Proj->densityFrozen( b_rho, ( *particles ), iPart, 0 );
+        if( !dynamic_cast<ElectroMagnAM *>( EMfields ) ) {
+            double *b_rho=&( *EMfields->rho_ )( 0 );
+            
+            for( unsigned int iPart=first_index[0] ; ( int )iPart<last_index[last_index.size()-1]; iPart++ ) {
+                Proj->densityFrozen( b_rho, ( *particles ), iPart, 0 );
+            }
+        } else {
+            ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
+            unsigned int Nmode = emAM->rho_AM_.size();
+            for( unsigned int imode=0; imode<Nmode; imode++ ) {
+                complex<double> *b_rho = &( *emAM->rho_AM_[imode] )( 0 );
+                for( unsigned int iPart=first_index[0] ; ( int )iPart<last_index[last_index.size()-1]; iPart++ ) {
+                    Proj->densityFrozenComplex( b_rho, ( *particles ), iPart, 0, imode );
+                }
+            }
         }
         
     }
@@ -440,11 +468,7 @@ void SpeciesV::sort_part( Params &params )
             buf_cell_keys[idim][ineighbor].resize( MPIbuff.part_index_recv_sz[idim][ineighbor] );
             #pragma omp simd
             for( unsigned int ip=0; ip < MPIbuff.part_index_recv_sz[idim][ineighbor]; ip++ ) {
-                for( unsigned int ipos=0; ipos < nDim_particle ; ipos++ ) {
-                    double X = MPIbuff.partRecv[idim][ineighbor].position( ipos, ip )-min_loc_vec[ipos];
-                    int IX = round( X * dx_inv_[ipos] );
-                    buf_cell_keys[idim][ineighbor][ip] = buf_cell_keys[idim][ineighbor][ip] * length[ipos] + IX;
-                }
+                buf_cell_keys[idim][ineighbor][ip] = compute_cell_key( MPIbuff.partRecv[idim][ineighbor], ip );
             }
             //Can we vectorize this reduction ?
             for( unsigned int ip=0; ip < MPIbuff.part_index_recv_sz[idim][ineighbor]; ip++ ) {
@@ -578,19 +602,13 @@ void SpeciesV::compute_part_cell_keys( Params &params )
     //Compute part_cell_keys at patch creation. This operation is normally done in the pusher to avoid additional particles pass.
     
     unsigned int ip, npart;
-    int IX;
-    double X;
     
     npart = particles->size(); //Number of particles
     
     #pragma omp simd
     for( ip=0; ip < npart ; ip++ ) {
         // Counts the # of particles in each cell (or sub_cell) and store it in slast_index.
-        for( unsigned int ipos=0; ipos < nDim_particle ; ipos++ ) {
-            X = particles->position( ipos, ip )-min_loc_vec[ipos];
-            IX = round( X * dx_inv_[ipos] );
-            particles->cell_keys[ip] = particles->cell_keys[ip] * this->length_[ipos] + IX;
-        }
+        particles->cell_keys[ip] = compute_cell_key( *particles, ip );
     }
     for( ip=0; ip < npart ; ip++ ) {
         count[particles->cell_keys[ip]] ++ ;
@@ -612,10 +630,7 @@ void SpeciesV::compute_bin_cell_keys( Params &params, int istart, int iend )
     #pragma omp simd
     for( int ip=istart; ip < iend; ip++ ) {
         // Counts the # of particles in each cell (or sub_cell) and store it in slast_index.
-        for( unsigned int ipos=0; ipos < nDim_particle ; ipos++ ) {
-            particles->cell_keys[ip] *= this->length_[ipos];
-            particles->cell_keys[ip] += round( ( particles->position( ipos, ip )-min_loc_vec[ipos] ) * dx_inv_[ipos] );
-        }
+        particles->cell_keys[ip] = compute_cell_key( *particles, ip );
     }
 }
 
@@ -629,14 +644,6 @@ void SpeciesV::importParticles( Params &params, Patch *patch, Particles &source_
         dynamic_cast<DiagnosticTrack *>( localDiags[tracking_diagnostic] )->setIDs( source_particles );
     }
     
-    unsigned int length[3];
-    length[0]=0;
-    length[1]=params.n_space[1]+1;
-    length[2]=params.n_space[2]+1;
-    
-    int IX;
-    double X;
-    
     // std::cerr << "SpeciesV::importParticles "
     //           << " for "<< this->name
     //           << " in patch (" << patch->Pcoordinates[0] << "," <<  patch->Pcoordinates[1] << "," <<  patch->Pcoordinates[2] << ") "
@@ -646,30 +653,40 @@ void SpeciesV::importParticles( Params &params, Patch *patch, Particles &source_
     //           << " nbp: " << npart
     //           << std::endl;
     
-    // Move particles
+    // Find the receiving cell of each particle and count the particles per cell
+    vector<unsigned int> part_cell( npart ), cell_count( nbin, 0 );
     for( unsigned int i=0; i<npart; i++ ) {
+        scell = compute_cell_key( source_particles, i );
+        part_cell[i] = scell;
+        cell_count[scell]++;
+    }
     
-        // Compute the receiving bin index
-        scell = 0;
-        for( unsigned int ipos=0; ipos < nDim_particle ; ipos++ ) {
-            X = source_particles.position( ipos, i )-min_loc_vec[ipos];
-            IX = round( X * dx_inv_[ipos] );
-            scell = scell * length[ipos] + IX;
-        }
-        
-        // Copy particle to the correct bin
-        source_particles.cp_particle( i, *particles, last_index[scell] );
-        
-        // Update the bin counts
-        last_index[scell]++;
-        for( ii=scell+1; ii<nbin; ii++ ) {
-            first_index[ii]++;
-            last_index[ii]++;
-        }
-        
-        particles->cell_keys.insert( particles->cell_keys.begin() + first_index[scell] + count[scell], scell );
-        count[scell] ++ ;
-        
+    // Number of particles imported in the cells before each cell
+    vector<unsigned int> cell_offset( nbin, 0 );
+    for( ii=1; ii<nbin; ii++ ) {
+        cell_offset[ii] = cell_offset[ii-1] + cell_count[ii-1];
+    }
+    
+    // Final slots: the particles are appended at the end of their cell, in import order
+    vector<unsigned int> src_ids( npart ), dest_ids( npart ), cell_fill( nbin, 0 );
+    vector<int> new_keys( npart );
+    for( unsigned int i=0; i<npart; i++ ) {
+        scell = part_cell[i];
+        ii = cell_offset[scell] + cell_fill[scell]++;
+        src_ids [ii] = i;
+        dest_ids[ii] = last_index[scell] + ii;
+        new_keys[ii] = scell;
+    }
+    
+    // Move particles
+    source_particles.cp_particles( src_ids, *particles, dest_ids );
+    Particles::insert_at_slots( particles->cell_keys, dest_ids, new_keys );
+    
+    // Update the bin counts
+    for( scell=0; scell<nbin; scell++ ) {
+        first_index[scell] += cell_offset[scell];
+        last_index [scell] += cell_offset[scell] + cell_count[scell];
+        count[scell] += cell_count[scell];
     }
     
     source_particles.clear();
@@ -709,7 +726,7 @@ void SpeciesV::ponderomotive_update_susceptibility_and_momentum( double time_dua
         //else
         //    npack_ *= (f_dim0-2*oversize[0]);
         
-        if( nDim_particle == 3 ) {
+        if( nDim_field == 3 ) {
             packsize_ *= ( f_dim2-2*oversize[2] );
         }
     }
@@ -726,7 +743,7 @@ void SpeciesV::ponderomotive_update_susceptibility_and_momentum( double time_dua
             // ipack end   @ last_index [ ipack * packsize_ + packsize_ - 1 ]
             //int nparts_in_pack = last_index[ (ipack+1) * packsize_-1 ] - first_index [ ipack * packsize_ ];
             int nparts_in_pack = last_index[( ipack+1 ) * packsize_-1 ];
-            smpi->dynamics_resize( ithread, nDim_particle, nparts_in_pack );
+            smpi->dynamics_resize( ithread, nDim_field, nparts_in_pack, params.geometry=="AMcylindrical" );
             
 #ifdef  __DETAILED_TIMERS
             timer = MPI_Wtime();
@@ -800,7 +817,7 @@ void SpeciesV::ponderomotive_project_susceptibility( double time_dual, unsigned
         //else
         //    npack_ *= (f_dim0-2*oversize[0]);
         
-        if( nDim_particle == 3 ) {
+        if( nDim_field == 3 ) {
             packsize_ *= ( f_dim2-2*oversize[2] );
         }
     }
@@ -817,7 +834,7 @@ void SpeciesV::ponderomotive_project_susceptibility( double time_dual, unsigned
             // ipack end   @ last_index [ ipack * packsize_ + packsize_ - 1 ]
             //int nparts_in_pack = last_index[ (ipack+1) * packsize_-1 ] - first_index [ ipack * packsize_ ];
             int nparts_in_pack = last_index[( ipack+1 ) * packsize_-1 ];
-            smpi->dynamics_resize( ithread, nDim_particle, nparts_in_pack );
+            smpi->dynamics_resize( ithread, nDim_field, nparts_in_pack, params.geometry=="AMcylindrical" );
             
 #ifdef  __DETAILED_TIMERS
             timer = MPI_Wtime();
@@ -899,7 +916,7 @@ void SpeciesV::ponderomotive_update_position_and_currents( double time_dual, uns
         
             //int nparts_in_pack = last_index[ (ipack+1) * packsize_-1 ] - first_index [ ipack * packsize_ ];
             int nparts_in_pack = last_index[( ipack+1 ) * packsize_-1 ];
-            smpi->dynamics_resize( ithread, nDim_particle, nparts_in_pack );
+            smpi->dynamics_resize( ithread, nDim_field, nparts_in_pack, params.geometry=="AMcylindrical" );
             
 #ifdef  __DETAILED_TIMERS
             timer = MPI_Wtime();
@@ -932,7 +949,7 @@ void SpeciesV::ponderomotive_update_position_and_currents( double time_dual, uns
                     for( unsigned int iwall=0; iwall<partWalls->size(); iwall++ ) {
                         for( iPart=first_index[scell] ; ( int )iPart<last_index[scell]; iPart++ ) {
                             double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart ) ) {
+                            if( !( *partWalls )[iwall]->apply( *particles, iPart, this, dtgf, ener_iPart, patch->rand_ ) ) {
                                 nrj_lost_per_thd[tid] += mass * ener_iPart;
                             }
                         }
@@ -941,7 +958,7 @@ void SpeciesV::ponderomotive_update_position_and_currents( double time_dual, uns
                     // Boundary Condition may be physical or due to domain decomposition
                     // apply returns 0 if iPart is not in the local domain anymore
                     for( iPart=first_index[ipack*packsize_+scell] ; ( int )iPart<last_index[ipack*packsize_+scell]; iPart++ ) {
-                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                        if( !partBoundCond->apply( *particles, iPart, this, ener_iPart, patch->rand_ ) ) {
                             addPartInExchList( iPart );
                             nrj_lost_per_thd[tid] += mass * ener_iPart;
                             particles->cell_keys[iPart] = -1;
@@ -1,6 +1,7 @@
 #ifndef SPECIESV_H
 #define SPECIESV_H
 
+#include <cmath>
 #include <vector>
 #include <string>
 
@@ -78,6 +79,21 @@ public:
     //! Compute cell_keys for the specified bin boundaries.
     void compute_bin_cell_keys( Params &params, int istart, int iend );
     
+    //! Cell key of the particle ipart of parts (cells ordered along x, y, z or along x, r in AM geometry)
+    inline int compute_cell_key( Particles &parts, unsigned int ipart )
+    {
+        if( nDim_field != nDim_particle ) {
+            double r = sqrt( parts.position( 1, ipart )*parts.position( 1, ipart ) + parts.position( 2, ipart )*parts.position( 2, ipart ) );
+            return round( ( parts.position( 0, ipart )-min_loc_vec[0] ) * dx_inv_[0] ) * length_[1]
+                   + round( ( r-min_loc_vec[1] ) * dx_inv_[1] );
+        }
+        int key = 0;
+        for( unsigned int ipos=0; ipos < nDim_particle ; ipos++ ) {
+            key = key * length_[ipos] + round( ( parts.position( ipos, ipart )-min_loc_vec[ipos] ) * dx_inv_[ipos] );
+        }
+        return key;
+    }
+    
     //! Create a new entry for a particle
     void add_space_for_a_particle() override
     {
@@ -0,0 +1,163 @@
+#include "FFT.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+
+FFT1D::FFT1D( unsigned int n ) :
+    n_( n )
+{
+    // Size of the radix-2 transforms
+    m_ = 1;
+    while( m_ < n_ ) {
+        m_ <<= 1;
+    }
+    bluestein_ = ( n_ > 1 ) && ( m_ != n_ );
+    if( bluestein_ ) {
+        // Bluestein's convolution must hold 2n-1 points
+        m_ = 1;
+        while( m_ < 2*n_-1 ) {
+            m_ <<= 1;
+        }
+    }
+    
+    // Bit reversal and twiddle factors
+    unsigned int nbits = 0;
+    while( ( 1u << nbits ) < m_ ) {
+        nbits++;
+    }
+    bitrev_.resize( m_ );
+    for( unsigned int i=0; i<m_; i++ ) {
+        unsigned int r = 0;
+        for( unsigned int b=0; b<nbits; b++ ) {
+            r |= ( ( i >> b ) & 1u ) << ( nbits-1-b );
+        }
+        bitrev_[i] = r;
+    }
+    twiddles_.resize( m_/2 );
+    for( unsigned int k=0; k<m_/2; k++ ) {
+        twiddles_[k] = polar( 1., -2.*M_PI*( double )k/( double )m_ );
+    }
+    
+    if( bluestein_ ) {
+        // Chirp exp(-i pi k^2 / n), k^2 being reduced modulo 2n to keep the angle accurate
+        chirp_.resize( n_ );
+        unsigned long long two_n = 2ull * n_;
+        for( unsigned int k=0; k<n_; k++ ) {
+            unsigned long long k2 = ( ( unsigned long long )k * k ) % two_n;
+            chirp_[k] = polar( 1., -M_PI*( double )k2/( double )n_ );
+        }
+        // Transform of the conjugate chirp, wrapped around to make a circular convolution
+        chirp_fft_.assign( m_, 0. );
+        chirp_fft_[0] = conj( chirp_[0] );
+        for( unsigned int k=1; k<n_; k++ ) {
+            chirp_fft_[k] = conj( chirp_[k] );
+            chirp_fft_[m_-k] = conj( chirp_[k] );
+        }
+        radix2( &chirp_fft_[0], false );
+    }
+}
+
+
+void FFT1D::forward( complex<double> *z, unsigned int howmany, size_t stride, size_t dist )
+{
+    many( z, howmany, stride, dist, false );
+}
+
+
+void FFT1D::backward( complex<double> *z, unsigned int howmany, size_t stride, size_t dist )
+{
+    many( z, howmany, stride, dist, true );
+}
+
+
+void FFT1D::many( complex<double> *z, unsigned int howmany, size_t stride, size_t dist, bool inverse )
+{
+    if( n_ < 2 || howmany == 0 ) {
+        return;
+    }
+    double norm = inverse ? 1./( double )n_ : 1.;
+    
+    #pragma omp parallel
+    {
+        vector<complex<double> > buffer( stride==1 ? 0 : n_ );
+        vector<complex<double> > work( bluestein_ ? m_ : 0 );
+        
+        #pragma omp for schedule(static)
+        for( int i=0; i<( int )howmany; i++ ) {
+            complex<double> *a = z + ( size_t )i*dist;
+            complex<double> *b = a;
+            // Gather strided arrays in a contiguous buffer
+            if( stride != 1 ) {
+                b = &buffer[0];
+                for( unsigned int j=0; j<n_; j++ ) {
+                    b[j] = a[j*stride];
+                }
+            }
+            transform( b, work.data(), inverse );
+            if( stride != 1 ) {
+                for( unsigned int j=0; j<n_; j++ ) {
+                    a[j*stride] = b[j] * norm;
+                }
+            } else if( inverse ) {
+                for( unsigned int j=0; j<n_; j++ ) {
+                    a[j] *= norm;
+                }
+            }
+        }
+    }
+}
+
+
+void FFT1D::transform( complex<double> *z, complex<double> *work, bool inverse )
+{
+    if( ! bluestein_ ) {
+        radix2( z, inverse );
+        return;
+    }
+    
+    // Chirp-z algorithm: the transform is a convolution with the chirp, done with radix-2 transforms.
+    // The backward transform is the conjugate of the forward transform of the conjugate.
+    for( unsigned int k=0; k<n_; k++ ) {
+        work[k] = ( inverse ? conj( z[k] ) : z[k] ) * chirp_[k];
+    }
+    fill( work+n_, work+m_, complex<double>( 0. ) );
+    radix2( work, false );
+    for( unsigned int k=0; k<m_; k++ ) {
+        work[k] *= chirp_fft_[k];
+    }
+    radix2( work, true );
+    double norm = 1./( double )m_;
+    for( unsigned int k=0; k<n_; k++ ) {
+        z[k] = work[k] * chirp_[k] * norm;
+        if( inverse ) {
+            z[k] = conj( z[k] );
+        }
+    }
+}
+
+
+void FFT1D::radix2( complex<double> *z, bool inverse )
+{
+    for( unsigned int i=0; i<m_; i++ ) {
+        unsigned int j = bitrev_[i];
+        if( i < j ) {
+            swap( z[i], z[j] );
+        }
+    }
+    for( unsigned int len=2; len<=m_; len<<=1 ) {
+        unsigned int half = len/2;
+        unsigned int step = m_/len;
+        for( unsigned int i=0; i<m_; i+=len ) {
+            for( unsigned int k=0; k<half; k++ ) {
+                complex<double> w = inverse ? conj( twiddles_[k*step] ) : twiddles_[k*step];
+                complex<double> u = z[i+k];
+                complex<double> v = z[i+k+half] * w;
+                z[i+k]      = u + v;
+                z[i+k+half] = u - v;
+            }
+        }
+    }
+}
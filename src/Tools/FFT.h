@@ -0,0 +1,57 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+
+//! Complex 1D fast Fourier transforms of a given size, with the conventions of numpy.fft
+//! (forward: exp(-2 i pi j k / n), backward normalized by 1/n).
+//! Powers of 2 use an iterative radix-2 algorithm, other sizes the chirp-z (Bluestein) algorithm.
+class FFT1D
+{
+public:
+    FFT1D( unsigned int n );
+    ~FFT1D() {};
+    
+    //! In-place forward transforms of howmany arrays, whose elements are separated by stride
+    //! and whose first elements are separated by dist. The arrays are distributed among the threads.
+    void forward( std::complex<double> *z, unsigned int howmany=1, std::size_t stride=1, std::size_t dist=0 );
+    
+    //! In-place backward transforms, same arguments as forward
+    void backward( std::complex<double> *z, unsigned int howmany=1, std::size_t stride=1, std::size_t dist=0 );
+    
+private:
+    //! Transforms howmany arrays, the threads using their own buffers
+    void many( std::complex<double> *z, unsigned int howmany, std::size_t stride, std::size_t dist, bool inverse );
+    
+    //! Transform of one contiguous array of size n_ (work must hold m_ values when using Bluestein)
+    void transform( std::complex<double> *z, std::complex<double> *work, bool inverse );
+    
+    //! In-place radix-2 transform of size m_ (not normalized)
+    void radix2( std::complex<double> *z, bool inverse );
+    
+    //! Size of the transforms
+    unsigned int n_;
+    
+    //! Size of the radix-2 transforms (n_ if power of 2, otherwise the size of the Bluestein convolution)
+    unsigned int m_;
+    
+    //! Whether the chirp-z algorithm is used
+    bool bluestein_;
+    
+    //! Bit-reversal permutation for the radix-2 transforms
+    std::vector<unsigned int> bitrev_;
+    
+    //! Twiddle factors exp(-2 i pi k / m_)
+    std::vector<std::complex<double> > twiddles_;
+    
+    //! Chirp exp(-i pi k^2 / n_)
+    std::vector<std::complex<double> > chirp_;
+    
+    //! Transform of the conjugate chirp, padded to m_
+    std::vector<std::complex<double> > chirp_fft_;
+};
+
+#endif
@@ -336,6 +336,12 @@ public:
         getVect( locationId, vect_name, vect, H5T_NATIVE_DOUBLE, resizeVect );
     }
     
+    //! retrieve a float vector
+    static void getVect( hid_t locationId, std::string vect_name,  std::vector<float> &vect, bool resizeVect=false )
+    {
+        getVect( locationId, vect_name, vect, H5T_NATIVE_FLOAT, resizeVect );
+    }
+    
     //! retrieve an unsigned int vector
     static void getVect( hid_t locationId, std::string vect_name,  std::vector<unsigned int> &vect, bool resizeVect=false )
     {
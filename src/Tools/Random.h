@@ -0,0 +1,140 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <cmath>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Random
+//! Counter-based random number generator (Philox4x32-10, Salmon et al., SC'11). The numbers are a function of a key
+//! (random_seed, patch hindex) and of a counter (kind of stream, timestep, stream id, position in the stream) only:
+//! they depend neither on the thread nor on the MPI process that draws them, and no state needs to be saved.
+//! Each patch owns a generator (Patch::rand_). A stream is selected before each operation drawing numbers:
+//!   - creation of the particles of the patch (all species, in order)
+//!   - dynamics of species ispec at timestep itime (ionization, radiation, pair creation, thermal boundaries)
+//!   - collisions of group icoll at timestep itime
+//!   - boundaries of species ispec at timestep itime, when the ponderomotive dynamics is split in two steps
+//  --------------------------------------------------------------------------------------------------------------------
+class Random
+{
+public:
+    //! Kinds of streams
+    enum Kind { creation = 0, dynamics = 1, collisions = 2, boundaries = 3 };
+
+    Random( uint32_t seed ) : seed_( seed )
+    {
+        setStream( 0, creation, 0, 0 );
+    }
+
+    //! Select a stream, from its beginning
+    inline void setStream( uint32_t hindex, uint32_t kind, uint32_t itime, uint32_t id )
+    {
+        key_[0] = seed_;
+        key_[1] = hindex;
+        counter_[0] = 0;
+        counter_[1] = id;
+        counter_[2] = itime;
+        counter_[3] = kind;
+        navail_ = 0;
+    }
+
+    //! Random integer in [0, 2^32[
+    inline uint32_t integer()
+    {
+        if( navail_ == 0 ) {
+            philox( counter_, key_, block_ );
+            counter_[0]++;
+            navail_ = 4;
+        }
+        return block_[4 - navail_--];
+    }
+
+    //! Random number in [0, 1[ (53 random bits)
+    inline double uniform()
+    {
+        uint32_t a = integer();
+        uint32_t b = integer();
+        return toDouble( a, b );
+    }
+
+    //! Random number in [0, 1-1e-11[
+    inline double uniform1()
+    {
+        return uniform() * ( 1.-1e-11 );
+    }
+
+    //! Random number in [-1, 1[
+    inline double uniform2()
+    {
+        return 2.*uniform() - 1.;
+    }
+
+    //! Random number in a normal distribution of standard deviation stddev (Box-Muller)
+    inline double normal( double stddev )
+    {
+        double u1 = 1. - uniform();
+        double u2 = uniform();
+        return stddev * std::sqrt( -2.*std::log( u1 ) ) * std::cos( 2.*M_PI*u2 );
+    }
+
+    //! Fill u[0:n] with random numbers in [0, 1[: the blocks of the stream are computed independently (vectorized).
+    //! The numbers left in the current block are skipped.
+    inline void uniform( double *u, unsigned int n )
+    {
+        unsigned int nblocks = n/2;
+        uint32_t c0 = counter_[0], c1 = counter_[1], c2 = counter_[2], c3 = counter_[3];
+        uint32_t k0 = key_[0], k1 = key_[1];
+        #pragma omp simd
+        for( unsigned int iblock=0 ; iblock<nblocks ; iblock++ ) {
+            uint32_t counter[4] = { c0+iblock, c1, c2, c3 };
+            uint32_t key[2] = { k0, k1 };
+            uint32_t block[4];
+            philox( counter, key, block );
+            u[2*iblock  ] = toDouble( block[0], block[1] );
+            u[2*iblock+1] = toDouble( block[2], block[3] );
+        }
+        counter_[0] += nblocks;
+        navail_ = 0;
+        if( n%2 ) {
+            u[n-1] = uniform();
+        }
+    }
+
+    //! Philox4x32 with 10 rounds: block of 4 random integers for a given counter and key
+    #pragma omp declare simd
+    static inline void philox( const uint32_t counter[4], const uint32_t key[2], uint32_t block[4] )
+    {
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for( int iround=0 ; iround<10 ; iround++ ) {
+            uint64_t p0 = ( uint64_t )0xD2511F53u * c0;
+            uint64_t p1 = ( uint64_t )0xCD9E8D57u * c2;
+            c0 = ( uint32_t )( p1 >> 32 ) ^ c1 ^ k0;
+            c1 = ( uint32_t )p1;
+            c2 = ( uint32_t )( p0 >> 32 ) ^ c3 ^ k1;
+            c3 = ( uint32_t )p0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        block[0] = c0;
+        block[1] = c1;
+        block[2] = c2;
+        block[3] = c3;
+    }
+
+private:
+    //! Double in [0, 1[ from 2 random integers
+    static inline double toDouble( uint32_t a, uint32_t b )
+    {
+        return ( ( double )( a >> 5 ) * 67108864. + ( double )( b >> 6 ) ) * ( 1./9007199254740992. );
+    }
+
+    uint32_t seed_;
+    uint32_t key_[2];
+    uint32_t counter_[4];
+    //! Last block computed, and number of its integers not used yet
+    uint32_t block_[4];
+    unsigned int navail_;
+};
+
+#endif
@@ -0,0 +1,25 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The outputs written by the background thread must match the synchronous ones
+
+# FIELD DIAGNOSTICS
+Validate("List of timesteps of the field diagnostic", S.Field(0, "Ex").getAvailableTimesteps())
+for field in ["Ex", "Ey", "Rho_electron"]:
+	Validate("Field "+field, S.Field(0, field, timesteps=[70,80]).getData(), 1e-10)
+
+# PROBE DIAGNOSTICS
+Validate("List of timesteps of the probe", S.Probe(0, "Ex").getAvailableTimesteps())
+for field in ["Ex", "Ey", "Rho"]:
+	Validate("Probe "+field, S.Probe(0, field, timesteps=[70,80]).getData(), 1e-10)
+
+# TRACKED PARTICLES
+track = S.TrackParticles("electron", axes=["Id", "x", "y", "px", "py", "Ex", "Ey"]).getData()
+Validate("Number of tracked particles", track["Id"].shape)
+for axis in ["x", "y", "px", "py", "Ex", "Ey"]:
+	Validate("Tracked particles "+axis, track[axis][-1], 1e-10)
+
+# SCALARS
+Validate("Electromagnetic energy", S.Scalar("Uelm").getData(), 1e-10)
@@ -0,0 +1,12 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Each diagnostic written in parallel must match the previous one (up to the order of the sums)
+for i in range(len(S.namelist.axes)):
+	default  = np.array(S.ParticleBinning(2*i  ).getData())
+	parallel = np.array(S.ParticleBinning(2*i+1).getData())
+	Validate("Timesteps of parallel binning "+str(i), S.ParticleBinning(2*i+1).getAvailableTimesteps())
+	Validate("Parallel binning "+str(i)+" matches default", np.abs(parallel-default).max() <= 1e-12*np.abs(default).max())
+	Validate("Parallel binning "+str(i), parallel[-1], 1e-10)
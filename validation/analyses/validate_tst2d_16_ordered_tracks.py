@@ -0,0 +1,28 @@
+import os, re, numpy as np, h5py
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+axes = ["Id", "x", "y", "px", "py", "Ex", "Ey"]
+default = S.TrackParticles("electron"        , axes=axes).getData()
+ordered = S.TrackParticles("electron_ordered", axes=axes).getData()
+
+# The ordered track, read without sorting, must match the sorted default track
+for axis in axes:
+	Validate("Ordered track "+axis+" identical to default", np.array_equal(default[axis], ordered[axis]))
+Validate("Tracked timesteps", ordered["times"])
+for axis in axes[1:]:
+	Validate("Ordered track "+axis, ordered[axis][-1], 1e-10)
+
+# In the file, each particle is written at the slot given by its ID
+with h5py.File("./restart000/TrackParticlesDisordered_electron_ordered.h5", "r") as f:
+	slots_ok = True
+	for t in f["data"]:
+		latest_IDs = f["data"][t]["latest_IDs"][()]
+		count = latest_IDs % 2**32
+		offset = np.cumsum(count) - count
+		Id = f["data"][t]["particles"]["electron_ordered"]["id"][()]
+		written = np.flatnonzero(Id)
+		slots = offset[(Id[written]>>32).astype(int)] + (Id[written] % 2**32) - 1
+		slots_ok = slots_ok and np.array_equal(slots, written)
+	Validate("Ordered track slots", slots_ok)